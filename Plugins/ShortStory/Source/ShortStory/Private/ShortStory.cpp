@@ -3,6 +3,8 @@
 #include "ShortStory.h"
 #include "ShortStorySubsystem.h"
 #include "ShortStoryParser.h"
+#include "ShortStoryAudio.h"
+#include "ShortStoryAudioSubsystem.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 
@@ -133,6 +135,62 @@ static void ClearCacheCommand(const TArray<FString>& Args, UWorld* World)
 	UE_LOG(LogShortStory, Display, TEXT("Story cache cleared"));
 }
 
+static void CacheStatsCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || !World->GetGameInstance())
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.CacheStats: No valid world or game instance"));
+		return;
+	}
+
+	UShortStorySubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UShortStorySubsystem>();
+	if (!Subsystem)
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.CacheStats: ShortStorySubsystem not available"));
+		return;
+	}
+
+	const FShortStoryCache& Cache = Subsystem->GetStoryCache();
+	const FShortStoryCache::FStats Stats = Cache.GetStats();
+	const int64 BudgetBytes = Subsystem->GetCacheBudgetBytes();
+
+	UE_LOG(LogShortStory, Display, TEXT("=== Story Cache ==="));
+	UE_LOG(LogShortStory, Display, TEXT("%d stories, %.2f MB (text %.2f MB, textures %.2f MB), budget %s, %d evictions"),
+		Stats.NumStories,
+		Stats.GetTotalBytes() / (1024.0 * 1024.0),
+		Stats.TextBytes / (1024.0 * 1024.0),
+		Stats.TextureBytes / (1024.0 * 1024.0),
+		BudgetBytes > 0 ? *FString::Printf(TEXT("%.0f MB"), BudgetBytes / (1024.0 * 1024.0)) : TEXT("unlimited"),
+		Stats.NumEvictions);
+
+	// Most recently used first (the first to be evicted is listed last)
+	struct FRow
+	{
+		FString FileName;
+		int64 TextBytes;
+		int64 TextureBytes;
+		uint64 LastUsed;
+	};
+	TArray<FRow> Rows;
+	Cache.ForEach([&Rows](const FShortStoryCache::FCachedStory& Entry)
+	{
+		Rows.Add({ Entry.FileName, Entry.TextBytes, Entry.TextureBytes, Entry.LastUsed.load(std::memory_order_relaxed) });
+	});
+	Rows.Sort([](const FRow& A, const FRow& B) { return A.LastUsed > B.LastUsed; });
+
+	const FName CurrentStoryId = Subsystem->GetCurrentStoryId();
+	for (const FRow& Row : Rows)
+	{
+		const bool bIsPlaying = Subsystem->IsPlaying() && FName(*Row.FileName) == CurrentStoryId;
+		UE_LOG(LogShortStory, Display, TEXT("  %s%s: %.2f MB (text %.1f KB, textures %.2f MB)"),
+			*Row.FileName,
+			bIsPlaying ? TEXT(" [playing]") : TEXT(""),
+			(Row.TextBytes + Row.TextureBytes) / (1024.0 * 1024.0),
+			Row.TextBytes / 1024.0,
+			Row.TextureBytes / (1024.0 * 1024.0));
+	}
+}
+
 static void DebugNextScreen(const TArray<FString>& Args, UWorld* World)
 {
 	if (!World || !World->GetGameInstance())
@@ -212,6 +270,129 @@ static void DebugSkipLine(const TArray<FString>& Args, UWorld* World)
 	Subsystem->DebugSkipCurrentLine();
 }
 
+static void SkipCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || !World->GetGameInstance())
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.Skip: No valid world or game instance"));
+		return;
+	}
+
+	UShortStorySubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UShortStorySubsystem>();
+	if (!Subsystem)
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.Skip: ShortStorySubsystem not available"));
+		return;
+	}
+
+	EStorySkipEventPolicy Policy = EStorySkipEventPolicy::FireStateOnly;
+	if (Args.Num() > 0)
+	{
+		if (Args[0].Equals(TEXT("all"), ESearchCase::IgnoreCase))
+		{
+			Policy = EStorySkipEventPolicy::FireAll;
+		}
+		else if (Args[0].Equals(TEXT("none"), ESearchCase::IgnoreCase))
+		{
+			Policy = EStorySkipEventPolicy::SuppressAll;
+		}
+		else if (!Args[0].Equals(TEXT("state"), ESearchCase::IgnoreCase))
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("Story.Skip: Unknown event policy '%s' (all, none, state)"), *Args[0]);
+			return;
+		}
+	}
+
+	if (!Subsystem->SkipToNextStablePoint(Policy))
+	{
+		UE_LOG(LogShortStory, Display, TEXT("Story.Skip: Nothing to skip (not playing or waiting for input)"));
+	}
+}
+
+static void ExportLocCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (Args.Num() < 1)
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("Story.ExportLoc: Usage: Story.ExportLoc <filename.tos>"));
+		return;
+	}
+
+	if (!World || !World->GetGameInstance())
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.ExportLoc: No valid world or game instance"));
+		return;
+	}
+
+	UShortStorySubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UShortStorySubsystem>();
+	if (!Subsystem)
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.ExportLoc: ShortStorySubsystem not available"));
+		return;
+	}
+
+	FString OutPath;
+	if (Subsystem->ExportStoryStrings(Args[0], OutPath))
+	{
+		UE_LOG(LogShortStory, Display, TEXT("Story.ExportLoc: Exported '%s' to %s"), *Args[0], *OutPath);
+	}
+}
+
+static void SetCultureCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || !World->GetGameInstance())
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.SetCulture: No valid world or game instance"));
+		return;
+	}
+
+	UShortStorySubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UShortStorySubsystem>();
+	if (!Subsystem)
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.SetCulture: ShortStorySubsystem not available"));
+		return;
+	}
+
+	Subsystem->SetStoryCulture(Args.Num() > 0 ? Args[0] : FString());
+}
+
+static void AudioCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || !World->GetGameInstance())
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.Audio: No valid world or game instance"));
+		return;
+	}
+
+	UShortStoryAudioSubsystem* AudioSubsystem = World->GetGameInstance()->GetSubsystem<UShortStoryAudioSubsystem>();
+	IShortStoryAudioBackend* Backend = AudioSubsystem ? AudioSubsystem->GetBackend() : nullptr;
+	if (!Backend)
+	{
+		UE_LOG(LogShortStory, Error, TEXT("Story.Audio: ShortStoryAudioSubsystem not available"));
+		return;
+	}
+
+	UE_LOG(LogShortStory, Display, TEXT("=== Story Audio ==="));
+	UE_LOG(LogShortStory, Display, TEXT("%s backend, scheduling %s, %.0f ms lookahead, %d pending cues"),
+		Backend->GetName(),
+		AudioSubsystem->bScheduleStoryAudio ? TEXT("on") : TEXT("off"),
+		AudioSubsystem->LookaheadSeconds * 1000.0f,
+		AudioSubsystem->GetNumPendingCues());
+
+	// The mock records what would have played, newest last
+	if (const FShortStoryMockAudioBackend* Mock = Backend->AsMock())
+	{
+		const TArray<FShortStoryMockAudioBackend::FRecordedCue>& Cues = Mock->GetRecordedCues();
+		const int32 NumShown = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 0) : 20;
+		UE_LOG(LogShortStory, Display, TEXT("Music: %s%s"), Mock->GetMusic().IsEmpty() ? TEXT("(none)") : *Mock->GetMusic(), Mock->IsPaused() ? TEXT(" [paused]") : TEXT(""));
+		for (int32 Index = FMath::Max(Cues.Num() - NumShown, 0); Index < Cues.Num(); ++Index)
+		{
+			const FShortStoryMockAudioBackend::FRecordedCue& Cue = Cues[Index];
+			UE_LOG(LogShortStory, Display, TEXT("  #%d %s: audible at %.3f (scheduled %.1f ms ahead)%s"),
+				Cue.CueId, *Cue.CuePath, Cue.AudibleTime, (Cue.AudibleTime - Cue.ScheduledTime) * 1000.0, Cue.bCancelled ? TEXT(" [cancelled]") : TEXT(""));
+		}
+	}
+}
+
 // Register console commands
 static FAutoConsoleCommandWithWorldAndArgs GListStoriesCommand(
 	TEXT("Story.List"),
@@ -231,6 +412,18 @@ static FAutoConsoleCommandWithWorldAndArgs GClearCacheCommand(
 	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ClearCacheCommand)
 );
 
+static FAutoConsoleCommandWithWorldAndArgs GCacheStatsCommand(
+	TEXT("Story.CacheStats"),
+	TEXT("Show cached stories with their memory use (most recently used first) and the cache budget"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&CacheStatsCommand)
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GAudioCommand(
+	TEXT("Story.Audio"),
+	TEXT("Show the story audio backend and pending cues (and the last cues recorded by the mock backend). Usage: Story.Audio [count]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&AudioCommand)
+);
+
 static FAutoConsoleCommandWithWorldAndArgs GDebugNextScreenCommand(
 	TEXT("Story.NextScreen"),
 	TEXT("[DEBUG] Skip to next screen"),
@@ -255,6 +448,24 @@ static FAutoConsoleCommandWithWorldAndArgs GDebugSkipLineCommand(
 	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DebugSkipLine)
 );
 
+static FAutoConsoleCommandWithWorldAndArgs GSkipCommand(
+	TEXT("Story.Skip"),
+	TEXT("Skip to the next Wait pause or screen end. Usage: Story.Skip [all|none|state] (timed events to fire, default state)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SkipCommand)
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GExportLocCommand(
+	TEXT("Story.ExportLoc"),
+	TEXT("Write the translation template of a story to Stories/Loc/<SourceCulture>/. Usage: Story.ExportLoc <filename.tos>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ExportLocCommand)
+);
+
+static FAutoConsoleCommandWithWorldAndArgs GSetCultureCommand(
+	TEXT("Story.SetCulture"),
+	TEXT("Show story text in another culture (no argument = source text). Usage: Story.SetCulture [culture]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SetCultureCommand)
+);
+
 // ========================================
 // Module Implementation
 // ========================================
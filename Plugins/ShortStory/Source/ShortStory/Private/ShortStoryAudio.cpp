@@ -0,0 +1,332 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryAudio.h"
+#include "ShortStory.h"
+#include "Components/AudioComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/PackageName.h"
+#include "Quartz/AudioMixerClockHandle.h"
+#include "Quartz/QuartzSubsystem.h"
+#include "Sound/SoundBase.h"
+
+namespace
+{
+	/** Quartz clock shared by all story cues */
+	const FName StoryCueClockName(TEXT("ShortStoryCues"));
+
+	/** Recorded cues kept by the mock backend (a headless server would otherwise grow the log forever) */
+	constexpr int32 MaxRecordedCues = 4096;
+}
+
+// ========================================
+// Engine Backend
+// ========================================
+
+FShortStoryEngineAudioBackend::FShortStoryEngineAudioBackend(UGameInstance* InGameInstance)
+	: GameInstance(InGameInstance)
+{
+}
+
+FShortStoryEngineAudioBackend::~FShortStoryEngineAudioBackend() = default;
+
+FSoftObjectPath FShortStoryEngineAudioBackend::GetSoundPath(const FString& CuePath)
+{
+	const FString PackageName = FPackageName::ObjectPathToPackageName(CuePath);
+	if (!FPackageName::IsValidLongPackageName(PackageName))
+	{
+		return FSoftObjectPath();
+	}
+
+	// "/Game/Audio/SFX_Door" names the package; the sound inside has the same short name
+	if (PackageName == CuePath)
+	{
+		return FSoftObjectPath(CuePath + TEXT(".") + FPackageName::GetShortName(CuePath));
+	}
+	return FSoftObjectPath(CuePath);
+}
+
+bool FShortStoryEngineAudioBackend::PrepareCue(const FString& CuePath)
+{
+	if (const TObjectPtr<USoundBase>* Prepared = Sounds.Find(CuePath))
+	{
+		return *Prepared != nullptr;
+	}
+
+	USoundBase* Sound = nullptr;
+	const FSoftObjectPath SoundPath = GetSoundPath(CuePath);
+	if (SoundPath.IsNull())
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("PrepareCue: '%s' is not a sound asset path"), *CuePath);
+	}
+	else
+	{
+		// Already resident when the story was prewarmed
+		Sound = Cast<USoundBase>(SoundPath.TryLoad());
+		if (!Sound)
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("PrepareCue: Failed to load sound '%s'"), *SoundPath.ToString());
+		}
+	}
+
+	Sounds.Add(CuePath, Sound);
+	return Sound != nullptr;
+}
+
+void FShortStoryEngineAudioBackend::ReleaseCues()
+{
+	Sounds.Empty();
+}
+
+int32 FShortStoryEngineAudioBackend::ScheduleCue(const FString& CuePath, double Delay)
+{
+	USoundBase* Sound = FindSound(CuePath);
+	UWorld* World = GetWorld();
+	if (!Sound || !World)
+	{
+		return INDEX_NONE;
+	}
+
+	PruneActiveSounds();
+
+	UAudioComponent* Component = UGameplayStatics::CreateSound2D(World, Sound, 1.0f, 1.0f, 0.0f, nullptr, true, true);
+	if (!Component)
+	{
+		// No audio device
+		return INDEX_NONE;
+	}
+
+	UQuartzClockHandle* ClockHandle = Delay > 0.0 ? GetClock(World) : nullptr;
+	if (ClockHandle)
+	{
+		// The mixer counts the delay in clock ticks and starts the sound on the exact buffer frame
+		FQuartzQuantizationBoundary Boundary(EQuartzCommandQuantization::Tick, FMath::Max(static_cast<float>(Delay * 1000.0), 1.0f),
+			EQuarztQuantizationReference::CurrentTimeRelative, true);
+		Component->PlayQuantized(World, ClockHandle, Boundary, FOnQuartzCommandEventBP());
+	}
+	else
+	{
+		// Late cues start into the sound, so they stay in step with the story clock
+		Component->Play(Delay < 0.0 ? static_cast<float>(-Delay) : 0.0f);
+	}
+
+	FActiveSound& Active = ActiveSounds.AddDefaulted_GetRef();
+	Active.CueId = NextCueId++;
+	Active.Component = Component;
+	Active.AudibleTime = FApp::GetCurrentTime() + FMath::Max(Delay, 0.0);
+	return Active.CueId;
+}
+
+void FShortStoryEngineAudioBackend::CancelCue(int32 CueId)
+{
+	const int32 Index = ActiveSounds.IndexOfByPredicate([CueId](const FActiveSound& Active) { return Active.CueId == CueId; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (IsValid(ActiveSounds[Index].Component))
+	{
+		ActiveSounds[Index].Component->Stop();
+	}
+	ActiveSounds.RemoveAtSwap(Index);
+}
+
+void FShortStoryEngineAudioBackend::SetPaused(bool bPause)
+{
+	for (const FActiveSound& Active : ActiveSounds)
+	{
+		if (IsValid(Active.Component))
+		{
+			Active.Component->SetPaused(bPause);
+		}
+	}
+
+	if (IsValid(MusicComponent))
+	{
+		MusicComponent->SetPaused(bPause);
+	}
+}
+
+void FShortStoryEngineAudioBackend::PlayMusic(const FString& CuePath)
+{
+	StopMusic();
+
+	USoundBase* Sound = FindSound(CuePath);
+	UWorld* World = GetWorld();
+	if (!Sound || !World)
+	{
+		return;
+	}
+
+	MusicComponent = UGameplayStatics::CreateSound2D(World, Sound, 1.0f, 1.0f, 0.0f, nullptr, true, false);
+	if (MusicComponent)
+	{
+		MusicComponent->Play();
+	}
+}
+
+void FShortStoryEngineAudioBackend::StopMusic()
+{
+	if (IsValid(MusicComponent))
+	{
+		MusicComponent->Stop();
+		MusicComponent->DestroyComponent();
+	}
+	MusicComponent = nullptr;
+}
+
+void FShortStoryEngineAudioBackend::StopAll()
+{
+	for (const FActiveSound& Active : ActiveSounds)
+	{
+		if (IsValid(Active.Component))
+		{
+			Active.Component->Stop();
+		}
+	}
+	ActiveSounds.Empty();
+
+	StopMusic();
+}
+
+bool FShortStoryEngineAudioBackend::SupportsScheduling() const
+{
+	// Without the audio mixer there is no Quartz, and cues are sent when due
+	const UWorld* World = GetWorld();
+	return World && UQuartzSubsystem::Get(World) != nullptr;
+}
+
+void FShortStoryEngineAudioBackend::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(Sounds);
+	for (FActiveSound& Active : ActiveSounds)
+	{
+		Collector.AddReferencedObject(Active.Component);
+	}
+	Collector.AddReferencedObject(MusicComponent);
+	Collector.AddReferencedObject(Clock);
+}
+
+UWorld* FShortStoryEngineAudioBackend::GetWorld() const
+{
+	const UGameInstance* Instance = GameInstance.Get();
+	return Instance ? Instance->GetWorld() : nullptr;
+}
+
+USoundBase* FShortStoryEngineAudioBackend::FindSound(const FString& CuePath)
+{
+	if (const TObjectPtr<USoundBase>* Prepared = Sounds.Find(CuePath))
+	{
+		return *Prepared;
+	}
+
+	PrepareCue(CuePath);
+	return Sounds.FindRef(CuePath);
+}
+
+UQuartzClockHandle* FShortStoryEngineAudioBackend::GetClock(UWorld* World)
+{
+	if (Clock && ClockWorld.Get() == World)
+	{
+		return Clock;
+	}
+
+	Clock = nullptr;
+	ClockWorld = World;
+
+	UQuartzSubsystem* Quartz = UQuartzSubsystem::Get(World);
+	if (!Quartz)
+	{
+		return nullptr;
+	}
+
+	UQuartzClockHandle* NewClock = Quartz->CreateNewClock(World, StoryCueClockName, FQuartzClockSettings(), true);
+	if (!NewClock)
+	{
+		return nullptr;
+	}
+
+	// One tick per millisecond, applied right away rather than on the next bar
+	FQuartzQuantizationBoundary Immediately(EQuartzCommandQuantization::None);
+	NewClock->SetMillisecondsPerTick(World, Immediately, FOnQuartzCommandEventBP(), NewClock, 1.0f);
+	NewClock->StartClock(World, NewClock);
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryAudio: Created cue clock in %s"), *World->GetName());
+
+	Clock = NewClock;
+	return Clock;
+}
+
+void FShortStoryEngineAudioBackend::PruneActiveSounds()
+{
+	const double Now = FApp::GetCurrentTime();
+	ActiveSounds.RemoveAllSwap([Now](const FActiveSound& Active)
+	{
+		// Queued sounds may report not playing until the clock starts them
+		return !IsValid(Active.Component) || (Now > Active.AudibleTime && !Active.Component->IsPlaying());
+	});
+}
+
+// ========================================
+// Mock Backend
+// ========================================
+
+bool FShortStoryMockAudioBackend::PrepareCue(const FString& CuePath)
+{
+	PreparedCues.Add(CuePath);
+	return true;
+}
+
+void FShortStoryMockAudioBackend::ReleaseCues()
+{
+	PreparedCues.Empty();
+}
+
+int32 FShortStoryMockAudioBackend::ScheduleCue(const FString& CuePath, double Delay)
+{
+	if (RecordedCues.Num() >= MaxRecordedCues)
+	{
+		RecordedCues.RemoveAt(0, MaxRecordedCues / 2, EAllowShrinking::No);
+	}
+
+	FRecordedCue& Cue = RecordedCues.AddDefaulted_GetRef();
+	Cue.CueId = NextCueId++;
+	Cue.CuePath = CuePath;
+	Cue.ScheduledTime = FApp::GetCurrentTime();
+	Cue.AudibleTime = Cue.ScheduledTime + Delay;
+
+	UE_LOG(LogShortStory, Verbose, TEXT("MockAudio: Cue %d '%s' audible in %.1f ms"), Cue.CueId, *CuePath, Delay * 1000.0);
+	return Cue.CueId;
+}
+
+void FShortStoryMockAudioBackend::CancelCue(int32 CueId)
+{
+	if (FRecordedCue* Cue = RecordedCues.FindByPredicate([CueId](const FRecordedCue& Recorded) { return Recorded.CueId == CueId; }))
+	{
+		Cue->bCancelled = true;
+	}
+}
+
+void FShortStoryMockAudioBackend::StopAll()
+{
+	const double Now = FApp::GetCurrentTime();
+	for (FRecordedCue& Cue : RecordedCues)
+	{
+		if (Cue.AudibleTime > Now)
+		{
+			Cue.bCancelled = true;
+		}
+	}
+	Music.Reset();
+}
+
+void FShortStoryMockAudioBackend::Reset()
+{
+	RecordedCues.Empty();
+	PreparedCues.Empty();
+	Music.Reset();
+	bIsPaused = false;
+}
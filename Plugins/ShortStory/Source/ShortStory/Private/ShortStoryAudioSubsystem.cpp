@@ -0,0 +1,279 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryAudioSubsystem.h"
+#include "ShortStoryAudio.h"
+#include "ShortStorySubsystem.h"
+#include "ShortStory.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/App.h"
+
+namespace
+{
+	bool IsAudioCue(const FStoryTimedEvent& Event)
+	{
+		return Event.EventType == EStoryTimedEventType::SFX && !Event.AssetPath.IsEmpty();
+	}
+}
+
+void UShortStoryAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SetBackend(nullptr);
+
+	StorySubsystem = Collection.InitializeDependency<UShortStorySubsystem>();
+	if (StorySubsystem.IsValid())
+	{
+		ClockChangedHandle = StorySubsystem->OnClockChanged.AddUObject(this, &UShortStoryAudioSubsystem::HandleClockChanged);
+	}
+	else
+	{
+		UE_LOG(LogShortStory, Error, TEXT("ShortStoryAudioSubsystem: ShortStorySubsystem not available, story audio disabled"));
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryAudioSubsystem initialized (%s backend, %.0f ms lookahead)"), Backend->GetName(), LookaheadSeconds * 1000.0f);
+}
+
+void UShortStoryAudioSubsystem::Deinitialize()
+{
+	if (UShortStorySubsystem* Subsystem = StorySubsystem.Get())
+	{
+		Subsystem->OnClockChanged.Remove(ClockChangedHandle);
+	}
+	ClockChangedHandle.Reset();
+	StorySubsystem.Reset();
+
+	ClearTicker();
+	PendingCues.Empty();
+	if (Backend.IsValid())
+	{
+		Backend->StopAll();
+		Backend->ReleaseCues();
+		Backend.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UShortStoryAudioSubsystem::SetBackend(TSharedPtr<IShortStoryAudioBackend> NewBackend)
+{
+	ClearTicker();
+	PendingCues.Empty();
+	if (Backend.IsValid())
+	{
+		Backend->StopAll();
+		Backend->ReleaseCues();
+	}
+
+	if (!NewBackend.IsValid())
+	{
+		if (bUseMockBackend || !FApp::CanEverRenderAudio())
+		{
+			NewBackend = MakeShared<FShortStoryMockAudioBackend>();
+		}
+		else
+		{
+			NewBackend = MakeShared<FShortStoryEngineAudioBackend>(GetGameInstance());
+		}
+	}
+	Backend = NewBackend;
+
+	// Pick up a story that is already playing
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	if (Subsystem && Subsystem->IsPlaying())
+	{
+		PrepareStory();
+		Reschedule();
+	}
+}
+
+void UShortStoryAudioSubsystem::HandleClockChanged(EStoryClockChange Change)
+{
+	if (!bScheduleStoryAudio || !Backend.IsValid())
+	{
+		return;
+	}
+
+	switch (Change)
+	{
+		case EStoryClockChange::Started:
+			CancelPendingCues();
+			Backend->StopAll();
+			PrepareStory();
+			Reschedule();
+			break;
+
+		case EStoryClockChange::Stopped:
+			ClearTicker();
+			CancelPendingCues();
+			Backend->StopAll();
+			Backend->ReleaseCues();
+			ScheduledScreenIndex = INDEX_NONE;
+			break;
+
+		case EStoryClockChange::RateChanged:
+			// Cancel first: cues queued on the audio clock would otherwise start during the pause
+			CancelPendingCues();
+			Backend->SetPaused(StorySubsystem.IsValid() && StorySubsystem->IsPaused());
+			Reschedule();
+			break;
+
+		default:
+			Reschedule();
+			break;
+	}
+}
+
+void UShortStoryAudioSubsystem::PrepareStory()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (!Story)
+	{
+		return;
+	}
+
+	// Resolve every cue up front so playback never loads
+	TSet<FString> Prepared;
+	int32 NumFailed = 0;
+	for (const FStoryScreen& Screen : Story->Screens)
+	{
+		for (const FStoryTimedEvent& Event : Screen.TimedEvents)
+		{
+			if (IsAudioCue(Event) && !Prepared.Contains(Event.AssetPath))
+			{
+				Prepared.Add(Event.AssetPath);
+				NumFailed += Backend->PrepareCue(Event.AssetPath) ? 0 : 1;
+			}
+		}
+	}
+
+	if (!Story->OST.IsEmpty())
+	{
+		if (Backend->PrepareCue(Story->OST))
+		{
+			Backend->PlayMusic(Story->OST);
+		}
+		else
+		{
+			++NumFailed;
+		}
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryAudio: Prepared %d cues for '%s' (%d failed)"),
+		Prepared.Num() + (Story->OST.IsEmpty() ? 0 : 1), *Subsystem->GetCurrentStoryId().ToString(), NumFailed);
+}
+
+void UShortStoryAudioSubsystem::Reschedule()
+{
+	ClearTicker();
+	CancelPendingCues();
+
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem && Subsystem->IsPlaying() ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (!Story || !Story->Screens.IsValidIndex(Subsystem->GetCurrentScreenIndex()))
+	{
+		ScheduledScreenIndex = INDEX_NONE;
+		return;
+	}
+
+	// Cues already audible keep playing; the cursor restarts at the first cue not reached yet
+	ScheduledScreenIndex = Subsystem->GetCurrentScreenIndex();
+	const TArray<FStoryTimedEvent>& TimedEvents = Story->Screens[ScheduledScreenIndex].TimedEvents;
+	NextEventIndex = Algo::LowerBoundBy(TimedEvents, Subsystem->GetScreenTime(), &FStoryTimedEvent::StartTime);
+
+	ScheduleDueCues();
+}
+
+void UShortStoryAudioSubsystem::ScheduleDueCues()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem && Subsystem->IsPlaying() ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (!Story || !Story->Screens.IsValidIndex(ScheduledScreenIndex) || Subsystem->GetCurrentScreenIndex() != ScheduledScreenIndex)
+	{
+		return;
+	}
+
+	// Paused: resuming reschedules
+	const float Rate = Subsystem->GetPlaybackRate();
+	if (Rate <= 0.0f)
+	{
+		return;
+	}
+
+	const double Now = FApp::GetCurrentTime();
+	PendingCues.RemoveAllSwap([Now](const FPendingCue& Cue) { return Cue.AudibleTime <= Now; });
+
+	// Backends that cannot start in the future get each cue when it is due
+	const float ScreenTime = Subsystem->GetScreenTime();
+	const float Horizon = ScreenTime + (Backend->SupportsScheduling() ? LookaheadSeconds * Rate : 0.0f);
+
+	const TArray<FStoryTimedEvent>& TimedEvents = Story->Screens[ScheduledScreenIndex].TimedEvents;
+	for (; TimedEvents.IsValidIndex(NextEventIndex); ++NextEventIndex)
+	{
+		const FStoryTimedEvent& Event = TimedEvents[NextEventIndex];
+		if (!IsAudioCue(Event))
+		{
+			continue;
+		}
+
+		if (Event.StartTime > Horizon)
+		{
+			// Sleep until this cue enters the window
+			const float Delay = (Event.StartTime - Horizon) / Rate;
+			TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateUObject(this, &UShortStoryAudioSubsystem::TickScheduler), Delay
+			);
+			return;
+		}
+
+		const double Delay = (Event.StartTime - ScreenTime) / Rate;
+		const int32 CueId = Backend->ScheduleCue(Event.AssetPath, Delay);
+		if (CueId != INDEX_NONE && Delay > 0.0)
+		{
+			PendingCues.Add({ CueId, Now + Delay });
+		}
+
+		UE_LOG(LogShortStory, Verbose, TEXT("ShortStoryAudio: Cue '%s' at %.3fs scheduled %.1f ms ahead"), *Event.AssetPath, Event.StartTime, Delay * 1000.0);
+	}
+}
+
+bool UShortStoryAudioSubsystem::TickScheduler(float DeltaTime)
+{
+	// Returning false removes this one-shot ticker
+	TickerHandle.Reset();
+
+	// A screen change we did not hear about (should not happen, but never play the wrong screen's cues)
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	if (Subsystem && Subsystem->GetCurrentScreenIndex() != ScheduledScreenIndex)
+	{
+		Reschedule();
+	}
+	else
+	{
+		ScheduleDueCues();
+	}
+	return false;
+}
+
+void UShortStoryAudioSubsystem::CancelPendingCues()
+{
+	const double Now = FApp::GetCurrentTime();
+	for (const FPendingCue& Cue : PendingCues)
+	{
+		if (Cue.AudibleTime > Now)
+		{
+			Backend->CancelCue(Cue.CueId);
+		}
+	}
+	PendingCues.Reset();
+}
+
+void UShortStoryAudioSubsystem::ClearTicker()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
@@ -0,0 +1,504 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryBlipSubsystem.h"
+#include "ShortStoryBlipVoice.h"
+#include "ShortStorySubsystem.h"
+#include "ShortStory.h"
+#include "Components/AudioComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Sound/SoundBase.h"
+
+namespace
+{
+	/** Lines expected to reveal at once (a typewriter segment is usually one line) */
+	constexpr int32 ExpectedActiveLines = 8;
+
+	/** Voice name of a line: its own, else the story default */
+	FName GetLineVoice(const FShortStory& Story, const FStoryLine& Line)
+	{
+		return Line.Voice.IsNone() ? Story.DefaultVoice : Line.Voice;
+	}
+}
+
+void UShortStoryBlipSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActiveLines.Reserve(ExpectedActiveLines);
+
+	StorySubsystem = Collection.InitializeDependency<UShortStorySubsystem>();
+	if (StorySubsystem.IsValid())
+	{
+		LinesRevealedHandle = StorySubsystem->OnLinesRevealed.AddUObject(this, &UShortStoryBlipSubsystem::HandleLinesRevealed);
+		ClockChangedHandle = StorySubsystem->OnClockChanged.AddUObject(this, &UShortStoryBlipSubsystem::HandleClockChanged);
+		GatherPrewarmAssetsHandle = StorySubsystem->OnGatherPrewarmAssets.AddUObject(this, &UShortStoryBlipSubsystem::HandleGatherPrewarmAssets);
+	}
+	else
+	{
+		UE_LOG(LogShortStory, Error, TEXT("ShortStoryBlipSubsystem: ShortStorySubsystem not available, blips disabled"));
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryBlipSubsystem initialized (%d voices configured, pool of %d)"), Voices.Num(), MaxVoices);
+}
+
+void UShortStoryBlipSubsystem::Deinitialize()
+{
+	if (UShortStorySubsystem* Subsystem = StorySubsystem.Get())
+	{
+		Subsystem->OnLinesRevealed.Remove(LinesRevealedHandle);
+		Subsystem->OnClockChanged.Remove(ClockChangedHandle);
+		Subsystem->OnGatherPrewarmAssets.Remove(GatherPrewarmAssetsHandle);
+	}
+	LinesRevealedHandle.Reset();
+	ClockChangedHandle.Reset();
+	GatherPrewarmAssetsHandle.Reset();
+	StorySubsystem.Reset();
+
+	ActiveLines.Empty();
+	UpdateTicker();
+	DestroyVoicePool();
+
+	if (VoiceLoadHandle.IsValid())
+	{
+		VoiceLoadHandle->CancelHandle();
+		VoiceLoadHandle.Reset();
+	}
+
+	ResolvedVoices.Empty();
+	VoiceIndices.Empty();
+	LoadedVoices.Empty();
+	LoadedSounds.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShortStoryBlipSubsystem::HandleLinesRevealed(FName StoryId, int32 ScreenIndex, int32 FirstLine, int32 LastLine)
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	if (!bEnableBlips || ResolvedVoices.Num() == 0 || !Subsystem || Subsystem->GetCurrentScreenIndex() != ScreenIndex)
+	{
+		return;
+	}
+
+	const FShortStory* Story = Subsystem->FindLoadedStory(StoryId);
+	if (!Story)
+	{
+		return;
+	}
+
+	for (int32 LineIndex = FirstLine; LineIndex <= LastLine; ++LineIndex)
+	{
+		AddActiveLine(*Story, LineIndex);
+	}
+	UpdateTicker();
+}
+
+void UShortStoryBlipSubsystem::HandleClockChanged(EStoryClockChange Change)
+{
+	switch (Change)
+	{
+		case EStoryClockChange::Started:
+		{
+			// The first line starts before Started is broadcast, so it is picked up by the rebuild
+			const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+			const FShortStory* Story = Subsystem ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+			if (bEnableBlips && Story)
+			{
+				ResolveVoices(*Story);
+			}
+			RebuildActiveLines();
+			break;
+		}
+
+		case EStoryClockChange::Stopped:
+			ActiveLines.Reset();
+			UpdateTicker();
+			for (UAudioComponent* Component : VoicePool)
+			{
+				if (IsValid(Component))
+				{
+					Component->Stop();
+				}
+			}
+
+			// Voice assets are resolved again by the next story
+			if (VoiceLoadHandle.IsValid())
+			{
+				VoiceLoadHandle->CancelHandle();
+				VoiceLoadHandle.Reset();
+			}
+			ResolvedVoices.Reset();
+			VoiceIndices.Reset();
+			LoadedVoices.Reset();
+			LoadedSounds.Reset();
+			break;
+
+		case EStoryClockChange::RateChanged:
+			// Paused: stop ticking until resumed
+			UpdateTicker();
+			break;
+
+		default:
+			// Screen changes and skips: characters passed over stay silent
+			RebuildActiveLines();
+			break;
+	}
+}
+
+void UShortStoryBlipSubsystem::HandleGatherPrewarmAssets(const FShortStory& Story, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+	// Voices hold their sounds, so loading a voice loads them too
+	auto AddVoice = [this, &OutAssetPaths](FName VoiceName)
+	{
+		const TSoftObjectPtr<UShortStoryBlipVoice>* Voice = VoiceName.IsNone() ? nullptr : Voices.Find(VoiceName);
+		if (Voice && !Voice->IsNull())
+		{
+			OutAssetPaths.AddUnique(Voice->ToSoftObjectPath());
+		}
+	};
+
+	for (const FStoryScreen& Screen : Story.Screens)
+	{
+		for (const FStoryLine& Line : Screen.Lines)
+		{
+			AddVoice(Line.Voice);
+		}
+	}
+	AddVoice(Story.DefaultVoice);
+}
+
+void UShortStoryBlipSubsystem::ResolveVoices(const FShortStory& Story)
+{
+	ResolvedVoices.Reset();
+	VoiceIndices.Reset();
+	LoadedVoices.Reset();
+	LoadedSounds.Reset();
+
+	TArray<FSoftObjectPath> MissingVoices;
+	for (const FStoryScreen& Screen : Story.Screens)
+	{
+		for (const FStoryLine& Line : Screen.Lines)
+		{
+			const FName VoiceName = GetLineVoice(Story, Line);
+			if (VoiceName.IsNone() || VoiceIndices.Contains(VoiceName))
+			{
+				continue;
+			}
+
+			// Unknown and empty voices are remembered as INDEX_NONE so they are reported once
+			int32& VoiceIndex = VoiceIndices.Add(VoiceName, INDEX_NONE);
+
+			const TSoftObjectPtr<UShortStoryBlipVoice>* VoicePath = Voices.Find(VoiceName);
+			if (!VoicePath || VoicePath->IsNull())
+			{
+				UE_LOG(LogShortStory, Warning, TEXT("ShortStoryBlips: Voice '%s' in '%s' is not configured (Voices in [/Script/ShortStory.ShortStoryBlipSubsystem])"),
+					*VoiceName.ToString(), *Story.SourceFileName);
+				continue;
+			}
+
+			// Prewarmed voices are resident along with their sounds; the others stay silent until they load
+			UShortStoryBlipVoice* VoiceAsset = VoicePath->Get();
+			if (!VoiceAsset)
+			{
+				MissingVoices.Add(VoicePath->ToSoftObjectPath());
+				continue;
+			}
+
+			FResolvedVoice Voice;
+			Voice.AssetIndex = LoadedVoices.Add(VoiceAsset);
+			Voice.FirstSound = LoadedSounds.Num();
+			for (USoundBase* Sound : VoiceAsset->Sounds)
+			{
+				if (Sound)
+				{
+					LoadedSounds.Add(Sound);
+				}
+			}
+			Voice.NumSounds = LoadedSounds.Num() - Voice.FirstSound;
+
+			if (Voice.NumSounds == 0)
+			{
+				UE_LOG(LogShortStory, Warning, TEXT("ShortStoryBlips: Voice '%s' (%s) has no sounds"), *VoiceName.ToString(), *VoiceAsset->GetName());
+				continue;
+			}
+
+			VoiceIndex = ResolvedVoices.Add(Voice);
+		}
+	}
+
+	if (ResolvedVoices.Num() > 0)
+	{
+		EnsureVoicePool();
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryBlips: %d voices (%d sounds) for '%s'"), ResolvedVoices.Num(), LoadedSounds.Num(), *Story.SourceFileName);
+
+	// Only one background load per story, so voices that fail to load are not requested again
+	if (MissingVoices.Num() > 0 && !VoiceLoadHandle.IsValid())
+	{
+		UE_LOG(LogShortStory, Log, TEXT("ShortStoryBlips: %d voices of '%s' were not prewarmed, loading them in the background"),
+			MissingVoices.Num(), *Story.SourceFileName);
+		VoiceLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(MissingVoices),
+			FStreamableDelegate::CreateUObject(this, &UShortStoryBlipSubsystem::HandleVoicesLoaded));
+	}
+}
+
+void UShortStoryBlipSubsystem::HandleVoicesLoaded()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem && Subsystem->IsPlaying() ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (!bEnableBlips || !Story)
+	{
+		return;
+	}
+
+	// The handle keeps the voices loaded until the story stops
+	ResolveVoices(*Story);
+	RebuildActiveLines();
+}
+
+void UShortStoryBlipSubsystem::AddActiveLine(const FShortStory& Story, int32 LineIndex)
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const int32 ScreenIndex = Subsystem->GetCurrentScreenIndex();
+	if (!Story.Screens.IsValidIndex(ScreenIndex) || !Story.Screens[ScreenIndex].Lines.IsValidIndex(LineIndex))
+	{
+		return;
+	}
+
+	// Only typewriter lines reveal character by character
+	const FStoryLine& Line = Story.Screens[ScreenIndex].Lines[LineIndex];
+	if (Line.AnimationType != EStoryLineAnimation::Typewriter || !Line.Timeline.bIsBaked)
+	{
+		return;
+	}
+
+	const int32* VoiceIndex = VoiceIndices.Find(GetLineVoice(Story, Line));
+	if (!VoiceIndex || *VoiceIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const float LineStartTime = Subsystem->GetLineStartTime(LineIndex);
+	if (LineStartTime < 0.0f)
+	{
+		return;
+	}
+
+	const int32 NumVisible = Subsystem->GetCharacterIndexAtTime(Line, Subsystem->GetScreenTime() - LineStartTime);
+	if (NumVisible >= Line.Timeline.CharRevealTimes.Num()
+		|| ActiveLines.ContainsByPredicate([LineIndex](const FActiveLine& Active) { return Active.LineIndex == LineIndex; }))
+	{
+		return;
+	}
+
+	FActiveLine& Active = ActiveLines.AddDefaulted_GetRef();
+	Active.LineIndex = LineIndex;
+	Active.VoiceIndex = *VoiceIndex;
+	Active.NextChar = NumVisible;
+}
+
+void UShortStoryBlipSubsystem::RebuildActiveLines()
+{
+	ActiveLines.Reset();
+
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem && Subsystem->IsPlaying() ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (bEnableBlips && ResolvedVoices.Num() > 0 && Story && Story->Screens.IsValidIndex(Subsystem->GetCurrentScreenIndex()))
+	{
+		const int32 NumLines = Story->Screens[Subsystem->GetCurrentScreenIndex()].Lines.Num();
+		for (int32 LineIndex = 0; LineIndex < NumLines; ++LineIndex)
+		{
+			AddActiveLine(*Story, LineIndex);
+		}
+	}
+
+	UpdateTicker();
+}
+
+bool UShortStoryBlipSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShortStory_Blips);
+
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem && Subsystem->IsPlaying() ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (!Story || !Story->Screens.IsValidIndex(Subsystem->GetCurrentScreenIndex()))
+	{
+		ActiveLines.Reset();
+		TickerHandle.Reset();
+		return false;
+	}
+
+	const FStoryScreen& Screen = Story->Screens[Subsystem->GetCurrentScreenIndex()];
+	const float ScreenTime = Subsystem->GetScreenTime();
+	const double Now = FApp::GetCurrentTime();
+
+	for (int32 ActiveIndex = ActiveLines.Num() - 1; ActiveIndex >= 0; --ActiveIndex)
+	{
+		FActiveLine& Active = ActiveLines[ActiveIndex];
+		const FStoryLine& Line = Screen.Lines[Active.LineIndex];
+		const TArray<float>& RevealTimes = Line.Timeline.CharRevealTimes;
+		FResolvedVoice& Voice = ResolvedVoices[Active.VoiceIndex];
+		const UShortStoryBlipVoice* VoiceAsset = LoadedVoices[Voice.AssetIndex];
+
+		// Only the characters revealed since the last tick are walked
+		const float LineTime = ScreenTime - Subsystem->GetLineStartTime(Active.LineIndex);
+		for (; Active.NextChar < RevealTimes.Num() && RevealTimes[Active.NextChar] <= LineTime; ++Active.NextChar)
+		{
+			const TCHAR Character = Line.Text[Active.NextChar];
+			if (FChar::IsWhitespace(Character))
+			{
+				// The next word starts with a blip
+				Active.LettersSinceBlip = 0;
+				continue;
+			}
+
+			if (FChar::IsPunct(Character))
+			{
+				Active.LettersSinceBlip = 0;
+				Voice.SilentUntil = FMath::Max(Voice.SilentUntil, Now + VoiceAsset->PunctuationGap);
+				continue;
+			}
+
+			if (Active.LettersSinceBlip++ % FMath::Max(VoiceAsset->LettersPerBlip, 1) != 0)
+			{
+				continue;
+			}
+
+			if (Now < Voice.SilentUntil)
+			{
+				INC_DWORD_STAT(STAT_ShortStory_BlipsLimited);
+				continue;
+			}
+
+			PlayBlip(Voice);
+			Voice.SilentUntil = Now + VoiceAsset->MinInterval;
+		}
+
+		if (Active.NextChar >= RevealTimes.Num())
+		{
+			ActiveLines.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+		}
+	}
+
+	if (ActiveLines.Num() == 0)
+	{
+		// Returning false removes the ticker until the next line reveals
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void UShortStoryBlipSubsystem::UpdateTicker()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const bool bShouldTick = ActiveLines.Num() > 0 && Subsystem && Subsystem->GetPlaybackRate() > 0.0f;
+
+	if (bShouldTick && !TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UShortStoryBlipSubsystem::Tick));
+	}
+	else if (!bShouldTick && TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+void UShortStoryBlipSubsystem::PlayBlip(FResolvedVoice& Voice)
+{
+	INC_DWORD_STAT(STAT_ShortStory_BlipsPlayed);
+	++NumBlipsPlayed;
+
+	// Never the same sound twice in a row
+	int32 SoundIndex = FMath::RandRange(0, Voice.NumSounds - 1);
+	if (Voice.NumSounds > 1 && SoundIndex == Voice.LastSound)
+	{
+		SoundIndex = (SoundIndex + 1) % Voice.NumSounds;
+	}
+	Voice.LastSound = SoundIndex;
+
+	// Headless runs count blips without playing them
+	if (!EnsureVoicePool())
+	{
+		return;
+	}
+
+	// A free component if there is one, else the one used longest ago
+	UAudioComponent* Component = nullptr;
+	for (int32 Offset = 0; Offset < VoicePool.Num() && !Component; ++Offset)
+	{
+		UAudioComponent* Candidate = VoicePool[(NextPoolIndex + Offset) % VoicePool.Num()];
+		if (!Candidate->IsPlaying())
+		{
+			Component = Candidate;
+			NextPoolIndex = (NextPoolIndex + Offset) % VoicePool.Num();
+		}
+	}
+	if (!Component)
+	{
+		Component = VoicePool[NextPoolIndex];
+		Component->Stop();
+	}
+	NextPoolIndex = (NextPoolIndex + 1) % VoicePool.Num();
+
+	const UShortStoryBlipVoice* VoiceAsset = LoadedVoices[Voice.AssetIndex];
+	Component->SetSound(LoadedSounds[Voice.FirstSound + SoundIndex]);
+	Component->SetPitchMultiplier(FMath::FRandRange(VoiceAsset->MinPitch, FMath::Max(VoiceAsset->MinPitch, VoiceAsset->MaxPitch)));
+	Component->SetVolumeMultiplier(VoiceAsset->Volume);
+	Component->Play();
+}
+
+bool UShortStoryBlipSubsystem::EnsureVoicePool()
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || !FApp::CanEverRenderAudio())
+	{
+		return false;
+	}
+
+	if (PoolWorld.Get() == World && VoicePool.Num() > 0 && IsValid(VoicePool[0]))
+	{
+		return true;
+	}
+
+	// The old world's components went away with it
+	DestroyVoicePool();
+	PoolWorld = World;
+
+	const int32 PoolSize = FMath::Clamp(MaxVoices, 1, 16);
+	VoicePool.Reserve(PoolSize);
+	for (int32 Index = 0; Index < PoolSize; ++Index)
+	{
+		UAudioComponent* Component = NewObject<UAudioComponent>(World);
+		Component->bAutoActivate = false;
+		Component->bAutoDestroy = false;
+		Component->bAllowSpatialization = false;
+		Component->bIsUISound = true;
+		Component->RegisterComponentWithWorld(World);
+		VoicePool.Add(Component);
+	}
+	NextPoolIndex = 0;
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryBlips: Created %d pooled voices in %s"), PoolSize, *World->GetName());
+	return true;
+}
+
+void UShortStoryBlipSubsystem::DestroyVoicePool()
+{
+	for (UAudioComponent* Component : VoicePool)
+	{
+		if (IsValid(Component))
+		{
+			Component->Stop();
+			Component->DestroyComponent();
+		}
+	}
+	VoicePool.Reset();
+	PoolWorld.Reset();
+}
@@ -2,6 +2,8 @@
 
 #include "ShortStoryBlueprintLibrary.h"
 #include "ShortStoryParser.h"
+#include "ShortStoryTextLayout.h"
+#include "Styling/CoreStyle.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
@@ -26,135 +28,24 @@ float UShortStoryBlueprintLibrary::GetPauseDurationSeconds(EStoryPauseDuration P
 
 TArray<FVector2D> UShortStoryBlueprintLibrary::CalculateWordPositions(const FString& Text, EStoryLineAnimation AnimType, FVector2D CanvasSize, float FontSize)
 {
-	TArray<FVector2D> Positions;
+	const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Regular", FMath::RoundToInt(FontSize));
+	const FStoryTextLayout& Layout = FShortStoryTextLayoutCache::Get().GetLayout(Text, AnimType, Font, CanvasSize);
 
-	// Split text into words
-	TArray<FString> Words = SplitTextIntoWords(Text);
-	if (Words.Num() == 0)
+	TArray<FVector2D> Positions;
+	Positions.Reserve(Layout.Words.Num());
+	for (const FStoryWordRect& Word : Layout.Words)
 	{
-		return Positions;
-	}
-
-	// Calculate approximate word spacing
-	const float CharWidth = FontSize * 0.6f; // Approximate monospace character width
-	const float SpaceWidth = FontSize * 0.3f;
-	const float LineHeight = FontSize * 1.5f;
-
-	// Center positions
-	const FVector2D Center = CanvasSize * 0.5f;
-
-	switch (AnimType)
-	{
-	case EStoryLineAnimation::Typewriter:
-	case EStoryLineAnimation::Paragraph:
-		{
-			// Left-aligned, vertically centered
-			float CurrentX = CanvasSize.X * 0.1f; // 10% from left
-			float CurrentY = Center.Y;
-
-			for (const FString& Word : Words)
-			{
-				float WordWidth = Word.Len() * CharWidth;
-
-				// Check if we need to wrap to next line
-				if (CurrentX + WordWidth > CanvasSize.X * 0.9f && Positions.Num() > 0)
-				{
-					CurrentX = CanvasSize.X * 0.1f;
-					CurrentY += LineHeight;
-				}
-
-				Positions.Add(FVector2D(CurrentX, CurrentY));
-				CurrentX += WordWidth + SpaceWidth;
-			}
-		}
-		break;
-
-	case EStoryLineAnimation::LeftToRight:
-		{
-			// Animate from left to center
-			float TotalWidth = 0.0f;
-			for (const FString& Word : Words)
-			{
-				TotalWidth += Word.Len() * CharWidth + SpaceWidth;
-			}
-
-			float StartX = Center.X - TotalWidth * 0.5f;
-			float CurrentX = StartX;
-			float Y = Center.Y;
-
-			for (const FString& Word : Words)
-			{
-				Positions.Add(FVector2D(CurrentX, Y));
-				CurrentX += Word.Len() * CharWidth + SpaceWidth;
-			}
-		}
-		break;
-
-	case EStoryLineAnimation::TopDown:
-		{
-			// Vertically stacked, centered
-			float StartY = Center.Y - (Words.Num() * LineHeight * 0.5f);
-
-			for (int32 i = 0; i < Words.Num(); ++i)
-			{
-				Positions.Add(FVector2D(Center.X, StartY + i * LineHeight));
-			}
-		}
-		break;
-
-	case EStoryLineAnimation::WordRain:
-		{
-			// Random X positions, words "fall" from top
-			for (int32 i = 0; i < Words.Num(); ++i)
-			{
-				// Random X position within canvas bounds (with margins)
-				float RandomX = FMath::FRandRange(CanvasSize.X * 0.1f, CanvasSize.X * 0.9f);
-
-				// Start above canvas, final position in center region
-				float FinalY = Center.Y + FMath::FRandRange(-LineHeight * 2, LineHeight * 2);
-
-				Positions.Add(FVector2D(RandomX, FinalY));
-			}
-		}
-		break;
-
-	case EStoryLineAnimation::Snake:
-		{
-			// Wavy serpentine path
-			const float Amplitude = LineHeight * 2.0f;
-			const float Frequency = 0.5f;
-			const float WordSpacing = FontSize * 3.0f;
-
-			float StartX = CanvasSize.X * 0.1f;
-			float BaseY = Center.Y;
-
-			for (int32 i = 0; i < Words.Num(); ++i)
-			{
-				float X = StartX + i * WordSpacing;
-				float Y = BaseY + Amplitude * FMath::Sin(i * Frequency);
-
-				// Wrap to next line if needed
-				if (X > CanvasSize.X * 0.9f)
-				{
-					X = StartX;
-					BaseY += LineHeight * 3.0f;
-					Y = BaseY + Amplitude * FMath::Sin(i * Frequency);
-				}
-
-				Positions.Add(FVector2D(X, Y));
-			}
-		}
-		break;
-
-	default:
-		// Fallback to standard positioning
-		Positions.Add(Center);
-		break;
+		Positions.Add(Word.Position);
 	}
 
 	return Positions;
 }
 
+FStoryTextLayout UShortStoryBlueprintLibrary::GetTextLayout(const FString& Text, EStoryLineAnimation AnimType, FVector2D CanvasSize, const FSlateFontInfo& Font)
+{
+	return FShortStoryTextLayoutCache::Get().GetLayout(Text, AnimType, Font, CanvasSize);
+}
+
 void UShortStoryBlueprintLibrary::TriggerStoryEffect(UObject* WorldContextObject, EStoryEffect Effect, int32 PlayerIndex)
 {
 	if (!WorldContextObject)
@@ -0,0 +1,420 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryCache.h"
+#include "Engine/Texture2D.h"
+#include "TextureResource.h"
+
+FShortStoryCache::FCachedStory::FCachedStory(const FString& InFileName, FStoryRef InStory)
+	: FileName(InFileName)
+	, Story(InStory)
+	, LastUsed(0)
+{
+}
+
+FShortStoryCache::FShortStoryCache()
+	: Current(new FSnapshot())
+	, ActiveReaders(0)
+	, AccessClock(0)
+	, NumEvictions(0)
+{
+}
+
+FShortStoryCache::~FShortStoryCache()
+{
+	for (const FSnapshot* Snapshot : Retired)
+	{
+		delete Snapshot;
+	}
+	delete Current.load();
+}
+
+uint64 FShortStoryCache::HashKey(FStringView StoryFileName)
+{
+	// FNV-1a over lower-cased characters, so "Orazio.tos" and "orazio.TOS" share a key
+	uint64 Hash = 0xcbf29ce484222325ull;
+	for (TCHAR Char : StoryFileName)
+	{
+		Hash ^= static_cast<uint64>(FChar::ToLower(Char));
+		Hash *= 0x100000001b3ull;
+	}
+	return Hash;
+}
+
+void FShortStoryCache::CalculateStorySize(const FShortStory& Story, int64& OutTextBytes, int64& OutTextureBytes)
+{
+	int64 TextBytes = sizeof(FShortStory)
+		+ Story.Title.GetAllocatedSize()
+		+ Story.OST.GetAllocatedSize()
+		+ Story.SourceFileName.GetAllocatedSize()
+		+ Story.Screens.GetAllocatedSize();
+
+	int64 TextureBytes = 0;
+	TSet<const UTexture2D*, DefaultKeyFuncs<const UTexture2D*>, TInlineSetAllocator<16>> CountedTextures;
+
+	for (const FStoryScreen& Screen : Story.Screens)
+	{
+		TextBytes += Screen.Name.GetAllocatedSize()
+			+ Screen.BackgroundPath.GetAllocatedSize()
+			+ Screen.Lines.GetAllocatedSize()
+			+ Screen.TimedEvents.GetAllocatedSize()
+			+ Screen.Segments.GetAllocatedSize()
+			+ Screen.LineSegmentIndices.GetAllocatedSize()
+			+ Screen.LineRunOffsets.GetAllocatedSize()
+			+ Screen.SourceLineStarts.GetAllocatedSize();
+
+		for (const FStoryLine& Line : Screen.Lines)
+		{
+			TextBytes += Line.Text.GetAllocatedSize()
+				+ Line.Spans.GetAllocatedSize()
+				+ Line.InlineWaits.GetAllocatedSize()
+				+ Line.Timeline.CharRevealTimes.GetAllocatedSize();
+		}
+
+		for (const FStoryTimedEvent& Event : Screen.TimedEvents)
+		{
+			TextBytes += Event.AssetPath.GetAllocatedSize();
+		}
+
+		const UTexture2D* Texture = Screen.RuntimeTexture;
+		if (!Texture || CountedTextures.Contains(Texture))
+		{
+			continue;
+		}
+		CountedTextures.Add(Texture);
+
+		// Transient textures keep their mips in CPU memory as well as on the GPU
+		TextureBytes += Texture->CalcTextureMemorySizeEnum(TMC_AllMips);
+		if (const FTexturePlatformData* PlatformData = Texture->GetPlatformData())
+		{
+			for (const FTexture2DMipMap& Mip : PlatformData->Mips)
+			{
+				TextureBytes += Mip.BulkData.GetBulkDataSize();
+			}
+		}
+	}
+
+	OutTextBytes = TextBytes;
+	OutTextureBytes = TextureBytes;
+}
+
+const FShortStoryCache::FEntryRef* FShortStoryCache::FindEntry(const FSnapshot& Snapshot, uint64 Key, FStringView StoryFileName)
+{
+	const FEntryRef* Entry = Snapshot.Entries.Find(Key);
+	if (Entry && FStringView((*Entry)->FileName).Equals(StoryFileName, ESearchCase::IgnoreCase))
+	{
+		return Entry;
+	}
+	return nullptr;
+}
+
+FShortStoryCache::FEntryRef FShortStoryCache::CopyEntry(const FCachedStory& Entry)
+{
+	FEntryRef Copy = MakeShared<FCachedStory, ESPMode::ThreadSafe>(Entry.FileName, Entry.Story);
+	Copy->TextBytes = Entry.TextBytes;
+	Copy->TextureBytes = Entry.TextureBytes;
+	Copy->LastUsed.store(Entry.LastUsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	return Copy;
+}
+
+const FShortStory* FShortStoryCache::Find(FStringView StoryFileName) const
+{
+	const FSnapshot* Snapshot = Current.load();
+	if (const FEntryRef* Entry = FindEntry(*Snapshot, HashKey(StoryFileName), StoryFileName))
+	{
+		(*Entry)->LastUsed.store(AccessClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return &(*Entry)->Story.Get();
+	}
+	return nullptr;
+}
+
+FShortStoryCache::FStoryPtr FShortStoryCache::FindShared(FStringView StoryFileName) const
+{
+	const FSnapshot* Snapshot = Current.load();
+	if (const FEntryRef* Entry = FindEntry(*Snapshot, HashKey(StoryFileName), StoryFileName))
+	{
+		(*Entry)->LastUsed.store(AccessClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return (*Entry)->Story;
+	}
+	return nullptr;
+}
+
+bool FShortStoryCache::Contains(FStringView StoryFileName) const
+{
+	return FindEntry(*Current.load(), HashKey(StoryFileName), StoryFileName) != nullptr;
+}
+
+const FShortStory* FShortStoryCache::FindTranslation(FStringView StoryFileName, FStringView Culture, bool& bOutLookedUp) const
+{
+	bOutLookedUp = false;
+	const FEntryRef* Entry = FindEntry(*Current.load(), HashKey(StoryFileName), StoryFileName);
+	if (!Entry || Culture.IsEmpty() || !FStringView((*Entry)->TranslationCulture).Equals(Culture, ESearchCase::IgnoreCase))
+	{
+		return nullptr;
+	}
+
+	bOutLookedUp = true;
+	return (*Entry)->Translation.Get();
+}
+
+bool FShortStoryCache::SetTranslation(FStringView StoryFileName, const FString& Culture, FStoryPtr Translation)
+{
+	// Sized outside the lock; the translation's textures are the story's, so only its text counts
+	int64 TranslationBytes = 0;
+	if (Translation.IsValid())
+	{
+		int64 SharedTextureBytes = 0;
+		CalculateStorySize(*Translation, TranslationBytes, SharedTextureBytes);
+	}
+
+	{
+		FScopeLock Lock(&WriteMutex);
+		const FSnapshot* Snapshot = Current.load();
+		const uint64 Key = HashKey(StoryFileName);
+		const FEntryRef* Entry = FindEntry(*Snapshot, Key, StoryFileName);
+		if (!Entry)
+		{
+			return false;
+		}
+
+		FEntryRef NewEntry = CopyEntry(**Entry);
+		NewEntry->Translation = MoveTemp(Translation);
+		NewEntry->TranslationCulture = Culture;
+		NewEntry->TranslationBytes = TranslationBytes;
+
+		FSnapshot* Next = new FSnapshot(*Snapshot);
+		Next->Entries.Add(Key, NewEntry);
+		Publish(Next);
+	}
+
+	OnWritten();
+	return true;
+}
+
+void FShortStoryCache::ClearTranslations()
+{
+	{
+		FScopeLock Lock(&WriteMutex);
+		const FSnapshot* Snapshot = Current.load();
+
+		FSnapshot* Next = nullptr;
+		for (const TPair<uint64, FEntryRef>& Pair : Snapshot->Entries)
+		{
+			if (Pair.Value->TranslationCulture.IsEmpty())
+			{
+				continue;
+			}
+
+			if (!Next)
+			{
+				Next = new FSnapshot(*Snapshot);
+			}
+			Next->Entries.Add(Pair.Key, CopyEntry(*Pair.Value));
+		}
+
+		if (!Next)
+		{
+			return;
+		}
+		Publish(Next);
+	}
+
+	OnWritten();
+}
+
+FShortStoryCache::FStoryPtr FShortStoryCache::Add(const FString& StoryFileName, const FShortStory& Story)
+{
+	// Built and measured outside the lock: parsing threads only contend for the map copy
+	FEntryRef NewEntry = MakeShared<FCachedStory, ESPMode::ThreadSafe>(StoryFileName, MakeShared<FShortStory, ESPMode::ThreadSafe>(Story));
+	CalculateStorySize(*NewEntry->Story, NewEntry->TextBytes, NewEntry->TextureBytes);
+	NewEntry->LastUsed.store(AccessClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	FStoryPtr Replaced;
+	{
+		FScopeLock Lock(&WriteMutex);
+		const uint64 Key = HashKey(StoryFileName);
+		FSnapshot* Next = new FSnapshot(*Current.load());
+		if (const FEntryRef* Existing = Next->Entries.Find(Key))
+		{
+			Replaced = (*Existing)->Story;
+		}
+		Next->Entries.Add(Key, NewEntry);
+		Publish(Next);
+	}
+
+	OnWritten();
+	return Replaced;
+}
+
+FShortStoryCache::FStoryPtr FShortStoryCache::Remove(FStringView StoryFileName)
+{
+	FStoryPtr Removed;
+	{
+		FScopeLock Lock(&WriteMutex);
+		const FSnapshot* Snapshot = Current.load();
+		const uint64 Key = HashKey(StoryFileName);
+		const FEntryRef* Entry = FindEntry(*Snapshot, Key, StoryFileName);
+		if (!Entry)
+		{
+			return nullptr;
+		}
+		Removed = (*Entry)->Story;
+
+		FSnapshot* Next = new FSnapshot(*Snapshot);
+		Next->Entries.Remove(Key);
+		Publish(Next);
+	}
+
+	OnWritten();
+	return Removed;
+}
+
+TArray<FShortStoryCache::FStoryRef> FShortStoryCache::Empty()
+{
+	TArray<FStoryRef> Removed;
+	{
+		FScopeLock Lock(&WriteMutex);
+		const FSnapshot* Snapshot = Current.load();
+		if (Snapshot->Entries.Num() == 0)
+		{
+			return Removed;
+		}
+
+		Removed.Reserve(Snapshot->Entries.Num());
+		for (const TPair<uint64, FEntryRef>& Pair : Snapshot->Entries)
+		{
+			Removed.Add(Pair.Value->Story);
+		}
+		Publish(new FSnapshot());
+	}
+
+	OnWritten();
+	return Removed;
+}
+
+TArray<FShortStoryCache::FStoryRef> FShortStoryCache::Trim(int64 BudgetBytes, TConstArrayView<uint64> ProtectedKeys)
+{
+	TArray<FStoryRef> Evicted;
+	{
+		FScopeLock Lock(&WriteMutex);
+		const FSnapshot* Snapshot = Current.load();
+
+		int64 TotalBytes = 0;
+		for (const TPair<uint64, FEntryRef>& Pair : Snapshot->Entries)
+		{
+			TotalBytes += Pair.Value->GetTotalBytes();
+		}
+		if (TotalBytes <= BudgetBytes)
+		{
+			return Evicted;
+		}
+
+		// Oldest first; stamps are read once so concurrent hits cannot reorder the list mid-sort
+		TArray<TPair<uint64, uint64>, TInlineAllocator<32>> Candidates; // (LastUsed, Key)
+		for (const TPair<uint64, FEntryRef>& Pair : Snapshot->Entries)
+		{
+			if (!ProtectedKeys.Contains(Pair.Key))
+			{
+				Candidates.Emplace(Pair.Value->LastUsed.load(std::memory_order_relaxed), Pair.Key);
+			}
+		}
+		Candidates.Sort([](const TPair<uint64, uint64>& A, const TPair<uint64, uint64>& B) { return A.Key < B.Key; });
+
+		FSnapshot* Next = new FSnapshot(*Snapshot);
+		for (const TPair<uint64, uint64>& Candidate : Candidates)
+		{
+			if (TotalBytes <= BudgetBytes)
+			{
+				break;
+			}
+
+			const FEntryRef& Entry = Next->Entries.FindChecked(Candidate.Value);
+			TotalBytes -= Entry->GetTotalBytes();
+			Evicted.Add(Entry->Story);
+			Next->Entries.Remove(Candidate.Value);
+		}
+
+		if (Evicted.Num() == 0)
+		{
+			// Only protected stories left: over budget, but nothing may go
+			delete Next;
+			return Evicted;
+		}
+
+		NumEvictions.fetch_add(Evicted.Num());
+		Publish(Next);
+	}
+
+	OnWritten();
+	return Evicted;
+}
+
+int32 FShortStoryCache::Num() const
+{
+	return Current.load()->Entries.Num();
+}
+
+FShortStoryCache::FStats FShortStoryCache::GetStats() const
+{
+	FStats Stats;
+	const FSnapshot* Snapshot = Current.load();
+	Stats.NumStories = Snapshot->Entries.Num();
+	for (const TPair<uint64, FEntryRef>& Pair : Snapshot->Entries)
+	{
+		Stats.TextBytes += Pair.Value->TextBytes + Pair.Value->TranslationBytes;
+		Stats.TextureBytes += Pair.Value->TextureBytes;
+	}
+	Stats.NumEvictions = NumEvictions.load();
+	return Stats;
+}
+
+void FShortStoryCache::ForEach(TFunctionRef<void(const FCachedStory& Entry)> Visitor) const
+{
+	const FSnapshot* Snapshot = Current.load();
+	for (const TPair<uint64, FEntryRef>& Pair : Snapshot->Entries)
+	{
+		Visitor(*Pair.Value);
+	}
+}
+
+void FShortStoryCache::Publish(const FSnapshot* NewSnapshot)
+{
+	Retired.Add(Current.exchange(NewSnapshot));
+}
+
+void FShortStoryCache::OnWritten()
+{
+	if (IsInGameThread())
+	{
+		ReclaimRetired();
+	}
+}
+
+void FShortStoryCache::ReclaimRetired()
+{
+	check(IsInGameThread());
+
+	TArray<const FSnapshot*> ToDelete;
+	{
+		FScopeLock Lock(&WriteMutex);
+		ToDelete = MoveTemp(Retired);
+		Retired.Reset();
+	}
+
+	if (ToDelete.Num() == 0)
+	{
+		return;
+	}
+
+	// A reader that enters after this check already sees the new snapshot, so only older readers matter
+	if (ActiveReaders.load() != 0)
+	{
+		FScopeLock Lock(&WriteMutex);
+		Retired.Append(ToDelete);
+		return;
+	}
+
+	for (const FSnapshot* Snapshot : ToDelete)
+	{
+		delete Snapshot;
+	}
+}
@@ -0,0 +1,202 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryHistorySubsystem.h"
+#include "ShortStorySubsystem.h"
+#include "ShortStory.h"
+#include "Algo/BinarySearch.h"
+
+void UShortStoryHistorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Fixed allocation: the log never grows past its capacity
+	Entries.SetNum(FMath::Clamp(HistoryCapacity, 16, 65536));
+	Head = 0;
+	Count = 0;
+
+	StorySubsystem = Collection.InitializeDependency<UShortStorySubsystem>();
+	if (StorySubsystem.IsValid())
+	{
+		LinesRevealedHandle = StorySubsystem->OnLinesRevealed.AddUObject(this, &UShortStoryHistorySubsystem::HandleLinesRevealed);
+	}
+	else
+	{
+		UE_LOG(LogShortStory, Error, TEXT("ShortStoryHistorySubsystem: ShortStorySubsystem not available, history disabled"));
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("ShortStoryHistorySubsystem initialized (capacity %d lines)"), Entries.Num());
+}
+
+void UShortStoryHistorySubsystem::Deinitialize()
+{
+	if (UShortStorySubsystem* Subsystem = StorySubsystem.Get())
+	{
+		Subsystem->OnLinesRevealed.Remove(LinesRevealedHandle);
+	}
+	LinesRevealedHandle.Reset();
+	StorySubsystem.Reset();
+
+	Entries.Empty();
+	Head = 0;
+	Count = 0;
+
+	Super::Deinitialize();
+}
+
+void UShortStoryHistorySubsystem::HandleLinesRevealed(FName StoryId, int32 ScreenIndex, int32 FirstLine, int32 LastLine)
+{
+	// Displayed lines are wrapped differently in each culture; the source lines they come from are not
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem ? Subsystem->FindLoadedStory(StoryId) : nullptr;
+	if (!Story || !Story->Screens.IsValidIndex(ScreenIndex) || Story->Screens[ScreenIndex].SourceLineStarts.Num() == 0)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("ShortStoryHistorySubsystem: Screen %d of '%s' not loaded, not logged"), ScreenIndex, *StoryId.ToString());
+		return;
+	}
+
+	const TArray<int32>& SourceLineStarts = Story->Screens[ScreenIndex].SourceLineStarts;
+	const int32 FirstSourceLine = FMath::Max(Algo::UpperBound(SourceLineStarts, FirstLine) - 1, 0);
+	const int32 LastSourceLine = FMath::Max(Algo::UpperBound(SourceLineStarts, LastLine) - 1, 0);
+
+	// A long skip only ever needs the last Capacity lines
+	const int32 FirstKept = FMath::Max(FirstSourceLine, LastSourceLine - Entries.Num() + 1);
+	for (int32 SourceLineIndex = FirstKept; SourceLineIndex <= LastSourceLine; ++SourceLineIndex)
+	{
+		// Wrapped parts of a source line reveal one after another, but it is logged once
+		if (Count > 0)
+		{
+			const FHistoryEntry& Latest = GetEntry(Count - 1);
+			if (Latest.StoryId == StoryId && Latest.ScreenIndex == ScreenIndex && Latest.SourceLineIndex == SourceLineIndex)
+			{
+				continue;
+			}
+		}
+		AddEntry(StoryId, ScreenIndex, SourceLineIndex);
+	}
+}
+
+void UShortStoryHistorySubsystem::AddEntry(FName StoryId, int32 ScreenIndex, int32 SourceLineIndex)
+{
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	if (ScreenIndex < 0 || ScreenIndex > MAX_uint16 || SourceLineIndex < 0 || SourceLineIndex > MAX_uint16)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("ShortStoryHistorySubsystem: Line %d of screen %d out of range, not logged"), SourceLineIndex, ScreenIndex);
+		return;
+	}
+
+	int32 Index;
+	if (Count < Entries.Num())
+	{
+		Index = (Head + Count) % Entries.Num();
+		++Count;
+	}
+	else
+	{
+		// Full: overwrite the oldest
+		Index = Head;
+		Head = (Head + 1) % Entries.Num();
+	}
+
+	FHistoryEntry& Entry = Entries[Index];
+	Entry.StoryId = StoryId;
+	Entry.ScreenIndex = static_cast<uint16>(ScreenIndex);
+	Entry.SourceLineIndex = static_cast<uint16>(SourceLineIndex);
+}
+
+TArray<FStoryHistoryRow> UShortStoryHistorySubsystem::GetHistoryPage(int32 FirstRow, int32 NumRows) const
+{
+	TArray<FStoryHistoryRow> Rows;
+
+	FirstRow = FMath::Clamp(FirstRow, 0, Count);
+	const int32 EndRow = FMath::Min(Count, FirstRow + FMath::Max(NumRows, 0));
+	if (EndRow <= FirstRow)
+	{
+		return Rows;
+	}
+
+	Rows.Reserve(EndRow - FirstRow);
+
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+
+	// Consecutive rows usually share a story, so resolve it once per run
+	FName ResolvedStoryId;
+	const FShortStory* ResolvedStory = nullptr;
+
+	for (int32 Row = FirstRow; Row < EndRow; ++Row)
+	{
+		const FHistoryEntry& Entry = GetEntry(Row);
+
+		FStoryHistoryRow& OutRow = Rows.AddDefaulted_GetRef();
+		OutRow.StoryId = Entry.StoryId;
+		OutRow.ScreenIndex = Entry.ScreenIndex;
+		OutRow.SourceLineIndex = Entry.SourceLineIndex;
+
+		if (Row == 0)
+		{
+			OutRow.bStartsScreen = true;
+		}
+		else
+		{
+			const FHistoryEntry& Previous = GetEntry(Row - 1);
+			OutRow.bStartsScreen = (Previous.StoryId != Entry.StoryId || Previous.ScreenIndex != Entry.ScreenIndex);
+		}
+
+		if (Subsystem && (Row == FirstRow || Entry.StoryId != ResolvedStoryId))
+		{
+			ResolvedStoryId = Entry.StoryId;
+			ResolvedStory = Subsystem->FindLoadedStory(Entry.StoryId);
+		}
+
+		if (ResolvedStory && ResolvedStory->Screens.IsValidIndex(Entry.ScreenIndex))
+		{
+			const FStoryScreen& Screen = ResolvedStory->Screens[Entry.ScreenIndex];
+			if (Screen.SourceLineStarts.IsValidIndex(Entry.SourceLineIndex))
+			{
+				const int32 FirstLine = Screen.SourceLineStarts[Entry.SourceLineIndex];
+				const int32 LastLine = Screen.SourceLineStarts.IsValidIndex(Entry.SourceLineIndex + 1)
+					? Screen.SourceLineStarts[Entry.SourceLineIndex + 1] - 1
+					: Screen.Lines.Num() - 1;
+
+				// Wrapped parts are joined back into the source line; span offsets move with their part
+				OutRow.LineIndex = FirstLine;
+				for (int32 LineIndex = FirstLine; LineIndex <= LastLine; ++LineIndex)
+				{
+					const FStoryLine& Line = Screen.Lines[LineIndex];
+					if (LineIndex > FirstLine)
+					{
+						OutRow.Text.AppendChar(TEXT(' '));
+					}
+
+					const int32 Offset = OutRow.Text.Len();
+					OutRow.Text += Line.Text;
+					for (const FStoryTextSpan& Span : Line.Spans)
+					{
+						FStoryTextSpan& OutSpan = OutRow.Spans.Add_GetRef(Span);
+						OutSpan.StartIndex += Offset;
+					}
+				}
+				OutRow.bIsResolved = true;
+			}
+		}
+	}
+
+	return Rows;
+}
+
+TArray<FStoryHistoryRow> UShortStoryHistorySubsystem::GetLatestHistory(int32 NumRows) const
+{
+	NumRows = FMath::Clamp(NumRows, 0, Count);
+	return GetHistoryPage(Count - NumRows, NumRows);
+}
+
+void UShortStoryHistorySubsystem::ClearHistory()
+{
+	Head = 0;
+	Count = 0;
+
+	UE_LOG(LogShortStory, Log, TEXT("ClearHistory: Story history cleared"));
+}
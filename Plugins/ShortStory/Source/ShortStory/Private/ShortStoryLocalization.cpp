@@ -0,0 +1,328 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryLocalization.h"
+#include "ShortStory.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Algo/BinarySearch.h"
+#include "Containers/StringConv.h"
+
+namespace
+{
+	constexpr uint32 StringTableMagic = 0x4C425453; // 'STBL'
+	constexpr uint32 StringTableVersion = 1;
+
+	struct FStringTableHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 Count;
+		uint32 PoolLength;
+	};
+
+	/** Parse one CSV field starting at Index (quoted fields support "" escapes); Index ends after the separator */
+	FString ReadCsvField(const FString& Row, int32& Index)
+	{
+		FString Field;
+		if (Index < Row.Len() && Row[Index] == TEXT('"'))
+		{
+			++Index;
+			while (Index < Row.Len())
+			{
+				if (Row[Index] == TEXT('"'))
+				{
+					if (Index + 1 < Row.Len() && Row[Index + 1] == TEXT('"'))
+					{
+						Field.AppendChar(TEXT('"'));
+						Index += 2;
+						continue;
+					}
+					++Index;
+					break;
+				}
+				Field.AppendChar(Row[Index++]);
+			}
+
+			// Skip to the separator
+			while (Index < Row.Len() && Row[Index] != TEXT(','))
+			{
+				++Index;
+			}
+		}
+		else
+		{
+			const int32 Start = Index;
+			while (Index < Row.Len() && Row[Index] != TEXT(','))
+			{
+				++Index;
+			}
+			Field = Row.Mid(Start, Index - Start).TrimStartAndEnd();
+		}
+
+		if (Index < Row.Len())
+		{
+			++Index; // Consume ','
+		}
+		return Field;
+	}
+}
+
+FShortStoryStringTable::~FShortStoryStringTable()
+{
+	// Region must be released before its file handle
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+TSharedPtr<FShortStoryStringTable> FShortStoryStringTable::LoadCompiled(const FString& TablePath)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*TablePath))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FShortStoryStringTable> Table = MakeShareable(new FShortStoryStringTable());
+
+	// Prefer a mapping: only the pages of lines actually shown are ever read
+	Table->MappedHandle.Reset(PlatformFile.OpenMapped(*TablePath));
+	if (Table->MappedHandle)
+	{
+		Table->MappedRegion.Reset(Table->MappedHandle->MapRegion());
+	}
+
+	if (Table->MappedRegion)
+	{
+		if (!Table->Bind(Table->MappedRegion->GetMappedPtr(), Table->MappedRegion->GetMappedSize()))
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("FShortStoryStringTable: Invalid string table '%s'"), *TablePath);
+			return nullptr;
+		}
+		return Table;
+	}
+
+	// Platform without file mapping: read the whole table
+	Table->MappedRegion.Reset();
+	Table->MappedHandle.Reset();
+	if (!FFileHelper::LoadFileToArray(Table->OwnedData, *TablePath) || !Table->Bind(Table->OwnedData.GetData(), Table->OwnedData.Num()))
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("FShortStoryStringTable: Failed to load string table '%s'"), *TablePath);
+		return nullptr;
+	}
+	return Table;
+}
+
+TSharedPtr<FShortStoryStringTable> FShortStoryStringTable::LoadFromCsv(const FString& CsvPath)
+{
+	FString CsvText;
+	if (!FFileHelper::LoadFileToString(CsvText, *CsvPath))
+	{
+		return nullptr;
+	}
+
+	TMap<int32, FString> Strings;
+	const int32 NumErrors = ParseCsv(CsvText, Strings);
+	if (NumErrors > 0)
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("FShortStoryStringTable: %d invalid rows in '%s'"), NumErrors, *CsvPath);
+	}
+
+	TSharedPtr<FShortStoryStringTable> Table = MakeShareable(new FShortStoryStringTable());
+	BuildTableData(Strings, Table->OwnedData);
+	if (!Table->Bind(Table->OwnedData.GetData(), Table->OwnedData.Num()))
+	{
+		return nullptr;
+	}
+	return Table;
+}
+
+TSharedPtr<FShortStoryStringTable> FShortStoryStringTable::LoadForStory(const FString& LocDirectory, const TArray<FString>& CultureNames, const FString& StoryFileName)
+{
+	const FString RelativePath = FPaths::ChangeExtension(StoryFileName, TEXT(""));
+	IFileManager& FileManager = IFileManager::Get();
+
+	for (const FString& CultureName : CultureNames)
+	{
+		const FString BasePath = FPaths::Combine(LocDirectory, CultureName, RelativePath);
+		const FString CsvPath = BasePath + TEXT(".csv");
+		const FString TablePath = BasePath + TEXT(".stbl");
+
+		const FDateTime CsvTime = FileManager.GetTimeStamp(*CsvPath);
+		const FDateTime TableTime = FileManager.GetTimeStamp(*TablePath);
+		const bool bHasCsv = CsvTime != FDateTime::MinValue();
+		const bool bHasTable = TableTime != FDateTime::MinValue();
+
+		if (!bHasCsv && !bHasTable)
+		{
+			continue;
+		}
+
+		// Compile edited translations once; fall back to an in-memory table if the directory is read-only
+		TSharedPtr<FShortStoryStringTable> Table;
+		if (bHasCsv && (!bHasTable || CsvTime > TableTime) && !CompileCsv(CsvPath, TablePath))
+		{
+			Table = LoadFromCsv(CsvPath);
+		}
+		else
+		{
+			Table = LoadCompiled(TablePath);
+		}
+
+		if (Table.IsValid())
+		{
+			UE_LOG(LogShortStory, Log, TEXT("FShortStoryStringTable: Loaded %d '%s' strings for '%s'%s"),
+				Table->Num(), *CultureName, *StoryFileName, Table->IsMemoryMapped() ? TEXT(" (mapped)") : TEXT(""));
+			return Table;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FShortStoryStringTable::CompileCsv(const FString& CsvPath, const FString& TablePath)
+{
+	FString CsvText;
+	if (!FFileHelper::LoadFileToString(CsvText, *CsvPath))
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("FShortStoryStringTable: Failed to read '%s'"), *CsvPath);
+		return false;
+	}
+
+	TMap<int32, FString> Strings;
+	const int32 NumErrors = ParseCsv(CsvText, Strings);
+	if (NumErrors > 0)
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("FShortStoryStringTable: %d invalid rows in '%s'"), NumErrors, *CsvPath);
+	}
+
+	TArray<uint8> Data;
+	BuildTableData(Strings, Data);
+	if (!FFileHelper::SaveArrayToFile(Data, *TablePath))
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("FShortStoryStringTable: Could not write '%s'"), *TablePath);
+		return false;
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("FShortStoryStringTable: Compiled %d strings into '%s'"), Strings.Num(), *TablePath);
+	return true;
+}
+
+int32 FShortStoryStringTable::ParseCsv(const FString& CsvText, TMap<int32, FString>& OutStrings)
+{
+	TArray<FString> Rows;
+	CsvText.ParseIntoArrayLines(Rows);
+
+	int32 NumErrors = 0;
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		const FString& Row = Rows[RowIndex];
+		if (Row.TrimStart().IsEmpty() || Row.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		int32 Index = 0;
+		const FString IdField = ReadCsvField(Row, Index);
+		const FString TextField = ReadCsvField(Row, Index);
+
+		if (!IdField.IsNumeric())
+		{
+			// Header row
+			if (RowIndex == 0 && IdField.Equals(TEXT("Id"), ESearchCase::IgnoreCase))
+			{
+				continue;
+			}
+			++NumErrors;
+			continue;
+		}
+
+		OutStrings.Add(FCString::Atoi(*IdField), TextField);
+	}
+
+	return NumErrors;
+}
+
+void FShortStoryStringTable::BuildTableData(const TMap<int32, FString>& Strings, TArray<uint8>& OutData)
+{
+	TArray<int32> SortedIds;
+	Strings.GenerateKeyArray(SortedIds);
+	SortedIds.Sort();
+
+	// Pool is always UTF-16 so tables are portable between platforms with different TCHAR sizes
+	TArray<UTF16CHAR> PoolData;
+	TArray<uint32> OffsetData;
+	OffsetData.Reserve(SortedIds.Num() + 1);
+	for (int32 Id : SortedIds)
+	{
+		OffsetData.Add(PoolData.Num());
+		const FString& Text = Strings[Id];
+		FTCHARToUTF16 Converted(*Text, Text.Len());
+		PoolData.Append(reinterpret_cast<const UTF16CHAR*>(Converted.Get()), Converted.Length());
+	}
+	OffsetData.Add(PoolData.Num());
+
+	FStringTableHeader Header;
+	Header.Magic = StringTableMagic;
+	Header.Version = StringTableVersion;
+	Header.Count = SortedIds.Num();
+	Header.PoolLength = PoolData.Num();
+
+	OutData.Reset();
+	OutData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	OutData.Append(reinterpret_cast<const uint8*>(SortedIds.GetData()), SortedIds.Num() * sizeof(int32));
+	OutData.Append(reinterpret_cast<const uint8*>(OffsetData.GetData()), OffsetData.Num() * sizeof(uint32));
+	OutData.Append(reinterpret_cast<const uint8*>(PoolData.GetData()), PoolData.Num() * sizeof(UTF16CHAR));
+}
+
+bool FShortStoryStringTable::Bind(const uint8* Data, int64 Size)
+{
+	if (!Data || Size < static_cast<int64>(sizeof(FStringTableHeader)))
+	{
+		return false;
+	}
+
+	const FStringTableHeader* Header = reinterpret_cast<const FStringTableHeader*>(Data);
+	if (Header->Magic != StringTableMagic || Header->Version != StringTableVersion)
+	{
+		return false;
+	}
+
+	const int64 ExpectedSize = sizeof(FStringTableHeader)
+		+ static_cast<int64>(Header->Count) * sizeof(int32)
+		+ (static_cast<int64>(Header->Count) + 1) * sizeof(uint32)
+		+ static_cast<int64>(Header->PoolLength) * sizeof(UTF16CHAR);
+	if (Size < ExpectedSize || Header->Count > MAX_int32)
+	{
+		return false;
+	}
+
+	Count = static_cast<int32>(Header->Count);
+	PoolLength = Header->PoolLength;
+	Ids = reinterpret_cast<const int32*>(Data + sizeof(FStringTableHeader));
+	Offsets = reinterpret_cast<const uint32*>(Ids + Count);
+	Pool = reinterpret_cast<const UTF16CHAR*>(Offsets + Count + 1);
+	return true;
+}
+
+bool FShortStoryStringTable::FindString(int32 LineId, FString& OutText) const
+{
+	const int32 Index = Algo::BinarySearch(TArrayView<const int32>(Ids, Count), LineId);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const uint32 Start = Offsets[Index];
+	const uint32 End = Offsets[Index + 1];
+	if (Start > End || End > PoolLength)
+	{
+		return false;
+	}
+
+	FUTF16ToTCHAR Converted(reinterpret_cast<const UTF16CHAR*>(Pool + Start), End - Start);
+	OutText = FString(Converted.Length(), Converted.Get());
+	return true;
+}
@@ -4,19 +4,214 @@
 #include "ShortStory.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/Crc.h"
 #include "HAL/PlatformFileManager.h"
 #include "ShortStorySubsystem.h"
 
+namespace
+{
+	/** Kinds of inline markup tags */
+	enum class EInlineTag : uint8
+	{
+		Bold,
+		Italic,
+		Shake,
+		Color,
+		Wait
+	};
+
+	/** Parse a markup color value (#RGB, #RGBA, #RRGGBB or #RRGGBBAA) */
+	bool ParseMarkupColor(const FString& Value, FLinearColor& OutColor)
+	{
+		if (!Value.StartsWith(TEXT("#")))
+		{
+			return false;
+		}
+
+		FString Hex = Value.RightChop(1);
+		for (TCHAR Char : Hex)
+		{
+			if (!FChar::IsHexDigit(Char))
+			{
+				return false;
+			}
+		}
+
+		// Expand the short forms (#f00 -> #ff0000)
+		if (Hex.Len() == 3 || Hex.Len() == 4)
+		{
+			FString Expanded;
+			for (TCHAR Char : Hex)
+			{
+				Expanded.AppendChar(Char);
+				Expanded.AppendChar(Char);
+			}
+			Hex = Expanded;
+		}
+
+		if (Hex.Len() != 6 && Hex.Len() != 8)
+		{
+			return false;
+		}
+
+		OutColor = FLinearColor(FColor::FromHex(Hex));
+		return true;
+	}
+
+	/**
+	 * Parse the body of a tag (text between '<' and '>')
+	 * @return True if the body is a recognised tag with a valid value
+	 */
+	bool ParseInlineTagBody(const FString& Body, EInlineTag& OutTag, bool& bOutClosing, FLinearColor& OutColor, float& OutWait)
+	{
+		FString Lower = Body.TrimStartAndEnd().ToLower();
+		bOutClosing = Lower.StartsWith(TEXT("/"));
+		if (bOutClosing)
+		{
+			Lower.RightChopInline(1);
+		}
+
+		FString Name = Lower;
+		FString Value;
+		const bool bHasValue = Lower.Split(TEXT("="), &Name, &Value);
+		Name.TrimStartAndEndInline();
+		Value.TrimStartAndEndInline();
+
+		if (bHasValue && bOutClosing)
+		{
+			return false;
+		}
+
+		if (Name == TEXT("b") && !bHasValue)
+		{
+			OutTag = EInlineTag::Bold;
+			return true;
+		}
+		if (Name == TEXT("i") && !bHasValue)
+		{
+			OutTag = EInlineTag::Italic;
+			return true;
+		}
+		if (Name == TEXT("shake") && !bHasValue)
+		{
+			OutTag = EInlineTag::Shake;
+			return true;
+		}
+		if (Name == TEXT("color"))
+		{
+			OutTag = EInlineTag::Color;
+			return bOutClosing || (bHasValue && ParseMarkupColor(Value, OutColor));
+		}
+		if (Name == TEXT("wait") && bHasValue && !bOutClosing && FCString::IsNumeric(*Value))
+		{
+			OutTag = EInlineTag::Wait;
+			OutWait = FCString::Atof(*Value);
+			return OutWait >= 0.0f;
+		}
+
+		return false;
+	}
+
+	/** Apply a recognised tag to the markup state (and record inline waits on the line) */
+	void ApplyInlineTag(const FString& Body, int32 VisibleIndex, FStoryLine& OutLine, FStoryMarkupState& InOutState)
+	{
+		EInlineTag Tag;
+		bool bClosing = false;
+		FLinearColor Color = FLinearColor::White;
+		float Wait = 0.0f;
+		if (!ParseInlineTagBody(Body, Tag, bClosing, Color, Wait))
+		{
+			return;
+		}
+
+		const int32 Delta = bClosing ? -1 : 1;
+		switch (Tag)
+		{
+		case EInlineTag::Bold:
+			InOutState.BoldDepth = FMath::Max(0, InOutState.BoldDepth + Delta);
+			break;
+		case EInlineTag::Italic:
+			InOutState.ItalicDepth = FMath::Max(0, InOutState.ItalicDepth + Delta);
+			break;
+		case EInlineTag::Shake:
+			InOutState.ShakeDepth = FMath::Max(0, InOutState.ShakeDepth + Delta);
+			break;
+		case EInlineTag::Color:
+			if (bClosing)
+			{
+				if (InOutState.ColorStack.Num() > 0)
+				{
+					InOutState.ColorStack.Pop();
+				}
+			}
+			else
+			{
+				InOutState.ColorStack.Add(Color);
+			}
+			break;
+		case EInlineTag::Wait:
+			// Consecutive waits at the same position are merged
+			if (OutLine.InlineWaits.Num() > 0 && OutLine.InlineWaits.Last().CharIndex == VisibleIndex)
+			{
+				OutLine.InlineWaits.Last().Duration += Wait;
+			}
+			else
+			{
+				FStoryInlineWait& InlineWait = OutLine.InlineWaits.AddDefaulted_GetRef();
+				InlineWait.CharIndex = VisibleIndex;
+				InlineWait.Duration = Wait;
+			}
+			break;
+		}
+
+		InOutState.StyleFlags = 0;
+		if (InOutState.BoldDepth > 0) InOutState.StyleFlags |= static_cast<int32>(EStoryTextStyle::Bold);
+		if (InOutState.ItalicDepth > 0) InOutState.StyleFlags |= static_cast<int32>(EStoryTextStyle::Italic);
+		if (InOutState.ShakeDepth > 0) InOutState.StyleFlags |= static_cast<int32>(EStoryTextStyle::Shake);
+	}
+
+	void AddDiagnostic(TArray<FStoryParseDiagnostic>& OutDiagnostics, EStoryDiagnosticSeverity Severity, int32 Line, int32 Column, const TCHAR* Code, const FString& Message)
+	{
+		OutDiagnostics.Emplace(Severity, Line, Column, FName(Code), Message);
+	}
+
+	/** Parse a timed event number field; non-numeric values are reported and read as 0 like before */
+	float ParseEventNumber(const FString& Field, const TCHAR* What, int32 LineNumber, int32 Column, TArray<FStoryParseDiagnostic>& OutDiagnostics)
+	{
+		const FString Trimmed = Field.TrimStartAndEnd();
+		if (!FCString::IsNumeric(*Trimmed))
+		{
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("InvalidEventNumber"),
+				FString::Printf(TEXT("Invalid %s '%s' (expected a number, using 0)"), What, *Trimmed));
+			return 0.0f;
+		}
+		return FCString::Atof(*Trimmed);
+	}
+}
+
 bool UShortStoryParser::ParseStoryFile(const FString& StoryFilePath, FShortStory& OutStory, TArray<FString>& OutErrors, int32 MaxLineLength)
+{
+	TArray<FStoryParseDiagnostic> Diagnostics;
+	const bool bSuccess = ParseStoryFile(StoryFilePath, OutStory, Diagnostics, MaxLineLength);
+
+	OutErrors.Empty(Diagnostics.Num());
+	for (const FStoryParseDiagnostic& Diagnostic : Diagnostics)
+	{
+		OutErrors.Add(Diagnostic.ToString());
+	}
+	return bSuccess;
+}
+
+bool UShortStoryParser::ParseStoryFile(const FString& StoryFilePath, FShortStory& OutStory, TArray<FStoryParseDiagnostic>& OutDiagnostics, int32 MaxLineLength, TArray<FStorySourceString>* OutSourceStrings)
 {
 	SCOPE_CYCLE_COUNTER(STAT_ShortStory_ParseStory);
 
-	OutErrors.Empty();
+	OutDiagnostics.Empty();
 
 	// Check if file exists
 	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*StoryFilePath))
 	{
-		OutErrors.Add(FString::Printf(TEXT("File not found: %s"), *StoryFilePath));
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, 0, 0, TEXT("FileNotFound"), FString::Printf(TEXT("File not found: %s"), *StoryFilePath));
 		return false;
 	}
 
@@ -24,12 +219,12 @@ bool UShortStoryParser::ParseStoryFile(const FString& StoryFilePath, FShortStory
 	FString FileContent;
 	if (!FFileHelper::LoadFileToString(FileContent, *StoryFilePath))
 	{
-		OutErrors.Add(FString::Printf(TEXT("Failed to read file: %s"), *StoryFilePath));
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, 0, 0, TEXT("FileReadFailed"), FString::Printf(TEXT("Failed to read file: %s"), *StoryFilePath));
 		return false;
 	}
 
 	// Parse content
-	bool bSuccess = ParseStoryFromString(FileContent, OutStory, OutErrors, MaxLineLength);
+	bool bSuccess = ParseStoryFromString(FileContent, OutStory, OutDiagnostics, MaxLineLength, OutSourceStrings);
 
 	if (bSuccess)
 	{
@@ -40,17 +235,34 @@ bool UShortStoryParser::ParseStoryFile(const FString& StoryFilePath, FShortStory
 }
 
 bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortStory& OutStory, TArray<FString>& OutErrors, int32 MaxLineLength)
+{
+	TArray<FStoryParseDiagnostic> Diagnostics;
+	const bool bSuccess = ParseStoryFromString(StoryText, OutStory, Diagnostics, MaxLineLength);
+
+	OutErrors.Empty(Diagnostics.Num());
+	for (const FStoryParseDiagnostic& Diagnostic : Diagnostics)
+	{
+		OutErrors.Add(Diagnostic.ToString());
+	}
+	return bSuccess;
+}
+
+bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortStory& OutStory, TArray<FStoryParseDiagnostic>& OutDiagnostics, int32 MaxLineLength, TArray<FStorySourceString>* OutSourceStrings)
 {
 	OutStory = FShortStory();
-	OutErrors.Empty();
+	OutDiagnostics.Empty();
+	if (OutSourceStrings)
+	{
+		OutSourceStrings->Reset();
+	}
 
-	// Split into lines
+	// Split into lines (kept as-is: empty lines must still count towards line numbers)
 	TArray<FString> Lines;
-	StoryText.ParseIntoArrayLines(Lines);
+	StoryText.ParseIntoArrayLines(Lines, false);
 
-	if (Lines.Num() == 0)
+	if (StoryText.TrimStartAndEnd().IsEmpty())
 	{
-		OutErrors.Add(TEXT("Empty story file"));
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, 0, 0, TEXT("EmptyFile"), TEXT("Empty story file"));
 		return false;
 	}
 
@@ -68,6 +280,9 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 	FStoryScreen* CurrentScreen = nullptr;
 	bool bFoundStorySection = false;
 
+	// Source text lines seen on the current screen per key (for localisation ids)
+	TMap<FString, int32> LineKeyCounts;
+
 	// Buffer for multi-line blocks
 	TArray<FString> PendingLines;
 
@@ -77,6 +292,9 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 		const int32 LineNumber = i + 1;
 		FString Line = CleanLine(Lines[i]);
 
+		// Column of the first non-blank character (diagnostic columns are relative to the source line)
+		const int32 LineColumn = Lines[i].Len() - Lines[i].TrimStart().Len() + 1;
+
 		// Skip empty lines
 		if (Line.IsEmpty())
 		{
@@ -90,7 +308,7 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 			// Check for orphaned pending lines
 			if (PendingLines.Num() > 0)
 			{
-				OutErrors.Add(FString::Printf(TEXT("Line %d: Orphaned text lines found before section change (missing metadata line?)"), LineNumber));
+				AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, LineColumn, TEXT("OrphanedText"), TEXT("Orphaned text lines found before section change (missing metadata line?)"));
 				PendingLines.Empty();
 			}
 
@@ -111,11 +329,12 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 				OutStory.Screens.AddDefaulted();
 				CurrentScreen = &OutStory.Screens.Last();
 				CurrentScreen->Name = SectionName;
+				LineKeyCounts.Reset();
 				continue;
 			}
 			else
 			{
-				OutErrors.Add(FString::Printf(TEXT("Line %d: Unknown section [%s]"), LineNumber, *SectionName));
+				AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, LineColumn, TEXT("UnknownSection"), FString::Printf(TEXT("Unknown section [%s]"), *SectionName));
 				continue;
 			}
 		}
@@ -131,7 +350,7 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 				}
 				else
 				{
-					OutErrors.Add(FString::Printf(TEXT("Line %d: Invalid metadata format: %s"), LineNumber, *Line));
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, LineColumn, TEXT("InvalidMetadata"), FString::Printf(TEXT("Invalid metadata format: %s"), *Line));
 				}
 			}
 			break;
@@ -140,7 +359,7 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 			{
 				if (!CurrentScreen)
 				{
-					OutErrors.Add(FString::Printf(TEXT("Line %d: No active screen section"), LineNumber));
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, LineColumn, TEXT("NoActiveScreen"), TEXT("No active screen section"));
 					continue;
 				}
 
@@ -170,6 +389,11 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 						{
 							CurrentScreen->TransitionType = Transition;
 						}
+						else if (Line.StartsWith(TEXT("transition"), ESearchCase::IgnoreCase))
+						{
+							AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, LineColumn, TEXT("UnknownTransition"),
+								FString::Printf(TEXT("Unknown transition type '%s'"), *CurrentScreenMetadata[TEXT("transition")]));
+						}
 					}
 					continue;
 				}
@@ -178,15 +402,10 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 				if (Line.StartsWith(TEXT("@")))
 				{
 					FStoryTimedEvent Event;
-					FString EventError;
-					if (ParseTimedEvent(Line.Mid(1), LineNumber, Event, EventError))
+					if (ParseTimedEvent(Line.Mid(1), LineNumber, LineColumn, Event, OutDiagnostics))
 					{
 						CurrentScreen->TimedEvents.Add(Event);
 					}
-					else
-					{
-						OutErrors.Add(FString::Printf(TEXT("Line %d: %s"), LineNumber, *EventError));
-					}
 					continue;
 				}
 				
@@ -195,7 +414,7 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 				{
 					if (PendingLines.Num() > 0)
 					{
-						OutErrors.Add(FString::Printf(TEXT("Line %d: [SPACER] found inside a pending text block (missing metadata line?)"), LineNumber));
+						AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, LineColumn, TEXT("SpacerInBlock"), TEXT("[SPACER] found inside a pending text block (missing metadata line?)"));
 						PendingLines.Empty();
 					}
 
@@ -214,27 +433,49 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 				{
 					// Finisher Line
 					FString FinisherText;
-					EStoryLineAnimation Anim;
-					EStorySpeed Speed;
-					EStoryPauseDuration Pause;
-					EStoryEffect Effect;
-					FVector2D Offset;
-					FString LineError;
-
-					if (ParseLineAttributes(Line, FinisherText, Anim, Speed, Pause, Effect, Offset, LineError))
+					FStoryLine Attributes;
+					FString LineKey;
+
+					if (ParseLineAttributes(Line, LineNumber, LineColumn, FinisherText, Attributes, LineKey, OutDiagnostics))
 					{
+						// Every line wrapped from one source line shares its id, so translations replace whole source lines
+						// The key is the block's id= attribute or the raw text; repeats on the screen are counted apart
+						auto AddSourceLine = [&](const FString& SourceText, EStoryPauseDuration Pause)
+						{
+							const int32 FirstNewLine = CurrentScreen->Lines.Num();
+							ProcessTextToLines(SourceText, Attributes, Pause, CurrentScreen->Lines, MaxLineLength);
+
+							// Blank lines ([SPACER] with attributes) have nothing to translate
+							if (SourceText.TrimStartAndEnd().IsEmpty())
+							{
+								return;
+							}
+
+							const FString& Key = LineKey.IsEmpty() ? SourceText : LineKey;
+							int32& Occurrence = LineKeyCounts.FindOrAdd(Key);
+							const int32 LineId = MakeLineId(CurrentScreen->Name, Key, Occurrence++);
+
+							for (int32 NewLine = FirstNewLine; NewLine < CurrentScreen->Lines.Num(); ++NewLine)
+							{
+								CurrentScreen->Lines[NewLine].LineId = LineId;
+							}
+
+							if (OutSourceStrings)
+							{
+								OutSourceStrings->Add({ LineId, OutStory.Screens.Num() - 1, SourceText });
+							}
+						};
+
 						// 1. Process Pending Lines
 						for (const FString& Pending : PendingLines)
 						{
 							// Pending lines get: Same Anim/Effect/Offset, but Pause = None
-							// Pending lines get: Same Anim/Effect/Offset, but Pause = None
-							ProcessTextToLines(Pending, Anim, Speed, EStoryPauseDuration::None, Effect, Offset, CurrentScreen->Lines, MaxLineLength);
+							AddSourceLine(Pending, EStoryPauseDuration::None);
 						}
 
 						// 2. Process Final Line
 						// Gets the actual Pause
-						// Gets the actual Pause
-						ProcessTextToLines(FinisherText, Anim, Speed, Pause, Effect, Offset, CurrentScreen->Lines, MaxLineLength);
+						AddSourceLine(FinisherText, Attributes.PauseDuration);
 
 						// 3. Add Paragraph Spacer
 						FStoryLine Spacer;
@@ -247,10 +488,6 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 						// Clear buffer
 						PendingLines.Empty();
 					}
-					else
-					{
-						OutErrors.Add(FString::Printf(TEXT("Line %d: %s"), LineNumber, *LineError));
-					}
 				}
 				else
 				{
@@ -262,7 +499,7 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 
 		case EParseState::None:
 			{
-				OutErrors.Add(FString::Printf(TEXT("Line %d: Content found before [STORY] or [SCREEN] section"), LineNumber));
+				AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, LineColumn, TEXT("ContentOutsideSection"), TEXT("Content found before [STORY] or [SCREEN] section"));
 			}
 			break;
 		}
@@ -271,14 +508,14 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 	// Validate story section was found
 	if (!bFoundStorySection)
 	{
-		OutErrors.Add(TEXT("Missing [STORY] section"));
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, 0, 0, TEXT("MissingStorySection"), TEXT("Missing [STORY] section"));
 		return false;
 	}
 
 	// Check for leftover pending lines
 	if (PendingLines.Num() > 0)
 	{
-		OutErrors.Add(FString::Printf(TEXT("End of file: Orphaned text lines found (missing metadata line?)")));
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, Lines.Num(), 0, TEXT("OrphanedText"), TEXT("End of file: Orphaned text lines found (missing metadata line?)"));
 	}
 
 	// Apply story metadata
@@ -290,17 +527,27 @@ bool UShortStoryParser::ParseStoryFromString(const FString& StoryText, FShortSto
 	{
 		OutStory.OST = StoryMetadata[TEXT("ost")];
 	}
+	if (StoryMetadata.Contains(TEXT("speed")))
+	{
+		// Story-wide default profile, resolved against Speed_*.csv by the subsystem
+		OutStory.DefaultSpeedProfile = FName(*StoryMetadata[TEXT("speed")]);
+	}
+	if (StoryMetadata.Contains(TEXT("voice")))
+	{
+		// Story-wide default blip voice, resolved by the blip subsystem
+		OutStory.DefaultVoice = FName(*StoryMetadata[TEXT("voice")]);
+	}
 
 	// Validate story
 	if (!OutStory.IsValid())
 	{
 		if (OutStory.Title.IsEmpty())
 		{
-			OutErrors.Add(TEXT("Missing 'title' in [STORY] section"));
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, 0, 0, TEXT("MissingTitle"), TEXT("Missing 'title' in [STORY] section"));
 		}
 		if (OutStory.Screens.Num() == 0)
 		{
-			OutErrors.Add(TEXT("No screens defined (missing [SCREEN_XX] sections)"));
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, 0, 0, TEXT("NoScreens"), TEXT("No screens defined (missing [SCREEN_XX] sections)"));
 		}
 		return false;
 	}
@@ -323,6 +570,12 @@ bool UShortStoryParser::ParseMetadataLine(const FString& Line, TMap<FString, FSt
 		Key = Key.TrimStartAndEnd();
 		Value = Value.TrimStartAndEnd();
 
+		// Keys are single words - reject text lines such as "The <color=#f00>red</color> door"
+		if (Key.Contains(TEXT(" ")) || Key.Contains(TEXT("<")))
+		{
+			return false;
+		}
+
 		if (!Key.IsEmpty() && !Value.IsEmpty())
 		{
 			OutMetadata.Add(Key, Value);
@@ -333,22 +586,31 @@ bool UShortStoryParser::ParseMetadataLine(const FString& Line, TMap<FString, FSt
 	return false;
 }
 
-bool UShortStoryParser::ParseLineAttributes(const FString& Line, FString& OutText, EStoryLineAnimation& OutAnim, EStorySpeed& OutSpeed, EStoryPauseDuration& OutPause, EStoryEffect& OutEffect, FVector2D& OutOffset, FString& OutError)
+bool UShortStoryParser::ParseLineAttributes(const FString& Line, int32 LineNumber, int32 ColumnBase, FString& OutText, FStoryLine& OutAttributes, FString& OutLineKey, TArray<FStoryParseDiagnostic>& OutDiagnostics)
 {
 	// Format: TEXT | ANIMATION [| key=value | key=value ...]
 	// Only TEXT and ANIMATION are mandatory
-	// Optional named parameters: speed=X, pause=X, effect=X, offset=X,Y
+	// Optional named parameters: speed=X, pause=X, effect=X, offset=X,Y, voice=X, id=X
+	// Every problem is reported; bad optional fields fall back to defaults and only the bad field is ignored
 	TArray<FString> Fields;
-	Line.ParseIntoArray(Fields, TEXT("|"), false);
-
-	for (FString& Field : Fields)
+	TArray<int32> FieldColumns;
+	int32 FieldStart = 0;
+	for (int32 Index = 0; Index <= Line.Len(); ++Index)
 	{
-		Field = Field.TrimStartAndEnd();
+		if (Index == Line.Len() || Line[Index] == TEXT('|'))
+		{
+			const FString RawField = Line.Mid(FieldStart, Index - FieldStart);
+			const FString Field = RawField.TrimStart();
+			FieldColumns.Add(ColumnBase + FieldStart + (RawField.Len() - Field.Len()));
+			Fields.Add(Field.TrimEnd());
+			FieldStart = Index + 1;
+		}
 	}
 
 	if (Fields.Num() < 2)
 	{
-		OutError = FString::Printf(TEXT("Invalid story line format (expected at least 2 fields, got %d)"), Fields.Num());
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, ColumnBase, TEXT("InvalidLineFormat"),
+			FString::Printf(TEXT("Invalid story line format (expected at least 2 fields, got %d)"), Fields.Num()));
 		return false;
 	}
 
@@ -361,26 +623,27 @@ bool UShortStoryParser::ParseLineAttributes(const FString& Line, FString& OutTex
 
 	if (OutText.IsEmpty())
 	{
-		OutError = TEXT("Empty text field");
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, FieldColumns[0], TEXT("EmptyText"), TEXT("Empty text field"));
 		return false;
 	}
 
+	// Initialize optional fields with defaults
+	OutAttributes = FStoryLine();
+	OutLineKey.Reset();
+
 	// Parse animation (mandatory)
-	if (!ParseAnimationType(Fields[1], OutAnim))
+	if (!ParseAnimationType(Fields[1], OutAttributes.AnimationType))
 	{
-		OutError = FString::Printf(TEXT("Unknown animation type '%s'"), *Fields[1]);
-		OutAnim = EStoryLineAnimation::Typewriter;
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, FieldColumns[1], TEXT("UnknownAnimation"),
+			FString::Printf(TEXT("Unknown animation type '%s' (using typewriter)"), *Fields[1]));
+		OutAttributes.AnimationType = EStoryLineAnimation::Typewriter;
 	}
 
-	// Initialize optional fields with defaults
-	OutSpeed = EStorySpeed::Standard;
-	OutPause = EStoryPauseDuration::None;
-	OutEffect = EStoryEffect::None;
-	OutOffset = FVector2D::ZeroVector;
-
 	// Parse optional named parameters (field 2+)
 	for (int32 i = 2; i < Fields.Num(); ++i)
 	{
+		const int32 Column = FieldColumns[i];
+
 		FString Key, Value;
 		if (Fields[i].Split(TEXT("="), &Key, &Value))
 		{
@@ -389,48 +652,76 @@ bool UShortStoryParser::ParseLineAttributes(const FString& Line, FString& OutTex
 
 			if (Key == TEXT("speed"))
 			{
-				if (!ParseSpeed(Value, OutSpeed))
+				if (!ParseSpeed(Value, OutAttributes))
 				{
-					OutError = FString::Printf(TEXT("Unknown speed '%s'"), *Value);
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("InvalidSpeed"),
+						FString::Printf(TEXT("Invalid speed '%s'"), *Value));
 				}
 			}
 			else if (Key == TEXT("pause"))
 			{
-				if (!ParsePauseDuration(Value, OutPause))
+				if (!ParsePauseDuration(Value, OutAttributes.PauseDuration))
 				{
-					OutError = FString::Printf(TEXT("Unknown pause duration '%s'"), *Value);
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("UnknownPause"),
+						FString::Printf(TEXT("Unknown pause duration '%s'"), *Value));
 				}
 			}
 			else if (Key == TEXT("effect"))
 			{
-				if (!ParseEffectType(Value, OutEffect))
+				if (!ParseEffectType(Value, OutAttributes.Effect))
 				{
-					OutError = FString::Printf(TEXT("Unknown effect type '%s'"), *Value);
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("UnknownEffect"),
+						FString::Printf(TEXT("Unknown effect type '%s'"), *Value));
 				}
 			}
 			else if (Key == TEXT("offset"))
 			{
-				if (!ParsePositionOffset(Value, OutOffset))
+				if (!ParsePositionOffset(Value, OutAttributes.PositionOffset))
 				{
-					OutError = FString::Printf(TEXT("Invalid offset format '%s' (expected X,Y)"), *Value);
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("InvalidOffset"),
+						FString::Printf(TEXT("Invalid offset format '%s' (expected X,Y)"), *Value));
+				}
+			}
+			else if (Key == TEXT("voice"))
+			{
+				if (Value.IsEmpty())
+				{
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("InvalidVoice"), TEXT("Empty voice name"));
+				}
+				else
+				{
+					OutAttributes.Voice = FName(*Value);
+				}
+			}
+			else if (Key == TEXT("id"))
+			{
+				if (Value.IsEmpty())
+				{
+					AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("InvalidId"), TEXT("Empty line id (using the line text)"));
+				}
+				else
+				{
+					OutLineKey = Value;
 				}
 			}
 			else
 			{
-				OutError = FString::Printf(TEXT("Unknown parameter '%s'"), *Key);
+				AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("UnknownParameter"),
+					FString::Printf(TEXT("Unknown parameter '%s'"), *Key));
 			}
 		}
 		else
 		{
-			// Not a key=value format, log warning but continue
-			OutError = FString::Printf(TEXT("Invalid parameter format '%s' (expected key=value)"), *Fields[i]);
+			// Not a key=value format, ignore the field but continue
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Warning, LineNumber, Column, TEXT("InvalidParameterFormat"),
+				FString::Printf(TEXT("Invalid parameter format '%s' (expected key=value)"), *Fields[i]));
 		}
 	}
 
 	return true;
 }
 
-void UShortStoryParser::ProcessTextToLines(const FString& Text, EStoryLineAnimation Anim, EStorySpeed Speed, EStoryPauseDuration Pause, EStoryEffect Effect, FVector2D Offset, TArray<FStoryLine>& OutLines, int32 MaxLineLength)
+void UShortStoryParser::ProcessTextToLines(const FString& Text, const FStoryLine& Attributes, EStoryPauseDuration Pause, TArray<FStoryLine>& OutLines, int32 MaxLineLength)
 {
 	// SPLITTING LOGIC
 	// 1. Split by Manual Delimiter '\\'
@@ -450,14 +741,13 @@ void UShortStoryParser::ProcessTextToLines(const FString& Text, EStoryLineAnimat
 		FinalSegments.Append(Wrapped);
 	}
 
+	// Inline styles may span wrapped segments; anything left open is closed at the end of the block
+	FStoryMarkupState MarkupState;
+
 	for (int32 i = 0; i < FinalSegments.Num(); ++i)
 	{
-		FStoryLine NewLine;
-		NewLine.Text = FinalSegments[i];
-		NewLine.AnimationType = Anim;
-		NewLine.Speed = Speed;
-		NewLine.Effect = Effect;
-		NewLine.PositionOffset = Offset;
+		FStoryLine NewLine = Attributes;
+		ParseInlineMarkup(FinalSegments[i], NewLine, MarkupState);
 		
 		// Logic: Intermediate parts of a SINGLE logical line (split manually or wrapped) get None pause.
 		// Only the LAST segment of this specific text block gets the requested Pause.
@@ -474,19 +764,34 @@ void UShortStoryParser::ProcessTextToLines(const FString& Text, EStoryLineAnimat
 	}
 }
 
+int32 UShortStoryParser::MakeLineId(const FString& ScreenName, const FString& LineKey, int32 Occurrence)
+{
+	// Screen names are case-insensitive in navigation, so hash them upper-cased
+	uint32 Hash = FCrc::StrCrc32(*ScreenName.ToUpper());
+	Hash = HashCombine(Hash, FCrc::StrCrc32(*LineKey));
+	Hash = HashCombine(Hash, GetTypeHash(Occurrence));
+
+	// Zero is reserved for lines without an id (spacers)
+	return Hash != 0 ? static_cast<int32>(Hash) : 1;
+}
+
 // Deprecated Shim
 bool UShortStoryParser::ParseStoryLine(const FString& Line, int32 LineNumber, TArray<FStoryLine>& OutLines, FString& OutError)
 {
     FString Text;
-    EStoryLineAnimation Anim;
-    EStorySpeed Speed;
-    EStoryPauseDuration Pause;
-    EStoryEffect Effect;
-    FVector2D Offset;
+    FStoryLine Attributes;
+    FString LineKey;
+    TArray<FStoryParseDiagnostic> Diagnostics;
 
-    if (ParseLineAttributes(Line, Text, Anim, Speed, Pause, Effect, Offset, OutError))
+    const bool bParsed = ParseLineAttributes(Line, LineNumber, 1, Text, Attributes, LineKey, Diagnostics);
+    if (Diagnostics.Num() > 0)
     {
-        ProcessTextToLines(Text, Anim, Speed, Pause, Effect, Offset, OutLines, 80); // Use default 80 for deprecated shim
+        OutError = Diagnostics.Last().Message;
+    }
+
+    if (bParsed)
+    {
+        ProcessTextToLines(Text, Attributes, Attributes.PauseDuration, OutLines, 80); // Use default 80 for deprecated shim
         return true;
     }
     return false;
@@ -502,24 +807,52 @@ TArray<FString> UShortStoryParser::SplitTextByLength(const FString& Text, int32
 		return Result;
 	}
 
+	// Only visible characters count towards the limit; inline tags are never split
+	auto GetVisibleLength = [](const FString& InText)
+	{
+		int32 Visible = 0;
+		for (int32 i = 0; i < InText.Len(); )
+		{
+			const int32 TagLength = MatchInlineTag(InText, i);
+			i += (TagLength > 0) ? TagLength : 1;
+			Visible += (TagLength > 0) ? 0 : 1;
+		}
+		return Visible;
+	};
+
 	FString Remaining = Text;
-	while (Remaining.Len() > MaxLen)
+	while (GetVisibleLength(Remaining) > MaxLen)
 	{
 		int32 SplitIndex = -1;
-		// Find last space before MaxLen
-		for (int32 i = MaxLen; i >= 0; --i)
+		int32 ForceSplitIndex = -1;
+
+		// Find last space at or before visible character MaxLen
+		int32 VisibleIndex = 0;
+		for (int32 i = 0; i < Remaining.Len() && VisibleIndex <= MaxLen; )
 		{
+			const int32 TagLength = MatchInlineTag(Remaining, i);
+			if (TagLength > 0)
+			{
+				i += TagLength;
+				continue;
+			}
+
 			if (Remaining[i] == ' ')
 			{
 				SplitIndex = i;
-				break;
 			}
+			if (VisibleIndex == MaxLen)
+			{
+				ForceSplitIndex = i;
+			}
+			++VisibleIndex;
+			++i;
 		}
 
-		if (SplitIndex == -1)
+		if (SplitIndex <= 0)
 		{
 			// No space found, force split at MaxLen to strictly obey limit.
-			SplitIndex = MaxLen;
+			SplitIndex = ForceSplitIndex;
 		}
 
 		Result.Add(Remaining.Left(SplitIndex).TrimStartAndEnd());
@@ -534,7 +867,88 @@ TArray<FString> UShortStoryParser::SplitTextByLength(const FString& Text, int32
 	return Result;
 }
 
-bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, FStoryTimedEvent& OutEvent, FString& OutError)
+int32 UShortStoryParser::MatchInlineTag(const FString& Text, int32 Index)
+{
+	if (!Text.IsValidIndex(Index) || Text[Index] != TEXT('<'))
+	{
+		return 0;
+	}
+
+	const int32 CloseIndex = Text.Find(TEXT(">"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1);
+	if (CloseIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	EInlineTag Tag;
+	bool bClosing = false;
+	FLinearColor Color;
+	float Wait = 0.0f;
+	if (!ParseInlineTagBody(Text.Mid(Index + 1, CloseIndex - Index - 1), Tag, bClosing, Color, Wait))
+	{
+		return 0;
+	}
+
+	return CloseIndex - Index + 1;
+}
+
+void UShortStoryParser::ParseInlineMarkup(const FString& RawText, FStoryLine& OutLine, FStoryMarkupState& InOutState)
+{
+	OutLine.Spans.Reset();
+	OutLine.InlineWaits.Reset();
+
+	// Fast path: no markup in this segment and no style carried over from the previous one
+	if (!RawText.Contains(TEXT("<")) && InOutState.StyleFlags == 0 && InOutState.ColorStack.Num() == 0)
+	{
+		OutLine.Text = RawText;
+		return;
+	}
+
+	FString VisibleText;
+	VisibleText.Reserve(RawText.Len());
+
+	for (int32 i = 0; i < RawText.Len(); )
+	{
+		const int32 TagLength = MatchInlineTag(RawText, i);
+		if (TagLength > 0)
+		{
+			ApplyInlineTag(RawText.Mid(i + 1, TagLength - 2), VisibleText.Len(), OutLine, InOutState);
+			i += TagLength;
+			continue;
+		}
+
+		// Visible character: extend the current span, or open a new one if the style changed
+		int32 StyleFlags = InOutState.StyleFlags;
+		FLinearColor Color = FLinearColor::White;
+		if (InOutState.ColorStack.Num() > 0)
+		{
+			StyleFlags |= static_cast<int32>(EStoryTextStyle::Color);
+			Color = InOutState.ColorStack.Last();
+		}
+
+		if (OutLine.Spans.Num() == 0 || OutLine.Spans.Last().StyleFlags != StyleFlags || OutLine.Spans.Last().Color != Color)
+		{
+			FStoryTextSpan& NewSpan = OutLine.Spans.AddDefaulted_GetRef();
+			NewSpan.StartIndex = VisibleText.Len();
+			NewSpan.StyleFlags = StyleFlags;
+			NewSpan.Color = Color;
+		}
+
+		OutLine.Spans.Last().Length++;
+		VisibleText.AppendChar(RawText[i]);
+		++i;
+	}
+
+	OutLine.Text = MoveTemp(VisibleText);
+
+	// A single unstyled span carries no information - keep plain lines span-free
+	if (OutLine.Spans.Num() == 1 && OutLine.Spans[0].StyleFlags == 0)
+	{
+		OutLine.Spans.Reset();
+	}
+}
+
+bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, int32 Column, FStoryTimedEvent& OutEvent, TArray<FStoryParseDiagnostic>& OutDiagnostics)
 {
 	// Format: sfx <path> | <time>
 	// Format: vfx <path> | <time> | <duration>
@@ -546,7 +960,7 @@ bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, F
 
 	if (Parts.Num() == 0)
 	{
-		OutError = TEXT("Empty timed event");
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, Column, TEXT("InvalidTimedEvent"), TEXT("Empty timed event"));
 		return false;
 	}
 
@@ -562,13 +976,13 @@ bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, F
 
 		if (Fields.Num() < 2)
 		{
-			OutError = TEXT("Invalid @sfx format (expected: @sfx <path> | <time>)");
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, Column, TEXT("InvalidTimedEvent"), TEXT("Invalid @sfx format (expected: @sfx <path> | <time>)"));
 			return false;
 		}
 
 		OutEvent.EventType = EStoryTimedEventType::SFX;
 		OutEvent.AssetPath = Fields[0].TrimStartAndEnd();
-		OutEvent.StartTime = FCString::Atof(*Fields[1].TrimStartAndEnd());
+		OutEvent.StartTime = ParseEventNumber(Fields[1], TEXT("start time"), LineNumber, Column, OutDiagnostics);
 		return true;
 	}
 	else if (Command.Equals(TEXT("vfx")))
@@ -580,14 +994,14 @@ bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, F
 
 		if (Fields.Num() < 3)
 		{
-			OutError = TEXT("Invalid @vfx format (expected: @vfx <class> | <time> | <duration>)");
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, Column, TEXT("InvalidTimedEvent"), TEXT("Invalid @vfx format (expected: @vfx <class> | <time> | <duration>)"));
 			return false;
 		}
 
 		OutEvent.EventType = EStoryTimedEventType::VFX;
 		OutEvent.AssetPath = Fields[0].TrimStartAndEnd();
-		OutEvent.StartTime = FCString::Atof(*Fields[1].TrimStartAndEnd());
-		OutEvent.Duration = FCString::Atof(*Fields[2].TrimStartAndEnd());
+		OutEvent.StartTime = ParseEventNumber(Fields[1], TEXT("start time"), LineNumber, Column, OutDiagnostics);
+		OutEvent.Duration = ParseEventNumber(Fields[2], TEXT("duration"), LineNumber, Column, OutDiagnostics);
 		return true;
 	}
 	else if (Command.Equals(TEXT("wait")))
@@ -595,12 +1009,12 @@ bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, F
 		// Format: wait <duration>
 		if (Parts.Num() < 2)
 		{
-			OutError = TEXT("Invalid @wait format (expected: @wait <duration>)");
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, Column, TEXT("InvalidTimedEvent"), TEXT("Invalid @wait format (expected: @wait <duration>)"));
 			return false;
 		}
 
 		OutEvent.EventType = EStoryTimedEventType::Wait;
-		OutEvent.StartTime = FCString::Atof(*Parts[1]);
+		OutEvent.StartTime = ParseEventNumber(Parts[1], TEXT("duration"), LineNumber, Column, OutDiagnostics);
 		return true;
 	}
 	else if (Command.Equals(TEXT("background")))
@@ -609,7 +1023,7 @@ bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, F
 		FString Path = Line.Mid(Command.Len()).TrimStartAndEnd();
 		if (Path.IsEmpty())
 		{
-			OutError = TEXT("Invalid @background format (expected: @background <path>)");
+			AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, Column, TEXT("InvalidTimedEvent"), TEXT("Invalid @background format (expected: @background <path>)"));
 			return false;
 		}
 
@@ -619,7 +1033,8 @@ bool UShortStoryParser::ParseTimedEvent(const FString& Line, int32 LineNumber, F
 	}
 	else
 	{
-		OutError = FString::Printf(TEXT("Unknown timed event command '%s'"), *Command);
+		AddDiagnostic(OutDiagnostics, EStoryDiagnosticSeverity::Error, LineNumber, Column, TEXT("UnknownTimedEvent"),
+			FString::Printf(TEXT("Unknown timed event command '%s'"), *Command));
 		return false;
 	}
 }
@@ -815,24 +1230,42 @@ bool UShortStoryParser::IsSectionHeader(const FString& Line, FString& OutSection
 	return false;
 }
 
-bool UShortStoryParser::ParseSpeed(const FString& SpeedString, EStorySpeed& OutSpeed)
+bool UShortStoryParser::ParseSpeed(const FString& SpeedString, FStoryLine& OutLine)
 {
 	FString Lower = SpeedString.ToLower();
 
-	if (Lower.Equals(TEXT("standard")))
+	if (Lower.IsEmpty())
 	{
-		OutSpeed = EStorySpeed::Standard;
+		return false;
+	}
+
+	// Numeric per-letter override (e.g. speed=0.02)
+	if (FCString::IsNumeric(*Lower))
+	{
+		const float PerLetter = FCString::Atof(*Lower);
+		if (PerLetter <= 0.0f)
+		{
+			return false;
+		}
+		OutLine.PerLetterOverride = PerLetter;
 		return true;
 	}
+
+	if (Lower.Equals(TEXT("standard")))
+	{
+		OutLine.Speed = EStorySpeed::Standard;
+	}
 	else if (Lower.Equals(TEXT("fast")))
 	{
-		OutSpeed = EStorySpeed::Fast;
-		return true;
+		OutLine.Speed = EStorySpeed::Fast;
 	}
 	else if (Lower.Equals(TEXT("slow")))
 	{
-		OutSpeed = EStorySpeed::Slow;
-		return true;
+		OutLine.Speed = EStorySpeed::Slow;
 	}
-	return false;
+
+	// Any other name refers to a custom profile (Speed_<Name>.csv), validated when the story is loaded.
+	// Built-in names are stored too so an explicit speed=standard is not replaced by the story default.
+	OutLine.SpeedProfile = FName(*SpeedString);
+	return true;
 }
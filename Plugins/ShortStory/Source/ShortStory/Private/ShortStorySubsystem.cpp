@@ -11,6 +11,18 @@
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "TextureResource.h"
+#include "HAL/FileManager.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "Misc/App.h"
+#include "ShortStoryLocalization.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/Culture.h"
+#include "ShortStoryPrewarmManifest.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Tasks/Task.h"
+#include "ShortStoryAudio.h"
 
 // Define profiling stats
 DEFINE_STAT(STAT_ShortStory_LoadStory);
@@ -18,6 +30,81 @@ DEFINE_STAT(STAT_ShortStory_Tick);
 DEFINE_STAT(STAT_ShortStory_GetScreenState);
 DEFINE_STAT(STAT_ShortStory_StartLine);
 DEFINE_STAT(STAT_ShortStory_ParseStory);
+DEFINE_STAT(STAT_ShortStory_UpdateLineParams);
+DEFINE_STAT(STAT_ShortStory_CachedStories);
+DEFINE_STAT(STAT_ShortStory_CacheTextMemory);
+DEFINE_STAT(STAT_ShortStory_CacheTextureMemory);
+DEFINE_STAT(STAT_ShortStory_CacheEvictions);
+DEFINE_STAT(STAT_ShortStory_Blips);
+DEFINE_STAT(STAT_ShortStory_BlipsPlayed);
+DEFINE_STAT(STAT_ShortStory_BlipsLimited);
+
+namespace
+{
+	/** Delay between consecutive line starts in a TopDown block */
+	constexpr float TopDownCascadeDelay = 0.2f;
+
+	/** Upper bound on state transitions per Tick (zero-length lines and pauses chain within one frame) */
+	constexpr int32 MaxTransitionsPerTick = 64;
+
+	/** Shorter idle spans keep ticking: a few frames cost less than unregistering and re-registering */
+	constexpr float MinSleepSeconds = 0.1f;
+
+	/** Extra delay after a character is revealed (punctuation and word boundaries) */
+	float GetCharacterExtraDelay(TCHAR Char, const FStoryAnimationTiming& Timing)
+	{
+		if (FChar::IsWhitespace(Char))
+		{
+			return Timing.ExtraAtSpace;
+		}
+		if (Char == TEXT('.') || Char == TEXT('!') || Char == TEXT('?'))
+		{
+			return Timing.ExtraAtPeriod;
+		}
+		if (Char == TEXT(':'))
+		{
+			return Timing.ExtraAtColon;
+		}
+		if (Char == TEXT(',') || Char == TEXT(';'))
+		{
+			// Semicolon shares the comma timing
+			return Timing.ExtraAtComma;
+		}
+		return 0.0f;
+	}
+
+	/** Fill a line's reveal timeline from its visible text and inline waits */
+	void BuildRevealTimeline(const FStoryLine& Line, const FStoryAnimationTiming& Timing, FStoryRevealTimeline& OutTimeline)
+	{
+		// Character i becomes visible once it has been "typed"; its extra delay follows while it is shown
+		OutTimeline.CharRevealTimes.SetNumUninitialized(Line.Text.Len());
+
+		// Inline <wait=X> pauses are inserted before the character they precede
+		float CurrentTime = 0.0f;
+		int32 WaitIndex = 0;
+		for (int32 i = 0; i < Line.Text.Len(); ++i)
+		{
+			while (Line.InlineWaits.IsValidIndex(WaitIndex) && Line.InlineWaits[WaitIndex].CharIndex <= i)
+			{
+				CurrentTime += Line.InlineWaits[WaitIndex++].Duration;
+			}
+
+			CurrentTime += Timing.PerLetter;
+			OutTimeline.CharRevealTimes[i] = CurrentTime;
+			CurrentTime += GetCharacterExtraDelay(Line.Text[i], Timing);
+		}
+
+		// Trailing waits hold the line before its pause starts
+		for (; WaitIndex < Line.InlineWaits.Num(); ++WaitIndex)
+		{
+			CurrentTime += Line.InlineWaits[WaitIndex].Duration;
+		}
+
+		OutTimeline.TypewriterDuration = CurrentTime;
+		OutTimeline.PerLetter = Timing.PerLetter;
+		OutTimeline.BlockDuration = Timing.BlockDuration;
+	}
+}
 
 void UShortStorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -26,6 +113,13 @@ void UShortStorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// Load timing configuration from CSV files
 	LoadTimingConfigs();
 
+	// Story text follows the game language unless set explicitly
+	if (bFollowEngineCulture)
+	{
+		CultureChangedHandle = FInternationalization::Get().OnCultureChanged().AddUObject(this, &UShortStorySubsystem::HandleCultureChanged);
+		HandleCultureChanged();
+	}
+
 	UE_LOG(LogShortStory, Log, TEXT("ShortStorySubsystem initialized"));
 }
 
@@ -34,25 +128,44 @@ void UShortStorySubsystem::Deinitialize()
 	// Stop playback if active
 	StopStory();
 
-	// Clear cache
+	// Workers still running drop their results; loaded background assets are let go
+	CancelPrewarm();
+	for (const TSharedPtr<FStreamableHandle>& Handle : PrewarmedAssetHandles)
 	{
-		FScopeLock Lock(&CacheMutex);
-		
-		// Clean up runtime textures
-		for (auto& Elem : CachedStories)
-		{
-			for (const FStoryScreen& Screen : Elem.Value.Screens)
-			{
-				if (Screen.RuntimeTexture)
-				{
-					Screen.RuntimeTexture->RemoveFromRoot();
-				}
-			}
-		}
-		
-		CachedStories.Empty();
+		Handle->ReleaseHandle();
+	}
+	PrewarmedAssetHandles.Empty();
+
+	// Tables still loading are dropped with the shared results
+	if (TranslationTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TranslationTickerHandle);
+		TranslationTickerHandle.Reset();
+	}
+	TranslationLoads.Reset();
+	PendingTranslations.Empty();
+
+	if (CultureChangedHandle.IsValid())
+	{
+		FInternationalization::Get().OnCultureChanged().Remove(CultureChangedHandle);
+		CultureChangedHandle.Reset();
 	}
 
+	// Clear the cache and release every runtime texture, including those kept for the current story
+	for (const FShortStoryCache::FStoryRef& Story : StoryCache.Empty())
+	{
+		ReleaseStoryTextures(*Story);
+	}
+	CurrentStory = FShortStory();
+	CurrentSourceStory.Reset();
+	CurrentStoryId = NAME_None;
+	ReleaseDeferredTextures(CurrentStory);
+	UpdateCacheStats();
+
+	LineParametersTexture = nullptr;
+	PackedLineParameters.Empty();
+	LastUploadedLineParameters.Empty();
+
 	Super::Deinitialize();
 }
 
@@ -69,18 +182,14 @@ FShortStory UShortStorySubsystem::LoadStory(const FString& StoryFileName, bool b
 		return FShortStory();
 	}
 
-	// Normalize filename for case-insensitive caching
-	FString CacheKey = StoryFileName.ToLower();
-
-	// Check cache first (unless force reload)
+	// Check cache first (unless force reload); the probe is case-insensitive and lock-free
 	if (!bForceReload)
 	{
-		FScopeLock Lock(&CacheMutex);
-		if (CachedStories.Contains(CacheKey))
+		if (const FShortStory* Cached = StoryCache.Find(StoryFileName))
 		{
 			UE_LOG(LogShortStory, Log, TEXT("LoadStory: Loading '%s' from cache"), *StoryFileName);
 			bSuccess = true;
-			return CachedStories[CacheKey];
+			return *Cached;
 		}
 	}
 
@@ -97,23 +206,27 @@ FShortStory UShortStorySubsystem::LoadStory(const FString& StoryFileName, bool b
 
 	// Parse story from file
 	FShortStory Story;
-	TArray<FString> Errors;
-	bool bParsed = UShortStoryParser::ParseStoryFile(FullPath, Story, Errors, MaxLineLength);
+	TArray<FStoryParseDiagnostic> Diagnostics;
+	bool bParsed = UShortStoryParser::ParseStoryFile(FullPath, Story, Diagnostics, MaxLineLength);
 
 	if (!bParsed)
 	{
 		UE_LOG(LogShortStory, Error, TEXT("LoadStory: Failed to parse '%s'"), *StoryFileName);
-		for (const FString& Error : Errors)
+		for (const FStoryParseDiagnostic& Diagnostic : Diagnostics)
 		{
-			UE_LOG(LogShortStory, Error, TEXT("  - %s"), *Error);
+			UE_LOG(LogShortStory, Error, TEXT("  - [%s] %s"), *Diagnostic.Code.ToString(), *Diagnostic.ToString());
 		}
 		return FShortStory();
 	}
 
-	// Log warnings if any
-	if (Errors.Num() > 0)
+	// Log problems the parser recovered from
+	if (Diagnostics.Num() > 0)
 	{
-		UE_LOG(LogShortStory, Warning, TEXT("LoadStory: Parsed '%s' with %d warnings"), *StoryFileName, Errors.Num());
+		UE_LOG(LogShortStory, Warning, TEXT("LoadStory: Parsed '%s' with %d problems"), *StoryFileName, Diagnostics.Num());
+		for (const FStoryParseDiagnostic& Diagnostic : Diagnostics)
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("  - [%s] %s"), *Diagnostic.Code.ToString(), *Diagnostic.ToString());
+		}
 	}
 	else
 	{
@@ -127,280 +240,1328 @@ FShortStory UShortStorySubsystem::LoadStory(const FString& StoryFileName, bool b
 		ResolveBackgroundTexture(Screen, StoryBaseDir);
 	}
 
-	// Cache the story
-	{
-		FScopeLock Lock(&CacheMutex);
-		CachedStories.Add(CacheKey, Story);
-	}
+	CacheParsedStory(StoryFileName, Story);
 
 	bSuccess = true;
 	return Story;
 }
 
-void UShortStorySubsystem::ResolveBackgroundTexture(FStoryScreen& Screen, const FString& BaseSearchPath)
+void UShortStorySubsystem::CacheParsedStory(const FString& StoryFileName, FShortStory& Story)
 {
-	// If we already have an asset pointer, we're good (unless we want to override?)
-	// But let's check if we need to load from disk
-	if (Screen.BackgroundPath.IsEmpty())
+	// Resolve speed profiles and bake reveal timelines once, so playback never re-scans text
+	BakeStoryTimelines(Story);
+
+	// Cache the story (a forced reload replaces the old copy, its textures and its translation), then fit the budget
+	if (FShortStoryCache::FStoryPtr Replaced = StoryCache.Add(StoryFileName, Story))
 	{
-		return;
+		ReleaseStoryTextures(*Replaced);
 	}
+	EnforceCacheBudget(StoryFileName);
+}
 
-	// If it looks like an asset path and we have a SoftPtr, ensure it is loaded
-	if ((Screen.BackgroundPath.StartsWith(TEXT("/Game")) || Screen.BackgroundPath.StartsWith(TEXT("/Engine"))) 
-		&& !Screen.Background.IsNull())
+namespace
+{
+	/** Background image decoded to RGBA, ready to become a texture */
+	struct FDecodedBackground
 	{
-		// Force synchronous load so it's ready immediately
-		if (UTexture2D* LoadedAsset = Screen.Background.LoadSynchronous())
-		{
-		}
-		return;
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray64<uint8> RGBA;
+
+		bool IsValid() const { return Width > 0 && Height > 0; }
+	};
+
+	/** Is the background a content asset (loaded through its soft pointer) rather than an image file */
+	bool IsAssetBackgroundPath(const FString& BackgroundPath)
+	{
+		return BackgroundPath.StartsWith(TEXT("/Game")) || BackgroundPath.StartsWith(TEXT("/Engine"));
 	}
 
-	// It's a raw file path. Try to load it.
-	FString FullPath = Screen.BackgroundPath;
-	if (FPaths::IsRelative(FullPath))
+	/**
+	 * Locate a raw background image file (thread-safe)
+	 * Relative paths are tried against the story's folder, the Stories root and the project, in that order
+	 */
+	bool FindBackgroundFile(const FString& BackgroundPath, const FString& BaseSearchPath, const FString& StoriesDir, FString& OutFullPath)
 	{
-		// Order of precedence:
-		// 1. Relative to exact Story File location (BaseSearchPath) - if provided
-		if (!BaseSearchPath.IsEmpty())
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		if (!FPaths::IsRelative(BackgroundPath))
+		{
+			OutFullPath = BackgroundPath;
+			return PlatformFile.FileExists(*OutFullPath);
+		}
+
+		const FString Candidates[] =
 		{
-			FString StoryRelative = FPaths::Combine(BaseSearchPath, FullPath);
-			if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*StoryRelative))
+			BaseSearchPath.IsEmpty() ? FString() : FPaths::Combine(BaseSearchPath, BackgroundPath),
+			FPaths::Combine(StoriesDir, BackgroundPath),
+			FPaths::Combine(FPaths::ProjectDir(), BackgroundPath)
+		};
+
+		for (const FString& Candidate : Candidates)
+		{
+			if (!Candidate.IsEmpty() && PlatformFile.FileExists(*Candidate))
 			{
-				FullPath = StoryRelative;
-				goto LoadFile; // Found it
+				OutFullPath = Candidate;
+				return true;
 			}
 		}
 
-		// 2. Relative to Stories Root Directory
-		FString StoriesRelative = FPaths::Combine(GetStoriesDirectory(), FullPath);
-		if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*StoriesRelative))
+		OutFullPath = BackgroundPath;
+		return false;
+	}
+
+	/** Read and decode an image file to RGBA (thread-safe once the ImageWrapper module is loaded) */
+	bool DecodeBackgroundFile(IImageWrapperModule& ImageWrapperModule, const FString& FullPath, FDecodedBackground& OutDecoded)
+	{
+		// Load raw data
+		TArray<uint8> RawData;
+		if (!FFileHelper::LoadFileToArray(RawData, *FullPath))
+		{
+			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to load file: %s"), *FullPath);
+			return false;
+		}
+
+		// Auto-detect format
+		EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(RawData.GetData(), RawData.Num());
+		if (ImageFormat == EImageFormat::Invalid)
+		{
+			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Unable to detect image format: %s"), *FullPath);
+			return false;
+		}
+
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(RawData.GetData(), RawData.Num()))
 		{
-			FullPath = StoriesRelative;
-			goto LoadFile;
+			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to decompress image: %s"), *FullPath);
+			return false;
 		}
 
-		// 3. Relative to Project Directory
-		FString ProjectRelative = FPaths::Combine(FPaths::ProjectDir(), FullPath);
-		if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*ProjectRelative))
+		// Get uncompressed RGBA data (not BGRA - UE5 expects RGBA for CreateTransient)
+		if (!ImageWrapper->GetRaw(ERGBFormat::RGBA, 8, OutDecoded.RGBA))
 		{
-			FullPath = ProjectRelative;
+			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to get raw image data: %s"), *FullPath);
+			return false;
 		}
+
+		OutDecoded.Width = ImageWrapper->GetWidth();
+		OutDecoded.Height = ImageWrapper->GetHeight();
+		return true;
 	}
 
-LoadFile:
-	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*FullPath))
+	/** Create a rooted transient texture from a decoded image (game thread) */
+	UTexture2D* CreateBackgroundTexture(const FDecodedBackground& Decoded, const FString& SourcePath)
 	{
-		UE_LOG(LogShortStory, Warning, TEXT("ResolveBackgroundTexture: File not found: %s (Base: %s)"), *FullPath, *BaseSearchPath);
-		return;
+		check(IsInGameThread());
+
+		// Create the texture - this will allocate the platform data
+		UTexture2D* Texture = UTexture2D::CreateTransient(Decoded.Width, Decoded.Height, PF_R8G8B8A8);
+		if (!Texture)
+		{
+			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to decode image: %s"), *SourcePath);
+			return nullptr;
+		}
+
+		// Configure texture settings
+		Texture->SRGB = true;
+		Texture->Filter = TextureFilter::TF_Bilinear;
+
+		// Get the platform data that was created
+		FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+		if (!PlatformData || PlatformData->Mips.Num() == 0)
+		{
+			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: No platform data or mips for texture: %s"), *SourcePath);
+			return nullptr;
+		}
+
+		// Copy our image data into the first mip
+		FTexture2DMipMap& Mip = PlatformData->Mips[0];
+		void* TextureData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+		const int64 DataSize = static_cast<int64>(Decoded.Width) * Decoded.Height * 4;
+		FMemory::Memcpy(TextureData, Decoded.RGBA.GetData(), FMath::Min(DataSize, Decoded.RGBA.Num()));
+		Mip.BulkData.Unlock();
+
+		// Update the texture resource on the GPU
+		Texture->UpdateResource();
+
+		// Make sure it doesn't get garbage collected immediately if it's transient
+		Texture->AddToRoot();
+
+		UE_LOG(LogShortStory, Log, TEXT("ResolveBackgroundTexture: Created %dx%d texture from %s"), Decoded.Width, Decoded.Height, *SourcePath);
+		return Texture;
 	}
 
-	// Load raw data
-	TArray<uint8> RawData;
-	if (!FFileHelper::LoadFileToArray(RawData, *FullPath))
+	/** Add the sound assets of a story's @sfx events, OST and blip voices, so its first cues do not load on the game thread */
+	void AddStoryAudioPaths(const FShortStory& Story, TArray<FSoftObjectPath>& OutAssetPaths)
 	{
-		UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to load file: %s"), *FullPath);
-		return;
-	}
+		auto AddCue = [&OutAssetPaths](const FString& CuePath)
+		{
+			const FSoftObjectPath SoundPath = CuePath.IsEmpty() ? FSoftObjectPath() : FShortStoryEngineAudioBackend::GetSoundPath(CuePath);
+			if (!SoundPath.IsNull())
+			{
+				OutAssetPaths.AddUnique(SoundPath);
+			}
+		};
 
-	// Use IImageWrapper to load texture (works in both editor and packaged builds)
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+		for (const FStoryScreen& Screen : Story.Screens)
+		{
+			for (const FStoryTimedEvent& Event : Screen.TimedEvents)
+			{
+				if (Event.EventType == EStoryTimedEventType::SFX)
+				{
+					AddCue(Event.AssetPath);
+				}
+			}
+		}
+		AddCue(Story.OST);
+	}
+}
 
-	// Auto-detect format
-	EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(RawData.GetData(), RawData.Num());
-	if (ImageFormat == EImageFormat::Invalid)
+void UShortStorySubsystem::ResolveBackgroundTexture(FStoryScreen& Screen, const FString& BaseSearchPath)
+{
+	if (Screen.BackgroundPath.IsEmpty())
 	{
-		UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Unable to detect image format: %s"), *FullPath);
 		return;
 	}
 
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
-	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(RawData.GetData(), RawData.Num()))
+	// If it looks like an asset path and we have a SoftPtr, ensure it is loaded
+	if (IsAssetBackgroundPath(Screen.BackgroundPath) && !Screen.Background.IsNull())
 	{
-		UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to decompress image: %s"), *FullPath);
+		// Force synchronous load so it's ready immediately (a no-op when prewarmed)
+		Screen.Background.LoadSynchronous();
 		return;
 	}
 
-	// Get uncompressed RGBA data (not BGRA - UE5 expects RGBA for CreateTransient)
-	TArray64<uint8> UncompressedRGBA;
-	if (!ImageWrapper->GetRaw(ERGBFormat::RGBA, 8, UncompressedRGBA))
+	// It's a raw file path. Try to load it.
+	FString FullPath;
+	if (!FindBackgroundFile(Screen.BackgroundPath, BaseSearchPath, GetStoriesDirectory(), FullPath))
 	{
-		UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to get raw image data: %s"), *FullPath);
+		UE_LOG(LogShortStory, Warning, TEXT("ResolveBackgroundTexture: File not found: %s (Base: %s)"), *FullPath, *BaseSearchPath);
 		return;
 	}
 
-	// Create texture from raw data
-	const int32 Width = ImageWrapper->GetWidth();
-	const int32 Height = ImageWrapper->GetHeight();
+	// Use IImageWrapper to load texture (works in both editor and packaged builds)
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	FDecodedBackground Decoded;
+	if (DecodeBackgroundFile(ImageWrapperModule, FullPath, Decoded))
+	{
+		Screen.RuntimeTexture = CreateBackgroundTexture(Decoded, FullPath);
+	}
+}
 
-	// Create the texture - this will allocate the platform data
-	Screen.RuntimeTexture = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);
+// ========================================
+// Prewarming
+// ========================================
 
-	if (Screen.RuntimeTexture)
+/** Prewarm state shared between the game thread and its worker tasks */
+struct FStoryPrewarmJob
+{
+	/** One story parsed, with its image file backgrounds decoded, off the game thread */
+	struct FResult
 	{
-		// Configure texture settings
-		Screen.RuntimeTexture->SRGB = true;
-		Screen.RuntimeTexture->Filter = TextureFilter::TF_Bilinear;
+		FString StoryFileName;
+		FShortStory Story;
+		TArray<FStoryParseDiagnostic> Diagnostics;
+		bool bParsed = false;
 
-		// Get the platform data that was created
-		FTexturePlatformData* PlatformData = Screen.RuntimeTexture->GetPlatformData();
-		if (PlatformData && PlatformData->Mips.Num() > 0)
-		{
-			// Get the first mip level
-			FTexture2DMipMap& Mip = PlatformData->Mips[0];
+		/** Decoded backgrounds by screen index (invalid for asset backgrounds and missing files) */
+		TArray<FDecodedBackground> Backgrounds;
+
+		/** Already cached story that only needed its translation loaded */
+		bool bTranslationOnly = false;
+
+		/** Table of the job's culture (null when the story has no translation) */
+		TSharedPtr<FShortStoryStringTable> StringTable;
+	};
+
+	/** Culture the tables were loaded for (empty = source text, no tables) */
+	FString Culture;
+
+	/** Set on cancel; workers stop at their next check and nothing they produce is used */
+	std::atomic<bool> bCancelled { false };
 
-			// Lock the bulk data for writing
-			void* TextureData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+	/** Finished stories waiting for the game thread */
+	FCriticalSection ResultsMutex;
+	TArray<TUniquePtr<FResult>> Results;
 
-			// Copy our image data to the texture
-			const int64 DataSize = static_cast<int64>(Width) * Height * 4;
-			FMemory::Memcpy(TextureData, UncompressedRGBA.GetData(), DataSize);
+	/** Stories handed to workers, and how many of them the game thread has collected */
+	int32 NumStories = 0;
+	int32 NumStoriesDone = 0;
 
-			// Unlock the bulk data
-			Mip.BulkData.Unlock();
+	/** Async loads of background assets */
+	TArray<TSharedPtr<FStreamableHandle>> AssetHandles;
+};
 
-			// Update the texture resource on the GPU
-			Screen.RuntimeTexture->UpdateResource();
+bool UShortStorySubsystem::PrewarmStories(const UShortStoryPrewarmManifest* Manifest)
+{
+	check(IsInGameThread());
+
+	if (!Manifest)
+	{
+		UE_LOG(LogShortStory, Error, TEXT("PrewarmStories: No manifest"));
+		return false;
+	}
+
+	if (PrewarmJob.IsValid())
+	{
+		UE_LOG(LogShortStory, Log, TEXT("PrewarmStories: '%s' replaces the prewarm in progress"), *Manifest->GetName());
+		CancelPrewarm();
+	}
 
-			UE_LOG(LogShortStory, Log, TEXT("ResolveBackgroundTexture: Created %dx%d texture from %s"), Width, Height, *FullPath);
+	// Only stories that are not cached yet go to the workers, and cached ones still missing their translation
+	TArray<FString> ToParse;
+	TArray<FString> ToTranslate;
+	TArray<FSoftObjectPath> AssetPaths;
+	for (const FString& StoryFileName : Manifest->StoryFiles)
+	{
+		if (StoryFileName.IsEmpty())
+		{
+			continue;
 		}
-		else
+
+		if (const FShortStory* Cached = StoryCache.Find(StoryFileName))
+		{
+			// Cached stories keep their image textures, but asset backgrounds may have been collected since
+			for (const FStoryScreen& Screen : Cached->Screens)
+			{
+				if (!Screen.RuntimeTexture && !Screen.Background.IsNull())
+				{
+					AssetPaths.AddUnique(Screen.Background.ToSoftObjectPath());
+				}
+			}
+			AddStoryAudioPaths(*Cached, AssetPaths);
+			OnGatherPrewarmAssets.Broadcast(*Cached, AssetPaths);
+
+			bool bLookedUp = false;
+			StoryCache.FindTranslation(StoryFileName, StoryCulture, bLookedUp);
+			if (!StoryCulture.IsEmpty() && !bLookedUp)
+			{
+				ToTranslate.AddUnique(StoryFileName);
+			}
+		}
+		else if (!ToParse.ContainsByPredicate([&StoryFileName](const FString& Other) { return Other.Equals(StoryFileName, ESearchCase::IgnoreCase); }))
 		{
-			UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: No platform data or mips for texture: %s"), *FullPath);
-			Screen.RuntimeTexture = nullptr;
+			ToParse.Add(StoryFileName);
 		}
 	}
 
-	if (Screen.RuntimeTexture)
+	for (const TSoftObjectPtr<UTexture2D>& Background : Manifest->Backgrounds)
 	{
-		// Make sure it doesn't get garbage collected immediately if it's transient
-		Screen.RuntimeTexture->AddToRoot(); 
-		
-		UE_LOG(LogShortStory, Log, TEXT("ResolveBackgroundTexture: Loaded runtime texture from %s"), *FullPath);
+		if (!Background.IsNull())
+		{
+			AssetPaths.AddUnique(Background.ToSoftObjectPath());
+		}
 	}
-	else
+
+	if (ToParse.Num() == 0 && ToTranslate.Num() == 0 && AssetPaths.Num() == 0)
 	{
-		UE_LOG(LogShortStory, Error, TEXT("ResolveBackgroundTexture: Failed to decode image: %s"), *FullPath);
+		UE_LOG(LogShortStory, Log, TEXT("PrewarmStories: Nothing to load for '%s'"), *Manifest->GetName());
+		return false;
 	}
-}
 
-TArray<FString> UShortStorySubsystem::GetAvailableStories()
-{
-	TArray<FString> StoryFiles;
+	PrewarmJob = MakeShared<FStoryPrewarmJob, ESPMode::ThreadSafe>();
+	PrewarmJob->NumStories = ToParse.Num() + ToTranslate.Num();
+	PrewarmJob->Culture = StoryCulture;
 
-	FString StoriesDir = GetStoriesDirectory();
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	// Everything the workers need is gathered here, so they never touch the subsystem
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const FString StoriesDir = GetStoriesDirectory();
+	const FString LocDir = GetLocDirectory();
+	const int32 LineLength = MaxLineLength;
 
-	// Check if directory exists
-	if (!PlatformFile.DirectoryExists(*StoriesDir))
+	// Tables of the active culture are read with the stories, so StartStory finds their translation ready
+	TArray<FString> CultureNames;
+	if (!StoryCulture.IsEmpty())
 	{
-		UE_LOG(LogShortStory, Warning, TEXT("GetAvailableStories: Stories directory does not exist: %s"), *StoriesDir);
-		return StoryFiles;
+		CultureNames = FInternationalization::Get().GetPrioritizedCultureNames(StoryCulture);
 	}
 
-	// Ensure trailing separator for MakePathRelativeTo
-	if (!StoriesDir.EndsWith(TEXT("/")))
+	for (const FString& StoryFileName : ToTranslate)
 	{
-		StoriesDir += TEXT("/");
-	}
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job = PrewarmJob, StoryFileName, LocDir, CultureNames]()
+		{
+			if (Job->bCancelled)
+			{
+				return;
+			}
 
-	// Recursive visitor
-	class FGenericRecursiveVisitor : public IPlatformFile::FDirectoryVisitor
-	{
-	public:
-		TArray<FString>& Files;
-		FString RootDir;
+			TUniquePtr<FStoryPrewarmJob::FResult> Result = MakeUnique<FStoryPrewarmJob::FResult>();
+			Result->StoryFileName = StoryFileName;
+			Result->bTranslationOnly = true;
+			Result->StringTable = FShortStoryStringTable::LoadForStory(LocDir, CultureNames, StoryFileName);
 
-		FGenericRecursiveVisitor(TArray<FString>& InFiles, const FString& InRootDir)
-			: Files(InFiles), RootDir(InRootDir) {}
+			FScopeLock Lock(&Job->ResultsMutex);
+			Job->Results.Add(MoveTemp(Result));
+		}, UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
 
-		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
+	for (const FString& StoryFileName : ToParse)
+	{
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job = PrewarmJob, StoryFileName, StoriesDir, LocDir, CultureNames, LineLength, &ImageWrapperModule]()
 		{
-			if (bIsDirectory)
+			if (Job->bCancelled)
 			{
-				return true; // Continue recursion
+				return;
 			}
 
-			FString Filename = FPaths::GetCleanFilename(FilenameOrDirectory);
-			if (Filename.EndsWith(TEXT(".tos"), ESearchCase::IgnoreCase))
+			TUniquePtr<FStoryPrewarmJob::FResult> Result = MakeUnique<FStoryPrewarmJob::FResult>();
+			Result->StoryFileName = StoryFileName;
+
+			const FString FullPath = FPaths::Combine(StoriesDir, StoryFileName);
+			Result->bParsed = UShortStoryParser::ParseStoryFile(FullPath, Result->Story, Result->Diagnostics, LineLength);
+
+			if (Result->bParsed)
 			{
-				// We want path relative to StoriesDir
-				FString FullPath = FilenameOrDirectory;
-				FString RelativePath = FullPath;
-				FPaths::MakePathRelativeTo(RelativePath, *RootDir);
-				Files.Add(RelativePath);
+				// File reads and image decoding are the slow part of a load; texture creation stays on the game thread
+				const FString StoryBaseDir = FPaths::GetPath(FullPath);
+				Result->Backgrounds.SetNum(Result->Story.Screens.Num());
+				for (int32 ScreenIndex = 0; ScreenIndex < Result->Story.Screens.Num(); ++ScreenIndex)
+				{
+					if (Job->bCancelled)
+					{
+						return;
+					}
+
+					const FString& BackgroundPath = Result->Story.Screens[ScreenIndex].BackgroundPath;
+					if (BackgroundPath.IsEmpty() || IsAssetBackgroundPath(BackgroundPath))
+					{
+						continue;
+					}
+
+					FString BackgroundFile;
+					if (FindBackgroundFile(BackgroundPath, StoryBaseDir, StoriesDir, BackgroundFile))
+					{
+						DecodeBackgroundFile(ImageWrapperModule, BackgroundFile, Result->Backgrounds[ScreenIndex]);
+					}
+					else
+					{
+						UE_LOG(LogShortStory, Warning, TEXT("PrewarmStories: File not found: %s (Base: %s)"), *BackgroundFile, *StoryBaseDir);
+					}
+				}
+
+				if (CultureNames.Num() > 0)
+				{
+					Result->StringTable = FShortStoryStringTable::LoadForStory(LocDir, CultureNames, StoryFileName);
+				}
 			}
-			return true;
-		}
-	};
 
-	FGenericRecursiveVisitor Visitor(StoryFiles, StoriesDir);
-	PlatformFile.IterateDirectoryRecursively(*StoriesDir, Visitor);
+			FScopeLock Lock(&Job->ResultsMutex);
+			Job->Results.Add(MoveTemp(Result));
+		}, UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
 
-	UE_LOG(LogShortStory, Log, TEXT("GetAvailableStories: Found %d story files in %s"), StoryFiles.Num(), *StoriesDir);
+	const int32 NumAssets = AssetPaths.Num();
+	if (NumAssets > 0)
+	{
+		RequestPrewarmAssets(MoveTemp(AssetPaths));
+	}
 
-	return StoryFiles;
-}
+	PrewarmTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UShortStorySubsystem::TickPrewarm)
+	);
 
-bool UShortStorySubsystem::IsStoryCached(const FString& StoryFileName) const
-{
-	FScopeLock Lock(&CacheMutex);
-	return CachedStories.Contains(StoryFileName.ToLower());
+	UE_LOG(LogShortStory, Log, TEXT("PrewarmStories: Prewarming '%s' (%d stories to parse, %d translations, %d background assets)"),
+		*Manifest->GetName(), ToParse.Num(), ToTranslate.Num(), NumAssets);
+
+	return true;
 }
 
-void UShortStorySubsystem::ClearCachedStory(const FString& StoryFileName)
+void UShortStorySubsystem::CancelPrewarm()
 {
-	FScopeLock Lock(&CacheMutex);
-	if (CachedStories.Remove(StoryFileName.ToLower()) > 0)
+	if (!PrewarmJob.IsValid())
 	{
-		UE_LOG(LogShortStory, Log, TEXT("ClearCachedStory: Cleared '%s' from cache"), *StoryFileName);
+		return;
 	}
-}
 
-void UShortStorySubsystem::ClearAllCachedStories()
-{
-	FScopeLock Lock(&CacheMutex);
-	int32 Count = CachedStories.Num();
-	CachedStories.Empty();
-	UE_LOG(LogShortStory, Log, TEXT("ClearAllCachedStories: Cleared %d stories from cache"), Count);
+	if (PrewarmTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PrewarmTickerHandle);
+		PrewarmTickerHandle.Reset();
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("CancelPrewarm: Prewarm cancelled (%d of %d stories cached)"), PrewarmJob->NumStoriesDone, PrewarmJob->NumStories);
+	FinishPrewarm(true);
 }
 
-FString UShortStorySubsystem::GetStoryFilePath(const FString& StoryFileName) const
+bool UShortStorySubsystem::IsPrewarming() const
 {
-	return FPaths::Combine(GetStoriesDirectory(), StoryFileName);
+	return PrewarmJob.IsValid();
 }
 
-FString UShortStorySubsystem::GetStoriesDirectory() const
+float UShortStorySubsystem::GetPrewarmProgress() const
 {
-	// Try project content directory first
-	FString ProjectStoriesDir = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Stories"));
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-
-	if (PlatformFile.DirectoryExists(*ProjectStoriesDir))
+	if (!PrewarmJob.IsValid())
 	{
-		UE_LOG(LogShortStory, Log, TEXT("Using project Stories directory: %s"), *ProjectStoriesDir);
-		return ProjectStoriesDir;
+		return 1.0f;
 	}
 
-	// Fallback to plugin content directory
-	IPluginManager& PluginManager = IPluginManager::Get();
-	TSharedPtr<IPlugin> Plugin = PluginManager.FindPlugin(TEXT("ShortStory"));
-	if (Plugin.IsValid())
+	// Each story and each asset load request weighs the same
+	float Done = static_cast<float>(PrewarmJob->NumStoriesDone);
+	float Total = static_cast<float>(PrewarmJob->NumStories);
+	for (const TSharedPtr<FStreamableHandle>& Handle : PrewarmJob->AssetHandles)
 	{
-		FString PluginStoriesDir = FPaths::Combine(Plugin->GetContentDir(), TEXT("Stories"));
+		Done += Handle->GetProgress();
+		Total += 1.0f;
+	}
+
+	return Total > 0.0f ? Done / Total : 1.0f;
+}
+
+bool UShortStorySubsystem::TickPrewarm(float DeltaTime)
+{
+	if (!PrewarmJob.IsValid())
+	{
+		PrewarmTickerHandle.Reset();
+		return false;
+	}
+
+	TArray<TUniquePtr<FStoryPrewarmJob::FResult>> Results;
+	{
+		FScopeLock Lock(&PrewarmJob->ResultsMutex);
+		Results = MoveTemp(PrewarmJob->Results);
+		PrewarmJob->Results.Reset();
+	}
+
+	// Tables loaded for a culture switched away from since are dropped
+	const bool bSameCulture = PrewarmJob->Culture.Equals(StoryCulture, ESearchCase::IgnoreCase);
+
+	for (TUniquePtr<FStoryPrewarmJob::FResult>& Result : Results)
+	{
+		++PrewarmJob->NumStoriesDone;
+
+		if (Result->bTranslationOnly)
+		{
+			// The story may have left the cache since
+			const FShortStory* Cached = StoryCache.Find(Result->StoryFileName);
+			if (Cached && bSameCulture)
+			{
+				AddStoryTranslation(Result->StoryFileName, *Cached, Result->StringTable.Get());
+			}
+			continue;
+		}
+
+		if (!Result->bParsed)
+		{
+			UE_LOG(LogShortStory, Error, TEXT("PrewarmStories: Failed to parse '%s'"), *Result->StoryFileName);
+			for (const FStoryParseDiagnostic& Diagnostic : Result->Diagnostics)
+			{
+				UE_LOG(LogShortStory, Error, TEXT("  - [%s] %s"), *Diagnostic.Code.ToString(), *Diagnostic.ToString());
+			}
+			continue;
+		}
+
+		// LoadStory got there first
+		if (const FShortStory* Cached = StoryCache.Find(Result->StoryFileName))
+		{
+			if (bSameCulture)
+			{
+				AddStoryTranslation(Result->StoryFileName, *Cached, Result->StringTable.Get());
+			}
+			continue;
+		}
+
+		if (Result->Diagnostics.Num() > 0)
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("PrewarmStories: Parsed '%s' with %d problems"), *Result->StoryFileName, Result->Diagnostics.Num());
+			for (const FStoryParseDiagnostic& Diagnostic : Result->Diagnostics)
+			{
+				UE_LOG(LogShortStory, Warning, TEXT("  - [%s] %s"), *Diagnostic.Code.ToString(), *Diagnostic.ToString());
+			}
+		}
+
+		FShortStory& Story = Result->Story;
+		TArray<FSoftObjectPath> AssetPaths;
+		for (int32 ScreenIndex = 0; ScreenIndex < Story.Screens.Num(); ++ScreenIndex)
+		{
+			FStoryScreen& Screen = Story.Screens[ScreenIndex];
+			if (Result->Backgrounds.IsValidIndex(ScreenIndex) && Result->Backgrounds[ScreenIndex].IsValid())
+			{
+				Screen.RuntimeTexture = CreateBackgroundTexture(Result->Backgrounds[ScreenIndex], Screen.BackgroundPath);
+			}
+			else if (!Screen.Background.IsNull())
+			{
+				AssetPaths.AddUnique(Screen.Background.ToSoftObjectPath());
+			}
+		}
+		AddStoryAudioPaths(Story, AssetPaths);
+		OnGatherPrewarmAssets.Broadcast(Story, AssetPaths);
+
+		if (AssetPaths.Num() > 0)
+		{
+			RequestPrewarmAssets(MoveTemp(AssetPaths));
+		}
+
+		CacheParsedStory(Result->StoryFileName, Story);
+		if (bSameCulture)
+		{
+			AddStoryTranslation(Result->StoryFileName, Story, Result->StringTable.Get());
+		}
+		UE_LOG(LogShortStory, Log, TEXT("PrewarmStories: Cached '%s' (%d screens)"), *Result->StoryFileName, Story.Screens.Num());
+	}
+
+	if (PrewarmJob->NumStoriesDone < PrewarmJob->NumStories)
+	{
+		return true;
+	}
+
+	for (const TSharedPtr<FStreamableHandle>& Handle : PrewarmJob->AssetHandles)
+	{
+		if (!Handle->HasLoadCompleted() && !Handle->WasCanceled())
+		{
+			return true;
+		}
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("PrewarmStories: Finished (%d stories, %d asset requests)"), PrewarmJob->NumStories, PrewarmJob->AssetHandles.Num());
+
+	// Returning false removes the ticker
+	PrewarmTickerHandle.Reset();
+	FinishPrewarm(false);
+	return false;
+}
+
+void UShortStorySubsystem::RequestPrewarmAssets(TArray<FSoftObjectPath> AssetPaths)
+{
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AssetPaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	if (Handle.IsValid())
+	{
+		PrewarmJob->AssetHandles.Add(Handle);
+	}
+}
+
+void UShortStorySubsystem::FinishPrewarm(bool bCancelled)
+{
+	TSharedPtr<FStoryPrewarmJob, ESPMode::ThreadSafe> Job = MoveTemp(PrewarmJob);
+	PrewarmJob.Reset();
+
+	if (bCancelled)
+	{
+		// Workers still running see the flag and drop their work; the job is freed with the last of them
+		Job->bCancelled = true;
+		for (const TSharedPtr<FStreamableHandle>& Handle : Job->AssetHandles)
+		{
+			Handle->CancelHandle();
+		}
+	}
+	else
+	{
+		// The new handles hold shared assets already, so the previous prewarm's can go without a reload
+		for (const TSharedPtr<FStreamableHandle>& Handle : PrewarmedAssetHandles)
+		{
+			Handle->ReleaseHandle();
+		}
+		PrewarmedAssetHandles = MoveTemp(Job->AssetHandles);
+	}
+
+	OnPrewarmCompleted.Broadcast(bCancelled);
+}
+
+const FShortStory* UShortStorySubsystem::FindLoadedStory(FName StoryId) const
+{
+	check(IsInGameThread());
+
+	if (StoryId.IsNone())
+	{
+		return nullptr;
+	}
+
+	// FName comparison is case-insensitive, like the cache keys
+	if (StoryId == CurrentStoryId && CurrentStory.Screens.Num() > 0)
+	{
+		return &CurrentStory;
+	}
+
+	// Name is built on the stack, so a cache hit never allocates
+	TStringBuilder<FName::StringBufferSize> StoryName;
+	StoryId.AppendString(StoryName);
+
+	// Stories shown in another culture are read from their translation
+	bool bLookedUp = false;
+	if (const FShortStory* Translated = StoryCache.FindTranslation(StoryName.ToView(), StoryCulture, bLookedUp))
+	{
+		return Translated;
+	}
+	return StoryCache.Find(StoryName.ToView());
+}
+
+TArray<FString> UShortStorySubsystem::GetAvailableStories()
+{
+	TArray<FString> StoryFiles;
+
+	FString StoriesDir = GetStoriesDirectory();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Check if directory exists
+	if (!PlatformFile.DirectoryExists(*StoriesDir))
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("GetAvailableStories: Stories directory does not exist: %s"), *StoriesDir);
+		return StoryFiles;
+	}
+
+	// Ensure trailing separator for MakePathRelativeTo
+	if (!StoriesDir.EndsWith(TEXT("/")))
+	{
+		StoriesDir += TEXT("/");
+	}
+
+	// Recursive visitor
+	class FGenericRecursiveVisitor : public IPlatformFile::FDirectoryVisitor
+	{
+	public:
+		TArray<FString>& Files;
+		FString RootDir;
+
+		FGenericRecursiveVisitor(TArray<FString>& InFiles, const FString& InRootDir)
+			: Files(InFiles), RootDir(InRootDir) {}
+
+		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
+		{
+			if (bIsDirectory)
+			{
+				return true; // Continue recursion
+			}
+
+			FString Filename = FPaths::GetCleanFilename(FilenameOrDirectory);
+			if (Filename.EndsWith(TEXT(".tos"), ESearchCase::IgnoreCase))
+			{
+				// We want path relative to StoriesDir
+				FString FullPath = FilenameOrDirectory;
+				FString RelativePath = FullPath;
+				FPaths::MakePathRelativeTo(RelativePath, *RootDir);
+				Files.Add(RelativePath);
+			}
+			return true;
+		}
+	};
+
+	FGenericRecursiveVisitor Visitor(StoryFiles, StoriesDir);
+	PlatformFile.IterateDirectoryRecursively(*StoriesDir, Visitor);
+
+	UE_LOG(LogShortStory, Log, TEXT("GetAvailableStories: Found %d story files in %s"), StoryFiles.Num(), *StoriesDir);
+
+	return StoryFiles;
+}
+
+bool UShortStorySubsystem::IsStoryCached(const FString& StoryFileName) const
+{
+	return StoryCache.Contains(StoryFileName);
+}
+
+void UShortStorySubsystem::ClearCachedStory(const FString& StoryFileName)
+{
+	if (FShortStoryCache::FStoryPtr Removed = StoryCache.Remove(StoryFileName))
+	{
+		ReleaseStoryTextures(*Removed);
+		UpdateCacheStats();
+		UE_LOG(LogShortStory, Log, TEXT("ClearCachedStory: Cleared '%s' from cache"), *StoryFileName);
+	}
+}
+
+void UShortStorySubsystem::ClearAllCachedStories()
+{
+	const TArray<FShortStoryCache::FStoryRef> Removed = StoryCache.Empty();
+	for (const FShortStoryCache::FStoryRef& Story : Removed)
+	{
+		ReleaseStoryTextures(*Story);
+	}
+	UpdateCacheStats();
+	UE_LOG(LogShortStory, Log, TEXT("ClearAllCachedStories: Cleared %d stories from cache"), Removed.Num());
+}
+
+int64 UShortStorySubsystem::GetCacheBudgetBytes() const
+{
+	return CacheBudgetMB > 0 ? static_cast<int64>(CacheBudgetMB) * 1024 * 1024 : 0;
+}
+
+void UShortStorySubsystem::EnforceCacheBudget(const FString& JustLoaded)
+{
+	const int64 BudgetBytes = GetCacheBudgetBytes();
+	if (BudgetBytes > 0)
+	{
+		// The story being loaded and the one on screen always stay, even if they alone exceed the budget
+		TArray<uint64, TInlineAllocator<2>> ProtectedKeys;
+		ProtectedKeys.Add(FShortStoryCache::HashKey(JustLoaded));
+		if (bIsPlaying && !CurrentStoryId.IsNone())
+		{
+			TStringBuilder<FName::StringBufferSize> CurrentName;
+			CurrentStoryId.AppendString(CurrentName);
+			ProtectedKeys.Add(FShortStoryCache::HashKey(CurrentName.ToView()));
+		}
+
+		const TArray<FShortStoryCache::FStoryRef> Evicted = StoryCache.Trim(BudgetBytes, ProtectedKeys);
+		for (const FShortStoryCache::FStoryRef& Story : Evicted)
+		{
+			UE_LOG(LogShortStory, Log, TEXT("EnforceCacheBudget: Evicted '%s' (cache over %d MB budget)"), *Story->SourceFileName, CacheBudgetMB);
+			ReleaseStoryTextures(*Story);
+		}
+	}
+
+	UpdateCacheStats();
+}
+
+void UShortStorySubsystem::ReleaseStoryTextures(const FShortStory& Story)
+{
+	for (const FStoryScreen& Screen : Story.Screens)
+	{
+		UTexture2D* Texture = Screen.RuntimeTexture;
+		if (!Texture)
+		{
+			continue;
+		}
+
+		// CurrentStory holds raw pointers to the cached textures, so those must stay rooted until it is replaced
+		const bool bUsedByCurrentStory = CurrentStory.Screens.ContainsByPredicate([Texture](const FStoryScreen& CurrentScreen)
+		{
+			return CurrentScreen.RuntimeTexture == Texture;
+		});
+
+		if (bUsedByCurrentStory)
+		{
+			DeferredTextureReleases.AddUnique(Texture);
+		}
+		else
+		{
+			Texture->RemoveFromRoot();
+		}
+	}
+}
+
+void UShortStorySubsystem::ReleaseDeferredTextures(const FShortStory& NextStory)
+{
+	for (int32 i = DeferredTextureReleases.Num() - 1; i >= 0; --i)
+	{
+		UTexture2D* Texture = DeferredTextureReleases[i];
+		const bool bStillUsed = NextStory.Screens.ContainsByPredicate([Texture](const FStoryScreen& Screen)
+		{
+			return Screen.RuntimeTexture == Texture;
+		});
+
+		if (!bStillUsed)
+		{
+			Texture->RemoveFromRoot();
+			DeferredTextureReleases.RemoveAtSwap(i);
+		}
+	}
+}
+
+void UShortStorySubsystem::UpdateCacheStats()
+{
+	const FShortStoryCache::FStats Stats = StoryCache.GetStats();
+	SET_DWORD_STAT(STAT_ShortStory_CachedStories, Stats.NumStories);
+	SET_MEMORY_STAT(STAT_ShortStory_CacheTextMemory, Stats.TextBytes);
+	SET_MEMORY_STAT(STAT_ShortStory_CacheTextureMemory, Stats.TextureBytes);
+	SET_DWORD_STAT(STAT_ShortStory_CacheEvictions, Stats.NumEvictions);
+}
+
+FString UShortStorySubsystem::GetStoryFilePath(const FString& StoryFileName) const
+{
+	return FPaths::Combine(GetStoriesDirectory(), StoryFileName);
+}
+
+FString UShortStorySubsystem::GetStoriesDirectory() const
+{
+	// Try project content directory first
+	FString ProjectStoriesDir = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Stories"));
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (PlatformFile.DirectoryExists(*ProjectStoriesDir))
+	{
+		UE_LOG(LogShortStory, Log, TEXT("Using project Stories directory: %s"), *ProjectStoriesDir);
+		return ProjectStoriesDir;
+	}
+
+	// Fallback to plugin content directory
+	IPluginManager& PluginManager = IPluginManager::Get();
+	TSharedPtr<IPlugin> Plugin = PluginManager.FindPlugin(TEXT("ShortStory"));
+	if (Plugin.IsValid())
+	{
+		FString PluginStoriesDir = FPaths::Combine(Plugin->GetContentDir(), TEXT("Stories"));
 		UE_LOG(LogShortStory, Log, TEXT("Using plugin Stories directory: %s"), *PluginStoriesDir);
 		return PluginStoriesDir;
 	}
 
-	// Last resort: return project directory even if it doesn't exist yet
-	UE_LOG(LogShortStory, Warning, TEXT("Stories directory not found, defaulting to project content directory"));
-	return ProjectStoriesDir;
+	// Last resort: return project directory even if it doesn't exist yet
+	UE_LOG(LogShortStory, Warning, TEXT("Stories directory not found, defaulting to project content directory"));
+	return ProjectStoriesDir;
+}
+
+FString UShortStorySubsystem::GetConfigDirectory() const
+{
+	return FPaths::Combine(GetStoriesDirectory(), TEXT("Config"));
+}
+
+FString UShortStorySubsystem::GetLocDirectory() const
+{
+	return FPaths::Combine(GetStoriesDirectory(), TEXT("Loc"));
+}
+
+// ========================================
+// Localisation
+// ========================================
+
+namespace
+{
+	/** Last displayed line wrapped from the same source line as FirstLine (lines of one source line share its id; spacers have none) */
+	int32 GetSourceLineEnd(const TArray<FStoryLine>& Lines, int32 FirstLine)
+	{
+		const int32 LineId = Lines[FirstLine].LineId;
+		int32 LastLine = FirstLine;
+		while (LineId != 0 && LastLine + 1 < Lines.Num() && Lines[LastLine + 1].LineId == LineId)
+		{
+			++LastLine;
+		}
+		return LastLine;
+	}
+
+	/** First displayed line of a source line, by its index among the screen's source lines (the last one if out of range) */
+	int32 GetSourceLineStart(const TArray<FStoryLine>& Lines, int32 SourceLineIndex)
+	{
+		int32 FirstLine = 0;
+		for (int32 Index = 0; Index < SourceLineIndex; ++Index)
+		{
+			const int32 NextLine = GetSourceLineEnd(Lines, FirstLine) + 1;
+			if (NextLine >= Lines.Num())
+			{
+				break;
+			}
+			FirstLine = NextLine;
+		}
+		return FirstLine;
+	}
+
+	/** Share of a source line's reveal reached at a time on its run's clock (0 = not started, 1 = fully shown) */
+	float GetSourceLineProgress(const FStoryScreen& Screen, int32 FirstLine, int32 LastLine, float RunTime)
+	{
+		const FStoryLineSegment& LastSegment = Screen.Segments[Screen.LineSegmentIndices[LastLine]];
+		const float Start = Screen.LineRunOffsets[FirstLine];
+		const float End = LastSegment.RunOffset + LastSegment.Duration;
+		return End > Start ? FMath::Clamp((RunTime - Start) / (End - Start), 0.0f, 1.0f) : 1.0f;
+	}
+
+	/** Time on its run's clock at which a source line has revealed a share of itself */
+	float GetSourceLineRunTime(const FStoryScreen& Screen, int32 FirstLine, int32 LastLine, float Progress)
+	{
+		const FStoryLineSegment& LastSegment = Screen.Segments[Screen.LineSegmentIndices[LastLine]];
+		const float Start = Screen.LineRunOffsets[FirstLine];
+		const float End = FMath::Max(Start, LastSegment.RunOffset + LastSegment.Duration);
+		return FMath::Lerp(Start, End, Progress);
+	}
+
+	/** Index among the screen's source lines of the one a displayed line was wrapped from */
+	int32 GetSourceLineIndex(const TArray<FStoryLine>& Lines, int32 LineIndex)
+	{
+		int32 SourceLineIndex = 0;
+		for (int32 FirstLine = 0; FirstLine < Lines.Num(); ++SourceLineIndex)
+		{
+			const int32 LastLine = GetSourceLineEnd(Lines, FirstLine);
+			if (LineIndex <= LastLine)
+			{
+				break;
+			}
+			FirstLine = LastLine + 1;
+		}
+		return SourceLineIndex;
+	}
+}
+
+/** Tables loaded off the game thread for stories started, or switched culture, without a prewarm */
+struct FStoryTranslationLoads
+{
+	struct FResult
+	{
+		FString StoryFileName;
+
+		/** Culture the table was loaded for */
+		FString Culture;
+
+		/** Table (null when the story has no translation) */
+		TSharedPtr<FShortStoryStringTable> StringTable;
+	};
+
+	/** Loaded tables waiting for the game thread */
+	FCriticalSection ResultsMutex;
+	TArray<FResult> Results;
+};
+
+void UShortStorySubsystem::HandleCultureChanged()
+{
+	SetStoryCulture(FInternationalization::Get().GetCurrentCulture()->GetName());
+}
+
+void UShortStorySubsystem::SetStoryCulture(const FString& Culture)
+{
+	// The source culture (and its regional variants) reads straight from the parsed story
+	const bool bIsSource = Culture.IsEmpty() || Culture.Equals(SourceCulture, ESearchCase::IgnoreCase)
+		|| Culture.StartsWith(SourceCulture + TEXT("-"), ESearchCase::IgnoreCase);
+	const FString NewCulture = bIsSource ? FString() : Culture;
+
+	if (NewCulture.Equals(StoryCulture, ESearchCase::IgnoreCase))
+	{
+		return;
+	}
+
+	StoryCulture = NewCulture;
+
+	// Translations are rebuilt for the new culture: the current story's as soon as its table loads, the others when prewarmed or started.
+	// Tables still loading for the previous culture are dropped when they arrive
+	StoryCache.ClearTranslations();
+	PendingTranslations.Empty();
+	UpdateCacheStats();
+	RefreshCurrentStoryText();
+
+	UE_LOG(LogShortStory, Log, TEXT("SetStoryCulture: Story text culture is now '%s'"),
+		StoryCulture.IsEmpty() ? *SourceCulture : *StoryCulture);
+}
+
+void UShortStorySubsystem::RequestStoryTranslation(const FString& StoryFileName)
+{
+	bool bLookedUp = false;
+	StoryCache.FindTranslation(StoryFileName, StoryCulture, bLookedUp);
+	if (StoryCulture.IsEmpty() || bLookedUp || PendingTranslations.Contains(StoryFileName))
+	{
+		return;
+	}
+
+	if (!TranslationLoads.IsValid())
+	{
+		TranslationLoads = MakeShared<FStoryTranslationLoads, ESPMode::ThreadSafe>();
+	}
+	PendingTranslations.Add(StoryFileName);
+
+	// File checks, CSV compiles and the table mapping all happen on the worker; most specific culture first (en-US, then en)
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Loads = TranslationLoads, StoryFileName, Culture = StoryCulture, LocDir = GetLocDirectory(),
+		CultureNames = FInternationalization::Get().GetPrioritizedCultureNames(StoryCulture)]()
+	{
+		FStoryTranslationLoads::FResult Result;
+		Result.StoryFileName = StoryFileName;
+		Result.Culture = Culture;
+		Result.StringTable = FShortStoryStringTable::LoadForStory(LocDir, CultureNames, StoryFileName);
+
+		FScopeLock Lock(&Loads->ResultsMutex);
+		Loads->Results.Add(MoveTemp(Result));
+	}, UE::Tasks::ETaskPriority::BackgroundHigh);
+
+	if (!TranslationTickerHandle.IsValid())
+	{
+		TranslationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UShortStorySubsystem::TickTranslationLoads)
+		);
+	}
+}
+
+bool UShortStorySubsystem::TickTranslationLoads(float DeltaTime)
+{
+	TArray<FStoryTranslationLoads::FResult> Results;
+	{
+		FScopeLock Lock(&TranslationLoads->ResultsMutex);
+		Results = MoveTemp(TranslationLoads->Results);
+		TranslationLoads->Results.Reset();
+	}
+
+	for (FStoryTranslationLoads::FResult& Result : Results)
+	{
+		// Tables loaded for a culture switched away from since are dropped
+		if (!Result.Culture.Equals(StoryCulture, ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+		PendingTranslations.Remove(Result.StoryFileName);
+
+		// The story may have left the cache since; the playing one is still held here
+		const FShortStory* Source = StoryCache.Find(Result.StoryFileName);
+		if (!Source && CurrentSourceStory.IsValid() && FName(*Result.StoryFileName) == CurrentStoryId)
+		{
+			Source = CurrentSourceStory.Get();
+		}
+
+		if (Source)
+		{
+			AddStoryTranslation(Result.StoryFileName, *Source, Result.StringTable.Get());
+		}
+	}
+
+	if (PendingTranslations.Num() > 0)
+	{
+		return true;
+	}
+
+	// Returning false removes the ticker
+	TranslationTickerHandle.Reset();
+	return false;
+}
+
+void UShortStorySubsystem::AddStoryTranslation(const FString& StoryFileName, const FShortStory& Story, const FShortStoryStringTable* Table)
+{
+	bool bLookedUp = false;
+	StoryCache.FindTranslation(StoryFileName, StoryCulture, bLookedUp);
+	if (StoryCulture.IsEmpty() || bLookedUp)
+	{
+		return;
+	}
+
+	// The table is only read here; playback and its getters use the baked copy
+	TSharedPtr<FShortStory, ESPMode::ThreadSafe> Translation;
+	int32 NumTranslated = 0;
+	if (Table)
+	{
+		Translation = MakeShared<FShortStory, ESPMode::ThreadSafe>(Story);
+		for (FStoryScreen& Screen : Translation->Screens)
+		{
+			NumTranslated += TranslateScreen(Screen, *Table);
+		}
+	}
+
+	if (NumTranslated == 0)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("AddStoryTranslation: No '%s' translation for '%s', using source text"), *StoryCulture, *StoryFileName);
+		Translation.Reset();
+	}
+	else
+	{
+		UE_LOG(LogShortStory, Log, TEXT("AddStoryTranslation: Translated %d source lines of '%s' to '%s'"), NumTranslated, *StoryFileName, *StoryCulture);
+	}
+
+	// Misses are remembered too, so untranslated stories never touch the disk again; the translation counts against the budget
+	if (StoryCache.SetTranslation(StoryFileName, StoryCulture, Translation))
+	{
+		EnforceCacheBudget(StoryFileName);
+	}
+
+	// A story already on screen switches to its new text where it is
+	if (CurrentSourceStory.IsValid() && FName(*StoryFileName) == CurrentStoryId)
+	{
+		ApplyCurrentStoryText(Translation.IsValid() ? *Translation : *CurrentSourceStory);
+	}
+}
+
+int32 UShortStorySubsystem::TranslateScreen(FStoryScreen& Screen, const FShortStoryStringTable& Table) const
+{
+	TArray<FStoryLine> Lines;
+	Lines.Reserve(Screen.Lines.Num());
+	int32 NumTranslated = 0;
+
+	for (int32 FirstLine = 0; FirstLine < Screen.Lines.Num(); )
+	{
+		const int32 LastLine = GetSourceLineEnd(Screen.Lines, FirstLine);
+		const FStoryLine& SourceLine = Screen.Lines[FirstLine];
+
+		FString Translation;
+		if (SourceLine.LineId != 0 && Table.FindString(SourceLine.LineId, Translation) && !Translation.TrimStartAndEnd().IsEmpty())
+		{
+			// The whole source line is replaced: its translation is wrapped and its markup parsed like source text,
+			// and the last segment keeps the source line's pause
+			const int32 FirstNewLine = Lines.Num();
+			UShortStoryParser::ProcessTextToLines(Translation, SourceLine, Screen.Lines[LastLine].PauseDuration, Lines, MaxLineLength);
+			for (int32 i = FirstNewLine; i < Lines.Num(); ++i)
+			{
+				FStoryLine& Line = Lines[i];
+				BuildRevealTimeline(Line, GetLineTiming(Line), Line.Timeline);
+			}
+			++NumTranslated;
+		}
+		else
+		{
+			Lines.Append(Screen.Lines.GetData() + FirstLine, LastLine - FirstLine + 1);
+		}
+
+		FirstLine = LastLine + 1;
+	}
+
+	if (NumTranslated > 0)
+	{
+		Screen.Lines = MoveTemp(Lines);
+		BakeScreenSchedule(Screen);
+	}
+	return NumTranslated;
 }
 
-FString UShortStorySubsystem::GetConfigDirectory() const
+void UShortStorySubsystem::RefreshCurrentStoryText()
 {
-	return FPaths::Combine(GetStoriesDirectory(), TEXT("Config"));
+	if (CurrentStoryId.IsNone() || !CurrentSourceStory.IsValid())
+	{
+		return;
+	}
+
+	if (StoryCulture.IsEmpty())
+	{
+		ApplyCurrentStoryText(*CurrentSourceStory);
+		return;
+	}
+
+	// The current text stays up until the new culture's table has loaded
+	const FString StoryFileName = CurrentStoryId.ToString();
+	bool bLookedUp = false;
+	const FShortStory* Translated = StoryCache.FindTranslation(StoryFileName, StoryCulture, bLookedUp);
+	if (bLookedUp)
+	{
+		ApplyCurrentStoryText(Translated ? *Translated : *CurrentSourceStory);
+	}
+	else
+	{
+		RequestStoryTranslation(StoryFileName);
+	}
+}
+
+void UShortStorySubsystem::ApplyCurrentStoryText(const FShortStory& Display)
+{
+	if (Display.Screens.Num() != CurrentStory.Screens.Num())
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("ApplyCurrentStoryText: '%s' changed since it started, keeping its current text"), *CurrentStoryId.ToString());
+		return;
+	}
+
+	// Playback stays on the same source line; lines are counted the same way in every culture
+	const bool bRemap = bIsPlaying && CurrentStory.Screens.IsValidIndex(CurrentScreenIndex)
+		&& CurrentStory.Screens[CurrentScreenIndex].Segments.IsValidIndex(CurrentSegmentIndex)
+		&& (CurrentState == EStoryPlaybackState::PlayingLine || CurrentState == EStoryPlaybackState::PausingAfterLine);
+	int32 SourceLineIndex = 0;
+	float SourceLineProgress = 0.0f;
+	bool bSourceLineShown = false;
+	if (bRemap)
+	{
+		const FStoryScreen& OldScreen = CurrentStory.Screens[CurrentScreenIndex];
+		const FStoryLineSegment& OldSegment = OldScreen.Segments[CurrentSegmentIndex];
+		const bool bPausing = CurrentState == EStoryPlaybackState::PausingAfterLine;
+
+		// Position on the run's clock, and the line of the segment it has reached (blocks hold several)
+		const float RunTime = OldSegment.RunOffset + (bPausing ? OldSegment.Duration + PauseElapsedTime : LineElapsedTime);
+		int32 LineIndex = OldSegment.FirstLine;
+		while (LineIndex < OldSegment.LastLine && OldScreen.LineRunOffsets[LineIndex + 1] <= RunTime)
+		{
+			++LineIndex;
+		}
+
+		SourceLineIndex = GetSourceLineIndex(OldScreen.Lines, LineIndex);
+		const int32 FirstLine = GetSourceLineStart(OldScreen.Lines, SourceLineIndex);
+		const int32 LastLine = GetSourceLineEnd(OldScreen.Lines, FirstLine);
+		bSourceLineShown = bPausing && OldSegment.LastLine == LastLine;
+		SourceLineProgress = GetSourceLineProgress(OldScreen, FirstLine, LastLine, RunTime);
+	}
+
+	// Only the text and its schedule change; the current story keeps its textures
+	for (int32 ScreenIndex = 0; ScreenIndex < CurrentStory.Screens.Num(); ++ScreenIndex)
+	{
+		const FStoryScreen& From = Display.Screens[ScreenIndex];
+		FStoryScreen& To = CurrentStory.Screens[ScreenIndex];
+		To.Lines = From.Lines;
+		To.Segments = From.Segments;
+		To.LineSegmentIndices = From.LineSegmentIndices;
+		To.LineRunOffsets = From.LineRunOffsets;
+		To.NumRuns = From.NumRuns;
+		To.SourceLineStarts = From.SourceLineStarts;
+	}
+	EnsureLineParametersCapacity();
+
+	if (!bRemap)
+	{
+		return;
+	}
+
+	const FStoryScreen& Screen = CurrentStory.Screens[CurrentScreenIndex];
+	if (Screen.Lines.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 FirstLine = GetSourceLineStart(Screen.Lines, SourceLineIndex);
+	const int32 LastLine = GetSourceLineEnd(Screen.Lines, FirstLine);
+
+	RunStartTimes.SetNum(Screen.NumRuns);
+	if (bSourceLineShown)
+	{
+		// The pause after the line keeps running, behind the line in its new text
+		CurrentSegmentIndex = Screen.LineSegmentIndices[LastLine];
+		const FStoryLineSegment& Segment = Screen.Segments[CurrentSegmentIndex];
+		CurrentLineIndex = Segment.LastLine;
+		LineDuration = Segment.Duration;
+		RunStartTimes[Segment.RunIndex] = ScreenElapsedTime - PauseElapsedTime - Segment.Duration - Segment.RunOffset;
+	}
+	else
+	{
+		// The line keeps its progress: the same share of its reveal, in its new text. Landing between two
+		// wrapped parts resumes at the end of the first, whose pause then runs again
+		const float RunTime = GetSourceLineRunTime(Screen, FirstLine, LastLine, SourceLineProgress);
+		int32 SegmentIndex = Screen.LineSegmentIndices[FirstLine];
+		while (SegmentIndex < Screen.LineSegmentIndices[LastLine] && Screen.Segments[SegmentIndex + 1].RunOffset <= RunTime)
+		{
+			++SegmentIndex;
+		}
+
+		const FStoryLineSegment& Segment = Screen.Segments[SegmentIndex];
+		CurrentSegmentIndex = SegmentIndex;
+		CurrentLineIndex = Segment.LastLine;
+		LineDuration = Segment.Duration;
+		LineElapsedTime = FMath::Clamp(RunTime - Segment.RunOffset, 0.0f, Segment.Duration);
+		RunStartTimes[Segment.RunIndex] = ScreenElapsedTime - Segment.RunOffset - LineElapsedTime;
+		bIsWaitingForInput = false;
+		CurrentState = EStoryPlaybackState::PlayingLine;
+	}
+
+	// Earlier runs end before now, however long their new text takes to reveal
+	const int32 CurrentRun = Screen.Segments[CurrentSegmentIndex].RunIndex;
+	for (const FStoryLineSegment& Segment : Screen.Segments)
+	{
+		if (Segment.RunIndex < CurrentRun && RunStartTimes[Segment.RunIndex] >= 0.0f)
+		{
+			RunStartTimes[Segment.RunIndex] = FMath::Min(RunStartTimes[Segment.RunIndex], ScreenElapsedTime - Segment.RunOffset - Segment.Duration);
+		}
+	}
+
+	UpdateLineParameters();
+	NotifyClockChanged(EStoryClockChange::Jumped);
+
+	// A sleeping story wakes to reschedule around its new line lengths
+	WakePlayback();
+}
+
+bool UShortStorySubsystem::ExportStoryStrings(const FString& StoryFileName, FString& OutPath)
+{
+	// Parsed again for the raw text: cached lines are wrapped and their markup is stripped
+	FShortStory Story;
+	TArray<FStoryParseDiagnostic> Diagnostics;
+	TArray<FStorySourceString> SourceStrings;
+	if (!UShortStoryParser::ParseStoryFile(GetStoryFilePath(StoryFileName), Story, Diagnostics, MaxLineLength, &SourceStrings))
+	{
+		UE_LOG(LogShortStory, Error, TEXT("ExportStoryStrings: Failed to parse '%s'"), *StoryFileName);
+		return false;
+	}
+
+	// One row per source text line; translators keep the id and replace the text, markup and '\\' breaks included
+	FString Csv = TEXT("Id,Text\n");
+	TSet<int32> SeenIds;
+	int32 LastScreenIndex = INDEX_NONE;
+	for (const FStorySourceString& SourceString : SourceStrings)
+	{
+		const FString& ScreenName = Story.Screens[SourceString.ScreenIndex].Name;
+		if (SourceString.ScreenIndex != LastScreenIndex)
+		{
+			LastScreenIndex = SourceString.ScreenIndex;
+			Csv += FString::Printf(TEXT("# %s\n"), *ScreenName);
+		}
+
+		bool bAlreadySeen = false;
+		SeenIds.Add(SourceString.LineId, &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("ExportStoryStrings: Duplicate line id %d in '%s' screen %s (give one of the lines an id=)"),
+				SourceString.LineId, *StoryFileName, *ScreenName);
+			continue;
+		}
+
+		Csv += FString::Printf(TEXT("%d,\"%s\"\n"), SourceString.LineId, *SourceString.Text.Replace(TEXT("\""), TEXT("\"\"")));
+	}
+
+	OutPath = FPaths::Combine(GetLocDirectory(), SourceCulture, FPaths::ChangeExtension(StoryFileName, TEXT("csv")));
+	if (!FFileHelper::SaveStringToFile(Csv, *OutPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogShortStory, Error, TEXT("ExportStoryStrings: Failed to write '%s'"), *OutPath);
+		return false;
+	}
+
+	UE_LOG(LogShortStory, Log, TEXT("ExportStoryStrings: Wrote %d lines to '%s'"), SeenIds.Num(), *OutPath);
+	return true;
 }
 
 // ========================================
@@ -486,7 +1647,7 @@ void UShortStorySubsystem::LoadTimingConfigs()
 	}
 
 	// Helper lambda to load speed config
-	auto LoadSpeedConfig = [&](EStorySpeed Speed, const FString& FileName)
+	auto LoadSpeedConfig = [&](const FString& FileName, FStoryAnimationTiming& OutTiming)
 	{
 		FString FilePath = FPaths::Combine(ConfigDir, FileName);
 		TArray<FString> Lines;
@@ -522,92 +1683,354 @@ void UShortStorySubsystem::LoadTimingConfigs()
 			else if (Name == TEXT("BlockDuration")) Timing.BlockDuration = Value;
 		}
 
-		SpeedTimings.Add(Speed, Timing);
+		OutTiming = Timing;
 		UE_LOG(LogShortStory, Log, TEXT("Loaded %s: PerLetter=%.3f, ExtraAtSpace=%.3f, ExtraAtPeriod=%.3f, ExtraAtComma=%.3f, ExtraAtColon=%.3f"),
 			*FileName, Timing.PerLetter, Timing.ExtraAtSpace, Timing.ExtraAtPeriod, Timing.ExtraAtComma, Timing.ExtraAtColon);
 		return true;
 	};
 
-	// Load all speed configs
-	LoadSpeedConfig(EStorySpeed::Standard, TEXT("Speed_Standard.csv"));
-	LoadSpeedConfig(EStorySpeed::Fast, TEXT("Speed_Fast.csv"));
-	LoadSpeedConfig(EStorySpeed::Slow, TEXT("Speed_Slow.csv"));
+	// Helper lambda to register a profile under its name
+	auto AddSpeedProfile = [&](FName ProfileName, const FStoryAnimationTiming& Timing)
+	{
+		const uint8 ProfileId = static_cast<uint8>(SpeedProfiles.Add(Timing));
+		SpeedProfileIds.Add(ProfileName, ProfileId);
+	};
+
+	SpeedProfiles.Reset();
+	SpeedProfileIds.Reset();
+
+	// Built-in speeds first so that SpeedProfileId == (uint8)EStorySpeed for them
+	const TCHAR* BuiltInSpeeds[] = { TEXT("Standard"), TEXT("Fast"), TEXT("Slow") };
+	for (const TCHAR* SpeedName : BuiltInSpeeds)
+	{
+		FStoryAnimationTiming Timing;
+		LoadSpeedConfig(FString::Printf(TEXT("Speed_%s.csv"), SpeedName), Timing);
+		AddSpeedProfile(FName(SpeedName), Timing);
+	}
+
+	// Custom profiles: any other Speed_<Name>.csv in the config directory
+	TArray<FString> SpeedFiles;
+	IFileManager::Get().FindFiles(SpeedFiles, *FPaths::Combine(ConfigDir, TEXT("Speed_*.csv")), true, false);
+	SpeedFiles.Sort();
+
+	for (const FString& SpeedFile : SpeedFiles)
+	{
+		const FName ProfileName(*FPaths::GetBaseFilename(SpeedFile).RightChop(6)); // Strip "Speed_"
+		if (ProfileName.IsNone() || SpeedProfileIds.Contains(ProfileName))
+		{
+			continue;
+		}
+
+		if (SpeedProfiles.Num() > MAX_uint8)
+		{
+			ShowError(FString::Printf(TEXT("Too many speed profiles, ignoring %s"), *SpeedFile));
+			break;
+		}
+
+		FStoryAnimationTiming Timing;
+		if (LoadSpeedConfig(SpeedFile, Timing))
+		{
+			AddSpeedProfile(ProfileName, Timing);
+		}
+	}
 
 	bTimingConfigsLoaded = true;
-	UE_LOG(LogShortStory, Log, TEXT("Timing configuration loaded: %d speeds, %d pauses"), 
-		SpeedTimings.Num(), PauseDurations.Num());
+	UE_LOG(LogShortStory, Log, TEXT("Timing configuration loaded: %d speed profiles, %d pauses"), 
+		SpeedProfiles.Num(), PauseDurations.Num());
 }
 
 FStoryAnimationTiming UShortStorySubsystem::GetSpeedTiming(EStorySpeed Speed) const
 {
-	if (const FStoryAnimationTiming* Found = SpeedTimings.Find(Speed))
+	// Built-in speeds occupy the first profile slots in enum order
+	const int32 ProfileId = static_cast<int32>(Speed);
+	if (SpeedProfiles.IsValidIndex(ProfileId))
 	{
-		return *Found;
+		return SpeedProfiles[ProfileId];
 	}
 	// Return Standard if not found (shouldn't happen if configs loaded)
-	if (const FStoryAnimationTiming* Standard = SpeedTimings.Find(EStorySpeed::Standard))
+	if (SpeedProfiles.Num() > 0)
 	{
-		return *Standard;
+		return SpeedProfiles[0];
 	}
 	return FStoryAnimationTiming();
 }
 
-float UShortStorySubsystem::GetPauseDuration(EStoryPauseDuration PauseType) const
+FStoryAnimationTiming UShortStorySubsystem::GetSpeedProfileTiming(FName ProfileName, bool& bFound) const
+{
+	if (const uint8* ProfileId = SpeedProfileIds.Find(ProfileName))
+	{
+		bFound = true;
+		return SpeedProfiles[*ProfileId];
+	}
+
+	bFound = false;
+	return GetSpeedTiming(EStorySpeed::Standard);
+}
+
+TArray<FName> UShortStorySubsystem::GetSpeedProfileNames() const
+{
+	TArray<FName> Names;
+	Names.SetNum(SpeedProfiles.Num());
+	for (const TPair<FName, uint8>& Pair : SpeedProfileIds)
+	{
+		Names[Pair.Value] = Pair.Key;
+	}
+	return Names;
+}
+
+FStoryAnimationTiming UShortStorySubsystem::GetLineTiming(const FStoryLine& Line) const
+{
+	FStoryAnimationTiming Timing;
+	if (Line.Timeline.bIsBaked && SpeedProfiles.IsValidIndex(Line.SpeedProfileId))
+	{
+		Timing = SpeedProfiles[Line.SpeedProfileId];
+	}
+	else if (const uint8* ProfileId = SpeedProfileIds.Find(Line.SpeedProfile))
+	{
+		Timing = SpeedProfiles[*ProfileId];
+	}
+	else
+	{
+		Timing = GetSpeedTiming(Line.Speed);
+	}
+
+	if (Line.PerLetterOverride > 0.0f)
+	{
+		Timing.PerLetter = Line.PerLetterOverride;
+	}
+	return Timing;
+}
+
+void UShortStorySubsystem::BakeStoryTimelines(FShortStory& Story) const
+{
+	// Resolve the story default once
+	const uint8* DefaultProfileId = nullptr;
+	if (!Story.DefaultSpeedProfile.IsNone())
+	{
+		DefaultProfileId = SpeedProfileIds.Find(Story.DefaultSpeedProfile);
+		if (!DefaultProfileId)
+		{
+			UE_LOG(LogShortStory, Warning, TEXT("BakeStoryTimelines: Unknown story speed profile '%s' in '%s' (no Speed_%s.csv), using line speeds"),
+				*Story.DefaultSpeedProfile.ToString(), *Story.SourceFileName, *Story.DefaultSpeedProfile.ToString());
+		}
+	}
+
+	for (FStoryScreen& Screen : Story.Screens)
+	{
+		for (FStoryLine& Line : Screen.Lines)
+		{
+			// Resolve the compact profile id: explicit profile > story default > Speed enum
+			uint8 ProfileId = static_cast<uint8>(Line.Speed);
+			if (!Line.SpeedProfile.IsNone())
+			{
+				if (const uint8* Found = SpeedProfileIds.Find(Line.SpeedProfile))
+				{
+					ProfileId = *Found;
+				}
+				else
+				{
+					UE_LOG(LogShortStory, Warning, TEXT("BakeStoryTimelines: Unknown speed profile '%s' in '%s' screen %s, using %s"),
+						*Line.SpeedProfile.ToString(), *Story.SourceFileName, *Screen.Name, *UEnum::GetValueAsString(Line.Speed));
+				}
+			}
+			else if (DefaultProfileId)
+			{
+				ProfileId = *DefaultProfileId;
+			}
+
+			Line.SpeedProfileId = SpeedProfiles.IsValidIndex(ProfileId) ? ProfileId : 0;
+			Line.Timeline.bIsBaked = true;
+
+			const FStoryAnimationTiming Timing = GetLineTiming(Line);
+
+			BuildRevealTimeline(Line, Timing, Line.Timeline);
+		}
+
+		// Playback walks timed events with a cursor, so they must be in time order
+		Algo::StableSortBy(Screen.TimedEvents, &FStoryTimedEvent::StartTime);
+
+		BakeScreenSchedule(Screen);
+	}
+}
+
+void UShortStorySubsystem::BakeScreenSchedule(FStoryScreen& Screen) const
+{
+	const int32 NumLines = Screen.Lines.Num();
+	Screen.Segments.Reset();
+	Screen.LineSegmentIndices.SetNumUninitialized(NumLines);
+	Screen.LineRunOffsets.SetNumUninitialized(NumLines);
+
+	int32 RunIndex = 0;
+	float RunTime = 0.0f;
+
+	for (int32 FirstLine = 0; FirstLine < NumLines; )
+	{
+		const FStoryLine& Line = Screen.Lines[FirstLine];
+
+		// A block (TopDown or Paragraph) is the run of consecutive lines sharing its animation type
+		const bool bIsBlockAnimation = (Line.AnimationType == EStoryLineAnimation::Paragraph || Line.AnimationType == EStoryLineAnimation::TopDown);
+		int32 LastLine = FirstLine;
+		if (bIsBlockAnimation)
+		{
+			while (LastLine + 1 < NumLines && Screen.Lines[LastLine + 1].AnimationType == Line.AnimationType)
+			{
+				++LastLine;
+			}
+		}
+
+		const int32 SegmentIndex = Screen.Segments.Num();
+		FStoryLineSegment& Segment = Screen.Segments.AddDefaulted_GetRef();
+		Segment.FirstLine = FirstLine;
+		Segment.LastLine = LastLine;
+		Segment.RunIndex = RunIndex;
+		Segment.RunOffset = RunTime;
+
+		if (bIsBlockAnimation)
+		{
+			// TopDown lines start one cascade delay apart; each finish time includes the delay before the next line
+			float CurrentDelay = 0.0f;
+			float MaxFinishTime = 0.0f;
+			for (int32 i = FirstLine; i <= LastLine; ++i)
+			{
+				Screen.LineSegmentIndices[i] = SegmentIndex;
+				Screen.LineRunOffsets[i] = RunTime + CurrentDelay;
+
+				if (Line.AnimationType == EStoryLineAnimation::TopDown)
+				{
+					CurrentDelay += TopDownCascadeDelay;
+				}
+
+				MaxFinishTime = FMath::Max(MaxFinishTime, CurrentDelay + CalculateLineDuration(Screen.Lines[i]));
+			}
+			Segment.Duration = MaxFinishTime;
+		}
+		else
+		{
+			Screen.LineSegmentIndices[FirstLine] = SegmentIndex;
+			Screen.LineRunOffsets[FirstLine] = RunTime;
+			Segment.Duration = GetLineTypewriterDuration(Line);
+		}
+
+		// The last line of a segment carries the real pause
+		const EStoryPauseDuration Pause = Screen.Lines[LastLine].PauseDuration;
+		Segment.bEndsInWait = (Pause == EStoryPauseDuration::Wait);
+		Segment.PauseAfter = Segment.bEndsInWait ? 0.0f : GetPauseDuration(Pause);
+
+		if (Segment.bEndsInWait)
+		{
+			// Input decides when the next run starts
+			++RunIndex;
+			RunTime = 0.0f;
+		}
+		else
+		{
+			RunTime += Segment.Duration + Segment.PauseAfter;
+		}
+
+		FirstLine = LastLine + 1;
+	}
+
+	Screen.NumRuns = Screen.Segments.Num() > 0 ? Screen.Segments.Last().RunIndex + 1 : 0;
+
+	// Skip targets, back to front: the next Wait, or the last segment of the screen
+	int32 NextStableSegment = Screen.Segments.Num() - 1;
+	for (int32 i = Screen.Segments.Num() - 1; i >= 0; --i)
+	{
+		if (Screen.Segments[i].bEndsInWait)
+		{
+			NextStableSegment = i;
+		}
+		Screen.Segments[i].NextStableSegment = NextStableSegment;
+	}
+
+	// Source lines name a line the same way in every culture (used by the history)
+	Screen.SourceLineStarts.Reset();
+	for (int32 FirstLine = 0; FirstLine < NumLines; FirstLine = GetSourceLineEnd(Screen.Lines, FirstLine) + 1)
+	{
+		Screen.SourceLineStarts.Add(FirstLine);
+	}
+}
+
+float UShortStorySubsystem::GetPauseDuration(EStoryPauseDuration PauseType) const
+{
+	// Both LineBreak and None use the configurable LineBreakPercent
+	if (PauseType == EStoryPauseDuration::LineBreak || PauseType == EStoryPauseDuration::None)
+	{
+		return FadeWindowSeconds * LineBreakPercent;
+	}
+
+	if (const float* Found = PauseDurations.Find(PauseType))
+	{
+		return *Found;
+	}
+	return 0.0f;
+}
+
+float UShortStorySubsystem::CalculateTypewriterDuration(const FString& Text, EStorySpeed Speed) const
+{
+	FStoryAnimationTiming Timing = GetSpeedTiming(Speed);
+	float Total = 0.0f;
+
+	for (TCHAR Char : Text)
+	{
+		Total += Timing.PerLetter + GetCharacterExtraDelay(Char, Timing);
+	}
+
+	return Total;
+}
+
+float UShortStorySubsystem::GetLineTypewriterDuration(const FStoryLine& Line) const
+{
+	if (Line.Timeline.bIsBaked)
+	{
+		return Line.Timeline.TypewriterDuration;
+	}
+
+	// Line was built at runtime (e.g. from Blueprint) - compute on the fly
+	const FStoryAnimationTiming Timing = GetLineTiming(Line);
+	float Total = 0.0f;
+	for (TCHAR Char : Line.Text)
+	{
+		Total += Timing.PerLetter + GetCharacterExtraDelay(Char, Timing);
+	}
+	for (const FStoryInlineWait& InlineWait : Line.InlineWaits)
+	{
+		Total += InlineWait.Duration;
+	}
+	return Total;
+}
+
+float UShortStorySubsystem::GetTypewriterProgressAtTime(const FStoryLine& Line, float Time) const
 {
-	// Both LineBreak and None use the configurable LineBreakPercent
-	if (PauseType == EStoryPauseDuration::LineBreak || PauseType == EStoryPauseDuration::None)
+	const int32 NumChars = Line.Text.Len();
+	if (NumChars == 0)
 	{
-		return FadeWindowSeconds * LineBreakPercent;
+		return 1.0f;
 	}
 
-	if (const float* Found = PauseDurations.Find(PauseType))
+	if (!Line.Timeline.bIsBaked)
 	{
-		return *Found;
+		// Runtime-built line: plain time-based interpolation
+		const float Duration = GetLineTypewriterDuration(Line);
+		return (Duration > 0.0f) ? FMath::Clamp(Time / Duration, 0.0f, 1.0f) : 1.0f;
 	}
-	return 0.0f;
-}
 
-float UShortStorySubsystem::CalculateTypewriterDuration(const FString& Text, EStorySpeed Speed) const
-{
-	FStoryAnimationTiming Timing = GetSpeedTiming(Speed);
-	float Total = 0.0f;
-
-	for (TCHAR Char : Text)
+	// Whole glyphs revealed so far, plus the fraction of the one currently being typed
+	const TArray<float>& RevealTimes = Line.Timeline.CharRevealTimes;
+	const int32 Revealed = Algo::UpperBound(RevealTimes, Time);
+	if (Revealed >= NumChars)
 	{
-		Total += Timing.PerLetter;
+		return 1.0f;
+	}
 
-		if (FChar::IsWhitespace(Char))
-		{
-			Total += Timing.ExtraAtSpace;
-		}
-		else if (Char == TEXT('.') || Char == TEXT('!') || Char == TEXT('?'))
-		{
-			Total += Timing.ExtraAtPeriod;
-		}
-		else if (Char == TEXT(','))
-		{
-			Total += Timing.ExtraAtComma;
-		}
-		else if (Char == TEXT(';') || Char == TEXT(':'))
-		{
-			// Semicolon treated as colon for now? Or comma?
-			// Previous logic had : and ; with comma. 
-			// Let's keep ; with comma or move to colon?
-			// Users request was specifically about Colon. 
-			// Original code: else if (Char == TEXT(',') || Char == TEXT(';') || Char == TEXT(':')) { ... ExtraAtComma }
-			// New logic: Colon has own timing.
-			if (Char == TEXT(':'))
-			{
-				Total += Timing.ExtraAtColon;
-			}
-			else
-			{
-				Total += Timing.ExtraAtComma;
-			}
-		}
+	float Fraction = 0.0f;
+	if (Line.Timeline.PerLetter > 0.0f)
+	{
+		const float TypingStart = RevealTimes[Revealed] - Line.Timeline.PerLetter;
+		Fraction = FMath::Clamp((Time - TypingStart) / Line.Timeline.PerLetter, 0.0f, 1.0f);
 	}
 
-	return Total;
+	return (Revealed + Fraction) / NumChars;
 }
 
 float UShortStorySubsystem::CalculateLineDuration(const FStoryLine& Line) const
@@ -616,12 +2039,11 @@ float UShortStorySubsystem::CalculateLineDuration(const FStoryLine& Line) const
 	// These use the fixed 'BlockDuration' defined in Speed config.
 	if (Line.AnimationType != EStoryLineAnimation::Typewriter)
 	{
-		FStoryAnimationTiming Timing = GetSpeedTiming(Line.Speed);
-		return Timing.BlockDuration;
+		return Line.Timeline.bIsBaked ? Line.Timeline.BlockDuration : GetLineTiming(Line).BlockDuration;
 	}
 
 	// Typewriter behavior uses per-character timing
-	return CalculateTypewriterDuration(Line.Text, Line.Speed);
+	return GetLineTypewriterDuration(Line);
 }
 
 EStorySpeed UShortStorySubsystem::GetSpeedForAnimation(EStoryLineAnimation AnimType)
@@ -645,61 +2067,32 @@ int32 UShortStorySubsystem::GetCharacterIndexAtTime(const FString& Text, EStoryS
 		return 0;
 	}
 
-	FStoryAnimationTiming Timing = GetSpeedTiming(Speed);
-	float CurrentTime = 0.0f;
-	int32 TotalChars = Text.Len();
-
-	for (int32 i = 0; i < TotalChars; ++i)
-	{
-		TCHAR Char = Text[i];
-		float TypeTime = Timing.PerLetter;
-		float ExtraTime = 0.0f;
+	// Strip the markup so inline waits delay the reveal exactly like they do on a parsed line
+	FStoryLine Line;
+	Line.Speed = Speed;
+	FStoryMarkupState MarkupState;
+	UShortStoryParser::ParseInlineMarkup(Text, Line, MarkupState);
 
-		if (FChar::IsWhitespace(Char))
-		{
-			ExtraTime = Timing.ExtraAtSpace;
-		}
-		else if (Char == TEXT('.') || Char == TEXT('!') || Char == TEXT('?'))
-		{
-			ExtraTime = Timing.ExtraAtPeriod;
-		}
-		else if (Char == TEXT(','))
-		{
-			ExtraTime = Timing.ExtraAtComma;
-		}
-		else if (Char == TEXT(';') || Char == TEXT(':'))
-		{
-			if (Char == TEXT(':'))
-			{
-				ExtraTime = Timing.ExtraAtColon;
-			}
-			else
-			{
-				ExtraTime = Timing.ExtraAtComma;
-			}
-		}
+	return GetCharacterIndexAtTime(Line, Time);
+}
 
-		// Phase 1: Typing the character (Hidden)
-		if (Time < CurrentTime + TypeTime)
-		{
-			// Still "typing" this character, it hasn't appeared yet
-			return i;
-		}
-		CurrentTime += TypeTime;
+int32 UShortStorySubsystem::GetCharacterIndexAtTime(const FStoryLine& Line, float Time) const
+{
+	if (Time <= 0.0f)
+	{
+		return 0;
+	}
 
-		// Phase 2: Extra pause after character (Visible)
-		if (Time < CurrentTime + ExtraTime)
-		{
-			// Character is typed and we are waiting in the "heavy pause"
-			// So this character (i) should be visible
-			return i + 1;
-		}
-		CurrentTime += ExtraTime;
+	if (!Line.Timeline.bIsBaked)
+	{
+		// Line was built at runtime (e.g. from Blueprint) - build the same timeline the loader would have baked
+		FStoryRevealTimeline Timeline;
+		BuildRevealTimeline(Line, GetLineTiming(Line), Timeline);
+		return Algo::UpperBound(Timeline.CharRevealTimes, Time);
 	}
 
-	// Time exceeds total duration, return end of string + 1? Or just length?
-	// Progress calculation uses TotalLength, so returning Len is appropriate for "100%"
-	return TotalChars;
+	// Reveal times are sorted, so the visible count is the number of entries <= Time
+	return Algo::UpperBound(Line.Timeline.CharRevealTimes, Time);
 }
 
 // ========================================
@@ -730,16 +2123,48 @@ bool UShortStorySubsystem::StartStory(const FString& StoryFileName)
 		return false;
 	}
 
+	// Textures of a story that left the cache while on screen can go once it is replaced
+	ReleaseDeferredTextures(LoadedStory);
+
+	// The prewarm builds translations off the game thread; a story it missed starts in source text and switches when its table loads
+	bool bLookedUp = false;
+	const FShortStory* Translated = StoryCache.FindTranslation(StoryFileName, StoryCulture, bLookedUp);
+
+	// The cached source is shared, so culture switches read it without reloading the story
+	CurrentSourceStory = StoryCache.FindShared(StoryFileName);
+	if (!CurrentSourceStory.IsValid())
+	{
+		CurrentSourceStory = MakeShared<FShortStory, ESPMode::ThreadSafe>(LoadedStory);
+	}
+
 	// Initialize playback state
-	CurrentStory = LoadedStory;
+	CurrentStory = Translated ? *Translated : LoadedStory;
+	CurrentStoryId = FName(*StoryFileName);
 	CurrentScreenIndex = 0;
 	CurrentLineIndex = 0;
 	ScreenElapsedTime = 0.0f;
-	ProcessedTimedEventIndices.Empty();
-	LineStartTimes.Init(-1.0f, CurrentStory.Screens[0].Lines.Num());
+	NextTimedEventIndex = 0;
+	CurrentSegmentIndex = INDEX_NONE;
+	RunStartTimes.Init(-1.0f, CurrentStory.Screens[0].NumRuns);
+	CarriedAdvanceTime = 0.0f;
 	bIsPlaying = true;
 	bIsPaused = false;
+	bWaitingForBackground = false;
+	bSkipHeldForBackground = false;
+	ScreenBackgroundHandle.Reset();
 	CurrentState = EStoryPlaybackState::PlayingLine;
+	PlaybackClockTime = FApp::GetCurrentTime();
+
+	// The previous story may have been asleep; the new one ticks from its first frame
+	if (bIsSleeping)
+	{
+		bIsSleeping = false;
+		if (TickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			TickerHandle.Reset();
+		}
+	}
 
 	// Register ticker if not already registered
 	if (!TickerHandle.IsValid())
@@ -749,12 +2174,24 @@ bool UShortStorySubsystem::StartStory(const FString& StoryFileName)
 		);
 	}
 
+	// Size the packed line parameter buffer for the largest screen
+	EnsureLineParametersCapacity();
+
 	// Start playing first line
 	StartLine(0);
+	UpdateLineParameters();
 
 	UE_LOG(LogShortStory, Log, TEXT("StartStory: Started story '%s' with %d screens"),
 		*StoryFileName, CurrentStory.Screens.Num());
 
+	if (!StoryCulture.IsEmpty() && !bLookedUp)
+	{
+		UE_LOG(LogShortStory, Log, TEXT("StartStory: '%s' was not prewarmed for '%s', loading its translation"), *StoryFileName, *StoryCulture);
+		RequestStoryTranslation(StoryFileName);
+	}
+
+	NotifyClockChanged(EStoryClockChange::Started);
+
 	return true;
 }
 
@@ -774,10 +2211,20 @@ void UShortStorySubsystem::StopStory()
 	ScreenElapsedTime = 0.0f;
 	LineElapsedTime = 0.0f;
 	PauseElapsedTime = 0.0f;
-	ProcessedTimedEventIndices.Empty();
-	LineStartTimes.Empty();
-
-	// Unregister ticker
+	NextTimedEventIndex = 0;
+	CurrentSegmentIndex = INDEX_NONE;
+	RunStartTimes.Empty();
+	CarriedAdvanceTime = 0.0f;
+	bIsFastForwarding = false;
+	bIsSleeping = false;
+	bWaitingForBackground = false;
+	bSkipHeldForBackground = false;
+	ScreenBackgroundHandle.Reset();
+
+	// Clear the packed parameters so widgets reading the texture hide all lines
+	UpdateLineParameters();
+
+	// Unregister ticker (per-frame or wake-up)
 	if (TickerHandle.IsValid())
 	{
 		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
@@ -785,17 +2232,29 @@ void UShortStorySubsystem::StopStory()
 	}
 
 	UE_LOG(LogShortStory, Log, TEXT("StopStory: Story stopped"));
+
+	NotifyClockChanged(EStoryClockChange::Stopped);
 }
 
 void UShortStorySubsystem::SetPaused(bool bPause)
 {
+	WakePlayback();
+
 	if (!bIsPlaying)
 	{
 		return;
 	}
 
+	if (bIsPaused == bPause)
+	{
+		return;
+	}
+
 	bIsPaused = bPause;
+	PlaybackClockTime = FApp::GetCurrentTime();
 	UE_LOG(LogShortStory, Log, TEXT("SetPaused: Playback %s"), bPause ? TEXT("paused") : TEXT("resumed"));
+
+	NotifyClockChanged(EStoryClockChange::RateChanged);
 }
 
 FStoryLine UShortStorySubsystem::GetCurrentLine() const
@@ -874,132 +2333,486 @@ FStoryScreenState UShortStorySubsystem::GetCurrentScreenState() const
 		FStoryLineState LineState;
 
 		LineState.FullText = SourceLine.Text;
+		LineState.Spans = SourceLine.Spans;
 		LineState.AnimationType = SourceLine.AnimationType;
 		LineState.Effect = SourceLine.Effect;
 		LineState.PositionOffset = SourceLine.PositionOffset;
 
 		// Calculate local time for this line if it has started
-		float LineStartTime = -1.0f;
-		if (LineStartTimes.IsValidIndex(i))
-		{
-			LineStartTime = LineStartTimes[i];
-		}
+		const float LineStartTime = GetLineStartTime(i);
 
 		// If line has started (time >= 0), calculate progress
 		if (LineStartTime >= 0.0f)
 		{
-			float LocalLineTime = ScreenElapsedTime - LineStartTime;
-			// We can't easily access the original duration here without recalculating or storing it.
-			// Re-calculating duration for every frame/line might be slightly expensive but acceptable.
-			// Alternatively, since we used LineDuration member for the *Current* line, we might rely on that?
-			// But that changes as we advance. 
-			// Let's recalculate helper.
-			// Calculate duration using new helper
-			float ThisLineDuration = CalculateLineDuration(SourceLine);
-			
-			float Progress = (ThisLineDuration > 0.0f) ? (LocalLineTime / ThisLineDuration) : 1.0f;
-			Progress = FMath::Clamp(Progress, 0.0f, 1.0f);
+			const float LocalLineTime = ScreenElapsedTime - LineStartTime;
+			ComputeLineProgress(SourceLine, LocalLineTime, LineState.AnimationProgress, LineState.CurrentTextProgress, LineState.PastTextProgress);
+
+			LineState.bIsAnimating = (LineState.AnimationProgress < 1.0f); // Roughly accurate
+			LineState.bIsFullyVisible = (LineState.AnimationProgress >= 1.0f);
+
+			// Glyph count from the baked timeline (markup is already stripped, inline waits included)
+			LineState.VisibleCharacters = (SourceLine.AnimationType == EStoryLineAnimation::Typewriter)
+				? GetCharacterIndexAtTime(SourceLine, LocalLineTime)
+				: SourceLine.Text.Len();
+		}
+		else
+		{
+			// Not started yet
+			LineState.AnimationProgress = 0.0f;
+			LineState.CurrentTextProgress = 0.0f;
+			LineState.PastTextProgress = 0.0f;
+			LineState.bIsFullyVisible = false;
+			LineState.bIsAnimating = false;
+		}
+
+		State.Lines.Add(LineState);
+	}
+
+	return State;
+}
+
+
+
+void UShortStorySubsystem::ComputeLineProgress(const FStoryLine& Line, float LocalLineTime, float& OutAnimationProgress, float& OutCurrentProgress, float& OutPastProgress) const
+{
+	// Duration comes from the timeline baked at load time (constant cost per line)
+	const float ThisLineDuration = CalculateLineDuration(Line);
+
+	OutAnimationProgress = (ThisLineDuration > 0.0f) ? FMath::Clamp(LocalLineTime / ThisLineDuration, 0.0f, 1.0f) : 1.0f;
+
+	if (Line.Text.IsEmpty() || ThisLineDuration <= 0.0f)
+	{
+		OutCurrentProgress = 1.0f;
+		OutPastProgress = 1.0f;
+	}
+	else if (Line.AnimationType == EStoryLineAnimation::Typewriter && Line.Timeline.bIsBaked)
+	{
+		// Glyph-accurate progress from the baked timeline: holds during punctuation delays and inline waits
+		OutCurrentProgress = GetTypewriterProgressAtTime(Line, LocalLineTime);
+
+		// Past progress trails by FadeWindow and catches up to 1.0 after the line finishes
+		const float PastTime = LocalLineTime - FadeWindowSeconds;
+		OutPastProgress = (PastTime >= ThisLineDuration) ? 1.0f : GetTypewriterProgressAtTime(Line, PastTime);
+	}
+	else
+	{
+		// Smooth interpolation: progress is based on time elapsed vs total duration
+		// This treats pauses as "character weight" rather than discrete stops
+		OutCurrentProgress = FMath::Clamp(LocalLineTime / ThisLineDuration, 0.0f, 1.0f);
+
+		// Past progress uses absolute time (LocalLineTime - FadeWindow) / Duration
+		// This allows PastProgress to "catch up" to 1.0 after the line finishes
+		const float PastTime = LocalLineTime - FadeWindowSeconds;
+		OutPastProgress = FMath::Clamp(PastTime / ThisLineDuration, 0.0f, 1.0f);
+	}
+}
+
+// ========================================
+// Packed Line Parameters
+// ========================================
+
+void UShortStorySubsystem::EnsureLineParametersCapacity()
+{
+	int32 MaxLines = 1;
+	for (const FStoryScreen& Screen : CurrentStory.Screens)
+	{
+		MaxLines = FMath::Max(MaxLines, Screen.Lines.Num());
+	}
+
+	if (MaxLines > PackedLineParameters.Num())
+	{
+		// Only ever grow: the texture is shared by every widget reading it
+		PackedLineParameters.SetNumZeroed(MaxLines);
+		LastUploadedLineParameters.Reset();
+
+		if (FApp::CanEverRender())
+		{
+			LineParametersTexture = UTexture2D::CreateTransient(MaxLines, 1, PF_A32B32G32R32F, TEXT("ShortStoryLineParameters"));
+			if (LineParametersTexture)
+			{
+				LineParametersTexture->Filter = TF_Nearest;
+				LineParametersTexture->SRGB = false;
+				LineParametersTexture->AddressX = TA_Clamp;
+				LineParametersTexture->AddressY = TA_Clamp;
+				LineParametersTexture->UpdateResource();
+			}
+		}
+
+		UE_LOG(LogShortStory, Verbose, TEXT("EnsureLineParametersCapacity: Line parameter buffer sized for %d lines"), MaxLines);
+	}
+}
+
+void UShortStorySubsystem::UpdateLineParameters()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShortStory_UpdateLineParams);
+
+	// Pack every line of the current screen: R = current progress, G = past progress, B = animation progress, A = started
+	FMemory::Memzero(PackedLineParameters.GetData(), PackedLineParameters.Num() * sizeof(FLinearColor));
+
+	if (bIsPlaying && CurrentStory.Screens.IsValidIndex(CurrentScreenIndex))
+	{
+		const FStoryScreen& CurrentScreen = CurrentStory.Screens[CurrentScreenIndex];
+		const int32 NumLines = FMath::Min(CurrentScreen.Lines.Num(), PackedLineParameters.Num());
+
+		for (int32 i = 0; i < NumLines; ++i)
+		{
+			const float LineStartTime = GetLineStartTime(i);
+			if (LineStartTime < 0.0f)
+			{
+				continue;
+			}
+
+			FLinearColor& Packed = PackedLineParameters[i];
+			ComputeLineProgress(CurrentScreen.Lines[i], ScreenElapsedTime - LineStartTime, Packed.B, Packed.R, Packed.G);
+			Packed.A = 1.0f;
+		}
+	}
+
+	if (!LineParametersTexture)
+	{
+		// No renderer (-nullrhi, dedicated server): the CPU buffer is still valid for inspection
+		return;
+	}
+
+	// Skip the upload when nothing moved (paused, waiting for input, fully revealed screens)
+	if (LastUploadedLineParameters == PackedLineParameters)
+	{
+		return;
+	}
+	LastUploadedLineParameters = PackedLineParameters;
+
+	// One region upload per frame; the render thread owns the copies until the update completes
+	const int32 Width = PackedLineParameters.Num();
+	const uint32 DataSize = Width * sizeof(FLinearColor);
+	uint8* UploadData = static_cast<uint8*>(FMemory::Malloc(DataSize));
+	FMemory::Memcpy(UploadData, PackedLineParameters.GetData(), DataSize);
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Width, 1);
+	LineParametersTexture->UpdateTextureRegions(0, 1, Region, DataSize, sizeof(FLinearColor), UploadData,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			FMemory::Free(SrcData);
+			delete Regions;
+		});
+}
+
+bool UShortStorySubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShortStory_Tick);
+
+	if (!bIsPlaying)
+	{
+		return true; // Keep ticking
+	}
+
+	if (bIsPaused)
+	{
+		// Debug jumps can still change the screen while paused (they wake the ticker first)
+		UpdateLineParameters();
+	}
+	else
+	{
+		AdvancePlayback(DeltaTime);
+	}
+
+	// Nothing changes until the next timed event, state end or input: stop ticking until then
+	if (bSleepWhenIdle && bIsPlaying)
+	{
+		const float IdleTime = GetIdlePlaybackTime();
+		if (IdleTime >= MinSleepSeconds)
+		{
+			SleepPlayback(IdleTime);
+			return false;
+		}
+	}
+
+	return true; // Keep ticking
+}
 
-			LineState.AnimationProgress = Progress;
-			LineState.bIsAnimating = (Progress < 1.0f); // Roughly accurate
-			LineState.bIsFullyVisible = (Progress >= 1.0f);
+void UShortStorySubsystem::AdvancePlayback(float DeltaTime)
+{
+	// Time left over after a state ends carries into the next state, so hitches and
+	// fast-forward advance through several lines in one tick without drifting.
+	// Kept in a member so GetScreenTime stays exact for listeners called mid-advance.
+	PlaybackClockTime = FApp::GetCurrentTime();
+	AdvanceRemainingTime = (bIsFastForwarding ? DeltaTime * FastForwardTimeScale : DeltaTime) + CarriedAdvanceTime;
+	CarriedAdvanceTime = 0.0f;
 
+	int32 Transitions = 0;
+	while (AdvanceRemainingTime > 0.0f && bIsPlaying && Transitions < MaxTransitionsPerTick)
+	{
+		switch (CurrentState)
+		{
+			case EStoryPlaybackState::PlayingLine:
+			{
+				const float StepTime = FMath::Min(AdvanceRemainingTime, FMath::Max(LineDuration - LineElapsedTime, 0.0f));
+				LineElapsedTime += StepTime;
+				ScreenElapsedTime += StepTime;
+				AdvanceRemainingTime -= StepTime;
+				ProcessTimedEvents();
 
+				if (LineElapsedTime >= LineDuration)
+				{
+					// Line animation complete
+					StartPause();
+					++Transitions;
+				}
+				break;
+			}
 
-			if (SourceLine.Text.IsEmpty())
+			case EStoryPlaybackState::PausingAfterLine:
 			{
-				LineState.CurrentTextProgress = 1.0f;
-				LineState.PastTextProgress = 1.0f;
+				if (bIsWaitingForInput && bIsFastForwarding && bFastForwardContinuesWaits)
+				{
+					bIsWaitingForInput = false;
+					AdvanceToNextLineOrScreen();
+					++Transitions;
+					break;
+				}
+
+				if (bIsWaitingForInput && PauseDuration <= 0.0f)
+				{
+					// Wait pauses without a configured duration only end on input;
+					// the screen clock keeps running for timed events
+					ScreenElapsedTime += AdvanceRemainingTime;
+					AdvanceRemainingTime = 0.0f;
+					ProcessTimedEvents();
+					break;
+				}
+
+				// A Wait with a configured duration times out like a timed pause (input can still end it first)
+				const float StepTime = FMath::Min(AdvanceRemainingTime, FMath::Max(PauseDuration - PauseElapsedTime, 0.0f));
+				PauseElapsedTime += StepTime;
+				ScreenElapsedTime += StepTime;
+				AdvanceRemainingTime -= StepTime;
+				ProcessTimedEvents();
+
+				if (PauseElapsedTime >= PauseDuration)
+				{
+					if (bIsWaitingForInput)
+					{
+						UE_LOG(LogShortStory, Log, TEXT("AdvancePlayback: Wait timed out after %.1fs"), PauseDuration);
+						bIsWaitingForInput = false;
+					}
+
+					// Pause complete, advance to next line or screen
+					AdvanceToNextLineOrScreen();
+					++Transitions;
+				}
+				break;
 			}
-			else
+
+			case EStoryPlaybackState::TransitioningScreen:
 			{
-				// Smooth interpolation: progress is based on time elapsed vs total duration
-				// This treats pauses as "character weight" rather than discrete stops
-				LineState.CurrentTextProgress = FMath::Clamp(LocalLineTime / ThisLineDuration, 0.0f, 1.0f);
-				
-				// Past progress uses absolute time (LocalLineTime - FadeWindow) / Duration
-				// This allows PastProgress to "catch up" to 1.0 after the line finishes
-				float PastTime = LocalLineTime - FadeWindowSeconds;
-				LineState.PastTextProgress = FMath::Clamp(PastTime / ThisLineDuration, 0.0f, 1.0f);
+				if (bWaitingForBackground)
+				{
+					// The transition (and the screen clock) only starts once the incoming background can be drawn
+					AdvanceRemainingTime = 0.0f;
+					BackgroundWaitTime += DeltaTime;
+
+					const bool bReady = IsScreenBackgroundReady(CurrentScreenIndex);
+					if (bReady || BackgroundWaitTime >= MaxBackgroundWaitSeconds)
+					{
+						if (!bReady)
+						{
+							UE_LOG(LogShortStory, Warning, TEXT("AdvancePlayback: Background of screen %d not ready after %.1fs, starting the transition anyway"),
+								CurrentScreenIndex, BackgroundWaitTime);
+						}
+						bWaitingForBackground = false;
+						NotifyClockChanged(EStoryClockChange::RateChanged);
+
+						// A skip requested while the background streamed in goes ahead now
+						if (bSkipHeldForBackground)
+						{
+							bSkipHeldForBackground = false;
+							SkipToNextStablePoint(HeldSkipEventPolicy);
+						}
+					}
+					break;
+				}
+
+				// Wait for screen transition pause
+				const float StepTime = FMath::Min(AdvanceRemainingTime, FMath::Max(ScreenTransitionPauseSeconds - TransitionElapsedTime, 0.0f));
+				TransitionElapsedTime += StepTime;
+				ScreenElapsedTime += StepTime;
+				AdvanceRemainingTime -= StepTime;
+				ProcessTimedEvents();
+
+				if (TransitionElapsedTime >= ScreenTransitionPauseSeconds)
+				{
+					OnScreenTransitionComplete();
+					++Transitions;
+				}
+				break;
 			}
+
+			case EStoryPlaybackState::Completed:
+			case EStoryPlaybackState::Idle:
+			default:
+				// No action needed
+				AdvanceRemainingTime = 0.0f;
+				break;
 		}
-		else
+	}
+
+	// Time left at the transition limit is owed, not lost: the next tick advances it first
+	if (Transitions >= MaxTransitionsPerTick && AdvanceRemainingTime > 0.0f && bIsPlaying)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("Tick: Transition limit reached, carrying %.3fs to the next tick"), AdvanceRemainingTime);
+		CarriedAdvanceTime = AdvanceRemainingTime;
+	}
+
+	AdvanceRemainingTime = 0.0f;
+
+	// Single packed upload for every line's reveal parameters
+	UpdateLineParameters();
+}
+
+float UShortStorySubsystem::GetIdlePlaybackTime() const
+{
+	if (bIsPaused)
+	{
+		return MAX_flt;
+	}
+
+	// Time carried from a tick that hit the transition limit is advanced right away
+	if (CarriedAdvanceTime > 0.0f)
+	{
+		return 0.0f;
+	}
+
+	if (!CurrentStory.Screens.IsValidIndex(CurrentScreenIndex))
+	{
+		return 0.0f;
+	}
+
+	float IdleTime = MAX_flt;
+	switch (CurrentState)
+	{
+		case EStoryPlaybackState::PlayingLine:
+			// Text is revealing
+			return 0.0f;
+
+		case EStoryPlaybackState::PausingAfterLine:
+			if (!bIsWaitingForInput || PauseDuration > 0.0f)
+			{
+				// Timed pauses, and Wait pauses with a timeout
+				IdleTime = PauseDuration - PauseElapsedTime;
+			}
+			else if (bIsFastForwarding && bFastForwardContinuesWaits)
+			{
+				return 0.0f;
+			}
+			break;
+
+		case EStoryPlaybackState::TransitioningScreen:
+			if (bWaitingForBackground)
+			{
+				// Polling the incoming background
+				return 0.0f;
+			}
+			IdleTime = ScreenTransitionPauseSeconds - TransitionElapsedTime;
+			break;
+
+		default:
+			break;
+	}
+
+	const FStoryScreen& CurrentScreen = CurrentStory.Screens[CurrentScreenIndex];
+	if (CurrentScreen.TimedEvents.IsValidIndex(NextTimedEventIndex))
+	{
+		IdleTime = FMath::Min(IdleTime, CurrentScreen.TimedEvents[NextTimedEventIndex].StartTime - ScreenElapsedTime);
+	}
+
+	// Line parameters keep moving until past progress has caught up, FadeWindowSeconds after a line ends
+	for (int32 i = 0; i < CurrentScreen.Lines.Num(); ++i)
+	{
+		const float LineStartTime = GetLineStartTime(i);
+		if (LineStartTime >= 0.0f && LineStartTime + CalculateLineDuration(CurrentScreen.Lines[i]) + FadeWindowSeconds > ScreenElapsedTime)
 		{
-			// Not started yet
-			LineState.AnimationProgress = 0.0f;
-			LineState.CurrentTextProgress = 0.0f;
-			LineState.PastTextProgress = 0.0f;
-			LineState.bIsFullyVisible = false;
-			LineState.bIsAnimating = false;
+			return 0.0f;
 		}
-
-		State.Lines.Add(LineState);
 	}
 
-	return State;
+	return IdleTime;
 }
 
+void UShortStorySubsystem::SleepPlayback(float PlaybackTime)
+{
+	// The per-frame ticker is removed by Tick returning false
+	TickerHandle.Reset();
+	bIsSleeping = true;
+	SleepStartTime = FApp::GetCurrentTime();
 
+	if (PlaybackTime < MAX_flt)
+	{
+		const float Delay = bIsFastForwarding ? PlaybackTime / FastForwardTimeScale : PlaybackTime;
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UShortStorySubsystem::WakeTick), Delay
+		);
+		UE_LOG(LogShortStory, Verbose, TEXT("SleepPlayback: Idle for %.2fs"), Delay);
+	}
+	else
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("SleepPlayback: Idle until input"));
+	}
+}
 
-bool UShortStorySubsystem::Tick(float DeltaTime)
+bool UShortStorySubsystem::WakeTick(float DeltaTime)
 {
-	SCOPE_CYCLE_COUNTER(STAT_ShortStory_Tick);
+	// Returning false removes this one-shot ticker
+	TickerHandle.Reset();
+	WakePlayback();
+	return false;
+}
 
-	if (!bIsPlaying || bIsPaused)
+void UShortStorySubsystem::WakePlayback()
+{
+	if (!bIsSleeping)
 	{
-		return true; // Keep ticking
+		return;
 	}
+	bIsSleeping = false;
 
-	// Increment screen elapsed time (for timed events)
-	ScreenElapsedTime += DeltaTime;
-
-	// Check and fire timed events
-	ProcessTimedEvents();
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UShortStorySubsystem::Tick)
+	);
 
-	// State machine logic
-	switch (CurrentState)
+	// Catch the clocks up before the caller acts, so input lands at the right screen time.
+	// Time asleep while paused does not count (pausing wakes first, so bIsPaused held for the whole sleep).
+	if (!bIsPaused)
 	{
-		case EStoryPlaybackState::PlayingLine:
-		{
-			LineElapsedTime += DeltaTime;
-			if (LineElapsedTime >= LineDuration)
-			{
-				// Line animation complete
-				StartPause();
-			}
-			break;
-		}
+		AdvancePlayback(static_cast<float>(FApp::GetCurrentTime() - SleepStartTime));
+	}
+}
 
-		case EStoryPlaybackState::PausingAfterLine:
-		{
-			PauseElapsedTime += DeltaTime;
-			if (PauseElapsedTime >= PauseDuration)
-			{
-				// Pause complete, advance to next line or screen
-				AdvanceToNextLineOrScreen();
-			}
-			break;
-		}
+float UShortStorySubsystem::GetScreenTime() const
+{
+	if (!bIsPlaying)
+	{
+		return 0.0f;
+	}
 
-		case EStoryPlaybackState::TransitioningScreen:
-		{
-			// Wait for screen transition pause
-			TransitionElapsedTime += DeltaTime;
-			if (TransitionElapsedTime >= ScreenTransitionPauseSeconds)
-			{
-				OnScreenTransitionComplete();
-			}
-			break;
-		}
+	// Between advances (and while asleep) the clock runs on at the playback rate
+	return ScreenElapsedTime + AdvanceRemainingTime + static_cast<float>(FApp::GetCurrentTime() - PlaybackClockTime) * GetPlaybackRate();
+}
 
-		case EStoryPlaybackState::Completed:
-		case EStoryPlaybackState::Idle:
-		default:
-			// No action needed
-			break;
+float UShortStorySubsystem::GetPlaybackRate() const
+{
+	if (!bIsPlaying || bIsPaused || bWaitingForBackground)
+	{
+		return 0.0f;
 	}
+	return bIsFastForwarding ? FastForwardTimeScale : 1.0f;
+}
 
-	return true; // Keep ticking
+void UShortStorySubsystem::NotifyClockChanged(EStoryClockChange Change)
+{
+	OnClockChanged.Broadcast(Change);
 }
 
 void UShortStorySubsystem::StartLine(int32 LineIndex)
@@ -1024,104 +2837,37 @@ void UShortStorySubsystem::StartLine(int32 LineIndex)
 
 	const FStoryLine& Line = CurrentScreen.Lines[LineIndex];
 
-	// BLOCK ANIMATION LOGIC
-	// Check if this line starts a block (TopDown or Paragraph)
-	bool bIsBlockAnimation = (Line.AnimationType == EStoryLineAnimation::Paragraph || Line.AnimationType == EStoryLineAnimation::TopDown);
-
-	if (bIsBlockAnimation)
-	{
-		// Find all lines in this block
-		// A block consists of consecutive lines with the same animation type
-		// and implicitly linked (e.g. by LineBreak pause, though usually the last one has the real pause)
-		// Actually, let's just group consecutive lines of the SAME animation type 
-		// until we hit a different type or the end of the screen.
-		// NOTE: The parser splits wrapped text into lines with Pause=LineBreak, 
-		// and the final line has the actual pause.
-		
-		int32 BlockEndIndex = LineIndex;
-		for (int32 i = LineIndex + 1; i < CurrentScreen.Lines.Num(); ++i)
-		{
-			const FStoryLine& NextLine = CurrentScreen.Lines[i];
-			if (NextLine.AnimationType == Line.AnimationType)
-			{
-				BlockEndIndex = i;
-				// If this line has a significant pause (not LineBreak/None), it ends the logical block?
-				// Or do we treat the whole sequence as one block regardless of pauses?
-				// Usually "Paragraph" means "Everything until the user clicks" or "Everything in this chunk".
-				// Given the parser splits one logical line into multiple FStoryLines, we should treat them as one block.
-				// However, if the user explicitly wrote two Paragraph lines separated by a pipe, they might want them separate.
-				// But Parser currently unifies them if they are in the same split group.
-				// Let's assume contiguous lines of same type = one block.
-				
-				// Optional: Break if we hit a Hard Pause? 
-				// But let's stick to contiguous same-type for now as a robust heuristic.
-			}
-			else
-			{
-				break;
-			}
-		}
+	if (!CurrentScreen.LineSegmentIndices.IsValidIndex(LineIndex))
+	{
+		UE_LOG(LogShortStory, Error, TEXT("StartLine: Screen %d has no baked schedule"), CurrentScreenIndex);
+		return;
+	}
 
-		// Calculate timing for the block
-		float CurrentDelay = 0.0f;
-		float MaxFinishTime = 0.0f;
-		float CascadeDelay = 0.2f; // Time between lines for TopDown
+	// Blocks (consecutive TopDown or Paragraph lines) were grouped into one segment at load time
+	CurrentSegmentIndex = CurrentScreen.LineSegmentIndices[LineIndex];
+	const FStoryLineSegment& Segment = CurrentScreen.Segments[CurrentSegmentIndex];
 
-		for (int32 i = LineIndex; i <= BlockEndIndex; ++i)
-		{
-			// Set start time
-			if (LineStartTimes.IsValidIndex(i))
-			{
-				LineStartTimes[i] = ScreenElapsedTime + CurrentDelay;
-			}
-			
-			// Update delay for next line
-			if (Line.AnimationType == EStoryLineAnimation::TopDown)
-			{
-				CurrentDelay += CascadeDelay;
-			}
-			else // Paragraph / FadeIn
-			{
-				// Parallel: No added delay
-			}
+	// Anchor the segment's run to the screen clock; line start times are derived from the baked offsets
+	if (RunStartTimes.IsValidIndex(Segment.RunIndex))
+	{
+		RunStartTimes[Segment.RunIndex] = ScreenElapsedTime - Segment.RunOffset;
+	}
 
-			// Track when this line finishes
-			float ThisDuration = CalculateLineDuration(CurrentScreen.Lines[i]);
-			float FinishTime = CurrentDelay + ThisDuration; // Relative to start of block
-			if (FinishTime > MaxFinishTime)
-			{
-				MaxFinishTime = FinishTime;
-			}
-		}
+	// Duration until the last animation of the segment finishes (includes TopDown cascade delays)
+	LineDuration = Segment.Duration;
 
-		// Set LineDuration to the total time until the *last* animation finishes
-		// This ensures the state machine waits appropriately.
-		// Note: MaxFinishTime includes the cascade delays.
-		// However, for TopDown, we added delay *before* setting FinishTime.
-		// Let's re-verify:
-		// Line 0: Start=0, Dur=F. Finish=F. NextDelay=0.2.
-		// Line 1: Start=0.2, Dur=F. Finish=0.2+F. NextDelay=0.4.
-		// MaxFinishTime will be (BlockSize-1)*Delay + FadeWindow.
-		LineDuration = MaxFinishTime;
+	// Calls to GetCurrentLine() return the last line of a block, which has the correct PauseDuration
+	CurrentLineIndex = Segment.LastLine;
 
-		UE_LOG(LogShortStory, Verbose, TEXT("StartLine: Started BLOCK %s (%d lines) duration: %.2fs"), 
-			*UEnum::GetValueAsString(Line.AnimationType), (BlockEndIndex - LineIndex + 1), LineDuration);
+	OnLinesRevealed.Broadcast(CurrentStoryId, CurrentScreenIndex, Segment.FirstLine, Segment.LastLine);
 
-		// Advance CurrentLineIndex to end of block
-		// calls to GetCurrentLine() will return the last line, which has the correct PauseDuration
-		CurrentLineIndex = BlockEndIndex;
+	if (Segment.LastLine > Segment.FirstLine)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("StartLine: Started BLOCK %s (%d lines) duration: %.2fs"),
+			*UEnum::GetValueAsString(Line.AnimationType), (Segment.LastLine - Segment.FirstLine + 1), LineDuration);
 	}
 	else
 	{
-		// Standard Single Line Behavior
-		LineDuration = CalculateTypewriterDuration(Line.Text, Line.Speed);
-
-		// Record start time
-		if (LineStartTimes.IsValidIndex(LineIndex))
-		{
-			LineStartTimes[LineIndex] = ScreenElapsedTime;
-		}
-
 		UE_LOG(LogShortStory, Verbose, TEXT("StartLine: Started line %d/%d on screen %d (duration: %.2fs): %s"),
 			LineIndex, CurrentScreen.Lines.Num() - 1, CurrentScreenIndex, LineDuration, *Line.Text);
 	}
@@ -1193,6 +2939,7 @@ void UShortStorySubsystem::AdvanceToNextScreen()
 		}
 
 		UE_LOG(LogShortStory, Log, TEXT("AdvanceToNextScreen: Story completed"));
+		NotifyClockChanged(EStoryClockChange::Stopped);
 
 		// Broadcast completion event
 		OnStoryCompleted.Broadcast();
@@ -1204,7 +2951,7 @@ void UShortStorySubsystem::AdvanceToNextScreen()
 
 	// Reset screen state and transition
 	ResetScreenState(CurrentScreenIndex);
-	CurrentState = EStoryPlaybackState::TransitioningScreen;
+	BeginScreenTransition();
 
 	UE_LOG(LogShortStory, Log, TEXT("AdvanceToNextScreen: Advanced to screen %d/%d"),
 		CurrentScreenIndex, CurrentStory.Screens.Num() - 1);
@@ -1215,38 +2962,128 @@ void UShortStorySubsystem::AdvanceToNextScreen()
 
 void UShortStorySubsystem::ProcessTimedEvents()
 {
-	if (CurrentScreenIndex >= CurrentStory.Screens.Num())
+	// Events are sorted by StartTime at load, so only the cursor needs checking.
+	// Re-validate each iteration: listeners may navigate or stop the story.
+	while (CurrentStory.Screens.IsValidIndex(CurrentScreenIndex))
+	{
+		const TArray<FStoryTimedEvent>& TimedEvents = CurrentStory.Screens[CurrentScreenIndex].TimedEvents;
+		if (!TimedEvents.IsValidIndex(NextTimedEventIndex) || ScreenElapsedTime < TimedEvents[NextTimedEventIndex].StartTime)
+		{
+			break;
+		}
+
+		const int32 EventIndex = NextTimedEventIndex++;
+		const FStoryTimedEvent Event = TimedEvents[EventIndex];
+
+		UE_LOG(LogShortStory, Verbose, TEXT("ProcessTimedEvents: Timed event %d reached at time %.2fs: %s '%s'"),
+			EventIndex, Event.StartTime, *UEnum::GetValueAsString(Event.EventType), *Event.AssetPath);
+
+		OnTimedEventTriggered.Broadcast(EventIndex, Event);
+	}
+}
+
+void UShortStorySubsystem::AdvanceScreenClockForSkip(float NewScreenTime, EStorySkipEventPolicy EventPolicy)
+{
+	ScreenElapsedTime = FMath::Max(ScreenElapsedTime, NewScreenTime);
+	NotifyClockChanged(EStoryClockChange::Jumped);
+
+	if (EventPolicy == EStorySkipEventPolicy::FireAll)
 	{
+		ProcessTimedEvents();
 		return;
 	}
 
-	const FStoryScreen& CurrentScreen = CurrentStory.Screens[CurrentScreenIndex];
+	if (!CurrentStory.Screens.IsValidIndex(CurrentScreenIndex))
+	{
+		return;
+	}
+
+	// Crossed events are [NextTimedEventIndex, EndIndex)
+	const TArray<FStoryTimedEvent>& TimedEvents = CurrentStory.Screens[CurrentScreenIndex].TimedEvents;
+	const int32 FirstIndex = NextTimedEventIndex;
+	const int32 EndIndex = FMath::Max(FirstIndex, Algo::UpperBoundBy(TimedEvents, ScreenElapsedTime, &FStoryTimedEvent::StartTime));
+	NextTimedEventIndex = EndIndex;
+
+	if (EventPolicy == EStorySkipEventPolicy::SuppressAll)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("AdvanceScreenClockForSkip: Suppressed %d timed events"), EndIndex - FirstIndex);
+		return;
+	}
 
-	// Check each timed event
-	for (int32 i = 0; i < CurrentScreen.TimedEvents.Num(); ++i)
+	// FireStateOnly: the latest background change, and VFX that are still running at the landing time
+	TArray<int32, TInlineAllocator<8>> EventsToFire;
+	int32 LastBackgroundChange = INDEX_NONE;
+	for (int32 i = FirstIndex; i < EndIndex; ++i)
 	{
-		// Skip if already processed
-		if (ProcessedTimedEventIndices.Contains(i))
+		const FStoryTimedEvent& Event = TimedEvents[i];
+		if (Event.EventType == EStoryTimedEventType::BackgroundChange)
 		{
-			continue;
+			LastBackgroundChange = i;
 		}
+		else if (Event.EventType == EStoryTimedEventType::VFX && Event.StartTime + Event.Duration > ScreenElapsedTime)
+		{
+			EventsToFire.Add(i);
+		}
+	}
+	if (LastBackgroundChange != INDEX_NONE)
+	{
+		EventsToFire.Add(LastBackgroundChange);
+		EventsToFire.Sort();
+	}
 
-		const FStoryTimedEvent& Event = CurrentScreen.TimedEvents[i];
+	// Copy before broadcasting: listeners may navigate away from this screen
+	TArray<FStoryTimedEvent, TInlineAllocator<8>> FiredEvents;
+	for (int32 EventIndex : EventsToFire)
+	{
+		FiredEvents.Add(TimedEvents[EventIndex]);
+	}
 
-		// Check if it's time to fire this event
-		if (ScreenElapsedTime >= Event.StartTime)
-		{
-			// Mark as processed (Blueprint will query screen state and handle timed events)
-			ProcessedTimedEventIndices.Add(i);
+	UE_LOG(LogShortStory, Verbose, TEXT("AdvanceScreenClockForSkip: Firing %d of %d crossed timed events"), FiredEvents.Num(), EndIndex - FirstIndex);
 
-			UE_LOG(LogShortStory, Verbose, TEXT("ProcessTimedEvents: Timed event %d reached at time %.2fs: %s '%s'"),
-				i, Event.StartTime, *UEnum::GetValueAsString(Event.EventType), *Event.AssetPath);
-		}
+	for (int32 i = 0; i < FiredEvents.Num(); ++i)
+	{
+		OnTimedEventTriggered.Broadcast(EventsToFire[i], FiredEvents[i]);
+	}
+}
+
+float UShortStorySubsystem::GetLineStartTime(int32 LineIndex) const
+{
+	if (CurrentSegmentIndex == INDEX_NONE || !CurrentStory.Screens.IsValidIndex(CurrentScreenIndex))
+	{
+		return -1.0f;
+	}
+
+	const FStoryScreen& CurrentScreen = CurrentStory.Screens[CurrentScreenIndex];
+	if (!CurrentScreen.LineSegmentIndices.IsValidIndex(LineIndex))
+	{
+		return -1.0f;
+	}
+
+	// Lines of segments not reached yet (including ones jumped over by a skip) come from the run offsets
+	const int32 SegmentIndex = CurrentScreen.LineSegmentIndices[LineIndex];
+	if (SegmentIndex > CurrentSegmentIndex)
+	{
+		return -1.0f;
+	}
+
+	const int32 RunIndex = CurrentScreen.Segments[SegmentIndex].RunIndex;
+	if (!RunStartTimes.IsValidIndex(RunIndex) || RunStartTimes[RunIndex] < 0.0f)
+	{
+		return -1.0f;
 	}
+
+	return RunStartTimes[RunIndex] + CurrentScreen.LineRunOffsets[LineIndex];
 }
 
 void UShortStorySubsystem::OnScreenTransitionComplete()
 {
+	// Blueprint can end the transition before the background arrived
+	if (bWaitingForBackground)
+	{
+		bWaitingForBackground = false;
+		NotifyClockChanged(EStoryClockChange::RateChanged);
+	}
+
 	// Called when screen transition animation completes in Blueprint
 	// For now, immediately start first line of new screen
 
@@ -1269,6 +3106,86 @@ void UShortStorySubsystem::OnScreenTransitionComplete()
 	}
 }
 
+void UShortStorySubsystem::BeginScreenTransition()
+{
+	CurrentState = EStoryPlaybackState::TransitioningScreen;
+	BackgroundWaitTime = 0.0f;
+	bSkipHeldForBackground = false;
+	bWaitingForBackground = !IsScreenBackgroundReady(CurrentScreenIndex);
+	if (!bWaitingForBackground)
+	{
+		return;
+	}
+
+	const FStoryScreen& Screen = CurrentStory.Screens[CurrentScreenIndex];
+	if (UTexture2D* Texture = GetScreenBackground(CurrentScreenIndex))
+	{
+		// Loaded but still streaming: keep every mip resident through the transition
+		Texture->SetForceMipLevelsToBeResident(MaxBackgroundWaitSeconds + ScreenTransitionPauseSeconds);
+	}
+	else
+	{
+		// Collected since the story was loaded (or never prewarmed)
+		ScreenBackgroundHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			Screen.Background.ToSoftObjectPath(), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+
+	UE_LOG(LogShortStory, Verbose, TEXT("BeginScreenTransition: Holding screen %d until its background is ready"), CurrentScreenIndex);
+
+	// Schedulers working ahead of the clock see it stop until the background arrives
+	NotifyClockChanged(EStoryClockChange::RateChanged);
+}
+
+float UShortStorySubsystem::GetTransitionProgress() const
+{
+	if (!bIsPlaying || CurrentState != EStoryPlaybackState::TransitioningScreen)
+	{
+		return 1.0f;
+	}
+
+	if (bWaitingForBackground || ScreenTransitionPauseSeconds <= 0.0f)
+	{
+		return bWaitingForBackground ? 0.0f : 1.0f;
+	}
+
+	// Extrapolated like GetScreenTime, so the blend is smooth whatever the tick order
+	const float TransitionTime = TransitionElapsedTime + (GetScreenTime() - ScreenElapsedTime);
+	return FMath::Clamp(TransitionTime / ScreenTransitionPauseSeconds, 0.0f, 1.0f);
+}
+
+bool UShortStorySubsystem::IsScreenBackgroundReady(int32 ScreenIndex) const
+{
+	if (!CurrentStory.Screens.IsValidIndex(ScreenIndex))
+	{
+		return false;
+	}
+
+	UTexture2D* Texture = GetScreenBackground(ScreenIndex);
+	if (!Texture)
+	{
+		// Nothing to wait for unless an asset still has to load
+		return CurrentStory.Screens[ScreenIndex].Background.IsNull();
+	}
+
+	if (!FApp::CanEverRender())
+	{
+		return true;
+	}
+
+	return Texture->GetResource() != nullptr && !Texture->HasPendingInitOrStreaming() && Texture->IsFullyStreamedIn();
+}
+
+UTexture2D* UShortStorySubsystem::GetScreenBackground(int32 ScreenIndex) const
+{
+	if (!CurrentStory.Screens.IsValidIndex(ScreenIndex))
+	{
+		return nullptr;
+	}
+
+	const FStoryScreen& Screen = CurrentStory.Screens[ScreenIndex];
+	return Screen.RuntimeTexture ? Screen.RuntimeTexture : Screen.Background.Get();
+}
+
 // ========================================
 // Screen Navigation
 // ========================================
@@ -1288,13 +3205,19 @@ void UShortStorySubsystem::ResetScreenState(int32 TargetScreenIndex)
 	ScreenElapsedTime = 0.0f;
 	LineElapsedTime = 0.0f;
 	PauseElapsedTime = 0.0f;
-	ProcessedTimedEventIndices.Empty();
-	LineStartTimes.Init(-1.0f, TargetScreen.Lines.Num());
+	NextTimedEventIndex = 0;
+	CurrentSegmentIndex = INDEX_NONE;
+	RunStartTimes.Init(-1.0f, TargetScreen.NumRuns);
 	TransitionElapsedTime = 0.0f;
+
+	NotifyClockChanged(EStoryClockChange::ScreenChanged);
 }
 
 bool UShortStorySubsystem::GoToScreen(int32 ScreenIndex)
 {
+	// Input wakes a sleeping ticker first, catching the clocks up (which may finish the story)
+	WakePlayback();
+
 	if (!bIsPlaying)
 	{
 		UE_LOG(LogShortStory, Warning, TEXT("GoToScreen: No story is currently playing"));
@@ -1313,7 +3236,7 @@ bool UShortStorySubsystem::GoToScreen(int32 ScreenIndex)
 
 	CurrentScreenIndex = ScreenIndex;
 	ResetScreenState(ScreenIndex);
-	CurrentState = EStoryPlaybackState::TransitioningScreen;
+	BeginScreenTransition();
 	OnScreenChanged.Broadcast(CurrentScreenIndex);
 
 	return true;
@@ -1355,6 +3278,8 @@ TArray<FString> UShortStorySubsystem::GetScreenNames() const
 
 void UShortStorySubsystem::DebugSkipToNextScreen()
 {
+	WakePlayback();
+
 	if (!bIsPlaying)
 	{
 		UE_LOG(LogShortStory, Warning, TEXT("DebugSkipToNextScreen: No story is currently playing"));
@@ -1377,6 +3302,8 @@ void UShortStorySubsystem::DebugSkipToNextScreen()
 			TickerHandle.Reset();
 		}
 
+		NotifyClockChanged(EStoryClockChange::Stopped);
+
 		// Broadcast completion event
 		OnStoryCompleted.Broadcast();
 		return;
@@ -1406,6 +3333,8 @@ void UShortStorySubsystem::DebugSkipToNextScreen()
 
 void UShortStorySubsystem::DebugSkipToPreviousScreen()
 {
+	WakePlayback();
+
 	if (!bIsPlaying)
 	{
 		UE_LOG(LogShortStory, Warning, TEXT("DebugSkipToPreviousScreen: No story is currently playing"));
@@ -1449,6 +3378,8 @@ void UShortStorySubsystem::DebugSkipToPreviousScreen()
 
 void UShortStorySubsystem::DebugJumpToScreen(int32 ScreenIndex)
 {
+	WakePlayback();
+
 	if (!bIsPlaying)
 	{
 		UE_LOG(LogShortStory, Warning, TEXT("DebugJumpToScreen: No story is currently playing"));
@@ -1486,6 +3417,8 @@ void UShortStorySubsystem::DebugJumpToScreen(int32 ScreenIndex)
 
 void UShortStorySubsystem::DebugSkipCurrentLine()
 {
+	WakePlayback();
+
 	if (!bIsPlaying)
 	{
 		UE_LOG(LogShortStory, Warning, TEXT("DebugSkipCurrentLine: No story is currently playing"));
@@ -1507,6 +3440,7 @@ void UShortStorySubsystem::DebugSkipCurrentLine()
 
 	// Advance screen time to complete the line (so it appears finished in rendering)
 	ScreenElapsedTime += RemainingTime;
+	NotifyClockChanged(EStoryClockChange::Jumped);
 
 	// Force line to complete
 	LineElapsedTime = LineDuration;
@@ -1522,6 +3456,8 @@ bool UShortStorySubsystem::IsWaitingForInput() const
 
 bool UShortStorySubsystem::ContinueStory()
 {
+	WakePlayback();
+
 	if (!IsWaitingForInput())
 	{
 		return false;
@@ -1537,3 +3473,124 @@ bool UShortStorySubsystem::ContinueStory()
 
 	return true;
 }
+
+bool UShortStorySubsystem::SkipToNextStablePoint(EStorySkipEventPolicy EventPolicy)
+{
+	WakePlayback();
+
+	if (!bIsPlaying)
+	{
+		UE_LOG(LogShortStory, Warning, TEXT("SkipToNextStablePoint: No story is currently playing"));
+		return false;
+	}
+
+	if (IsWaitingForInput())
+	{
+		// Already at a stable point, ContinueStory moves on
+		return false;
+	}
+
+	// The transition has not started until the incoming background can be drawn: hold the skip at its start until then
+	if (CurrentState == EStoryPlaybackState::TransitioningScreen && bWaitingForBackground)
+	{
+		bSkipHeldForBackground = true;
+		HeldSkipEventPolicy = EventPolicy;
+		UE_LOG(LogShortStory, Verbose, TEXT("SkipToNextStablePoint: Holding the skip until the background of screen %d is ready"), CurrentScreenIndex);
+		return true;
+	}
+
+	const int32 StartScreenIndex = CurrentScreenIndex;
+	const int32 StartLineIndex = CurrentLineIndex;
+
+	// Finish a running screen transition, then skip through the new screen
+	if (CurrentState == EStoryPlaybackState::TransitioningScreen)
+	{
+		AdvanceScreenClockForSkip(ScreenElapsedTime + FMath::Max(ScreenTransitionPauseSeconds - TransitionElapsedTime, 0.0f), EventPolicy);
+		if (CurrentState == EStoryPlaybackState::TransitioningScreen)
+		{
+			TransitionElapsedTime = ScreenTransitionPauseSeconds;
+			OnScreenTransitionComplete();
+		}
+	}
+	else if (CurrentState == EStoryPlaybackState::PausingAfterLine)
+	{
+		// A timed pause: finish it. At the end of the screen this is the skip (on to the next screen).
+		const bool bWasLastSegment = CurrentStory.Screens.IsValidIndex(CurrentScreenIndex)
+			&& CurrentSegmentIndex >= CurrentStory.Screens[CurrentScreenIndex].Segments.Num() - 1;
+		const int32 PauseSegmentIndex = CurrentSegmentIndex;
+
+		AdvanceScreenClockForSkip(ScreenElapsedTime + FMath::Max(PauseDuration - PauseElapsedTime, 0.0f), EventPolicy);
+		if (CurrentState == EStoryPlaybackState::PausingAfterLine && CurrentSegmentIndex == PauseSegmentIndex)
+		{
+			PauseElapsedTime = PauseDuration;
+			AdvanceToNextLineOrScreen();
+		}
+
+		if (bWasLastSegment)
+		{
+			UpdateLineParameters();
+			UE_LOG(LogShortStory, Log, TEXT("SkipToNextStablePoint: Finished screen %d"), StartScreenIndex);
+			return true;
+		}
+	}
+
+	// Jump from the playing segment to the end of the next stable segment in one step.
+	// No Wait lies in between, so both segments are in the same run and the gap is a baked offset difference.
+	if (CurrentState == EStoryPlaybackState::PlayingLine && CurrentStory.Screens.IsValidIndex(CurrentScreenIndex))
+	{
+		const FStoryScreen& CurrentScreen = CurrentStory.Screens[CurrentScreenIndex];
+		if (CurrentScreen.Segments.IsValidIndex(CurrentSegmentIndex))
+		{
+			const int32 ScreenIndex = CurrentScreenIndex;
+			const int32 FromSegmentIndex = CurrentSegmentIndex;
+			const FStoryLineSegment& FromSegment = CurrentScreen.Segments[FromSegmentIndex];
+			const int32 TargetSegmentIndex = FromSegment.NextStableSegment;
+			const FStoryLineSegment TargetSegment = CurrentScreen.Segments[TargetSegmentIndex];
+
+			const float SegmentStartTime = ScreenElapsedTime - LineElapsedTime;
+			const float TargetFinishTime = SegmentStartTime + (TargetSegment.RunOffset - FromSegment.RunOffset) + TargetSegment.Duration;
+			const int32 FromLastLine = FromSegment.LastLine;
+
+			AdvanceScreenClockForSkip(TargetFinishTime, EventPolicy);
+
+			// Listeners may have navigated while events fired
+			if (CurrentScreenIndex == ScreenIndex && CurrentSegmentIndex == FromSegmentIndex && CurrentState == EStoryPlaybackState::PlayingLine)
+			{
+				if (TargetSegmentIndex != FromSegmentIndex)
+				{
+					// One range for every line jumped over
+					OnLinesRevealed.Broadcast(CurrentStoryId, CurrentScreenIndex, FromLastLine + 1, TargetSegment.LastLine);
+				}
+
+				CurrentSegmentIndex = TargetSegmentIndex;
+				CurrentLineIndex = TargetSegment.LastLine;
+				LineDuration = TargetSegment.Duration;
+				LineElapsedTime = LineDuration;
+				StartPause();
+			}
+		}
+	}
+
+	UpdateLineParameters();
+
+	UE_LOG(LogShortStory, Log, TEXT("SkipToNextStablePoint: Skipped from screen %d line %d to screen %d line %d%s"),
+		StartScreenIndex, StartLineIndex, CurrentScreenIndex, CurrentLineIndex, IsWaitingForInput() ? TEXT(" (waiting for input)") : TEXT(""));
+
+	return true;
+}
+
+void UShortStorySubsystem::SetFastForward(bool bEnable)
+{
+	if (bIsFastForwarding == bEnable)
+	{
+		return;
+	}
+
+	// Time asleep so far passed at the old rate
+	WakePlayback();
+
+	bIsFastForwarding = bEnable;
+	UE_LOG(LogShortStory, Verbose, TEXT("SetFastForward: Fast-forward %s (x%.1f)"), bEnable ? TEXT("on") : TEXT("off"), FastForwardTimeScale);
+
+	NotifyClockChanged(EStoryClockChange::RateChanged);
+}
@@ -0,0 +1,207 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryTextLayout.h"
+#include "ShortStory.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "Rendering/SlateRenderer.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+
+FShortStoryTextLayoutCache& FShortStoryTextLayoutCache::Get()
+{
+	static FShortStoryTextLayoutCache Instance;
+	return Instance;
+}
+
+const FStoryTextLayout& FShortStoryTextLayoutCache::GetLayout(const FString& Text, EStoryLineAnimation AnimType, const FSlateFontInfo& Font, FVector2D CanvasSize)
+{
+	check(IsInGameThread());
+
+	FLayoutLookup Lookup;
+	Lookup.Text = Text;
+	Lookup.TextHash = FCrc::StrCrc32(*Text);
+	Lookup.FontHash = GetTypeHash(Font);
+	Lookup.Canvas = FIntPoint(FMath::RoundToInt(CanvasSize.X), FMath::RoundToInt(CanvasSize.Y));
+	Lookup.AnimType = AnimType;
+
+	const uint32 KeyHash = Lookup.GetHash();
+	if (const FStoryTextLayout* Found = Layouts.FindByHash(KeyHash, Lookup))
+	{
+		return *Found;
+	}
+
+	// Bounded cache: widgets normally only ever show a handful of lines per screen
+	if (Layouts.Num() >= MaxCachedLayouts)
+	{
+		UE_LOG(LogShortStory, Verbose, TEXT("FShortStoryTextLayoutCache: Flushing %d cached layouts"), Layouts.Num());
+		Layouts.Reset();
+	}
+
+	// Only a miss copies the text into the key
+	FStoryTextLayout& Layout = Layouts.AddByHash(KeyHash, FLayoutKey(Lookup));
+	BuildLayout(Text, AnimType, Font, CanvasSize, Lookup.TextHash, Layout);
+	return Layout;
+}
+
+void FShortStoryTextLayoutCache::Empty()
+{
+	Layouts.Empty();
+}
+
+void FShortStoryTextLayoutCache::BuildLayout(const FString& Text, EStoryLineAnimation AnimType, const FSlateFontInfo& Font, FVector2D CanvasSize, uint32 Seed, FStoryTextLayout& OutLayout) const
+{
+	OutLayout.Words.Reset();
+
+	// Use the real font cache when Slate is up; fall back to the old width heuristic otherwise (-nullrhi, commandlets)
+	TSharedPtr<FSlateFontMeasure> FontMeasure;
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	}
+
+	OutLayout.bMeasured = FontMeasure.IsValid();
+
+	const float FontSize = Font.Size;
+	const float GlyphHeight = FontMeasure.IsValid() ? FontMeasure->GetMaxCharacterHeight(Font) : FontSize;
+	const float SpaceWidth = FontMeasure.IsValid() ? FontMeasure->Measure(TEXT(" "), Font).X : FontSize * 0.3f;
+	const float LineHeight = GlyphHeight * 1.25f;
+	OutLayout.LineHeight = LineHeight;
+
+	// Split into words by index (no per-word strings) and measure each one
+	for (int32 i = 0; i < Text.Len(); )
+	{
+		if (FChar::IsWhitespace(Text[i]))
+		{
+			++i;
+			continue;
+		}
+
+		const int32 WordStart = i;
+		while (i < Text.Len() && !FChar::IsWhitespace(Text[i]))
+		{
+			++i;
+		}
+
+		FStoryWordRect& Word = OutLayout.Words.AddDefaulted_GetRef();
+		Word.StartIndex = WordStart;
+		Word.Length = i - WordStart;
+		Word.Size = FontMeasure.IsValid()
+			? FVector2D(FontMeasure->Measure(Text, WordStart, i, Font).X, GlyphHeight)
+			: FVector2D(Word.Length * FontSize * 0.6f, GlyphHeight);
+	}
+
+	if (OutLayout.Words.Num() == 0)
+	{
+		return;
+	}
+
+	// Center positions
+	const FVector2D Center = CanvasSize * 0.5f;
+	const float MarginLeft = CanvasSize.X * 0.1f;
+	const float MarginRight = CanvasSize.X * 0.9f;
+
+	// Seeded from the text so a line always lays out the same way
+	FRandomStream RandomStream(static_cast<int32>(Seed));
+
+	switch (AnimType)
+	{
+	case EStoryLineAnimation::Typewriter:
+	case EStoryLineAnimation::Paragraph:
+		{
+			// Left-aligned, vertically centered, wrapped at the right margin
+			float CurrentX = MarginLeft;
+			float CurrentY = Center.Y;
+
+			for (int32 i = 0; i < OutLayout.Words.Num(); ++i)
+			{
+				FStoryWordRect& Word = OutLayout.Words[i];
+				if (CurrentX + Word.Size.X > MarginRight && i > 0)
+				{
+					CurrentX = MarginLeft;
+					CurrentY += LineHeight;
+				}
+
+				Word.Position = FVector2D(CurrentX, CurrentY);
+				CurrentX += Word.Size.X + SpaceWidth;
+			}
+		}
+		break;
+
+	case EStoryLineAnimation::LeftToRight:
+		{
+			// Single row centered on the canvas
+			float TotalWidth = 0.0f;
+			for (const FStoryWordRect& Word : OutLayout.Words)
+			{
+				TotalWidth += Word.Size.X + SpaceWidth;
+			}
+			TotalWidth -= SpaceWidth;
+
+			float CurrentX = Center.X - TotalWidth * 0.5f;
+			for (FStoryWordRect& Word : OutLayout.Words)
+			{
+				Word.Position = FVector2D(CurrentX, Center.Y);
+				CurrentX += Word.Size.X + SpaceWidth;
+			}
+		}
+		break;
+
+	case EStoryLineAnimation::TopDown:
+		{
+			// Vertically stacked, each word centered
+			const float StartY = Center.Y - (OutLayout.Words.Num() * LineHeight * 0.5f);
+			for (int32 i = 0; i < OutLayout.Words.Num(); ++i)
+			{
+				FStoryWordRect& Word = OutLayout.Words[i];
+				Word.Position = FVector2D(Center.X - Word.Size.X * 0.5f, StartY + i * LineHeight);
+			}
+		}
+		break;
+
+	case EStoryLineAnimation::WordRain:
+		{
+			// Seeded X positions inside the margins, final Y scattered around the center
+			for (FStoryWordRect& Word : OutLayout.Words)
+			{
+				const float MaxX = FMath::Max(MarginLeft, MarginRight - Word.Size.X);
+				const float X = RandomStream.FRandRange(MarginLeft, MaxX);
+				const float Y = Center.Y + RandomStream.FRandRange(-LineHeight * 2.0f, LineHeight * 2.0f);
+				Word.Position = FVector2D(X, Y);
+			}
+		}
+		break;
+
+	case EStoryLineAnimation::Snake:
+		{
+			// Wavy serpentine path following the measured word widths, with a seeded phase per line
+			const float Amplitude = LineHeight * 2.0f;
+			const float Frequency = 0.5f;
+			const float Phase = RandomStream.FRandRange(0.0f, UE_TWO_PI);
+
+			float CurrentX = MarginLeft;
+			float BaseY = Center.Y;
+
+			for (int32 i = 0; i < OutLayout.Words.Num(); ++i)
+			{
+				FStoryWordRect& Word = OutLayout.Words[i];
+				if (CurrentX + Word.Size.X > MarginRight && i > 0)
+				{
+					CurrentX = MarginLeft;
+					BaseY += LineHeight * 3.0f;
+				}
+
+				Word.Position = FVector2D(CurrentX, BaseY + Amplitude * FMath::Sin(Phase + i * Frequency));
+				CurrentX += Word.Size.X + SpaceWidth * 2.0f;
+			}
+		}
+		break;
+
+	default:
+		for (FStoryWordRect& Word : OutLayout.Words)
+		{
+			Word.Position = Center - Word.Size * 0.5f;
+		}
+		break;
+	}
+}
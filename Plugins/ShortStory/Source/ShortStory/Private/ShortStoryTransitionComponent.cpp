@@ -0,0 +1,220 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryTransitionComponent.h"
+#include "ShortStorySubsystem.h"
+#include "ShortStory.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+UShortStoryTransitionComponent::UShortStoryTransitionComponent()
+{
+	// Story playback ticks while the game is paused, so the blend does too
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.bTickEvenWhenPaused = true;
+}
+
+void UShortStoryTransitionComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (TransitionMaterial)
+	{
+		BackgroundMaterial = UMaterialInstanceDynamic::Create(TransitionMaterial, this);
+	}
+
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	StorySubsystem = GameInstance ? GameInstance->GetSubsystem<UShortStorySubsystem>() : nullptr;
+	if (!StorySubsystem.IsValid())
+	{
+		UE_LOG(LogShortStory, Error, TEXT("ShortStoryTransitionComponent: ShortStorySubsystem not available on %s"), *GetNameSafe(GetOwner()));
+		return;
+	}
+
+	ClockChangedHandle = StorySubsystem->OnClockChanged.AddUObject(this, &UShortStoryTransitionComponent::HandleClockChanged);
+
+	// Pick up a story that is already playing
+	if (StorySubsystem->IsPlaying())
+	{
+		SnapToCurrentScreen();
+		if (StorySubsystem->GetPlaybackState() == EStoryPlaybackState::TransitioningScreen)
+		{
+			BeginTransition();
+		}
+	}
+	else
+	{
+		ApplyToMaterial();
+	}
+}
+
+void UShortStoryTransitionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UShortStorySubsystem* Subsystem = StorySubsystem.Get())
+	{
+		Subsystem->OnClockChanged.Remove(ClockChangedHandle);
+	}
+	ClockChangedHandle.Reset();
+	StorySubsystem.Reset();
+
+	OutgoingTexture = nullptr;
+	IncomingTexture = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UShortStoryTransitionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateBlend();
+}
+
+bool UShortStoryTransitionComponent::IsIncomingReady() const
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	return Subsystem && Subsystem->IsScreenBackgroundReady(IncomingScreenIndex);
+}
+
+void UShortStoryTransitionComponent::HandleClockChanged(EStoryClockChange Change)
+{
+	switch (Change)
+	{
+		case EStoryClockChange::Started:
+			SnapToCurrentScreen();
+			break;
+
+		case EStoryClockChange::ScreenChanged:
+			BeginTransition();
+			break;
+
+		case EStoryClockChange::Stopped:
+			// The last background stays up (story completed); only a blend in progress is finished
+			if (bIsTransitioning)
+			{
+				OutgoingTexture = nullptr;
+				OutgoingWeight = 0.0f;
+				IncomingWeight = 1.0f;
+				bIsTransitioning = false;
+				SetComponentTickEnabled(false);
+				ApplyToMaterial();
+			}
+			break;
+
+		default:
+			// Skips and pauses move the story clock; the blend reads it on the next tick
+			break;
+	}
+}
+
+void UShortStoryTransitionComponent::SnapToCurrentScreen()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	IncomingScreenIndex = Subsystem ? Subsystem->GetCurrentScreenIndex() : INDEX_NONE;
+	IncomingTexture = Subsystem ? Subsystem->GetScreenBackground(IncomingScreenIndex) : nullptr;
+	OutgoingTexture = nullptr;
+	OutgoingWeight = 0.0f;
+	IncomingWeight = 1.0f;
+	bIsTransitioning = false;
+	SetComponentTickEnabled(false);
+	ApplyToMaterial();
+}
+
+void UShortStoryTransitionComponent::BeginTransition()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	const FShortStory* Story = Subsystem ? Subsystem->FindLoadedStory(Subsystem->GetCurrentStoryId()) : nullptr;
+	if (!Story || !Story->Screens.IsValidIndex(Subsystem->GetCurrentScreenIndex()))
+	{
+		return;
+	}
+
+	// What is on screen now blends out, even if a previous transition was cut short
+	if (!bIsTransitioning || IncomingWeight >= OutgoingWeight)
+	{
+		OutgoingTexture = IncomingTexture;
+	}
+	IncomingScreenIndex = Subsystem->GetCurrentScreenIndex();
+	IncomingTexture = Subsystem->GetScreenBackground(IncomingScreenIndex);
+	TransitionType = Story->Screens[IncomingScreenIndex].TransitionType;
+	bIsTransitioning = true;
+
+	// The outgoing background must not drop mips while it fades
+	if (OutgoingTexture)
+	{
+		OutgoingTexture->SetForceMipLevelsToBeResident(Subsystem->GetScreenTransitionPause() + Subsystem->MaxBackgroundWaitSeconds);
+	}
+
+	// The screen changes before the subsystem enters its transition state, so the blend is read from the next tick
+	OutgoingWeight = 1.0f;
+	IncomingWeight = 0.0f;
+	SetComponentTickEnabled(true);
+	ApplyToMaterial();
+}
+
+void UShortStoryTransitionComponent::UpdateBlend()
+{
+	const UShortStorySubsystem* Subsystem = StorySubsystem.Get();
+	if (!Subsystem || !bIsTransitioning)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// An asset background may arrive after the transition was requested
+	if (!IncomingTexture)
+	{
+		IncomingTexture = Subsystem->GetScreenBackground(IncomingScreenIndex);
+	}
+
+	const bool bSameScreen = Subsystem->IsPlaying() && Subsystem->GetCurrentScreenIndex() == IncomingScreenIndex;
+	const float Progress = bSameScreen ? Subsystem->GetTransitionProgress() : 1.0f;
+	const bool bStarted = bSameScreen && !Subsystem->IsWaitingForBackground();
+
+	switch (TransitionType)
+	{
+		case EStoryTransition::Instant:
+			OutgoingWeight = bStarted ? 0.0f : 1.0f;
+			IncomingWeight = bStarted ? 1.0f : 0.0f;
+			break;
+
+		case EStoryTransition::Fade:
+			// Out to black over the first half, in from black over the second
+			OutgoingWeight = FMath::Max(1.0f - 2.0f * Progress, 0.0f);
+			IncomingWeight = FMath::Max(2.0f * Progress - 1.0f, 0.0f);
+			break;
+
+		case EStoryTransition::Crossfade:
+		default:
+			OutgoingWeight = 1.0f - Progress;
+			IncomingWeight = Progress;
+			break;
+	}
+
+	if (Progress >= 1.0f)
+	{
+		// Done: release the outgoing background
+		OutgoingTexture = nullptr;
+		OutgoingWeight = 0.0f;
+		IncomingWeight = 1.0f;
+		bIsTransitioning = false;
+		SetComponentTickEnabled(false);
+	}
+
+	ApplyToMaterial();
+}
+
+void UShortStoryTransitionComponent::ApplyToMaterial()
+{
+	if (!BackgroundMaterial)
+	{
+		return;
+	}
+
+	BackgroundMaterial->SetTextureParameterValue(OutgoingTextureParameter, OutgoingTexture);
+	BackgroundMaterial->SetTextureParameterValue(IncomingTextureParameter, IncomingTexture);
+	BackgroundMaterial->SetScalarParameterValue(OutgoingWeightParameter, OutgoingWeight);
+	BackgroundMaterial->SetScalarParameterValue(IncomingWeightParameter, IncomingWeight);
+}
@@ -0,0 +1,193 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "UObject/SoftObjectPath.h"
+
+class FShortStoryMockAudioBackend;
+class UAudioComponent;
+class UGameInstance;
+class UQuartzClockHandle;
+class USoundBase;
+class UWorld;
+
+/**
+ * Audio output used by UShortStoryAudioSubsystem
+ *
+ * Cue paths are the strings from the story file (@sfx events and the 'ost' metadata). Implement this to route
+ * story audio to middleware (FMOD, Wwise): PrepareCue resolves an event handle, ScheduleCue starts it on the
+ * middleware's own clock.
+ */
+class SHORTSTORY_API IShortStoryAudioBackend
+{
+public:
+	virtual ~IShortStoryAudioBackend() = default;
+
+	/** Name for logs */
+	virtual const TCHAR* GetName() const = 0;
+
+	/**
+	 * Resolve a cue before playback (called for every cue of a story when it starts)
+	 * @return False if the path cannot be played
+	 */
+	virtual bool PrepareCue(const FString& CuePath) = 0;
+
+	/** Forget prepared cues (called when the story stops) */
+	virtual void ReleaseCues() = 0;
+
+	/**
+	 * Play a cue
+	 * @param CuePath Cue to play
+	 * @param Delay Seconds from now until the cue must be audible; negative if late, in which case playback starts that far into the cue
+	 * @return Id for CancelCue, or INDEX_NONE if nothing plays
+	 */
+	virtual int32 ScheduleCue(const FString& CuePath, double Delay) = 0;
+
+	/** Cancel a cue that has not become audible yet */
+	virtual void CancelCue(int32 CueId) = 0;
+
+	/** Pause or resume everything the backend plays */
+	virtual void SetPaused(bool bPause) = 0;
+
+	/** Start the story music, replacing any playing */
+	virtual void PlayMusic(const FString& CuePath) = 0;
+
+	/** Stop the story music */
+	virtual void StopMusic() = 0;
+
+	/** Stop every cue and the music */
+	virtual void StopAll() = 0;
+
+	/** Can cues start at a future time; if not, each cue is sent when it is due (up to a frame late, started into the sound) */
+	virtual bool SupportsScheduling() const { return true; }
+
+	/** The mock backend, for debug commands that read its recorded cues; nullptr for every other backend */
+	virtual const FShortStoryMockAudioBackend* AsMock() const { return nullptr; }
+};
+
+/**
+ * Backend playing USoundBase assets through the engine audio mixer
+ *
+ * Cue paths are asset paths ("/Game/Audio/SFX_Door" or "/Game/Audio/SFX_Door.SFX_Door"), loaded when prepared.
+ * Future cues are queued on a Quartz clock ticking every millisecond, so the mixer starts them on the right
+ * audio buffer frame regardless of the game frame rate.
+ */
+class SHORTSTORY_API FShortStoryEngineAudioBackend : public IShortStoryAudioBackend, public FGCObject
+{
+public:
+	explicit FShortStoryEngineAudioBackend(UGameInstance* InGameInstance);
+	virtual ~FShortStoryEngineAudioBackend();
+
+	/** Asset path of a cue, or an empty path if the cue is not a content asset */
+	static FSoftObjectPath GetSoundPath(const FString& CuePath);
+
+	// IShortStoryAudioBackend interface
+	virtual const TCHAR* GetName() const override { return TEXT("Engine"); }
+	virtual bool PrepareCue(const FString& CuePath) override;
+	virtual void ReleaseCues() override;
+	virtual int32 ScheduleCue(const FString& CuePath, double Delay) override;
+	virtual void CancelCue(int32 CueId) override;
+	virtual void SetPaused(bool bPause) override;
+	virtual void PlayMusic(const FString& CuePath) override;
+	virtual void StopMusic() override;
+	virtual void StopAll() override;
+	virtual bool SupportsScheduling() const override;
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FShortStoryEngineAudioBackend"); }
+
+private:
+	/** One sound started or queued by ScheduleCue */
+	struct FActiveSound
+	{
+		int32 CueId = INDEX_NONE;
+		TObjectPtr<UAudioComponent> Component;
+		double AudibleTime = 0.0;
+	};
+
+	UWorld* GetWorld() const;
+
+	/** Prepared sound of a cue, loading it if PrepareCue was skipped */
+	USoundBase* FindSound(const FString& CuePath);
+
+	/** Millisecond clock of the current world (recreated after a level change) */
+	UQuartzClockHandle* GetClock(UWorld* World);
+
+	/** Drop finished sounds */
+	void PruneActiveSounds();
+
+	TWeakObjectPtr<UGameInstance> GameInstance;
+
+	/** Prepared cues (null = could not be loaded, not retried) */
+	TMap<FString, TObjectPtr<USoundBase>> Sounds;
+
+	TArray<FActiveSound> ActiveSounds;
+
+	TObjectPtr<UAudioComponent> MusicComponent;
+
+	TObjectPtr<UQuartzClockHandle> Clock;
+	TWeakObjectPtr<UWorld> ClockWorld;
+
+	int32 NextCueId = 0;
+};
+
+/**
+ * Backend that plays nothing and records every call, for headless runs (no audio device, -nullrhi, automation)
+ *
+ * Each cue is logged with the time it would have become audible, so scheduling accuracy can be checked
+ * without an audio mixer.
+ */
+class SHORTSTORY_API FShortStoryMockAudioBackend : public IShortStoryAudioBackend
+{
+public:
+	/** One ScheduleCue call */
+	struct FRecordedCue
+	{
+		int32 CueId = INDEX_NONE;
+		FString CuePath;
+
+		/** FApp::GetCurrentTime() of the call */
+		double ScheduledTime = 0.0;
+
+		/** FApp::GetCurrentTime() the cue would have become audible at */
+		double AudibleTime = 0.0;
+
+		bool bCancelled = false;
+	};
+
+	// IShortStoryAudioBackend interface
+	virtual const TCHAR* GetName() const override { return TEXT("Mock"); }
+	virtual bool PrepareCue(const FString& CuePath) override;
+	virtual void ReleaseCues() override;
+	virtual int32 ScheduleCue(const FString& CuePath, double Delay) override;
+	virtual void CancelCue(int32 CueId) override;
+	virtual void SetPaused(bool bPause) override { bIsPaused = bPause; }
+	virtual void PlayMusic(const FString& CuePath) override { Music = CuePath; }
+	virtual void StopMusic() override { Music.Reset(); }
+	virtual void StopAll() override;
+	virtual const FShortStoryMockAudioBackend* AsMock() const override { return this; }
+
+	/** Every cue scheduled since the last Reset */
+	const TArray<FRecordedCue>& GetRecordedCues() const { return RecordedCues; }
+
+	/** Cues prepared for the current story */
+	const TSet<FString>& GetPreparedCues() const { return PreparedCues; }
+
+	/** Music playing, empty if none */
+	const FString& GetMusic() const { return Music; }
+
+	bool IsPaused() const { return bIsPaused; }
+
+	/** Forget everything recorded */
+	void Reset();
+
+private:
+	TArray<FRecordedCue> RecordedCues;
+	TSet<FString> PreparedCues;
+	FString Music;
+	bool bIsPaused = false;
+	int32 NextCueId = 0;
+};
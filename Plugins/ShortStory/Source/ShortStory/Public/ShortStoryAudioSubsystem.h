@@ -0,0 +1,112 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "ShortStoryStructs.h"
+#include "ShortStoryAudioSubsystem.generated.h"
+
+class IShortStoryAudioBackend;
+class UShortStorySubsystem;
+enum class EStoryClockChange : uint8;
+
+/**
+ * Game instance subsystem playing @sfx events and the story OST on time
+ *
+ * Cues are resolved when a story starts. While it plays, every @sfx event entering the lookahead window is
+ * handed to the backend with its exact delay from now, computed from the story clock (so fast-forward and
+ * mid-frame starts are accounted for). The backend starts it on the audio clock, independent of the frame
+ * rate. Pauses, skips, fast-forward and screen changes cancel cues not yet audible and re-plan from the new
+ * screen time. Between cues the scheduler sleeps until the next one enters the window.
+ *
+ * The default backend plays USoundBase assets through Quartz; SetBackend swaps in middleware. Without an
+ * audio device (dedicated server, -nullrhi, automation) a mock backend records the cues instead.
+ */
+UCLASS(config=Game)
+class SHORTSTORY_API UShortStoryAudioSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Route story audio through another backend (e.g. FMOD or Wwise); stops everything the current one plays
+	 * @param NewBackend Backend to use, or null for the default
+	 */
+	void SetBackend(TSharedPtr<IShortStoryAudioBackend> NewBackend);
+
+	/** Get the backend in use */
+	IShortStoryAudioBackend* GetBackend() const { return Backend.Get(); }
+
+	/** Get the number of cues handed to the backend that are not audible yet */
+	int32 GetNumPendingCues() const { return PendingCues.Num(); }
+
+	/** Play @sfx events and the OST (when off, only OnTimedEventTriggered reports them) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Audio")
+	bool bScheduleStoryAudio = true;
+
+	/** How far ahead of the story clock cues are scheduled (keep above the worst frame time) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Audio", meta = (ClampMin = "0.02", ClampMax = "1.0"))
+	float LookaheadSeconds = 0.1f;
+
+	/** Use the recording mock backend even when audio can play */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Audio")
+	bool bUseMockBackend = false;
+
+private:
+	/** A cue handed to the backend */
+	struct FPendingCue
+	{
+		int32 CueId = INDEX_NONE;
+
+		/** FApp::GetCurrentTime() the cue becomes audible at */
+		double AudibleTime = 0.0;
+	};
+
+	/** Called by the story subsystem when its clock jumps or changes rate */
+	void HandleClockChanged(EStoryClockChange Change);
+
+	/** Resolve every cue of the playing story and start its OST */
+	void PrepareStory();
+
+	/** Cancel cues not audible yet and restart from the current screen time */
+	void Reschedule();
+
+	/** Hand cues entering the lookahead window to the backend, then sleep until the next one */
+	void ScheduleDueCues();
+
+	/** One-shot ticker waking the scheduler */
+	bool TickScheduler(float DeltaTime);
+
+	/** Cancel cues that are not audible yet */
+	void CancelPendingCues();
+
+	/** Stop the scheduler ticker */
+	void ClearTicker();
+
+	/** Audio output */
+	TSharedPtr<IShortStoryAudioBackend> Backend;
+
+	/** Cues handed to the backend that may not be audible yet */
+	TArray<FPendingCue> PendingCues;
+
+	/** Screen the cursor belongs to */
+	int32 ScheduledScreenIndex = INDEX_NONE;
+
+	/** Next timed event of that screen to consider */
+	int32 NextEventIndex = 0;
+
+	/** Ticker handle of the next wake-up */
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Story subsystem we follow */
+	TWeakObjectPtr<UShortStorySubsystem> StorySubsystem;
+
+	/** Handle of the OnClockChanged binding */
+	FDelegateHandle ClockChangedHandle;
+};
@@ -0,0 +1,165 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "ShortStoryBlipSubsystem.generated.h"
+
+class UAudioComponent;
+class UShortStoryBlipVoice;
+class UShortStorySubsystem;
+class USoundBase;
+struct FStreamableHandle;
+struct FShortStory;
+enum class EStoryClockChange : uint8;
+
+/**
+ * Game instance subsystem playing typewriter blips for the lines being revealed
+ *
+ * Each line speaks with the blip voice of its speaker (voice=<name>, or the story's 'voice' metadata). Reveal
+ * times come from the timeline baked at load time: a revealing line keeps a character cursor, so each frame
+ * only walks the characters that became visible since the last one. Blips are rate limited per voice, skip
+ * spaces and punctuation, and leave a gap after punctuation. They play through a fixed pool of audio
+ * components created up front, so dialogue uses at most MaxVoices voices and allocates nothing per character.
+ * Voice assets are loaded with the story audio by PrewarmStories; stories started without one load them in the background.
+ * The ticker only runs while a voiced line is revealing.
+ */
+UCLASS(config=Game)
+class SHORTSTORY_API UShortStoryBlipSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Get the number of lines currently blipping */
+	int32 GetNumActiveLines() const { return ActiveLines.Num(); }
+
+	/** Get the number of blips played since the subsystem started (also counted without an audio device) */
+	int32 GetNumBlipsPlayed() const { return NumBlipsPlayed; }
+
+	/** Play blips */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Blips")
+	bool bEnableBlips = true;
+
+	/** Voice name (voice=<name> in the story) to blip voice asset */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Blips")
+	TMap<FName, TSoftObjectPtr<UShortStoryBlipVoice>> Voices;
+
+	/** Audio components in the pool; a blip steals the oldest one when all are busy */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Blips", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 MaxVoices = 4;
+
+private:
+	/** Voice used by the playing story */
+	struct FResolvedVoice
+	{
+		/** Index into LoadedVoices */
+		int32 AssetIndex = INDEX_NONE;
+
+		/** Range of its sounds in LoadedSounds */
+		int32 FirstSound = 0;
+		int32 NumSounds = 0;
+
+		/** Sound played last (avoids repeats) */
+		int32 LastSound = INDEX_NONE;
+
+		/** FApp::GetCurrentTime() before which the voice stays silent (rate limit and punctuation gaps) */
+		double SilentUntil = 0.0;
+	};
+
+	/** Voiced typewriter line being revealed on the current screen */
+	struct FActiveLine
+	{
+		int32 LineIndex = INDEX_NONE;
+		int32 VoiceIndex = INDEX_NONE;
+
+		/** First character not walked yet */
+		int32 NextChar = 0;
+
+		/** Letters walked since the last blip, reset at word boundaries */
+		int32 LettersSinceBlip = 0;
+	};
+
+	/** Called by the story subsystem when lines start revealing */
+	void HandleLinesRevealed(FName StoryId, int32 ScreenIndex, int32 FirstLine, int32 LastLine);
+
+	/** Called by the story subsystem when its clock jumps or changes rate */
+	void HandleClockChanged(EStoryClockChange Change);
+
+	/** Called by the story subsystem when a story is prewarmed: adds the voices it uses */
+	void HandleGatherPrewarmAssets(const FShortStory& Story, TArray<FSoftObjectPath>& OutAssetPaths);
+
+	/** Resolve the voices the playing story uses from the loaded assets, and load the missing ones in the background */
+	void ResolveVoices(const FShortStory& Story);
+
+	/** Called when the voices missing at story start have loaded */
+	void HandleVoicesLoaded();
+
+	/**
+	 * Start following a line if it is a voiced typewriter line still revealing
+	 * Characters already visible are passed over silently (lines revealed by a skip never blip)
+	 */
+	void AddActiveLine(const FShortStory& Story, int32 LineIndex);
+
+	/** Follow every revealing line of the current screen again, from the current screen time */
+	void RebuildActiveLines();
+
+	/** Walk newly revealed characters and play due blips */
+	bool Tick(float DeltaTime);
+
+	/** Register the ticker if lines are revealing and playback runs; unregister it otherwise */
+	void UpdateTicker();
+
+	/** Play one blip of a voice through the pool */
+	void PlayBlip(FResolvedVoice& Voice);
+
+	/** Create the pool in the current world (again after a level change) */
+	bool EnsureVoicePool();
+
+	/** Stop and destroy the pool */
+	void DestroyVoicePool();
+
+	/** Voice assets of the playing story */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UShortStoryBlipVoice>> LoadedVoices;
+
+	/** Sounds of those voices, in voice order */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USoundBase>> LoadedSounds;
+
+	/** Pre-allocated audio components */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> VoicePool;
+
+	/** Background load of the voices the playing story started without */
+	TSharedPtr<FStreamableHandle> VoiceLoadHandle;
+
+	/** Voices of the playing story, and their names */
+	TArray<FResolvedVoice> ResolvedVoices;
+	TMap<FName, int32> VoiceIndices;
+
+	/** Lines being revealed (reserved up front) */
+	TArray<FActiveLine> ActiveLines;
+
+	/** World the pool was created in */
+	TWeakObjectPtr<UWorld> PoolWorld;
+
+	/** Pool component the next blip uses when none is free */
+	int32 NextPoolIndex = 0;
+
+	int32 NumBlipsPlayed = 0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Story subsystem we follow */
+	TWeakObjectPtr<UShortStorySubsystem> StorySubsystem;
+
+	FDelegateHandle LinesRevealedHandle;
+	FDelegateHandle ClockChangedHandle;
+	FDelegateHandle GatherPrewarmAssetsHandle;
+};
@@ -0,0 +1,47 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ShortStoryBlipVoice.generated.h"
+
+class USoundBase;
+
+/**
+ * Typewriter blip voice of a speaker, played by UShortStoryBlipSubsystem as their lines reveal
+ *
+ * Map it to a voice name in the subsystem's Voices config; lines pick it with voice=<name>.
+ */
+UCLASS(BlueprintType)
+class SHORTSTORY_API UShortStoryBlipVoice : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Blip sounds; one is picked per blip, never the same twice in a row when there are several (loaded with the voice) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip")
+	TArray<TObjectPtr<USoundBase>> Sounds;
+
+	/** Letters revealed per blip (the first letter of each word always blips) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 LettersPerBlip = 2;
+
+	/** Shortest time between two blips of this voice, in real seconds (also caps blips while fast-forwarding) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinInterval = 0.05f;
+
+	/** Silence after punctuation (. , ; : ! ?), in real seconds, so phrasing stays audible while fast-forwarding */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip", meta = (ClampMin = "0.0", ClampMax = "2.0"))
+	float PunctuationGap = 0.12f;
+
+	/** Random pitch range of each blip */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip", meta = (ClampMin = "0.1", ClampMax = "4.0"))
+	float MinPitch = 0.95f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip", meta = (ClampMin = "0.1", ClampMax = "4.0"))
+	float MaxPitch = 1.05f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Blip", meta = (ClampMin = "0.0", ClampMax = "4.0"))
+	float Volume = 1.0f;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "ShortStoryStructs.h"
+#include "ShortStoryTextLayout.h"
 #include "ShortStoryBlueprintLibrary.generated.h"
 
 /**
@@ -26,7 +27,7 @@ public:
 	static float GetPauseDurationSeconds(EStoryPauseDuration Pause);
 
 	/**
-	 * Calculate word positions for animated text
+	 * Calculate word positions for animated text (measured with the default font, cached)
 	 * @param Text The text to position
 	 * @param AnimType Animation type
 	 * @param CanvasSize Size of the canvas (for bounds calculation)
@@ -36,6 +37,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Narrative|Short Stories")
 	static TArray<FVector2D> CalculateWordPositions(const FString& Text, EStoryLineAnimation AnimType, FVector2D CanvasSize, float FontSize = 24.0f);
 
+	/**
+	 * Get the cached word layout for animated text, measured with the given font
+	 * @param Text The text to position
+	 * @param AnimType Animation type
+	 * @param CanvasSize Size of the canvas (for bounds calculation)
+	 * @param Font Font the widget renders the text with
+	 * @return Word rectangles (position and measured size) in reading order
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Short Stories")
+	static FStoryTextLayout GetTextLayout(const FString& Text, EStoryLineAnimation AnimType, FVector2D CanvasSize, const FSlateFontInfo& Font);
+
 	/**
 	 * Trigger a story effect (screen shake, storm, etc.)
 	 * @param WorldContextObject World context
@@ -0,0 +1,222 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ShortStoryStructs.h"
+#include <atomic>
+
+/**
+ * Read-mostly cache of parsed stories
+ *
+ * Reads never lock: the cache is an immutable snapshot (key hash -> story) published through an atomic
+ * pointer. Writers serialise on a mutex, copy the snapshot (stories are shared between snapshots, so only
+ * the map is copied), publish the copy and retire the old one. Retired snapshots are deleted on the game
+ * thread once no other thread is inside an FReadScope.
+ *
+ * Keys are case-insensitive 64-bit FNV-1a hashes of the story file name, computed without allocating.
+ * The stored file name is compared on a hit, so a hash collision can never return the wrong story.
+ *
+ * Every story is sized when added (text, baked timelines and runtime texture memory) and stamped on each
+ * hit; Trim evicts the least recently used stories until the cache fits a byte budget.
+ *
+ * A story can carry its translation into one culture. The translation is sized with the story and leaves
+ * the cache with it, so the budget bounds translated text too.
+ */
+class SHORTSTORY_API FShortStoryCache
+{
+public:
+	typedef TSharedRef<const FShortStory, ESPMode::ThreadSafe> FStoryRef;
+	typedef TSharedPtr<const FShortStory, ESPMode::ThreadSafe> FStoryPtr;
+
+	/** One cached story with its accounting */
+	struct FCachedStory
+	{
+		FCachedStory(const FString& InFileName, FStoryRef InStory);
+
+		/** File name the story was loaded with */
+		FString FileName;
+
+		/** Parsed story (shared by every snapshot holding it) */
+		FStoryRef Story;
+
+		/** Bytes of text, lines and baked timelines */
+		int64 TextBytes = 0;
+
+		/** Bytes of runtime background textures (CPU copy and GPU resource) */
+		int64 TextureBytes = 0;
+
+		/** Story with its lines in TranslationCulture (null if that culture has no translation of it) */
+		FStoryPtr Translation;
+
+		/** Culture the translation was looked up for (empty = not looked up) */
+		FString TranslationCulture;
+
+		/** Bytes of the translation's text, lines and baked timelines (its textures are the story's) */
+		int64 TranslationBytes = 0;
+
+		/** Access stamp, higher = more recently used */
+		mutable std::atomic<uint64> LastUsed;
+
+		int64 GetTotalBytes() const { return TextBytes + TranslationBytes + TextureBytes; }
+	};
+
+	/** Cache totals */
+	struct FStats
+	{
+		int32 NumStories = 0;
+
+		/** Text of the stories and of their translations */
+		int64 TextBytes = 0;
+		int64 TextureBytes = 0;
+		int32 NumEvictions = 0;
+
+		int64 GetTotalBytes() const { return TextBytes + TextureBytes; }
+	};
+
+	FShortStoryCache();
+	~FShortStoryCache();
+
+	FShortStoryCache(const FShortStoryCache&) = delete;
+	FShortStoryCache& operator=(const FShortStoryCache&) = delete;
+
+	/** Case-insensitive key hash of a story file name */
+	static uint64 HashKey(FStringView StoryFileName);
+
+	/**
+	 * Measure the memory held by a story
+	 * @param Story Parsed story
+	 * @param OutTextBytes Text, lines and baked timelines
+	 * @param OutTextureBytes Runtime background textures, each counted once
+	 */
+	static void CalculateStorySize(const FShortStory& Story, int64& OutTextBytes, int64& OutTextureBytes);
+
+	/**
+	 * Find a cached story (wait-free, no allocation) and mark it as recently used
+	 * On the game thread the pointer stays valid until the story is removed; on other threads only
+	 * while an FReadScope is open.
+	 * @param StoryFileName Story file name (case-insensitive)
+	 * @return Story, or null if not cached
+	 */
+	const FShortStory* Find(FStringView StoryFileName) const;
+
+	/**
+	 * Find a cached story and share it, so it outlives its removal from the cache
+	 * @param StoryFileName Story file name (case-insensitive)
+	 * @return Story, or null if not cached
+	 */
+	FStoryPtr FindShared(FStringView StoryFileName) const;
+
+	/** Is a story cached (wait-free, no allocation, does not count as a use) */
+	bool Contains(FStringView StoryFileName) const;
+
+	/**
+	 * Find the translation of a cached story (wait-free, no allocation); valid like the result of Find
+	 * @param StoryFileName Story file name (case-insensitive)
+	 * @param Culture Culture of the translation
+	 * @param bOutLookedUp True if the story's translation into Culture was looked up, even if it has none
+	 * @return Translation, or null
+	 */
+	const FShortStory* FindTranslation(FStringView StoryFileName, FStringView Culture, bool& bOutLookedUp) const;
+
+	/**
+	 * Attach the translation of a cached story, replacing any other culture's
+	 * @param StoryFileName Story file name (case-insensitive)
+	 * @param Culture Culture of the translation
+	 * @param Translation Translated story, or null if the culture has none (remembered, so it is not looked up again)
+	 * @return False if the story is not cached
+	 */
+	bool SetTranslation(FStringView StoryFileName, const FString& Culture, FStoryPtr Translation);
+
+	/**
+	 * Drop the translation of every story (e.g. when the culture changes)
+	 */
+	void ClearTranslations();
+
+	/**
+	 * Add or replace a story
+	 * @return The story it replaced, if any
+	 */
+	FStoryPtr Add(const FString& StoryFileName, const FShortStory& Story);
+
+	/**
+	 * Remove a story
+	 * @return The removed story, or null if it was not cached
+	 */
+	FStoryPtr Remove(FStringView StoryFileName);
+
+	/**
+	 * Remove every story
+	 * @return The removed stories
+	 */
+	TArray<FStoryRef> Empty();
+
+	/**
+	 * Evict least recently used stories until the cache fits the budget
+	 * @param BudgetBytes Maximum total bytes
+	 * @param ProtectedKeys Keys (HashKey) of stories that must stay, e.g. the playing story
+	 * @return The evicted stories
+	 */
+	TArray<FStoryRef> Trim(int64 BudgetBytes, TConstArrayView<uint64> ProtectedKeys);
+
+	/** Number of cached stories */
+	int32 Num() const;
+
+	/** Current totals */
+	FStats GetStats() const;
+
+	/** Visit every story of the current snapshot */
+	void ForEach(TFunctionRef<void(const FCachedStory& Entry)> Visitor) const;
+
+	/** Delete retired snapshots; game thread only (done automatically after game thread writes) */
+	void ReclaimRetired();
+
+	/** Open around reads from threads other than the game thread; snapshots are not reclaimed meanwhile */
+	class FReadScope
+	{
+	public:
+		explicit FReadScope(const FShortStoryCache& InCache) : Cache(InCache) { Cache.ActiveReaders.fetch_add(1); }
+		~FReadScope() { Cache.ActiveReaders.fetch_sub(1); }
+
+	private:
+		const FShortStoryCache& Cache;
+	};
+
+private:
+	typedef TSharedRef<FCachedStory, ESPMode::ThreadSafe> FEntryRef;
+
+	struct FSnapshot
+	{
+		TMap<uint64, FEntryRef> Entries;
+	};
+
+	/** Find the entry of a file name in a snapshot */
+	static const FEntryRef* FindEntry(const FSnapshot& Snapshot, uint64 Key, FStringView StoryFileName);
+
+	/** Copy an entry's story and accounting, without its translation */
+	static FEntryRef CopyEntry(const FCachedStory& Entry);
+
+	/** Swap in a new snapshot and retire the current one (WriteMutex must be held) */
+	void Publish(const FSnapshot* NewSnapshot);
+
+	/** Reclaim right away when written from the game thread */
+	void OnWritten();
+
+	/** Published snapshot (never null) */
+	std::atomic<const FSnapshot*> Current;
+
+	/** Open FReadScopes */
+	mutable std::atomic<int32> ActiveReaders;
+
+	/** Source of LRU stamps */
+	mutable std::atomic<uint64> AccessClock;
+
+	/** Stories evicted by Trim since startup */
+	std::atomic<int32> NumEvictions;
+
+	/** Serialises writers */
+	FCriticalSection WriteMutex;
+
+	/** Snapshots replaced but possibly still being read */
+	TArray<const FSnapshot*> Retired;
+};
@@ -0,0 +1,142 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ShortStoryStructs.h"
+#include "ShortStoryHistorySubsystem.generated.h"
+
+class UShortStorySubsystem;
+
+/**
+ * One materialised row of the history log
+ */
+USTRUCT(BlueprintType)
+struct FStoryHistoryRow
+{
+	GENERATED_BODY()
+
+	/** Text of the source line, its wrapped parts joined, in the culture shown now (empty if the story is no longer loaded, see bIsResolved) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FString Text;
+
+	/** Styled spans over Text */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	TArray<FStoryTextSpan> Spans;
+
+	/** Story the line belongs to */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FName StoryId;
+
+	/** Screen index within the story */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 ScreenIndex = 0;
+
+	/** Source line index within the screen (the same in every culture) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 SourceLineIndex = 0;
+
+	/** First displayed line of the source line within the screen (only set when resolved) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 LineIndex = 0;
+
+	/** Is this the first logged row of a screen (for separators in the log widget) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	bool bStartsScreen = false;
+
+	/** Could the text be resolved from a loaded story */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	bool bIsResolved = false;
+
+	FStoryHistoryRow() = default;
+};
+
+/**
+ * Game instance subsystem keeping a scrollable log of revealed story lines
+ *
+ * Lines are recorded as compact (story, screen, source line) references in a fixed-capacity ring buffer;
+ * text is only resolved for the rows a widget asks for. Memory stays constant however long the
+ * session runs, and rewinding or jumping screens never erases what was already read. Source lines
+ * are counted the same way in every culture, so rows read in the current language after a switch.
+ *
+ * Example usage:
+ *   UShortStoryHistorySubsystem* History = GetGameInstance()->GetSubsystem<UShortStoryHistorySubsystem>();
+ *   TArray<FStoryHistoryRow> Rows = History->GetHistoryPage(FirstVisibleRow, VisibleRowCount);
+ */
+UCLASS(config=Game)
+class SHORTSTORY_API UShortStoryHistorySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Get the number of rows in the log (at most HistoryCapacity)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story History")
+	int32 GetHistoryCount() const { return Count; }
+
+	/**
+	 * Materialise a page of the log
+	 * @param FirstRow Index of the first row (0 = oldest retained line)
+	 * @param NumRows Number of rows to return (clamped to the log size)
+	 * @return Rows in reading order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Story History")
+	TArray<FStoryHistoryRow> GetHistoryPage(int32 FirstRow, int32 NumRows) const;
+
+	/**
+	 * Materialise the most recent rows of the log
+	 * @param NumRows Number of rows to return (clamped to the log size)
+	 * @return Rows in reading order, ending with the latest line
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Story History")
+	TArray<FStoryHistoryRow> GetLatestHistory(int32 NumRows) const;
+
+	/**
+	 * Clear the log
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Story History")
+	void ClearHistory();
+
+	/** Maximum number of lines kept; older lines are overwritten */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "History", meta = (ClampMin = "16", ClampMax = "65536"))
+	int32 HistoryCapacity = 2048;
+
+private:
+	/** Compact reference to one revealed source line (no text) */
+	struct FHistoryEntry
+	{
+		FName StoryId;
+		uint16 ScreenIndex = 0;
+		uint16 SourceLineIndex = 0;
+	};
+
+	/** Called by the story subsystem when lines start revealing */
+	void HandleLinesRevealed(FName StoryId, int32 ScreenIndex, int32 FirstLine, int32 LastLine);
+
+	/** Append one entry, overwriting the oldest when full */
+	void AddEntry(FName StoryId, int32 ScreenIndex, int32 SourceLineIndex);
+
+	/** Entry at a logical row (0 = oldest) */
+	const FHistoryEntry& GetEntry(int32 Row) const { return Entries[(Head + Row) % Entries.Num()]; }
+
+	/** Ring storage, allocated once at HistoryCapacity */
+	TArray<FHistoryEntry> Entries;
+
+	/** Physical index of the oldest entry */
+	int32 Head = 0;
+
+	/** Number of valid entries */
+	int32 Count = 0;
+
+	/** Story subsystem we listen to */
+	TWeakObjectPtr<UShortStorySubsystem> StorySubsystem;
+
+	/** Handle of the OnLinesRevealed binding */
+	FDelegateHandle LinesRevealedHandle;
+};
@@ -0,0 +1,106 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Per-culture, per-story string table mapping line ids to translated text
+ *
+ * Translators edit Stories/Loc/<Culture>/<Story>.csv (Id,Text), one row per source text line with its
+ * inline markup. On first use the CSV is compiled into a flat binary table (.stbl next to it) which is
+ * memory-mapped, so loading a story's translation only reads the pages of the lines it looks up.
+ *
+ * Binary layout (native endian):
+ *   uint32 Magic, uint32 Version, uint32 Count, uint32 PoolLength
+ *   int32  Ids[Count]            (sorted ascending)
+ *   uint32 Offsets[Count + 1]    (UTF-16 code units into the pool)
+ *   UTF16  Pool[PoolLength]
+ */
+class SHORTSTORY_API FShortStoryStringTable
+{
+public:
+	~FShortStoryStringTable();
+
+	/**
+	 * Load a compiled table, memory-mapping it when the platform supports it
+	 * @param TablePath Absolute path to a .stbl file
+	 * @return Table, or null if the file is missing or invalid
+	 */
+	static TSharedPtr<FShortStoryStringTable> LoadCompiled(const FString& TablePath);
+
+	/**
+	 * Build a table in memory from a translation CSV (used when the compiled table cannot be written)
+	 * @param CsvPath Absolute path to the CSV
+	 * @return Table, or null if the CSV could not be read
+	 */
+	static TSharedPtr<FShortStoryStringTable> LoadFromCsv(const FString& CsvPath);
+
+	/**
+	 * Find and load the translation of a story, compiling its CSV if the table is missing or stale
+	 * Safe to call from worker threads
+	 * @param LocDirectory Root of the translation files (Stories/Loc)
+	 * @param CultureNames Cultures to try, most specific first (e.g. en-US, then en)
+	 * @param StoryFileName Story file name relative to the stories directory
+	 * @return Table, or null if no culture has a translation of the story
+	 */
+	static TSharedPtr<FShortStoryStringTable> LoadForStory(const FString& LocDirectory, const TArray<FString>& CultureNames, const FString& StoryFileName);
+
+	/**
+	 * Compile a translation CSV into the binary table format
+	 * @param CsvPath Absolute path to the CSV (Id,Text per row; Text may be quoted)
+	 * @param TablePath Absolute path of the .stbl to write
+	 * @return True if the table was written
+	 */
+	static bool CompileCsv(const FString& CsvPath, const FString& TablePath);
+
+	/**
+	 * Parse a translation CSV into id/text pairs
+	 * @param CsvText CSV file contents
+	 * @param OutStrings Parsed strings (later rows win on duplicate ids)
+	 * @return Number of rows that failed to parse
+	 */
+	static int32 ParseCsv(const FString& CsvText, TMap<int32, FString>& OutStrings);
+
+	/**
+	 * Serialise id/text pairs into the binary table format
+	 */
+	static void BuildTableData(const TMap<int32, FString>& Strings, TArray<uint8>& OutData);
+
+	/**
+	 * Look up a line
+	 * @param LineId Stable line id
+	 * @param OutText Translated text
+	 * @return True if the table has the line
+	 */
+	bool FindString(int32 LineId, FString& OutText) const;
+
+	/** Number of strings in the table */
+	int32 Num() const { return Count; }
+
+	/** Is the table backed by a memory-mapped file */
+	bool IsMemoryMapped() const { return MappedRegion != nullptr; }
+
+private:
+	FShortStoryStringTable() = default;
+
+	/** Validate the header and point the views at the table data */
+	bool Bind(const uint8* Data, int64 Size);
+
+	/** Mapping of the compiled file (null when loaded into memory) */
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** Owned table data when the file could not be mapped */
+	TArray<uint8> OwnedData;
+
+	/** Views into the table data */
+	const int32* Ids = nullptr;
+	const uint32* Offsets = nullptr;
+	const UTF16CHAR* Pool = nullptr;
+	int32 Count = 0;
+	uint32 PoolLength = 0;
+};
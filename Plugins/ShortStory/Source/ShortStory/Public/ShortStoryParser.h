@@ -7,6 +7,38 @@
 #include "ShortStory.h"
 #include "ShortStoryParser.generated.h"
 
+/**
+ * Inline markup style state carried across the wrapped segments of one text block
+ */
+struct FStoryMarkupState
+{
+	/** Active EStoryTextStyle flags (excluding Color) */
+	int32 StyleFlags = 0;
+
+	/** Nested <b>/<i>/<shake> open counts */
+	int32 BoldDepth = 0;
+	int32 ItalicDepth = 0;
+	int32 ShakeDepth = 0;
+
+	/** Open <color> tags, innermost last */
+	TArray<FLinearColor> ColorStack;
+};
+
+/**
+ * One translatable source text line, as written in the story file
+ */
+struct FStorySourceString
+{
+	/** Localisation id shared by every displayed line wrapped from this text */
+	int32 LineId = 0;
+
+	/** Index of the screen holding the line */
+	int32 ScreenIndex = INDEX_NONE;
+
+	/** Raw text, including inline markup and manual '\\' breaks */
+	FString Text;
+};
+
 /**
  * Static utility class for parsing .tos (Theory of Magic Story) files
  *
@@ -19,7 +51,10 @@
  * background = /Game/Textures/Path
  * transition = fade
  *
- * TEXT | ANIMATION | PAUSE | EFFECT [| OFFSET_X,OFFSET_Y]
+ * TEXT | ANIMATION [| speed=X | pause=X | effect=X | offset=X,Y | voice=X | id=X]
+ *
+ * Inline markup inside TEXT: <b>, <i>, <shake>, <color=#RGB[A]|#RRGGBB[AA]> (closed with </tag>)
+ * and <wait=SECONDS>. Unrecognised tags are kept as literal text.
  * @sfx Event:/SFX/Path | StartTime
  * @vfx BP_ParticleClass | StartTime | Duration
  */
@@ -33,12 +68,24 @@ public:
 	 * Parse a .tos file from disk
 	 * @param StoryFilePath Absolute path to .tos file
 	 * @param OutStory Parsed story data
-	 * @param OutErrors Array of error messages with line numbers
+	 * @param OutErrors Array of error messages with line numbers (see FStoryParseDiagnostic::ToString)
 	 * @param MaxLineLength Maximum character count for auto-wrapping text
 	 * @return True if parsing succeeded (OutStory is valid)
 	 */
 	static bool ParseStoryFile(const FString& StoryFilePath, FShortStory& OutStory, TArray<FString>& OutErrors, int32 MaxLineLength = 80);
 
+	/**
+	 * Parse a .tos file from disk, reporting structured diagnostics
+	 * Safe to call from worker threads (no UObject or subsystem access)
+	 * @param StoryFilePath Absolute path to .tos file
+	 * @param OutStory Parsed story data
+	 * @param OutDiagnostics Every problem found, in source order (file-level problems have Line 0)
+	 * @param MaxLineLength Maximum character count for auto-wrapping text
+	 * @param OutSourceStrings If set, receives every translatable source text line in source order
+	 * @return True if parsing succeeded (OutStory is valid); warnings and recovered errors may still be reported
+	 */
+	static bool ParseStoryFile(const FString& StoryFilePath, FShortStory& OutStory, TArray<FStoryParseDiagnostic>& OutDiagnostics, int32 MaxLineLength = 80, TArray<FStorySourceString>* OutSourceStrings = nullptr);
+
 	/**
 	 * Parse a .tos format string
 	 * @param StoryText Raw text content
@@ -49,8 +96,48 @@ public:
 	 */
 	static bool ParseStoryFromString(const FString& StoryText, FShortStory& OutStory, TArray<FString>& OutErrors, int32 MaxLineLength = 80);
 
+	/**
+	 * Parse a .tos format string, reporting structured diagnostics
+	 * @param StoryText Raw text content
+	 * @param OutStory Parsed story data
+	 * @param OutDiagnostics Every problem found, in source order
+	 * @param MaxLineLength Maximum character count for auto-wrapping text
+	 * @param OutSourceStrings If set, receives every translatable source text line in source order
+	 * @return True if parsing succeeded (OutStory is valid)
+	 */
+	static bool ParseStoryFromString(const FString& StoryText, FShortStory& OutStory, TArray<FStoryParseDiagnostic>& OutDiagnostics, int32 MaxLineLength = 80, TArray<FStorySourceString>* OutSourceStrings = nullptr);
+
 	static bool ParseStoryLine(const FString& Line, int32 LineNumber, TArray<FStoryLine>& OutLines, FString& OutError);
 
+	/**
+	 * Build the stable localisation id of a source text line
+	 * Every displayed line wrapped from the same source line shares its id
+	 * @param ScreenName Name of the screen section (e.g. "SCREEN_01_INTRO")
+	 * @param LineKey The line's id= attribute, or its raw text when it has none
+	 * @param Occurrence Number of earlier source lines on the screen with the same key
+	 * @return Non-zero line id
+	 */
+	static int32 MakeLineId(const FString& ScreenName, const FString& LineKey, int32 Occurrence);
+
+	/**
+	 * Process a text string into final story lines (handling wrapping, spacers, etc.)
+	 * Also used to wrap translated text at load time
+	 * @param Text Content text
+	 * @param Attributes Attributes copied onto every resulting line
+	 * @param Pause Pause to apply (usually only to the last part)
+	 * @param OutLines Resulting lines
+	 * @param MaxLineLength Maximum character count for auto-wrapping text
+	 */
+	static void ProcessTextToLines(const FString& Text, const FStoryLine& Attributes, EStoryPauseDuration Pause, TArray<FStoryLine>& OutLines, int32 MaxLineLength = 80);
+
+	/**
+	 * Strip inline markup from a text segment and build its styled spans and inline waits
+	 * @param RawText Segment text including markup
+	 * @param OutLine Line receiving Text, Spans and InlineWaits
+	 * @param InOutState Style state carried over from the previous segment of the same block
+	 */
+	static void ParseInlineMarkup(const FString& RawText, FStoryLine& OutLine, FStoryMarkupState& InOutState);
+
 private:
 	/**
 	 * Parse a metadata line (key = value format)
@@ -62,28 +149,16 @@ private:
 
 	/**
 	 * Parse a story line string into its components (Text + Metadata)
-	 * @param Line Raw line text
+	 * @param Line Cleaned line text
+	 * @param LineNumber Line number in file (for diagnostics)
+	 * @param ColumnBase Source column of the first character of Line
 	 * @param OutText The text content
-	 * @param OutAnim Animation type
-	 * @param OutPause Pause duration
-	 * @param OutEffect Visual effect
-	 * @param OutOffset Position offset
-	 * @param OutError Error message
-	 * @return True if valid
+	 * @param OutAttributes Line attributes (animation, speed, pause, effect, offset); Text is left empty
+	 * @param OutLineKey The id= attribute, empty if the line has none
+	 * @param OutDiagnostics Receives one diagnostic per bad field
+	 * @return True if the line produces text (bad optional fields are reported but do not fail the line)
 	 */
-	static bool ParseLineAttributes(const FString& Line, FString& OutText, EStoryLineAnimation& OutAnim, EStorySpeed& OutSpeed, EStoryPauseDuration& OutPause, EStoryEffect& OutEffect, FVector2D& OutOffset, FString& OutError);
-
-	/**
-	 * Process a text string into final story lines (handling wrapping, spacers, etc.)
-	 * @param Text Content text
-	 * @param Anim Animation to apply
-	 * @param Pause Pause to apply (usually only to the last part)
-	 * @param Effect Effect to apply
-	 * @param Offset Offset to apply
-	 * @param OutLines Resulting lines
-	 * @param MaxLineLength Maximum character count for auto-wrapping text
-	 */
-	static void ProcessTextToLines(const FString& Text, EStoryLineAnimation Anim, EStorySpeed Speed, EStoryPauseDuration Pause, EStoryEffect Effect, FVector2D Offset, TArray<FStoryLine>& OutLines, int32 MaxLineLength = 80);
+	static bool ParseLineAttributes(const FString& Line, int32 LineNumber, int32 ColumnBase, FString& OutText, FStoryLine& OutAttributes, FString& OutLineKey, TArray<FStoryParseDiagnostic>& OutDiagnostics);
 
 	/**
 	 * Helper to split text into chunks respecting word boundaries
@@ -93,15 +168,24 @@ private:
 	 */
 	static TArray<FString> SplitTextByLength(const FString& Text, int32 MaxLen);
 
+	/**
+	 * Check whether a recognised inline tag starts at the given index
+	 * @param Text Raw text
+	 * @param Index Index to test (must point at '<')
+	 * @return Length of the tag in characters, or 0 if no valid tag starts there
+	 */
+	static int32 MatchInlineTag(const FString& Text, int32 Index);
+
 	/**
 	 * Parse a timed event command (@sfx, @vfx, @wait, @background)
 	 * @param Line Raw line text (without @ prefix)
 	 * @param LineNumber Line number in file (for error reporting)
+	 * @param Column Source column of the '@'
 	 * @param OutEvent Parsed event data
-	 * @param OutError Error message if parsing fails
+	 * @param OutDiagnostics Receives problems with the event
 	 * @return True if line is valid timed event
 	 */
-	static bool ParseTimedEvent(const FString& Line, int32 LineNumber, FStoryTimedEvent& OutEvent, FString& OutError);
+	static bool ParseTimedEvent(const FString& Line, int32 LineNumber, int32 Column, FStoryTimedEvent& OutEvent, TArray<FStoryParseDiagnostic>& OutDiagnostics);
 
 	/**
 	 * Parse animation type from string
@@ -118,7 +202,16 @@ private:
 	 * @return True if valid pause duration
 	 */
 	static bool ParsePauseDuration(const FString& PauseString, EStoryPauseDuration& OutPause);
-	static bool ParseSpeed(const FString& SpeedString, EStorySpeed& OutSpeed);
+
+	/**
+	 * Parse speed from string
+	 * Accepts a built-in speed ("fast"), a named profile ("whisper" -> Speed_Whisper.csv)
+	 * or a numeric per-letter override in seconds ("0.02")
+	 * @param SpeedString String representation
+	 * @param OutLine Line receiving Speed, SpeedProfile or PerLetterOverride
+	 * @return True if valid speed
+	 */
+	static bool ParseSpeed(const FString& SpeedString, FStoryLine& OutLine);
 
 	/**
 	 * Parse effect type from string
@@ -0,0 +1,30 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ShortStoryPrewarmManifest.generated.h"
+
+class UTexture2D;
+
+/**
+ * Stories a level can start, loaded ahead of time with UShortStorySubsystem::PrewarmStories
+ *
+ * Prewarm it while the level streams in (e.g. behind the loading screen) so the first StartStory
+ * is served from the cache without touching the disk.
+ */
+UCLASS(BlueprintType)
+class SHORTSTORY_API UShortStoryPrewarmManifest : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Story files to parse and cache (relative to the Stories directory, e.g. "Orazio.tos") */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prewarm")
+	TArray<FString> StoryFiles;
+
+	/** Extra background assets to stream in (asset backgrounds referenced by StoryFiles are included automatically) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Prewarm")
+	TArray<TSoftObjectPtr<UTexture2D>> Backgrounds;
+};
@@ -71,6 +71,104 @@ struct FStoryAnimationTiming
 	FStoryAnimationTiming() = default;
 };
 
+/**
+ * Inline text style flags (from <b>, <i>, <shake>, <color> markup)
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EStoryTextStyle : uint8
+{
+	None				= 0 UMETA(Hidden),
+	Bold				= 1 << 0 UMETA(DisplayName = "Bold"),
+	Italic				= 1 << 1 UMETA(DisplayName = "Italic"),
+	Shake				= 1 << 2 UMETA(DisplayName = "Shake"),
+	Color				= 1 << 3 UMETA(DisplayName = "Color")
+};
+ENUM_CLASS_FLAGS(EStoryTextStyle);
+
+/**
+ * Run of consecutive visible characters sharing the same inline style
+ * Offsets index into FStoryLine::Text (markup already stripped)
+ */
+USTRUCT(BlueprintType)
+struct FStoryTextSpan
+{
+	GENERATED_BODY()
+
+	/** Index of the first visible character in this span */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 StartIndex = 0;
+
+	/** Number of visible characters in this span */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 Length = 0;
+
+	/** Combination of EStoryTextStyle flags */
+	UPROPERTY(BlueprintReadOnly, Category = "Story", meta = (Bitmask, BitmaskEnum = "/Script/ShortStory.EStoryTextStyle"))
+	int32 StyleFlags = 0;
+
+	/** Text color (only meaningful when the Color flag is set) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FLinearColor Color = FLinearColor::White;
+
+	FStoryTextSpan() = default;
+
+	bool HasStyle(EStoryTextStyle Style) const
+	{
+		return (StyleFlags & static_cast<int32>(Style)) != 0;
+	}
+};
+
+/**
+ * Inline reveal pause from <wait=X> markup
+ */
+USTRUCT(BlueprintType)
+struct FStoryInlineWait
+{
+	GENERATED_BODY()
+
+	/** Visible character index the wait happens before (Text.Len() = end of line) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 CharIndex = 0;
+
+	/** Wait duration in seconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float Duration = 0.0f;
+
+	FStoryInlineWait() = default;
+};
+
+/**
+ * Reveal timeline for a single line, baked once at load time
+ * Playback and rendering read it instead of re-scanning the text every frame
+ */
+USTRUCT(BlueprintType)
+struct FStoryRevealTimeline
+{
+	GENERATED_BODY()
+
+	/** Time (seconds from line start) at which each character becomes visible */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	TArray<float> CharRevealTimes;
+
+	/** Total typewriter duration, including the extra delay after the last character */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float TypewriterDuration = 0.0f;
+
+	/** Per-letter typing time the timeline was baked with */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float PerLetter = 0.0f;
+
+	/** Fixed duration used by block animations (Paragraph, TopDown, WordRain, ...) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float BlockDuration = 0.0f;
+
+	/** Has this timeline been baked? Lines built at runtime fall back to on-the-fly calculation */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	bool bIsBaked = false;
+
+	FStoryRevealTimeline() = default;
+};
+
 
 /**
  * Pause duration after a line
@@ -150,6 +248,50 @@ struct FStoryTimedEvent
 	FStoryTimedEvent() = default;
 };
 
+/**
+ * One playback step of a screen: a single line, or a TopDown/Paragraph block started together
+ * Baked at load time so skips can jump across steps without replaying them
+ */
+USTRUCT(BlueprintType)
+struct FStoryLineSegment
+{
+	GENERATED_BODY()
+
+	/** First line of the segment */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 FirstLine = 0;
+
+	/** Last line of the segment (its pause applies to the whole segment) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 LastLine = 0;
+
+	/** Time from segment start until the last line of the segment finishes animating */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float Duration = 0.0f;
+
+	/** Pause after the segment in seconds (0 for Wait pauses) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float PauseAfter = 0.0f;
+
+	/** Does the segment end in a Wait-for-input pause? */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	bool bEndsInWait = false;
+
+	/** Run this segment belongs to (runs are separated by Wait pauses) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 RunIndex = 0;
+
+	/** Start time relative to the start of its run */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float RunOffset = 0.0f;
+
+	/** First segment at or after this one that ends in a Wait or ends the screen */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 NextStableSegment = 0;
+
+	FStoryLineSegment() = default;
+};
+
 /**
  * Single line of story text with animation parameters
  * Corresponds to one pipe-delimited line in .tos file
@@ -159,10 +301,22 @@ struct FStoryLine
 {
 	GENERATED_BODY()
 
-	/** The text content of this line */
+	/** The text content of this line in the active story culture (inline markup stripped, see Spans) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	FString Text;
 
+	/** Styled spans over Text, pre-tokenised from inline markup (empty for plain lines) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	TArray<FStoryTextSpan> Spans;
+
+	/** Stable localisation id of the source line this line was wrapped from (screen name plus id= or text), 0 for spacers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	int32 LineId = 0;
+
+	/** Inline reveal pauses from <wait=X> markup, sorted by character index */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	TArray<FStoryInlineWait> InlineWaits;
+
 	/** Animation type for this line */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	EStoryLineAnimation AnimationType = EStoryLineAnimation::Typewriter;
@@ -171,6 +325,26 @@ struct FStoryLine
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	EStorySpeed Speed = EStorySpeed::Standard;
 
+	/** Named speed profile (e.g. "Whisper" for Speed_Whisper.csv). None falls back to the story default, then Speed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	FName SpeedProfile;
+
+	/** Inline per-letter override in seconds (speed=0.02). Zero or less uses the profile value */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	float PerLetterOverride = 0.0f;
+
+	/** Blip voice of the speaker (voice=name, see UShortStoryBlipSubsystem). None falls back to the story default */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	FName Voice;
+
+	/** Compact index into the subsystem speed profile table (resolved at load time) */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	uint8 SpeedProfileId = 0;
+
+	/** Reveal timeline baked at load time */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	FStoryRevealTimeline Timeline;
+
 	/** Pause duration after this line */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	EStoryPauseDuration PauseDuration = EStoryPauseDuration::None;
@@ -219,10 +393,30 @@ struct FStoryScreen
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	TArray<FStoryLine> Lines;
 
-	/** Timed events (SFX, VFX) triggered during this screen */
+	/** Timed events (SFX, VFX) triggered during this screen, sorted by StartTime at load time */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	TArray<FStoryTimedEvent> TimedEvents;
 
+	/** Playback segments baked at load time */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	TArray<FStoryLineSegment> Segments;
+
+	/** Segment index of each line */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	TArray<int32> LineSegmentIndices;
+
+	/** Start time of each line relative to the start of its run */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	TArray<float> LineRunOffsets;
+
+	/** Number of runs (segment groups separated by Wait pauses) */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	int32 NumRuns = 0;
+
+	/** First line of each source line (lines wrapped from one source line share its LineId); the same count in every culture */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Story")
+	TArray<int32> SourceLineStarts;
+
 	FStoryScreen() = default;
 };
 
@@ -243,6 +437,14 @@ struct FShortStory
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	FString OST;
 
+	/** Default speed profile for lines without a speed= parameter (story metadata 'speed') */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	FName DefaultSpeedProfile;
+
+	/** Default blip voice for lines without a voice= parameter (story metadata 'voice') */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
+	FName DefaultVoice;
+
 	/** Array of screens/pages in this story */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Story")
 	TArray<FStoryScreen> Screens;
@@ -260,6 +462,65 @@ struct FShortStory
 	}
 };
 
+/**
+ * Severity of a parse diagnostic
+ */
+UENUM(BlueprintType)
+enum class EStoryDiagnosticSeverity : uint8
+{
+	Info				UMETA(DisplayName = "Info"),
+	Warning				UMETA(DisplayName = "Warning (Recovered)"),
+	Error				UMETA(DisplayName = "Error (Content Dropped)")
+};
+
+/**
+ * One problem found while parsing a .tos file
+ */
+USTRUCT(BlueprintType)
+struct FStoryParseDiagnostic
+{
+	GENERATED_BODY()
+
+	/** How bad the problem is */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	EStoryDiagnosticSeverity Severity = EStoryDiagnosticSeverity::Error;
+
+	/** 1-based source line (0 = whole file) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 Line = 0;
+
+	/** 1-based source column (0 = whole line) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 Column = 0;
+
+	/** Stable identifier for tooling (e.g. UnknownAnimation) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FName Code;
+
+	/** Human readable description */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FString Message;
+
+	FStoryParseDiagnostic() = default;
+
+	FStoryParseDiagnostic(EStoryDiagnosticSeverity InSeverity, int32 InLine, int32 InColumn, FName InCode, const FString& InMessage)
+		: Severity(InSeverity), Line(InLine), Column(InColumn), Code(InCode), Message(InMessage)
+	{
+	}
+
+	/** Format as "Line L, col C: Message" (the legacy error string format) */
+	FString ToString() const
+	{
+		if (Line <= 0)
+		{
+			return Message;
+		}
+		return Column > 0
+			? FString::Printf(TEXT("Line %d, col %d: %s"), Line, Column, *Message)
+			: FString::Printf(TEXT("Line %d: %s"), Line, *Message);
+	}
+};
+
 /**
  * Runtime state for a story line with resolved text based on animation progress
  */
@@ -274,6 +535,14 @@ struct FStoryLineState
 	UPROPERTY(BlueprintReadOnly, Category = "Story")
 	FString FullText;
 
+	/** Styled spans over FullText (empty for plain lines) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	TArray<FStoryTextSpan> Spans;
+
+	/** Number of characters of FullText currently revealed */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 VisibleCharacters = 0;
+
 	/** Animation type for this line */
 	UPROPERTY(BlueprintReadOnly, Category = "Story")
 	EStoryLineAnimation AnimationType = EStoryLineAnimation::Typewriter;
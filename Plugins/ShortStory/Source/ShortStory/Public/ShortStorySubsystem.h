@@ -5,9 +5,16 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "ShortStoryStructs.h"
+#include "ShortStoryCache.h"
 #include "Containers/Ticker.h"
 #include "ShortStorySubsystem.generated.h"
 
+class FShortStoryStringTable;
+class UShortStoryPrewarmManifest;
+struct FStreamableHandle;
+struct FStoryPrewarmJob;
+struct FStoryTranslationLoads;
+
 /**
  * Playback state enum for state machine
  */
@@ -21,6 +28,17 @@ enum class EStoryPlaybackState : uint8
 	Completed
 };
 
+/**
+ * What to do with timed events crossed by SkipToNextStablePoint
+ */
+UENUM(BlueprintType)
+enum class EStorySkipEventPolicy : uint8
+{
+	FireAll				UMETA(DisplayName = "Fire All"),
+	SuppressAll			UMETA(DisplayName = "Suppress All"),
+	FireStateOnly		UMETA(DisplayName = "Fire State Only (backgrounds, VFX still active)")
+};
+
 /**
  * Delegate for story completion events
  */
@@ -31,6 +49,50 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStoryCompleted);
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnScreenChanged, int32, NewScreenIndex);
 
+/**
+ * Delegate for timed events (SFX, VFX, background changes) reaching their start time
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTimedEventTriggered, int32, EventIndex, const FStoryTimedEvent&, Event);
+
+/**
+ * Native delegate for lines becoming visible (StoryId, ScreenIndex, FirstLine, LastLine inclusive)
+ * Also broadcast for lines passed over by a skip, so listeners see every line in order
+ */
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnStoryLinesRevealed, FName, int32, int32, int32);
+
+/**
+ * Why the playback clock jumped or changed rate (native OnClockChanged)
+ */
+enum class EStoryClockChange : uint8
+{
+	/** A story started (screen 0, time 0) */
+	Started,
+	/** The screen changed (time 0 on the new screen) */
+	ScreenChanged,
+	/** Screen time jumped forward (skip) */
+	Jumped,
+	/** Paused, resumed, or fast-forward toggled */
+	RateChanged,
+	/** Playback stopped or the story completed */
+	Stopped
+};
+
+/**
+ * Native delegate for playback clock discontinuities; schedulers working ahead of the clock re-plan on it
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnStoryClockChanged, EStoryClockChange);
+
+/**
+ * Native delegate gathering the assets a story needs when it is prewarmed (Story, OutAssetPaths)
+ * Subsystems built on the story subsystem add the paths of their own assets
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnGatherStoryPrewarmAssets, const FShortStory&, TArray<FSoftObjectPath>&);
+
+/**
+ * Delegate for a prewarm finishing (bCancelled = stopped by CancelPrewarm or a newer prewarm)
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStoryPrewarmCompleted, bool, bCancelled);
+
 // Profiling stats
 DECLARE_STATS_GROUP(TEXT("ShortStory"), STATGROUP_ShortStory, STATCAT_Advanced);
 DECLARE_CYCLE_STAT_EXTERN(TEXT("LoadStory"), STAT_ShortStory_LoadStory, STATGROUP_ShortStory, SHORTSTORY_API);
@@ -38,6 +100,14 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick"), STAT_ShortStory_Tick, STATGROUP_ShortSto
 DECLARE_CYCLE_STAT_EXTERN(TEXT("GetCurrentScreenState"), STAT_ShortStory_GetScreenState, STATGROUP_ShortStory, SHORTSTORY_API);
 DECLARE_CYCLE_STAT_EXTERN(TEXT("StartLine"), STAT_ShortStory_StartLine, STATGROUP_ShortStory, SHORTSTORY_API);
 DECLARE_CYCLE_STAT_EXTERN(TEXT("ParseStory"), STAT_ShortStory_ParseStory, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateLineParams"), STAT_ShortStory_UpdateLineParams, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cached Stories"), STAT_ShortStory_CachedStories, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Cache Text Memory"), STAT_ShortStory_CacheTextMemory, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Cache Texture Memory"), STAT_ShortStory_CacheTextureMemory, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cache Evictions"), STAT_ShortStory_CacheEvictions, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Blips"), STAT_ShortStory_Blips, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blips Played"), STAT_ShortStory_BlipsPlayed, STATGROUP_ShortStory, SHORTSTORY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blips Rate Limited"), STAT_ShortStory_BlipsLimited, STATGROUP_ShortStory, SHORTSTORY_API);
 
 /**
  * Game instance subsystem for loading, caching, and playing short stories (.tos files)
@@ -75,6 +145,23 @@ public:
 	/** Broadcast when advancing to a new screen */
 	UPROPERTY(BlueprintAssignable, Category = "Narrative|Story Playback")
 	FOnScreenChanged OnScreenChanged;
+
+	/** Broadcast when a timed event on the current screen starts (index into the screen's sorted TimedEvents) */
+	UPROPERTY(BlueprintAssignable, Category = "Narrative|Story Playback")
+	FOnTimedEventTriggered OnTimedEventTriggered;
+
+	/** Broadcast when lines start revealing (native only, used by the history log) */
+	FOnStoryLinesRevealed OnLinesRevealed;
+
+	/** Broadcast when the playback clock jumps or changes rate (native only, used by the audio scheduler) */
+	FOnStoryClockChanged OnClockChanged;
+
+	/** Broadcast when a prewarmed story's assets are gathered, to add more to load with it (native only, used by blip voices) */
+	FOnGatherStoryPrewarmAssets OnGatherPrewarmAssets;
+
+	/** Broadcast when PrewarmStories has cached every story and loaded every background, or was cancelled */
+	UPROPERTY(BlueprintAssignable, Category = "Narrative|Short Stories")
+	FOnStoryPrewarmCompleted OnPrewarmCompleted;
 	
 	/** Helper to load background texture from disk if needed */
 	void ResolveBackgroundTexture(FStoryScreen& Screen, const FString& BaseSearchPath = TEXT(""));
@@ -117,6 +204,49 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Narrative|Short Stories")
 	void ClearAllCachedStories();
 
+	/**
+	 * Get the story cache (sizes, LRU stamps and totals for debugging)
+	 */
+	const FShortStoryCache& GetStoryCache() const { return StoryCache; }
+
+	/**
+	 * Get the cache budget in bytes (0 = unlimited)
+	 */
+	int64 GetCacheBudgetBytes() const;
+
+	// ========================================
+	// Prewarming
+	// ========================================
+
+	/**
+	 * Load the stories and backgrounds of a manifest in the background
+	 * Files are parsed and images decoded on worker threads; asset backgrounds stream in asynchronously.
+	 * Starting a new prewarm cancels the one in progress.
+	 * @param Manifest Stories and backgrounds to load
+	 * @return True if anything needs loading (OnPrewarmCompleted follows), false if all of it was already warm
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Short Stories")
+	bool PrewarmStories(const UShortStoryPrewarmManifest* Manifest);
+
+	/**
+	 * Stop the prewarm in progress; stories already cached stay cached
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Short Stories")
+	void CancelPrewarm();
+
+	/**
+	 * Is a prewarm in progress
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Short Stories")
+	bool IsPrewarming() const;
+
+	/**
+	 * Get the progress of the prewarm in progress
+	 * @return 0-1 (1 when no prewarm is running)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Short Stories")
+	float GetPrewarmProgress() const;
+
 	// ========================================
 	// Story Playback
 	// ========================================
@@ -153,6 +283,21 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
 	bool IsPaused() const { return bIsPaused; }
 
+	/**
+	 * Get the id of the current story (the file name it was started with)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	FName GetCurrentStoryId() const { return CurrentStoryId; }
+
+	/**
+	 * Find a loaded story by id without copying it: the current story first, then the cache
+	 * Lines are in the active story culture when the story has a translation loaded
+	 * Game thread only; the pointer is valid until the cache, the current story or the culture changes
+	 * @param StoryId Story id (file name, case-insensitive)
+	 * @return Story, or null if it is neither playing nor cached
+	 */
+	const FShortStory* FindLoadedStory(FName StoryId) const;
+
 	/**
 	 * Get current screen index (0-based)
 	 */
@@ -204,6 +349,133 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Narrative|Story Playback")
 	bool ContinueStory();
 
+	/**
+	 * Skip to the next stable point: the next Wait pause or the end of the current screen
+	 * Lands in the same state normal playback would reach, in one call, regardless of how many lines are skipped.
+	 * During a screen transition the transition is finished first (a transition still waiting for its background holds the skip
+	 * until the background is ready or MaxBackgroundWaitSeconds runs out); at the end-of-screen pause the skip moves on to the next screen.
+	 * @param EventPolicy How timed events crossed by the skip are handled
+	 * @return True if playback moved, false if not playing or already waiting for input
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Story Playback")
+	bool SkipToNextStablePoint(EStorySkipEventPolicy EventPolicy = EStorySkipEventPolicy::FireStateOnly);
+
+	/**
+	 * Enable or disable fast-forward (e.g. while a key is held)
+	 * Playback runs FastForwardTimeScale times faster and, if bFastForwardContinuesWaits, Wait pauses continue on their own
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Story Playback")
+	void SetFastForward(bool bEnable);
+
+	/**
+	 * Check if fast-forward is active
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	bool IsFastForwarding() const { return bIsFastForwarding; }
+
+	/**
+	 * Get the current screen time, exact between ticks (extrapolated from the last clock advance, also while the ticker sleeps)
+	 * @return Seconds since the current screen started, 0 when not playing
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	float GetScreenTime() const;
+
+	/**
+	 * Get how fast screen time runs
+	 * @return Screen seconds per real second: 0 when paused or stopped, FastForwardTimeScale while fast-forwarding
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	float GetPlaybackRate() const;
+
+	/**
+	 * Get how far the current screen transition has run, driven by the story clock
+	 * Stays at 0 while the incoming background is not ready (the transition has not started yet).
+	 * @return 0-1, 1 when no transition is running
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	float GetTransitionProgress() const;
+
+	/**
+	 * Is the current screen transition held until the incoming background is ready
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	bool IsWaitingForBackground() const { return bWaitingForBackground; }
+
+	/**
+	 * Can a screen's background be drawn right away: loaded, with its render resource created and fully streamed in
+	 * Without a renderer (-nullrhi) a loaded texture counts as ready, so the check can run headless.
+	 * @param ScreenIndex Screen of the current story
+	 * @return True if the background is ready or the screen has none
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	bool IsScreenBackgroundReady(int32 ScreenIndex) const;
+
+	/**
+	 * Get the background texture of a screen if it is in memory (image file backgrounds always are)
+	 * @param ScreenIndex Screen of the current story
+	 * @return Texture, or null if the screen has none or its asset is not loaded
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	UTexture2D* GetScreenBackground(int32 ScreenIndex) const;
+
+	/**
+	 * Get the screen time at which a line of the current screen started (compare with GetScreenTime)
+	 * @return Start time, or -1 if the line has not started yet
+	 */
+	float GetLineStartTime(int32 LineIndex) const;
+
+	/**
+	 * Get the packed per-line reveal parameters texture (one texel per line, updated once per frame)
+	 * R = CurrentTextProgress, G = PastTextProgress, B = AnimationProgress, A = 1 if the line has started.
+	 * Sample with nearest filtering at U = (LineIndex + 0.5) / Width.
+	 * @return Transient float texture, or null when the engine cannot render (e.g. -nullrhi)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	UTexture2D* GetLineParametersTexture() const { return LineParametersTexture; }
+
+	/**
+	 * Get the CPU copy of the packed per-line reveal parameters (same layout as the texture)
+	 * Valid with or without a renderer, so it can be checked under -nullrhi
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	TArray<FLinearColor> GetPackedLineParameters() const { return PackedLineParameters; }
+
+	// ========================================
+	// Localisation
+	// ========================================
+
+	/**
+	 * Switch the culture story text is shown in; playback continues with the new text
+	 * The current story's translation is loaded from Stories/Loc/<Culture>/ right away, other stories' when
+	 * they are prewarmed or started. Translated lines are wrapped and baked once; no textures are reloaded.
+	 * @param Culture Culture name (e.g. "en", "en-US"). Empty or SourceCulture shows the source text.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Narrative|Localization")
+	void SetStoryCulture(const FString& Culture);
+
+	/**
+	 * Get the culture story text is shown in (empty = source text)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Localization")
+	FString GetStoryCulture() const { return StoryCulture; }
+
+	/**
+	 * Write the source-culture translation template of a story (Stories/Loc/<SourceCulture>/<Story>.csv)
+	 * One row per source text line, with its inline markup and manual breaks
+	 * @param StoryFileName Story to export (e.g. "Intro.tos")
+	 * @param OutPath Written file
+	 * @return True if the file was written
+	 */
+	bool ExportStoryStrings(const FString& StoryFileName, FString& OutPath);
+
+	/** Culture the .tos files are written in */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Localization")
+	FString SourceCulture = TEXT("it");
+
+	/** Follow the engine culture (FInternationalization::OnCultureChanged) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Localization")
+	bool bFollowEngineCulture = true;
+
 	// ========================================
 	// Timing Configuration
 	// ========================================
@@ -216,6 +488,22 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
 	FStoryAnimationTiming GetSpeedTiming(EStorySpeed Speed) const;
 
+	/**
+	 * Get timing configuration for a named speed profile (Speed_<Name>.csv)
+	 * @param ProfileName Profile name (case-insensitive, e.g. "Whisper")
+	 * @param bFound True if the profile exists
+	 * @return Timing configuration struct (Standard if not found)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	FStoryAnimationTiming GetSpeedProfileTiming(FName ProfileName, bool& bFound) const;
+
+	/**
+	 * Get the names of all loaded speed profiles, in id order
+	 * @return Array of profile names (Standard, Fast, Slow first)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Playback")
+	TArray<FName> GetSpeedProfileNames() const;
+
 	/**
 	 * Get pause duration for a pause type
 	 * @param PauseType Pause type enum
@@ -321,13 +609,22 @@ public:
 
 	/**
 	 * Calculate which character index corresponds to a given elapsed time
-	 * @param Text The text to check
+	 * Inline markup is stripped and its waits are honoured, matching the baked timeline of the same line
+	 * @param Text The text to check, markup included
 	 * @param Speed Speed type
 	 * @param Time Elapsed time in seconds
 	 * @return 0-based character index
 	 */
 	int32 GetCharacterIndexAtTime(const FString& Text, EStorySpeed Speed, float Time) const;
 
+	/**
+	 * Calculate which character index corresponds to a given elapsed time, using the line's baked timeline
+	 * @param Line The line to check (profile, override and timeline are honoured)
+	 * @param Time Elapsed time in seconds since the line started
+	 * @return Number of visible characters
+	 */
+	int32 GetCharacterIndexAtTime(const FStoryLine& Line, float Time) const;
+
 private:
 	/**
 	 * Get absolute file path for a story file
@@ -342,18 +639,69 @@ private:
 	 */
 	FString GetStoriesDirectory() const;
 
-	/** Cache of parsed stories (key = filename, value = parsed story) */
-	TMap<FString, FShortStory> CachedStories;
+	/** Cache of parsed stories (key = filename, case-insensitive; lock-free reads) */
+	FShortStoryCache StoryCache;
+
+	/** Runtime textures of stories that left the cache while still used by CurrentStory */
+	TArray<UTexture2D*> DeferredTextureReleases;
 
-	/** Critical section for thread-safe cache access */
-	mutable FCriticalSection CacheMutex;
+	/**
+	 * Evict least recently used stories until the cache fits CacheBudgetMB
+	 * @param JustLoaded Story that was just added (never evicted by this call)
+	 */
+	void EnforceCacheBudget(const FString& JustLoaded);
+
+	/**
+	 * Unroot the runtime textures of a story leaving the cache (deferred while CurrentStory uses them)
+	 */
+	void ReleaseStoryTextures(const FShortStory& Story);
+
+	/**
+	 * Unroot deferred textures that the next current story does not use
+	 */
+	void ReleaseDeferredTextures(const FShortStory& NextStory);
+
+	/** Publish cache totals to the ShortStory stats group */
+	void UpdateCacheStats();
+
+	/**
+	 * Bake timelines and add a parsed story (backgrounds resolved) to the cache
+	 */
+	void CacheParsedStory(const FString& StoryFileName, FShortStory& Story);
+
+	/** Prewarm in progress (shared with its worker tasks) */
+	TSharedPtr<FStoryPrewarmJob, ESPMode::ThreadSafe> PrewarmJob;
+
+	/** Ticker handle collecting prewarm results on the game thread */
+	FTSTicker::FDelegateHandle PrewarmTickerHandle;
+
+	/** Streaming handles of the last finished prewarm, keeping its background assets loaded */
+	TArray<TSharedPtr<FStreamableHandle>> PrewarmedAssetHandles;
+
+	/**
+	 * Cache parsed stories and create their textures as workers finish them
+	 */
+	bool TickPrewarm(float DeltaTime);
+
+	/**
+	 * Request async loads of background assets for the prewarm in progress
+	 */
+	void RequestPrewarmAssets(TArray<FSoftObjectPath> AssetPaths);
+
+	/**
+	 * End the prewarm in progress and broadcast OnPrewarmCompleted
+	 */
+	void FinishPrewarm(bool bCancelled);
 
 	// ========================================
 	// Timing Configuration Data
 	// ========================================
 
-	/** Loaded speed timings from CSV files */
-	TMap<EStorySpeed, FStoryAnimationTiming> SpeedTimings;
+	/** Loaded speed profiles from Speed_*.csv files, indexed by FStoryLine::SpeedProfileId (built-ins first, in EStorySpeed order) */
+	TArray<FStoryAnimationTiming> SpeedProfiles;
+
+	/** Profile name to id lookup (FName compares case-insensitively) */
+	TMap<FName, uint8> SpeedProfileIds;
 
 	/** Loaded pause durations from CSV file */
 	TMap<EStoryPauseDuration, float> PauseDurations;
@@ -372,11 +720,46 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Display", meta = (ClampMin = "20", ClampMax = "300"))
 	int32 MaxLineLength = 80;
 
+	/** Memory ceiling for cached stories, text plus runtime textures (0 = unlimited); least recently used stories are evicted first */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Cache", meta = (ClampMin = "0"))
+	int32 CacheBudgetMB = 256;
+
+	/** Playback speed multiplier while fast-forwarding */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Playback", meta = (ClampMin = "1.0", ClampMax = "64.0"))
+	float FastForwardTimeScale = 8.0f;
+
+	/** Should fast-forward continue Wait pauses without input? */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Playback")
+	bool bFastForwardContinuesWaits = true;
+
+	/** Longest time a screen transition waits for its background before starting anyway (real seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Playback", meta = (ClampMin = "0.0", ClampMax = "30.0"))
+	float MaxBackgroundWaitSeconds = 5.0f;
+
+	/** Unregister the ticker while nothing changes (Wait pauses, settled screens); it wakes for the next timed event, state end or input */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Playback")
+	bool bSleepWhenIdle = true;
+
 private:
 
 	/** Time elapsed during screen transition */
 	float TransitionElapsedTime = 0.0f;
 
+	/** Is the screen transition held until the incoming background is ready */
+	bool bWaitingForBackground = false;
+
+	/** Real time spent waiting for the incoming background */
+	float BackgroundWaitTime = 0.0f;
+
+	/** Was SkipToNextStablePoint called while the transition waited for its background (runs once it is ready) */
+	bool bSkipHeldForBackground = false;
+
+	/** Event policy of the held skip */
+	EStorySkipEventPolicy HeldSkipEventPolicy = EStorySkipEventPolicy::FireStateOnly;
+
+	/** Load of the current screen's background asset, kept so it stays loaded while shown */
+	TSharedPtr<FStreamableHandle> ScreenBackgroundHandle;
+
 	/** Whether timing configs have been loaded */
 	bool bTimingConfigsLoaded = false;
 
@@ -386,12 +769,103 @@ private:
 	 */
 	void LoadTimingConfigs();
 
+	/** Culture text is shown in (empty = source) */
+	FString StoryCulture;
+
+	/** Handle of the engine culture change binding */
+	FDelegateHandle CultureChangedHandle;
+
+	/** Engine culture changed */
+	void HandleCultureChanged();
+
+	/** Tables being loaded by workers for stories started or switched culture without a prewarm (shared with the workers) */
+	TSharedPtr<FStoryTranslationLoads, ESPMode::ThreadSafe> TranslationLoads;
+
+	/** Stories whose table is being loaded for the active culture */
+	TSet<FString> PendingTranslations;
+
+	/** Ticker handle collecting loaded tables on the game thread */
+	FTSTicker::FDelegateHandle TranslationTickerHandle;
+
+	/**
+	 * Load the active culture's table for a story on a worker, unless its translation is built or already loading
+	 * The translation is built on the game thread when the table arrives, and shown at once if the story is playing
+	 * @param StoryFileName Story id
+	 */
+	void RequestStoryTranslation(const FString& StoryFileName);
+
+	/**
+	 * Build the translations of stories whose table has loaded
+	 */
+	bool TickTranslationLoads(float DeltaTime);
+
+	/**
+	 * Build a story's translation from its loaded table and keep it in the cache with the story
+	 * @param StoryFileName Story id
+	 * @param Story Cached source story
+	 * @param Table Active culture's table, null if the story has none
+	 */
+	void AddStoryTranslation(const FString& StoryFileName, const FShortStory& Story, const FShortStoryStringTable* Table);
+
+	/**
+	 * Replace translated source lines of a screen with their wrapped, parsed and baked translation
+	 * @param Screen Baked source screen, updated in place
+	 * @param Table Table to read
+	 * @return Number of source lines translated
+	 */
+	int32 TranslateScreen(FStoryScreen& Screen, const FShortStoryStringTable& Table) const;
+
+	/**
+	 * Switch the current story's lines to the active culture once its translation is built (requested if not)
+	 */
+	void RefreshCurrentStoryText();
+
+	/**
+	 * Swap the current story's lines for those of another culture's copy of it, in place
+	 * The line being revealed keeps its progress, mapped onto its new text through the source line's id
+	 * @param Display Source story or its translation
+	 */
+	void ApplyCurrentStoryText(const FShortStory& Display);
+
+	/**
+	 * Get the localisation directory (under Stories)
+	 */
+	FString GetLocDirectory() const;
+
 	/**
 	 * Get the Config directory path (under Stories)
 	 * @return Absolute path to Config directory
 	 */
 	FString GetConfigDirectory() const;
 
+	/**
+	 * Resolve speed profile ids and bake reveal timelines for every line of a freshly parsed story
+	 * @param Story Story to update in place
+	 */
+	void BakeStoryTimelines(FShortStory& Story) const;
+
+	/**
+	 * Bake the playback segments of a screen (block grouping, durations, pauses, runs and skip targets)
+	 * @param Screen Screen with baked line timelines, updated in place
+	 */
+	void BakeScreenSchedule(FStoryScreen& Screen) const;
+
+	/**
+	 * Get the effective timing for a line (resolved profile plus inline per-letter override)
+	 */
+	FStoryAnimationTiming GetLineTiming(const FStoryLine& Line) const;
+
+	/**
+	 * Get the typewriter duration of a line, from its baked timeline when available
+	 */
+	float GetLineTypewriterDuration(const FStoryLine& Line) const;
+
+	/**
+	 * Get normalized typewriter progress (0-1 over visible glyphs) at a time since line start
+	 * Holds still during punctuation delays and inline waits, so shaders never reveal markup or run ahead
+	 */
+	float GetTypewriterProgressAtTime(const FStoryLine& Line, float Time) const;
+
 	// ========================================
 	// Playback State
 	// ========================================
@@ -399,6 +873,12 @@ private:
 	/** Currently playing story */
 	FShortStory CurrentStory;
 
+	/** Source text of the current story (shared with the cache), so culture switches never reload it */
+	TSharedPtr<const FShortStory, ESPMode::ThreadSafe> CurrentSourceStory;
+
+	/** Id of the current story (file name passed to StartStory) */
+	FName CurrentStoryId;
+
 	/** Current screen index (0-based) */
 	int32 CurrentScreenIndex = 0;
 
@@ -420,8 +900,17 @@ private:
 	/** Time elapsed since screen started (for timed events) */
 	float ScreenElapsedTime = 0.0f;
 
-	/** Start times for each line on the current screen (relative to ScreenElapsedTime) */
-	TArray<float> LineStartTimes;
+	/** Segment currently playing or pausing on the current screen (INDEX_NONE before the first line starts) */
+	int32 CurrentSegmentIndex = INDEX_NONE;
+
+	/** ScreenElapsedTime at which each run of the current screen started (-1 = not reached yet) */
+	TArray<float> RunStartTimes;
+
+	/** Index of the next timed event to fire on the current screen (events are sorted by StartTime) */
+	int32 NextTimedEventIndex = 0;
+
+	/** Is fast-forward active? */
+	bool bIsFastForwarding = false;
 
 	/** Is a story currently playing? */
 	bool bIsPlaying = false;
@@ -435,27 +924,102 @@ private:
 	/** Current playback state */
 	EStoryPlaybackState CurrentState = EStoryPlaybackState::Idle;
 
-	/** Indices of timed events already processed on current screen */
-	TSet<int32> ProcessedTimedEventIndices;
-
-	/** Ticker handle for playback updates */
+	/** Ticker handle for playback updates (the one-shot wake-up ticker while asleep) */
 	FTSTicker::FDelegateHandle TickerHandle;
 
+	/** Is the per-frame ticker unregistered because nothing changes until a known time or input */
+	bool bIsSleeping = false;
+
+	/** FApp::GetCurrentTime() when the ticker went to sleep */
+	double SleepStartTime = 0.0;
+
+	/** FApp::GetCurrentTime() that ScreenElapsedTime was last brought up to */
+	double PlaybackClockTime = 0.0;
+
+	/** Time not yet consumed by the running AdvancePlayback (0 outside it) */
+	float AdvanceRemainingTime = 0.0f;
+
+	/** Playback time a tick could not consume within MaxTransitionsPerTick, advanced by the next tick */
+	float CarriedAdvanceTime = 0.0f;
+
+	// ========================================
+	// Packed Line Parameters
+	// ========================================
+
+	/** GPU copy of PackedLineParameters (width = most lines on any screen of the current story) */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> LineParametersTexture;
+
+	/** Per-line reveal parameters for the current screen, rebuilt every frame */
+	TArray<FLinearColor> PackedLineParameters;
+
+	/** Contents of the last texture upload, used to skip redundant uploads */
+	TArray<FLinearColor> LastUploadedLineParameters;
+
 	// ========================================
 	// Playback Methods
 	// ========================================
 
 	/**
-	 * Reset playback caches for a screen jump (clears timers, event indices, line start times)
-	 * @param TargetScreenIndex The screen index being jumped to (used to size LineStartTimes)
+	 * Reset playback caches for a screen jump (clears timers, event cursor, run start times)
+	 * @param TargetScreenIndex The screen index being jumped to (used to size RunStartTimes)
 	 */
 	void ResetScreenState(int32 TargetScreenIndex);
 
+	/**
+	 * Compute reveal progress values for a started line
+	 * @param Line Line to evaluate
+	 * @param LocalLineTime Time since the line started
+	 */
+	void ComputeLineProgress(const FStoryLine& Line, float LocalLineTime, float& OutAnimationProgress, float& OutCurrentProgress, float& OutPastProgress) const;
+
+	/**
+	 * Grow the packed line parameter buffer (and texture) to fit the largest screen of the current story
+	 */
+	void EnsureLineParametersCapacity();
+
+	/**
+	 * Pack every line's progress into the parameter buffer and upload it if it changed
+	 */
+	void UpdateLineParameters();
+
 	/**
 	 * Tick function called by FTSTicker
 	 */
 	bool Tick(float DeltaTime);
 
+	/**
+	 * Advance the playback clocks and state machine (the body of Tick)
+	 */
+	void AdvancePlayback(float DeltaTime);
+
+	/**
+	 * Playback time during which nothing changes: no state end, timed event or line fade
+	 * @return 0 while anything animates, MAX_flt if only input can change anything
+	 */
+	float GetIdlePlaybackTime() const;
+
+	/**
+	 * Swap the per-frame ticker for a one-shot wake-up (none when waiting for input); Tick returns false after this
+	 * @param PlaybackTime Result of GetIdlePlaybackTime
+	 */
+	void SleepPlayback(float PlaybackTime);
+
+	/**
+	 * One-shot ticker ending a sleep
+	 */
+	bool WakeTick(float DeltaTime);
+
+	/**
+	 * Resume per-frame ticking and catch the clocks up with the time slept; called before acting on input
+	 */
+	void WakePlayback();
+
+	/**
+	 * Broadcast OnClockChanged
+	 */
+	void NotifyClockChanged(EStoryClockChange Change);
+
 	/**
 	 * Start playing a specific line
 	 */
@@ -481,10 +1045,22 @@ private:
 	 */
 	void ProcessTimedEvents();
 
+	/**
+	 * Move the screen clock forward to a skip target, handling the timed events in between
+	 * @param NewScreenTime Target ScreenElapsedTime
+	 * @param EventPolicy How crossed timed events are handled
+	 */
+	void AdvanceScreenClockForSkip(float NewScreenTime, EStorySkipEventPolicy EventPolicy);
+
 	/**
 	 * Called when screen transition completes
 	 */
 	void OnScreenTransitionComplete();
 
+	/**
+	 * Enter TransitioningScreen for the current screen, holding it until the incoming background is ready
+	 */
+	void BeginScreenTransition();
+
 
 };
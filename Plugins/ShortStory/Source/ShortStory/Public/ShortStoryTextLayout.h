@@ -0,0 +1,157 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+#include "ShortStoryStructs.h"
+#include "ShortStoryTextLayout.generated.h"
+
+/**
+ * Measured rectangle of a single word in a laid out line
+ */
+USTRUCT(BlueprintType)
+struct FStoryWordRect
+{
+	GENERATED_BODY()
+
+	/** Top-left position in canvas space */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Measured size of the word */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	FVector2D Size = FVector2D::ZeroVector;
+
+	/** Index of the word's first character in the line text */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 StartIndex = 0;
+
+	/** Number of characters in the word */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	int32 Length = 0;
+
+	FStoryWordRect() = default;
+};
+
+/**
+ * Cached layout of one line for a given animation, font and canvas
+ */
+USTRUCT(BlueprintType)
+struct FStoryTextLayout
+{
+	GENERATED_BODY()
+
+	/** Word rectangles in reading order */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	TArray<FStoryWordRect> Words;
+
+	/** Height of one line of text in this font */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	float LineHeight = 0.0f;
+
+	/** Were the sizes measured with the Slate font cache (false = width heuristic, e.g. under -nullrhi) */
+	UPROPERTY(BlueprintReadOnly, Category = "Story")
+	bool bMeasured = false;
+
+	FStoryTextLayout() = default;
+};
+
+/**
+ * Game-thread cache of word layouts for animated story lines
+ *
+ * Text is measured with the real Slate font cache once per (text, animation, font, canvas)
+ * and the resulting word rectangles are reused every frame. WordRain and Snake use a stream
+ * seeded from the text, so a line always lands in the same place.
+ *
+ * Example usage:
+ *   const FStoryTextLayout& Layout = FShortStoryTextLayoutCache::Get().GetLayout(Line.Text, Line.AnimationType, Font, CanvasSize);
+ */
+class SHORTSTORY_API FShortStoryTextLayoutCache
+{
+public:
+	/** Access the shared cache (game thread only) */
+	static FShortStoryTextLayoutCache& Get();
+
+	/**
+	 * Get (building on first use) the layout for a line
+	 * @param Text Line text (markup already stripped)
+	 * @param AnimType Animation type, selects the placement pattern
+	 * @param Font Font used to render the text
+	 * @param CanvasSize Size of the canvas the line is placed in
+	 * @return Cached layout (reference is only valid until the next GetLayout or Empty call)
+	 */
+	const FStoryTextLayout& GetLayout(const FString& Text, EStoryLineAnimation AnimType, const FSlateFontInfo& Font, FVector2D CanvasSize);
+
+	/** Drop all cached layouts */
+	void Empty();
+
+	/** Number of cached layouts */
+	int32 Num() const { return Layouts.Num(); }
+
+private:
+	/** Everything that selects a layout; the text is only borrowed, so lookups never allocate */
+	struct FLayoutLookup
+	{
+		FStringView Text;
+		uint32 TextHash = 0;
+		uint32 FontHash = 0;
+		FIntPoint Canvas = FIntPoint::ZeroValue;
+		EStoryLineAnimation AnimType = EStoryLineAnimation::Typewriter;
+
+		uint32 GetHash() const
+		{
+			uint32 Hash = HashCombine(TextHash, FontHash);
+			Hash = HashCombine(Hash, GetTypeHash(Canvas));
+			return HashCombine(Hash, GetTypeHash(static_cast<uint8>(AnimType)));
+		}
+	};
+
+	/** Cache key: owns a copy of the text, so lines whose hashes collide never share a layout */
+	struct FLayoutKey
+	{
+		FString Text;
+		uint32 TextHash = 0;
+		uint32 FontHash = 0;
+		FIntPoint Canvas = FIntPoint::ZeroValue;
+		EStoryLineAnimation AnimType = EStoryLineAnimation::Typewriter;
+
+		FLayoutKey() = default;
+
+		explicit FLayoutKey(const FLayoutLookup& Lookup)
+			: Text(Lookup.Text), TextHash(Lookup.TextHash), FontHash(Lookup.FontHash), Canvas(Lookup.Canvas), AnimType(Lookup.AnimType)
+		{
+		}
+
+		bool operator==(const FLayoutKey& Other) const
+		{
+			return TextHash == Other.TextHash && FontHash == Other.FontHash && Canvas == Other.Canvas
+				&& AnimType == Other.AnimType && Text.Equals(Other.Text, ESearchCase::CaseSensitive);
+		}
+
+		bool operator==(const FLayoutLookup& Other) const
+		{
+			return TextHash == Other.TextHash && FontHash == Other.FontHash && Canvas == Other.Canvas
+				&& AnimType == Other.AnimType && FStringView(Text).Equals(Other.Text, ESearchCase::CaseSensitive);
+		}
+
+		friend uint32 GetTypeHash(const FLayoutKey& Key)
+		{
+			FLayoutLookup Lookup;
+			Lookup.TextHash = Key.TextHash;
+			Lookup.FontHash = Key.FontHash;
+			Lookup.Canvas = Key.Canvas;
+			Lookup.AnimType = Key.AnimType;
+			return Lookup.GetHash();
+		}
+	};
+
+	/** Build a layout from scratch */
+	void BuildLayout(const FString& Text, EStoryLineAnimation AnimType, const FSlateFontInfo& Font, FVector2D CanvasSize, uint32 Seed, FStoryTextLayout& OutLayout) const;
+
+	/** Cached layouts */
+	TMap<FLayoutKey, FStoryTextLayout> Layouts;
+
+	/** Upper bound on cached layouts; the cache is flushed when exceeded */
+	static constexpr int32 MaxCachedLayouts = 512;
+};
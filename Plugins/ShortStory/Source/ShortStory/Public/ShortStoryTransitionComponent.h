@@ -0,0 +1,126 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ShortStoryStructs.h"
+#include "ShortStoryTransitionComponent.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UShortStorySubsystem;
+class UTexture2D;
+enum class EStoryClockChange : uint8;
+
+/**
+ * Renders story backgrounds, blending screen transitions on the GPU
+ *
+ * Add it to the HUD or player controller and draw GetBackgroundMaterial() (e.g. as an Image brush). The
+ * material receives both textures and their weights (OutgoingTexture * OutgoingWeight + IncomingTexture *
+ * IncomingWeight). Both textures are held by the component and kept fully resident until the blend ends,
+ * so nothing is swapped mid-load. The blend follows the story clock (UShortStorySubsystem::GetTransitionProgress),
+ * which holds each transition until the incoming background is ready: Crossfade blends the two, Fade goes
+ * through black, Instant cuts once the incoming background is ready. The component only ticks during transitions.
+ */
+UCLASS(ClassGroup = (ShortStory), meta = (BlueprintSpawnableComponent))
+class SHORTSTORY_API UShortStoryTransitionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UShortStoryTransitionComponent();
+
+	// UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Get the material drawing the background (null without TransitionMaterial) */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	UMaterialInstanceDynamic* GetBackgroundMaterial() const { return BackgroundMaterial; }
+
+	/** Get the background being blended out (null when no transition runs) */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	UTexture2D* GetOutgoingTexture() const { return OutgoingTexture; }
+
+	/** Get the background of the current screen (null while its asset loads, or if the screen has none) */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	UTexture2D* GetIncomingTexture() const { return IncomingTexture; }
+
+	/** Get the weight of the outgoing background (also set without a material, for headless checks) */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	float GetOutgoingWeight() const { return OutgoingWeight; }
+
+	/** Get the weight of the incoming background */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	float GetIncomingWeight() const { return IncomingWeight; }
+
+	/** Is a transition blending (or waiting for its background) */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	bool IsTransitioning() const { return bIsTransitioning; }
+
+	/** Is the incoming background ready to draw (the transition starts once it is) */
+	UFUNCTION(BlueprintPure, Category = "Narrative|Story Background")
+	bool IsIncomingReady() const;
+
+	/** Material blending the two backgrounds; a dynamic instance is created from it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Story Background")
+	TObjectPtr<UMaterialInterface> TransitionMaterial;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Story Background")
+	FName OutgoingTextureParameter = TEXT("OutgoingTexture");
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Story Background")
+	FName IncomingTextureParameter = TEXT("IncomingTexture");
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Story Background")
+	FName OutgoingWeightParameter = TEXT("OutgoingWeight");
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Story Background")
+	FName IncomingWeightParameter = TEXT("IncomingWeight");
+
+private:
+	/** Called by the story subsystem when its clock jumps or changes rate */
+	void HandleClockChanged(EStoryClockChange Change);
+
+	/** Show the current screen's background without blending */
+	void SnapToCurrentScreen();
+
+	/** Start blending from what is shown to the current screen's background */
+	void BeginTransition();
+
+	/** Update weights from the story clock; ends the transition when it completes */
+	void UpdateBlend();
+
+	/** Push textures and weights to the material */
+	void ApplyToMaterial();
+
+	/** Dynamic instance of TransitionMaterial */
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> BackgroundMaterial;
+
+	/** Background shown before the transition, held until the blend ends */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> OutgoingTexture;
+
+	/** Background of the current screen */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> IncomingTexture;
+
+	float OutgoingWeight = 0.0f;
+	float IncomingWeight = 1.0f;
+
+	/** Screen IncomingTexture belongs to */
+	int32 IncomingScreenIndex = INDEX_NONE;
+
+	/** Transition of that screen */
+	EStoryTransition TransitionType = EStoryTransition::Fade;
+
+	bool bIsTransitioning = false;
+
+	/** Story subsystem we follow */
+	TWeakObjectPtr<UShortStorySubsystem> StorySubsystem;
+
+	FDelegateHandle ClockChangedHandle;
+};
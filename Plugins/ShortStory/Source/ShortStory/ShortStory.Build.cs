@@ -28,7 +28,8 @@ public class ShortStory : ModuleRules
 				"Engine",
 				"GameplayTags",
 				"Json",
-				"JsonUtilities"
+				"JsonUtilities",
+				"SlateCore"
 			}
 			);
 
@@ -36,8 +37,10 @@ public class ShortStory : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"AudioMixer", // For Quartz
 				"ImageWrapper",
 				"RenderCore",
+				"Slate",
 				"Projects" // For IPluginManager
 			}
 			);
@@ -0,0 +1,230 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#include "ShortStoryValidateCommandlet.h"
+#include "ShortStoryLocalization.h"
+#include "ShortStoryParser.h"
+#include "ShortStorySubsystem.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogShortStoryValidate, Log, All);
+
+namespace
+{
+	/** Diagnostics of one story file */
+	struct FStoryValidationResult
+	{
+		FString FilePath;
+		TArray<FStoryParseDiagnostic> Diagnostics;
+		bool bParsed = false;
+	};
+
+	const TCHAR* GetSeverityName(EStoryDiagnosticSeverity Severity)
+	{
+		switch (Severity)
+		{
+		case EStoryDiagnosticSeverity::Info:
+			return TEXT("info");
+		case EStoryDiagnosticSeverity::Warning:
+			return TEXT("warning");
+		default:
+			return TEXT("error");
+		}
+	}
+}
+
+UShortStoryValidateCommandlet::UShortStoryValidateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = false;
+}
+
+int32 UShortStoryValidateCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const bool bWarningsAsErrors = Switches.Contains(TEXT("WarningsAsErrors"));
+
+	// Same locations the story editor scans
+	TArray<FString> Roots;
+	if (const FString* Path = ParamValues.Find(TEXT("Path")))
+	{
+		Roots.Add(*Path);
+	}
+	else
+	{
+		Roots.Add(FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Stories")));
+		if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("ShortStory")))
+		{
+			Roots.Add(FPaths::Combine(Plugin->GetContentDir(), TEXT("Stories")));
+		}
+	}
+
+	TArray<FString> Files;
+	for (const FString& Root : Roots)
+	{
+		if (!IFileManager::Get().DirectoryExists(*Root))
+		{
+			continue;
+		}
+
+		TArray<FString> Found;
+		IFileManager::Get().FindFilesRecursive(Found, *Root, TEXT("*.tos"), true, false);
+		for (const FString& File : Found)
+		{
+			Files.AddUnique(FPaths::ConvertRelativePathToFull(File));
+		}
+	}
+	Files.Sort();
+
+	if (Files.Num() == 0)
+	{
+		UE_LOG(LogShortStoryValidate, Warning, TEXT("ShortStoryValidate: No .tos files found in %s"), *FString::Join(Roots, TEXT(", ")));
+	}
+
+	// Parsing is pure string work, so files are validated independently across all cores
+	const int32 MaxLineLength = GetDefault<UShortStorySubsystem>()->MaxLineLength;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FStoryValidationResult> Results;
+	Results.SetNum(Files.Num());
+	ParallelFor(Files.Num(), [&Files, &Results, MaxLineLength](int32 Index)
+	{
+		FStoryValidationResult& Result = Results[Index];
+		Result.FilePath = Files[Index];
+
+		FShortStory Story;
+		Result.bParsed = UShortStoryParser::ParseStoryFile(Result.FilePath, Story, Result.Diagnostics, MaxLineLength);
+	});
+
+	// Translation tables are compiled here, so a game never compiles one when it loads a story's translation
+	TArray<FString> TranslationFiles;
+	for (const FString& Root : Roots)
+	{
+		const FString LocDir = FPaths::Combine(Root, TEXT("Loc"));
+		if (IFileManager::Get().DirectoryExists(*LocDir))
+		{
+			IFileManager::Get().FindFilesRecursive(TranslationFiles, *LocDir, TEXT("*.csv"), true, false);
+		}
+	}
+
+	std::atomic<int32> NumTablesCompiled { 0 };
+	std::atomic<int32> NumTablesFailed { 0 };
+	ParallelFor(TranslationFiles.Num(), [&TranslationFiles, &NumTablesCompiled, &NumTablesFailed](int32 Index)
+	{
+		const FString& CsvPath = TranslationFiles[Index];
+		const FString TablePath = FPaths::ChangeExtension(CsvPath, TEXT("stbl"));
+		const FDateTime TableTime = IFileManager::Get().GetTimeStamp(*TablePath);
+		if (TableTime != FDateTime::MinValue() && TableTime >= IFileManager::Get().GetTimeStamp(*CsvPath))
+		{
+			return;
+		}
+
+		if (FShortStoryStringTable::CompileCsv(CsvPath, TablePath))
+		{
+			++NumTablesCompiled;
+		}
+		else
+		{
+			++NumTablesFailed;
+		}
+	});
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Report in file order, one "file(line,column): severity Code: message" line per diagnostic
+	int32 NumErrors = 0;
+	int32 NumWarnings = 0;
+	for (const FStoryValidationResult& Result : Results)
+	{
+		for (const FStoryParseDiagnostic& Diagnostic : Result.Diagnostics)
+		{
+			const bool bIsError = Diagnostic.Severity == EStoryDiagnosticSeverity::Error
+				|| (bWarningsAsErrors && Diagnostic.Severity == EStoryDiagnosticSeverity::Warning);
+			const FString Location = FString::Printf(TEXT("%s(%d,%d)"), *Result.FilePath, Diagnostic.Line, Diagnostic.Column);
+
+			if (bIsError)
+			{
+				++NumErrors;
+				UE_LOG(LogShortStoryValidate, Error, TEXT("%s: error %s: %s"), *Location, *Diagnostic.Code.ToString(), *Diagnostic.Message);
+			}
+			else if (Diagnostic.Severity == EStoryDiagnosticSeverity::Warning)
+			{
+				++NumWarnings;
+				UE_LOG(LogShortStoryValidate, Warning, TEXT("%s: warning %s: %s"), *Location, *Diagnostic.Code.ToString(), *Diagnostic.Message);
+			}
+			else
+			{
+				UE_LOG(LogShortStoryValidate, Display, TEXT("%s: info %s: %s"), *Location, *Diagnostic.Code.ToString(), *Diagnostic.Message);
+			}
+		}
+	}
+
+	if (NumTablesFailed > 0)
+	{
+		++NumWarnings;
+		UE_LOG(LogShortStoryValidate, Warning, TEXT("ShortStoryValidate: %d translation tables could not be compiled"), NumTablesFailed.load());
+	}
+
+	UE_LOG(LogShortStoryValidate, Display, TEXT("ShortStoryValidate: %d files, %d errors, %d warnings, %d of %d translation tables compiled (%.1f ms)"),
+		Files.Num(), NumErrors, NumWarnings, NumTablesCompiled.load(), TranslationFiles.Num(), ElapsedSeconds * 1000.0);
+
+	if (const FString* OutputPath = ParamValues.Find(TEXT("Output")))
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("files"), Files.Num());
+		Writer->WriteValue(TEXT("errors"), NumErrors);
+		Writer->WriteValue(TEXT("warnings"), NumWarnings);
+		Writer->WriteValue(TEXT("seconds"), ElapsedSeconds);
+
+		Writer->WriteArrayStart(TEXT("stories"));
+		for (const FStoryValidationResult& Result : Results)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("file"), Result.FilePath);
+			Writer->WriteValue(TEXT("parsed"), Result.bParsed);
+
+			Writer->WriteArrayStart(TEXT("diagnostics"));
+			for (const FStoryParseDiagnostic& Diagnostic : Result.Diagnostics)
+			{
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("severity"), GetSeverityName(Diagnostic.Severity));
+				Writer->WriteValue(TEXT("line"), Diagnostic.Line);
+				Writer->WriteValue(TEXT("column"), Diagnostic.Column);
+				Writer->WriteValue(TEXT("code"), Diagnostic.Code.ToString());
+				Writer->WriteValue(TEXT("message"), Diagnostic.Message);
+				Writer->WriteObjectEnd();
+			}
+			Writer->WriteArrayEnd();
+
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		if (!FFileHelper::SaveStringToFile(Json, **OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogShortStoryValidate, Error, TEXT("ShortStoryValidate: Failed to write report '%s'"), **OutputPath);
+			return 1;
+		}
+		UE_LOG(LogShortStoryValidate, Display, TEXT("ShortStoryValidate: Report written to '%s'"), **OutputPath);
+	}
+
+	return NumErrors > 0 ? 1 : 0;
+}
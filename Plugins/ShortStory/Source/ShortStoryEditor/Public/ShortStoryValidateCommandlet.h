@@ -0,0 +1,30 @@
+// Copyright Theory of Magic. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ShortStoryValidateCommandlet.generated.h"
+
+/**
+ * Parses every .tos story in parallel and reports all diagnostics
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=ShortStoryValidate [-Path=<dir>] [-Output=<report.json>] [-WarningsAsErrors]
+ *
+ * Without -Path both Content/Stories and the plugin's Content/Stories are scanned.
+ * Every diagnostic is printed as "file(line,column): severity Code: message" (the format CI log parsers
+ * pick up); -Output additionally writes a JSON report. Returns 1 if any error was found.
+ * Translation CSVs under Loc/ whose .stbl is missing or older are compiled, so games only map tables.
+ */
+UCLASS()
+class UShortStoryValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UShortStoryValidateCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
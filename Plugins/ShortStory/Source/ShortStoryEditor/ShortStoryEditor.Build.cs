@@ -36,6 +36,8 @@ public class ShortStoryEditor : ModuleRules
 			new string[]
 			{
 				"AssetTools",
+				"Json",
+				"Projects",
 				"Slate",
 				"SlateCore"
 			}
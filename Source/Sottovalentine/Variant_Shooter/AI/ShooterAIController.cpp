@@ -5,8 +5,10 @@
 #include "ShooterNPC.h"
 #include "Components/StateTreeAIComponent.h"
 #include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Sight.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "AI/Navigation/PathFollowingAgentInterface.h"
+#include "ShooterSignificanceSubsystem.h"
 
 AShooterAIController::AShooterAIController()
 {
@@ -29,18 +31,43 @@ void AShooterAIController::OnPossess(APawn* InPawn)
 	// ensure we're possessing an NPC
 	if (AShooterNPC* NPC = Cast<AShooterNPC>(InPawn))
 	{
-		// add the team tag to the pawn
-		NPC->Tags.Add(TeamTag);
+		// add the team tag to the pawn. Pooled NPCs may already have it
+		NPC->Tags.AddUnique(TeamTag);
 
 		// subscribe to the pawn's OnDeath delegate
 		NPC->OnPawnDeath.AddDynamic(this, &AShooterAIController::OnPawnDeath);
 
+		// match the NPC's significance bucket. Pooled NPCs get theirs before they're possessed
+		if (NPC->HasSignificance())
+		{
+			if (const UShooterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UShooterSignificanceSubsystem>())
+			{
+				ApplyLODSettings(SignificanceSubsystem->GetSettings(NPC->GetSignificance()));
+			}
+		}
+
 		// start AI logic
 		StateTreeAI->StartLogic();
 	}
 }
 
 void AShooterAIController::OnPawnDeath()
+{
+	// pooled NPCs keep their controller for when they're reused
+	const AShooterNPC* NPC = Cast<AShooterNPC>(GetPawn());
+	const bool bKeepController = NPC && NPC->IsPooled();
+
+	// stop the AI and unpossess the pawn
+	ReleasePawn();
+
+	if (!bKeepController)
+	{
+		// destroy this controller
+		Destroy();
+	}
+}
+
+void AShooterAIController::ReleasePawn()
 {
 	// stop movement
 	GetPathFollowingComponent()->AbortMove(*this, FPathFollowingResultFlags::UserAbort);
@@ -48,11 +75,31 @@ void AShooterAIController::OnPawnDeath()
 	// stop StateTree logic
 	StateTreeAI->StopLogic(FString(""));
 
+	// forget the current target and anything we perceived
+	ClearCurrentTarget();
+	ClearFocus(EAIFocusPriority::Gameplay);
+	AIPerception->ForgetAll();
+
+	// go back to full rate so a pooled controller doesn't start its next pawn with a far bucket's tick and senses
+	ApplyLODSettings(FShooterNPCLODSettings());
+
+	// unsubscribe from the pawn's death so we don't bind twice when possessing it again
+	if (AShooterNPC* NPC = Cast<AShooterNPC>(GetPawn()))
+	{
+		NPC->OnPawnDeath.RemoveDynamic(this, &AShooterAIController::OnPawnDeath);
+	}
+
 	// unpossess the pawn
 	UnPossess();
+}
+
+void AShooterAIController::ApplyLODSettings(const FShooterNPCLODSettings& Settings)
+{
+	// tick the StateTree less often. It receives the accumulated delta time
+	StateTreeAI->SetComponentTickInterval(Settings.StateTreeTickInterval);
 
-	// destroy this controller
-	Destroy();
+	// sight queries are the most expensive sense, so far NPCs rely on hearing and damage
+	AIPerception->SetSenseEnabled(UAISense_Sight::StaticClass(), Settings.bEnableSight);
 }
 
 void AShooterAIController::SetCurrentTarget(AActor* Target)
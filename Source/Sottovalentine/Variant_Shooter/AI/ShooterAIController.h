@@ -9,6 +9,7 @@
 class UStateTreeAIComponent;
 class UAIPerceptionComponent;
 struct FAIStimulus;
+struct FShooterNPCLODSettings;
 
 DECLARE_DELEGATE_TwoParams(FShooterPerceptionUpdatedDelegate, AActor*, const FAIStimulus&);
 DECLARE_DELEGATE_OneParam(FShooterPerceptionForgottenDelegate, AActor*);
@@ -73,6 +74,15 @@ public:
 	/** Returns the targeted enemy */
 	AActor* GetCurrentTarget() const { return TargetEnemy; };
 
+	/** Returns the team tag given to possessed pawns */
+	FName GetTeamTag() const { return TeamTag; }
+
+	/** Stops the AI logic and unpossesses the pawn, keeping this controller around so it can possess a pooled NPC again */
+	void ReleasePawn();
+
+	/** Applies the StateTree tick rate and perception settings of the pawn's significance bucket */
+	void ApplyLODSettings(const FShooterNPCLODSettings& Settings);
+
 protected:
 
 	/** Called when the AI perception component updates a perception on a given actor */
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterCrowdProxy.h"
+#include "ShooterCrowdSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Perception/AIPerceptionSystem.h"
+#include "Perception/AISense_Sight.h"
+
+AShooterCrowdProxy::AShooterCrowdProxy()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the capsule. Shots and sight traces hit it like they would hit the NPC's
+	Capsule = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Capsule"));
+	RootComponent = Capsule;
+
+	Capsule->SetCollisionProfileName(FName("Pawn"));
+	Capsule->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+	Capsule->SetCanEverAffectNavigation(false);
+	Capsule->SetGenerateOverlapEvents(false);
+
+	// start pooled
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+float AShooterCrowdProxy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	// the crowd handles the combatant's death, which may pool us right away
+	UShooterCrowdSubsystem* CrowdSubsystem = Crowd.Get();
+
+	if (!CrowdSubsystem || AgentIndex == INDEX_NONE)
+	{
+		return 0.0f;
+	}
+
+	CrowdSubsystem->ApplyShotDamage(AgentIndex, Damage);
+
+	return Damage;
+}
+
+void AShooterCrowdProxy::ActivateForAgent(UShooterCrowdSubsystem* InCrowd, int32 InAgentIndex, const TArray<FName>& AgentTags, float Radius, float HalfHeight)
+{
+	Crowd = InCrowd;
+	AgentIndex = InAgentIndex;
+
+	// look like the NPC the combatant would be promoted to
+	Tags = AgentTags;
+	Capsule->SetCapsuleSize(Radius, HalfHeight);
+
+	SetActorEnableCollision(true);
+
+	// let AI perception see us
+	UAIPerceptionSystem::RegisterPerceptionStimuliSource(this, UAISense_Sight::StaticClass(), this);
+}
+
+void AShooterCrowdProxy::Deactivate()
+{
+	// stop being sensed
+	if (UAIPerceptionSystem* PerceptionSystem = UAIPerceptionSystem::GetCurrent(this))
+	{
+		PerceptionSystem->UnregisterSource(*this);
+	}
+
+	SetActorEnableCollision(false);
+	Tags.Reset();
+
+	Crowd.Reset();
+	AgentIndex = INDEX_NONE;
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ShooterCrowdProxy.generated.h"
+
+class UCapsuleComponent;
+class UShooterCrowdSubsystem;
+
+/**
+ *  Stand-in actor for a simulated crowd combatant close to a player
+ *  Registered as a sight stimulus with the tags of the NPC it would be promoted to, so AI perception can sense it,
+ *  and blocks shots with a capsule of the same size, so players and NPCs can target and damage it.
+ *  Damage taken is passed on to the crowd combatant. Proxies are pooled by the crowd subsystem.
+ */
+UCLASS(NotPlaceable, Transient)
+class SOTTOVALENTINE_API AShooterCrowdProxy : public AActor
+{
+	GENERATED_BODY()
+
+	/** Collision matching the combatant's capsule */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCapsuleComponent* Capsule;
+
+	/** Crowd the combatant belongs to */
+	TWeakObjectPtr<UShooterCrowdSubsystem> Crowd;
+
+	/** Crowd combatant this proxy stands in for */
+	int32 AgentIndex = INDEX_NONE;
+
+public:
+
+	/** Constructor */
+	AShooterCrowdProxy();
+
+	/** Passes damage on to the crowd combatant */
+	virtual float TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
+
+	/** Stands in for a crowd combatant and registers as a sight stimulus */
+	void ActivateForAgent(UShooterCrowdSubsystem* InCrowd, int32 InAgentIndex, const TArray<FName>& AgentTags, float Radius, float HalfHeight);
+
+	/** Unregisters from perception and goes back to the pool */
+	void Deactivate();
+
+	/** Returns the crowd combatant this proxy stands in for, or INDEX_NONE if pooled */
+	int32 GetAgentIndex() const { return AgentIndex; }
+};
@@ -0,0 +1,746 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterCrowdSubsystem.h"
+#include "ShooterNPC.h"
+#include "ShooterNPCSpawner.h"
+#include "ShooterCrowdProxy.h"
+#include "ShooterAIController.h"
+#include "ShooterGameMode.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Tick"), STAT_ShooterCrowd_Tick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Simulated"), STAT_ShooterCrowd_Simulated, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Promoted"), STAT_ShooterCrowd_Promoted, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Proxies"), STAT_ShooterCrowd_Proxies, STATGROUP_Game);
+
+bool UShooterCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UShooterCrowdSubsystem::Deinitialize()
+{
+	// the world is going away and will destroy the instance owner, proxies and promoted actors with it
+	Squads.Empty();
+	InstancesOwner = nullptr;
+	FreeProxies.Empty();
+	Cells.Empty();
+
+	Positions.Empty();
+	Yaws.Empty();
+	Goals.Empty();
+	HPs.Empty();
+	FireCooldowns.Empty();
+	PerceptionCooldowns.Empty();
+	Targets.Empty();
+	SquadIndices.Empty();
+	States.Empty();
+	Actors.Empty();
+	Proxies.Empty();
+
+	NumAlive = 0;
+	NumPromoted = 0;
+	NumProxies = 0;
+	NumDrawn = 0;
+
+	Super::Deinitialize();
+}
+
+bool UShooterCrowdSubsystem::IsTickable() const
+{
+	// keep ticking until the last instances are cleared
+	return NumAlive > 0 || NumDrawn > 0;
+}
+
+TStatId UShooterCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterCrowdSubsystem, STATGROUP_Tickables);
+}
+
+int32 UShooterCrowdSubsystem::AddAgents(AShooterNPCSpawner* Spawner, TSubclassOf<AShooterNPC> NPCClass, int32 Count, const FVector& Home, float Radius)
+{
+	if (!IsValid(Spawner) || !NPCClass || Count <= 0)
+	{
+		return 0;
+	}
+
+	// copy the team, movement and size of the NPC class so both representations match
+	const AShooterNPC* NPCCDO = NPCClass->GetDefaultObject<AShooterNPC>();
+
+	const int32 SquadIndex = Squads.Num();
+
+	FShooterCrowdSquad& Squad = Squads.AddDefaulted_GetRef();
+	Squad.Spawner = Spawner;
+	Squad.NPCClass = NPCClass;
+	Squad.TeamByte = NPCCDO->GetTeamByte();
+	Squad.MoveSpeed = NPCCDO->GetCharacterMovement()->MaxWalkSpeed;
+	Squad.HalfHeight = NPCCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	Squad.CapsuleRadius = NPCCDO->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	Squad.Home = Home;
+
+	// proxies carry the tags a promoted NPC gets, so perception tells friend from foe the same way
+	Squad.Tags = NPCCDO->Tags;
+
+	if (NPCCDO->AIControllerClass && NPCCDO->AIControllerClass->IsChildOf<AShooterAIController>())
+	{
+		Squad.Tags.AddUnique(NPCCDO->AIControllerClass->GetDefaultObject<AShooterAIController>()->GetTeamTag());
+	}
+	Squad.Radius = Radius;
+
+	CreateInstances(Squad, NPCCDO);
+
+	InstanceTransforms.SetNum(Squads.Num());
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Positions.Add(PickGoal(Squad));
+		Yaws.Add(FMath::FRandRange(-180.0f, 180.0f));
+		Goals.Add(PickGoal(Squad));
+		HPs.Add(NPCCDO->CurrentHP);
+
+		// spread the shots and enemy searches across frames
+		FireCooldowns.Add(FMath::FRandRange(0.0f, RefireInterval));
+		PerceptionCooldowns.Add(FMath::FRandRange(0.0f, PerceptionInterval));
+
+		Targets.Add(INDEX_NONE);
+		SquadIndices.Add(SquadIndex);
+		States.Add(EShooterCrowdAgentState::Simulated);
+		Actors.AddDefaulted();
+		Proxies.AddDefaulted();
+	}
+
+	NumAlive += Count;
+
+	return Count;
+}
+
+void UShooterCrowdSubsystem::RemoveAgents(AShooterNPCSpawner* Spawner)
+{
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		if (States[i] == EShooterCrowdAgentState::Dead || Squads[SquadIndices[i]].Spawner.Get() != Spawner)
+		{
+			continue;
+		}
+
+		if (States[i] == EShooterCrowdAgentState::Promoted)
+		{
+			--NumPromoted;
+			Actors[i].Reset();
+		}
+
+		ReleaseProxy(i);
+
+		States[i] = EShooterCrowdAgentState::Dead;
+		Targets[i] = INDEX_NONE;
+		--NumAlive;
+	}
+}
+
+void UShooterCrowdSubsystem::GatherEnemyLocations(uint8 TeamByte, TArray<FVector>& OutLocations) const
+{
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		if (States[i] == EShooterCrowdAgentState::Simulated && Squads[SquadIndices[i]].TeamByte != TeamByte)
+		{
+			OutLocations.Add(Positions[i]);
+		}
+	}
+}
+
+void UShooterCrowdSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCrowd_Tick);
+
+	SyncPromoted();
+	UpdateRepresentations();
+	UpdateCells();
+
+	const int32 NumAgents = States.Num();
+
+	// look for enemies on a staggered schedule
+	for (int32 i = 0; i < NumAgents; ++i)
+	{
+		if (States[i] != EShooterCrowdAgentState::Simulated)
+		{
+			continue;
+		}
+
+		PerceptionCooldowns[i] -= DeltaTime;
+
+		if (PerceptionCooldowns[i] <= 0.0f)
+		{
+			PerceptionCooldowns[i] += PerceptionInterval;
+			Targets[i] = FindTarget(i);
+		}
+	}
+
+	// move and shoot
+	for (int32 i = 0; i < NumAgents; ++i)
+	{
+		if (States[i] != EShooterCrowdAgentState::Simulated)
+		{
+			continue;
+		}
+
+		const FShooterCrowdSquad& Squad = Squads[SquadIndices[i]];
+
+		// drop targets killed since the last search
+		int32 Target = Targets[i];
+
+		if (Target != INDEX_NONE && States[Target] == EShooterCrowdAgentState::Dead)
+		{
+			Target = Targets[i] = INDEX_NONE;
+		}
+
+		// close in on the target, or wander to the goal
+		const FVector Destination = Target != INDEX_NONE ? Positions[Target] : Goals[i];
+		const float StopDistance = Target != INDEX_NONE ? FireRange * 0.75f : 50.0f;
+
+		const FVector ToDestination = Destination - Positions[i];
+		const float Distance = ToDestination.Size();
+
+		if (Distance > StopDistance)
+		{
+			Positions[i] += ToDestination / Distance * FMath::Min(Squad.MoveSpeed * DeltaTime, Distance - StopDistance);
+
+		} else if (Target == INDEX_NONE) {
+
+			Goals[i] = PickGoal(Squad);
+		}
+
+		if (Distance > KINDA_SMALL_NUMBER)
+		{
+			Yaws[i] = ToDestination.Rotation().Yaw;
+		}
+
+		// roll a shot against the target when the weapon is ready
+		FireCooldowns[i] = FMath::Max(FireCooldowns[i] - DeltaTime, 0.0f);
+
+		if (Target != INDEX_NONE && FireCooldowns[i] <= 0.0f)
+		{
+			const float TargetDistance = FVector::Dist(Positions[i], Positions[Target]);
+
+			if (TargetDistance <= FireRange)
+			{
+				FireCooldowns[i] = RefireInterval;
+
+				const float HitChance = FMath::Lerp(MaxHitChance, MinHitChance, TargetDistance / FMath::Max(FireRange, 1.0f));
+
+				if (FMath::FRand() < HitChance)
+				{
+					ApplyShotDamage(Target, ShotDamage);
+				}
+			}
+		}
+	}
+
+	UpdateProxies();
+	UpdateInstances();
+
+	SET_DWORD_STAT(STAT_ShooterCrowd_Simulated, GetNumSimulated());
+	SET_DWORD_STAT(STAT_ShooterCrowd_Promoted, NumPromoted);
+	SET_DWORD_STAT(STAT_ShooterCrowd_Proxies, NumProxies);
+}
+
+void UShooterCrowdSubsystem::SyncPromoted()
+{
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		if (States[i] != EShooterCrowdAgentState::Promoted)
+		{
+			continue;
+		}
+
+		AShooterNPC* NPC = Actors[i].Get();
+
+		// the NPC already scored its own death
+		if (!IsValid(NPC) || NPC->IsDead())
+		{
+			KillAgent(i, false);
+			continue;
+		}
+
+		Positions[i] = NPC->GetActorLocation();
+		Yaws[i] = NPC->GetActorRotation().Yaw;
+	}
+}
+
+void UShooterCrowdSubsystem::UpdateRepresentations()
+{
+	// find the local players
+	PlayerLocations.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+
+		if (PC && PC->IsLocalController() && PC->GetPawn())
+		{
+			PlayerLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+
+	// nobody to promote around. Keep everyone as they are until a player comes back
+	if (PlayerLocations.Num() == 0)
+	{
+		return;
+	}
+
+	int32 NumTransitions = 0;
+
+	for (int32 i = 0; i < States.Num() && NumTransitions < MaxTransitionsPerFrame; ++i)
+	{
+		if (States[i] == EShooterCrowdAgentState::Dead)
+		{
+			continue;
+		}
+
+		float ClosestDistanceSquared = UE_MAX_FLT;
+
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(Positions[i], PlayerLocation));
+		}
+
+		if (States[i] == EShooterCrowdAgentState::Simulated)
+		{
+			if (ClosestDistanceSquared < FMath::Square(PromoteRadius) && NumPromoted < MaxPromoted && PromoteAgent(i))
+			{
+				++NumTransitions;
+			}
+
+		} else if (ClosestDistanceSquared > FMath::Square(DemoteRadius)) {
+
+			DemoteAgent(i);
+			++NumTransitions;
+		}
+	}
+}
+
+bool UShooterCrowdSubsystem::PromoteAgent(int32 Index)
+{
+	AShooterNPCSpawner* Spawner = Squads[SquadIndices[Index]].Spawner.Get();
+
+	if (!Spawner)
+	{
+		return false;
+	}
+
+	// take an NPC from the spawner's pool at the combatant's location
+	const FTransform SpawnTransform(FRotator(0.0f, Yaws[Index], 0.0f), Positions[Index]);
+
+	AShooterNPC* NPC = Spawner->AcquireNPC(SpawnTransform);
+
+	if (!NPC)
+	{
+		return false;
+	}
+
+	// carry over the damage taken in the crowd. The actor takes over from the proxy
+	NPC->CurrentHP = HPs[Index];
+	ReleaseProxy(Index);
+
+	States[Index] = EShooterCrowdAgentState::Promoted;
+	Actors[Index] = NPC;
+	Targets[Index] = INDEX_NONE;
+	++NumPromoted;
+
+	return true;
+}
+
+void UShooterCrowdSubsystem::DemoteAgent(int32 Index)
+{
+	if (AShooterNPC* NPC = Actors[Index].Get())
+	{
+		// carry over the actor's state
+		Positions[Index] = NPC->GetActorLocation();
+		Yaws[Index] = NPC->GetActorRotation().Yaw;
+		HPs[Index] = NPC->CurrentHP;
+
+		// return the actor to the spawner's pool
+		if (AShooterNPCSpawner* Spawner = Squads[SquadIndices[Index]].Spawner.Get())
+		{
+			Spawner->ReleaseNPC(NPC);
+		}
+	}
+
+	States[Index] = EShooterCrowdAgentState::Simulated;
+	Actors[Index].Reset();
+	--NumPromoted;
+
+	// look around right away
+	Goals[Index] = PickGoal(Squads[SquadIndices[Index]]);
+	PerceptionCooldowns[Index] = 0.0f;
+}
+
+void UShooterCrowdSubsystem::UpdateCells()
+{
+	// keep the cell allocations across ticks
+	for (TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		if (States[i] != EShooterCrowdAgentState::Dead)
+		{
+			Cells.FindOrAdd(GetCell(Positions[i])).Add(i);
+		}
+	}
+}
+
+FIntPoint UShooterCrowdSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+int32 UShooterCrowdSubsystem::FindTarget(int32 Index) const
+{
+	const uint8 TeamByte = Squads[SquadIndices[Index]].TeamByte;
+
+	int32 ClosestTarget = INDEX_NONE;
+	float ClosestDistanceSquared = FMath::Square(SightRange);
+
+	// only the cells within sight range can hold a target
+	const FIntPoint MinCell = GetCell(Positions[Index] - FVector(SightRange));
+	const FIntPoint MaxCell = GetCell(Positions[Index] + FVector(SightRange));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+
+			if (!Cell)
+			{
+				continue;
+			}
+
+			// promoted enemies are targeted too, and get real damage
+			for (const int32 i : *Cell)
+			{
+				if (States[i] == EShooterCrowdAgentState::Dead || Squads[SquadIndices[i]].TeamByte == TeamByte)
+				{
+					continue;
+				}
+
+				const float DistanceSquared = FVector::DistSquared(Positions[Index], Positions[i]);
+
+				if (DistanceSquared < ClosestDistanceSquared)
+				{
+					ClosestDistanceSquared = DistanceSquared;
+					ClosestTarget = i;
+				}
+			}
+		}
+	}
+
+	return ClosestTarget;
+}
+
+void UShooterCrowdSubsystem::UpdateProxies()
+{
+	// release the proxies that left view range, and move the rest along
+	for (int32 i = 0; i < Proxies.Num(); ++i)
+	{
+		AShooterCrowdProxy* Proxy = Proxies[i].Get();
+
+		if (!Proxy)
+		{
+			// the proxy was destroyed under us
+			if (!Proxies[i].IsExplicitlyNull())
+			{
+				Proxies[i].Reset();
+				--NumProxies;
+			}
+
+			continue;
+		}
+
+		bool bInRange = PlayerLocations.Num() == 0;
+
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			bInRange |= FVector::DistSquared(Positions[i], PlayerLocation) < FMath::Square(ProxyReleaseRadius);
+		}
+
+		if (!bInRange)
+		{
+			ReleaseProxy(i);
+			continue;
+		}
+
+		Proxy->SetActorLocationAndRotation(Positions[i], FRotator(0.0f, Yaws[i], 0.0f), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	// hand out proxies to the simulated combatants in the grid cells around the players
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		const FIntPoint MinCell = GetCell(PlayerLocation - FVector(ProxyRadius));
+		const FIntPoint MaxCell = GetCell(PlayerLocation + FVector(ProxyRadius));
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+
+				if (!Cell)
+				{
+					continue;
+				}
+
+				for (const int32 i : *Cell)
+				{
+					if (NumProxies >= MaxProxies)
+					{
+						return;
+					}
+
+					if (States[i] != EShooterCrowdAgentState::Simulated || Proxies[i].IsValid()
+						|| FVector::DistSquared(Positions[i], PlayerLocation) > FMath::Square(ProxyRadius))
+					{
+						continue;
+					}
+
+					const FTransform ProxyTransform(FRotator(0.0f, Yaws[i], 0.0f), Positions[i]);
+
+					// reuse a pooled proxy, or spawn a new one
+					AShooterCrowdProxy* Proxy = nullptr;
+
+					while (!Proxy && FreeProxies.Num() > 0)
+					{
+						Proxy = FreeProxies.Pop(EAllowShrinking::No);
+
+						if (IsValid(Proxy))
+						{
+							Proxy->SetActorTransform(ProxyTransform, false, nullptr, ETeleportType::TeleportPhysics);
+
+						} else {
+
+							Proxy = nullptr;
+						}
+					}
+
+					if (!Proxy)
+					{
+						FActorSpawnParameters SpawnParams;
+						SpawnParams.ObjectFlags |= RF_Transient;
+						SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+						Proxy = GetWorld()->SpawnActor<AShooterCrowdProxy>(AShooterCrowdProxy::StaticClass(), ProxyTransform, SpawnParams);
+					}
+
+					if (!Proxy)
+					{
+						return;
+					}
+
+					const FShooterCrowdSquad& Squad = Squads[SquadIndices[i]];
+					Proxy->ActivateForAgent(this, i, Squad.Tags, Squad.CapsuleRadius, Squad.HalfHeight);
+
+					Proxies[i] = Proxy;
+					++NumProxies;
+				}
+			}
+		}
+	}
+}
+
+void UShooterCrowdSubsystem::ReleaseProxy(int32 Index)
+{
+	if (!Proxies.IsValidIndex(Index) || !Proxies[Index].IsValid())
+	{
+		return;
+	}
+
+	AShooterCrowdProxy* Proxy = Proxies[Index].Get();
+	Proxies[Index].Reset();
+	--NumProxies;
+
+	Proxy->Deactivate();
+	FreeProxies.Add(Proxy);
+}
+
+void UShooterCrowdSubsystem::ApplyShotDamage(int32 Index, float Damage)
+{
+	if (States[Index] == EShooterCrowdAgentState::Simulated)
+	{
+		HPs[Index] -= Damage;
+
+		if (HPs[Index] <= 0.0f)
+		{
+			KillAgent(Index, true);
+		}
+
+	} else if (States[Index] == EShooterCrowdAgentState::Promoted) {
+
+		// the actor handles its own death, which we pick up on the next sync
+		if (AShooterNPC* NPC = Actors[Index].Get())
+		{
+			NPC->TakeDamage(Damage, FDamageEvent(), nullptr, nullptr);
+		}
+	}
+}
+
+void UShooterCrowdSubsystem::KillAgent(int32 Index, bool bScore)
+{
+	if (States[Index] == EShooterCrowdAgentState::Dead)
+	{
+		return;
+	}
+
+	if (States[Index] == EShooterCrowdAgentState::Promoted)
+	{
+		--NumPromoted;
+		Actors[Index].Reset();
+	}
+
+	ReleaseProxy(Index);
+
+	States[Index] = EShooterCrowdAgentState::Dead;
+	Targets[Index] = INDEX_NONE;
+	--NumAlive;
+
+	const FShooterCrowdSquad& Squad = Squads[SquadIndices[Index]];
+
+	// increment the team score, same as an NPC dying
+	if (bScore)
+	{
+		if (AShooterGameMode* GM = Cast<AShooterGameMode>(GetWorld()->GetAuthGameMode()))
+		{
+			GM->IncrementTeamScore(Squad.TeamByte);
+		}
+	}
+
+	// let the spawner know it has one less combatant
+	if (AShooterNPCSpawner* Spawner = Squad.Spawner.Get())
+	{
+		Spawner->OnCrowdAgentDied();
+	}
+}
+
+FVector UShooterCrowdSubsystem::PickGoal(const FShooterCrowdSquad& Squad) const
+{
+	// keep goals on the navmesh when there is one
+	if (const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		const FVector Floor = Squad.Home - FVector(0.0f, 0.0f, Squad.HalfHeight);
+
+		FNavLocation NavLocation;
+		if (NavSystem->GetRandomReachablePointInRadius(Floor, Squad.Radius, NavLocation))
+		{
+			return NavLocation.Location + FVector(0.0f, 0.0f, Squad.HalfHeight);
+		}
+	}
+
+	// otherwise pick a point on a disc at the spawner's height
+	const float Angle = FMath::FRandRange(0.0f, UE_TWO_PI);
+	const float Distance = Squad.Radius * FMath::Sqrt(FMath::FRand());
+
+	return Squad.Home + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+}
+
+void UShooterCrowdSubsystem::CreateInstances(FShooterCrowdSquad& Squad, const AShooterNPC* NPCCDO)
+{
+	UStaticMesh* Mesh = NPCCDO->GetCrowdMesh();
+
+	// squads without a crowd mesh are simulated but not drawn
+	if (!Mesh)
+	{
+		return;
+	}
+
+	if (!InstancesOwner)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		InstancesOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		USceneComponent* Root = NewObject<USceneComponent>(InstancesOwner, TEXT("Root"));
+		InstancesOwner->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	Squad.MeshScale = NPCCDO->GetCrowdMeshScale();
+
+	Squad.Instances = NewObject<UInstancedStaticMeshComponent>(InstancesOwner);
+	Squad.Instances->SetStaticMesh(Mesh);
+	Squad.Instances->SetMobility(EComponentMobility::Movable);
+	Squad.Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Squad.Instances->SetCanEverAffectNavigation(false);
+	Squad.Instances->SetupAttachment(InstancesOwner->GetRootComponent());
+	Squad.Instances->RegisterComponent();
+	InstancesOwner->AddInstanceComponent(Squad.Instances);
+}
+
+void UShooterCrowdSubsystem::UpdateInstances()
+{
+	for (TArray<FTransform>& Transforms : InstanceTransforms)
+	{
+		Transforms.Reset();
+	}
+
+	// the crowd mesh stands on the floor, below the capsule center
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		if (States[i] == EShooterCrowdAgentState::Simulated)
+		{
+			const FShooterCrowdSquad& Squad = Squads[SquadIndices[i]];
+			const FVector Feet = Positions[i] - FVector(0.0f, 0.0f, Squad.HalfHeight);
+
+			InstanceTransforms[SquadIndices[i]].Emplace(FRotator(0.0f, Yaws[i], 0.0f), Feet, Squad.MeshScale);
+		}
+	}
+
+	NumDrawn = 0;
+
+	for (int32 SquadIndex = 0; SquadIndex < Squads.Num(); ++SquadIndex)
+	{
+		UInstancedStaticMeshComponent* Instances = Squads[SquadIndex].Instances;
+
+		if (!Instances)
+		{
+			continue;
+		}
+
+		const TArray<FTransform>& Transforms = InstanceTransforms[SquadIndex];
+		const int32 NumAgents = Transforms.Num();
+
+		// match the instance count to the simulated combatants
+		const int32 NumInstances = Instances->GetInstanceCount();
+
+		if (NumInstances > NumAgents)
+		{
+			TArray<int32> InstancesToRemove;
+			for (int32 i = NumInstances - 1; i >= NumAgents; --i)
+			{
+				InstancesToRemove.Add(i);
+			}
+
+			Instances->RemoveInstances(InstancesToRemove);
+
+		} else if (NumInstances < NumAgents) {
+
+			TArray<FTransform> NewInstances(Transforms.GetData() + NumInstances, NumAgents - NumInstances);
+			Instances->AddInstances(NewInstances, false, true);
+		}
+
+		if (NumAgents > 0)
+		{
+			Instances->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+		}
+
+		NumDrawn += NumAgents;
+	}
+}
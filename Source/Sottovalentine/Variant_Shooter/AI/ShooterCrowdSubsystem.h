@@ -0,0 +1,290 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterCrowdSubsystem.generated.h"
+
+class AShooterNPC;
+class AShooterNPCSpawner;
+class AShooterCrowdProxy;
+class UInstancedStaticMeshComponent;
+
+/**
+ *  Representation of a crowd combatant
+ */
+enum class EShooterCrowdAgentState : uint8
+{
+	/** Simulated by the crowd and drawn as an instance */
+	Simulated,
+
+	/** Represented by a full NPC actor near a player */
+	Promoted,
+
+	/** Killed, either as a crowd agent or as an actor */
+	Dead
+};
+
+/**
+ *  Crowd combatants added by one spawner
+ *  They share the NPC class, team and instanced mesh of the spawner.
+ */
+USTRUCT()
+struct FShooterCrowdSquad
+{
+	GENERATED_BODY()
+
+	/** Spawner that owns these combatants and provides their actors on promotion */
+	UPROPERTY()
+	TWeakObjectPtr<AShooterNPCSpawner> Spawner;
+
+	/** NPC class the combatants are promoted to */
+	UPROPERTY()
+	TSubclassOf<AShooterNPC> NPCClass;
+
+	/** Draws the simulated combatants of this squad */
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	/** Team byte, from the NPC class */
+	uint8 TeamByte = 1;
+
+	/** Max walk speed, from the NPC class */
+	float MoveSpeed = 0.0f;
+
+	/** Capsule size, from the NPC class. Agent positions are capsule centers */
+	float HalfHeight = 0.0f;
+	float CapsuleRadius = 0.0f;
+
+	/** Tags of the promoted NPC, team tag included, carried by the combatants' proxies */
+	TArray<FName> Tags;
+
+	/** Area the combatants wander in */
+	FVector Home = FVector::ZeroVector;
+	float Radius = 0.0f;
+
+	/** Scale applied to the instanced mesh */
+	FVector MeshScale = FVector::OneVector;
+};
+
+/**
+ *  Simulates distant shooter NPCs as a lightweight crowd, so arenas can hold hundreds of combatants
+ *  Every combatant is a slot in a struct of arrays, bucketed in a 2D grid each tick. Crowd combatants wander around their spawner,
+ *  pick the closest enemy in the grid cells within sight range on a staggered perception update, and trade shots with it as hit rolls scaled by distance.
+ *  Simulated combatants in view range of a player get a pooled proxy actor registered with AI perception,
+ *  so NPC actors and players can sense, target and shoot them.
+ *  Combatants close to a player are promoted to a full NPC actor taken from their spawner's pool, keeping their HP,
+ *  and are demoted back to the crowd when every player is far again. Crowd deaths score for the team the same way NPC deaths do.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Squads, one per spawner */
+	UPROPERTY()
+	TArray<FShooterCrowdSquad> Squads;
+
+	/** Actor owning the instanced mesh components */
+	UPROPERTY()
+	TObjectPtr<AActor> InstancesOwner;
+
+	/** Capsule center of each combatant. Follows the actor while promoted */
+	TArray<FVector> Positions;
+
+	/** Facing of each combatant */
+	TArray<float> Yaws;
+
+	/** Point each combatant is wandering to */
+	TArray<FVector> Goals;
+
+	/** Remaining HP while simulated */
+	TArray<float> HPs;
+
+	/** Time until each combatant can shoot again */
+	TArray<float> FireCooldowns;
+
+	/** Time until each combatant looks for enemies again */
+	TArray<float> PerceptionCooldowns;
+
+	/** Combatant each combatant is shooting at */
+	TArray<int32> Targets;
+
+	/** Squad of each combatant */
+	TArray<int32> SquadIndices;
+
+	/** Current representation of each combatant */
+	TArray<EShooterCrowdAgentState> States;
+
+	/** Actor of each promoted combatant */
+	TArray<TWeakObjectPtr<AShooterNPC>> Actors;
+
+	/** Proxy of each simulated combatant in view range of a player */
+	TArray<TWeakObjectPtr<AShooterCrowdProxy>> Proxies;
+
+	/** Proxies not standing in for anyone */
+	UPROPERTY()
+	TArray<TObjectPtr<AShooterCrowdProxy>> FreeProxies;
+
+	/** Indices of the living combatants in each grid cell, rebuilt every tick */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** Number of combatants still alive, simulated or promoted */
+	int32 NumAlive = 0;
+
+	/** Number of promoted combatants */
+	int32 NumPromoted = 0;
+
+	/** Number of combatants with a proxy */
+	int32 NumProxies = 0;
+
+	/** Number of instances drawn after the last tick */
+	int32 NumDrawn = 0;
+
+	/** Player locations, reused across ticks */
+	TArray<FVector> PlayerLocations;
+
+	/** Scratch instance transforms per squad, reused across ticks */
+	TArray<TArray<FTransform>> InstanceTransforms;
+
+public:
+
+	/** Combatants closer than this to a player are promoted to actors */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float PromoteRadius = 3000.0f;
+
+	/** Promoted combatants further than this from every player go back to the crowd */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float DemoteRadius = 4000.0f;
+
+	/** Max number of combatants represented by actors at once */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 256))
+	int32 MaxPromoted = 24;
+
+	/** Max number of promotions and demotions per frame */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 1, ClampMax = 64))
+	int32 MaxTransitionsPerFrame = 2;
+
+	/** Simulated combatants closer than this to a player get a proxy actor that perception and shots can find */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float ProxyRadius = 8000.0f;
+
+	/** Proxies further than this from every player go back to the pool */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float ProxyReleaseRadius = 9000.0f;
+
+	/** Max number of combatants with a proxy at once */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 1024))
+	int32 MaxProxies = 64;
+
+	/** Size of the grid cells combatants are bucketed in for enemy searches */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 100, ClampMax = 100000, Units = "cm"))
+	float CellSize = 5000.0f;
+
+	/** Time between enemy searches of a crowd combatant */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0.05, ClampMax = 10, Units = "s"))
+	float PerceptionInterval = 0.5f;
+
+	/** Crowd combatants notice enemies closer than this */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float SightRange = 5000.0f;
+
+	/** Crowd combatants shoot at enemies closer than this, and walk towards them otherwise */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float FireRange = 3000.0f;
+
+	/** Time between shots of a crowd combatant */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0.05, ClampMax = 10, Units = "s"))
+	float RefireInterval = 1.5f;
+
+	/** Damage dealt by a crowd shot that hits */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 1000))
+	float ShotDamage = 10.0f;
+
+	/** Chance of a crowd shot hitting at point blank range */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 1))
+	float MaxHitChance = 0.6f;
+
+	/** Chance of a crowd shot hitting at fire range */
+	UPROPERTY(Config, EditAnywhere, Category="Crowd", meta = (ClampMin = 0, ClampMax = 1))
+	float MinHitChance = 0.1f;
+
+public:
+
+	/** Only simulate in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Only tick while there are combatants */
+	virtual bool IsTickable() const override;
+
+	/** Runs the crowd and moves combatants between representations */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tick */
+	virtual TStatId GetStatId() const override;
+
+	/** Adds crowd combatants of the spawner's NPC class around a location. Returns the number added */
+	int32 AddAgents(AShooterNPCSpawner* Spawner, TSubclassOf<AShooterNPC> NPCClass, int32 Count, const FVector& Home, float Radius);
+
+	/** Removes the spawner's remaining crowd combatants without scoring. Promoted ones are left to their actors */
+	void RemoveAgents(AShooterNPCSpawner* Spawner);
+
+	/** Adds the locations of the simulated combatants not on the given team. Promoted ones are left to their actors */
+	void GatherEnemyLocations(uint8 TeamByte, TArray<FVector>& OutLocations) const;
+
+	/** Returns the number of combatants simulated by the crowd */
+	int32 GetNumSimulated() const { return NumAlive - NumPromoted; }
+
+	/** Returns the number of combatants represented by actors */
+	int32 GetNumPromoted() const { return NumPromoted; }
+
+	/** Deals damage to a combatant, from a crowd shot or a hit on its proxy */
+	void ApplyShotDamage(int32 Index, float Damage);
+
+protected:
+
+	/** Syncs promoted combatants from their actors and catches their deaths */
+	void SyncPromoted();
+
+	/** Promotes and demotes combatants by distance to the players */
+	void UpdateRepresentations();
+
+	/** Replaces a crowd combatant with an NPC actor. Returns false if no actor was available */
+	bool PromoteAgent(int32 Index);
+
+	/** Puts a promoted combatant back in the crowd and returns its actor to the pool */
+	void DemoteAgent(int32 Index);
+
+	/** Buckets the living combatants in the grid */
+	void UpdateCells();
+
+	/** Returns the grid cell holding a location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Finds the closest enemy in sight range of a crowd combatant, searching the grid cells in range */
+	int32 FindTarget(int32 Index) const;
+
+	/** Hands out proxies to the simulated combatants in view range of the players, and moves them along */
+	void UpdateProxies();
+
+	/** Puts a combatant's proxy back in the pool */
+	void ReleaseProxy(int32 Index);
+
+	/** Kills a combatant. Scores for its team if it died in the crowd */
+	void KillAgent(int32 Index, bool bScore);
+
+	/** Picks a new point for a combatant to wander to */
+	FVector PickGoal(const FShooterCrowdSquad& Squad) const;
+
+	/** Matches the squad instances to their simulated combatants */
+	void UpdateInstances();
+
+	/** Creates the instanced mesh that draws a squad */
+	void CreateInstances(FShooterCrowdSquad& Squad, const AShooterNPC* NPCCDO);
+};
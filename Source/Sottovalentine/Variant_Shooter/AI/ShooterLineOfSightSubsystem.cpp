@@ -0,0 +1,224 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterLineOfSightSubsystem.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Line of Sight Tick"), STAT_ShooterLineOfSight_Tick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line of Sight Async Traces"), STAT_ShooterLineOfSight_AsyncTraces, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line of Sight Sync Traces"), STAT_ShooterLineOfSight_SyncTraces, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line of Sight Pairs"), STAT_ShooterLineOfSight_Pairs, STATGROUP_Game);
+
+bool UShooterLineOfSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UShooterLineOfSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterLineOfSightSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterLineOfSightSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterLineOfSight_Tick);
+
+	// read back the traces issued on previous frames, and forget pairs nobody asks for anymore
+	for (int32 i = Pairs.Num() - 1; i >= 0; --i)
+	{
+		FLineOfSightPair& Pair = Pairs[i];
+
+		if (!Pair.Observer.IsValid() || !Pair.Target.IsValid() || GFrameCounter - Pair.RequestFrame > uint64(ForgetAfterFrames))
+		{
+			RemovePair(i);
+			continue;
+		}
+
+		if (Pair.PendingTraces.Num() > 0)
+		{
+			CollectTraces(Pair);
+		}
+	}
+
+	// refresh stale pairs, starting after the last pair refreshed
+	int32 NumRefreshed = 0;
+
+	for (int32 Checked = 0; Checked < Pairs.Num() && NumRefreshed < MaxRefreshesPerFrame; ++Checked)
+	{
+		NextRefresh = NextRefresh % Pairs.Num();
+		FLineOfSightPair& Pair = Pairs[NextRefresh++];
+
+		const bool bStale = Pair.Result == EShooterLineOfSight::Unknown || GFrameCounter - Pair.ResultFrame >= uint64(CacheFrames);
+
+		if (bStale && Pair.PendingTraces.Num() == 0)
+		{
+			IssueTraces(Pair);
+			++NumRefreshed;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ShooterLineOfSight_Pairs, Pairs.Num());
+}
+
+EShooterLineOfSight UShooterLineOfSightSubsystem::RequestLineOfSight(AActor* Observer, AActor* Target, EShooterLineOfSightQuery Query, const FVector& Start, TConstArrayView<FVector> Ends)
+{
+	if (!IsValid(Observer) || !IsValid(Target))
+	{
+		return EShooterLineOfSight::Unknown;
+	}
+
+	// a pair without end points would never be traced, so fall back to the target's location
+	if (Ends.Num() == 0)
+	{
+		const FVector TargetLocation = Target->GetActorLocation();
+		return UpdatePair(Observer, Target, Query, Start, MakeArrayView(&TargetLocation, 1)).Result;
+	}
+
+	return UpdatePair(Observer, Target, Query, Start, Ends).Result;
+}
+
+EShooterLineOfSight UShooterLineOfSightSubsystem::ResolveLineOfSight(AActor* Observer, AActor* Target, EShooterLineOfSightQuery Query, const FVector& Start, const FVector& End)
+{
+	if (!IsValid(Observer) || !IsValid(Target))
+	{
+		return EShooterLineOfSight::Unknown;
+	}
+
+	FLineOfSightPair& Pair = UpdatePair(Observer, Target, Query, Start, MakeArrayView(&End, 1));
+
+	if (Pair.Result != EShooterLineOfSight::Unknown)
+	{
+		return Pair.Result;
+	}
+
+	// reset the sync budget on a new frame
+	if (SyncTraceFrame != GFrameCounter)
+	{
+		SyncTraceFrame = GFrameCounter;
+		NumSyncTraces = 0;
+	}
+
+	// over budget, wait for the async traces
+	if (NumSyncTraces >= MaxSyncTracesPerFrame)
+	{
+		return EShooterLineOfSight::Unknown;
+	}
+
+	++NumSyncTraces;
+	INC_DWORD_STAT(STAT_ShooterLineOfSight_SyncTraces);
+
+	FHitResult OutHit;
+	const bool bBlocked = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, TraceChannel, MakeQueryParams(Pair));
+
+	Pair.Result = bBlocked ? EShooterLineOfSight::Blocked : EShooterLineOfSight::Visible;
+	Pair.ResultFrame = GFrameCounter;
+
+	return Pair.Result;
+}
+
+UShooterLineOfSightSubsystem::FLineOfSightPair& UShooterLineOfSightSubsystem::UpdatePair(AActor* Observer, AActor* Target, EShooterLineOfSightQuery Query, const FVector& Start, TConstArrayView<FVector> Ends)
+{
+	const FPairKey Key(Observer, Target, Query);
+
+	int32 Index;
+	if (const int32* FoundIndex = PairIndices.Find(Key))
+	{
+		Index = *FoundIndex;
+
+	} else {
+
+		Index = Pairs.AddDefaulted();
+		PairIndices.Add(Key, Index);
+
+		Pairs[Index].Key = Key;
+		Pairs[Index].Observer = Observer;
+		Pairs[Index].Target = Target;
+	}
+
+	// the next refresh traces from wherever the pair was last asked about
+	FLineOfSightPair& Pair = Pairs[Index];
+	Pair.Start = Start;
+	Pair.Ends.Reset();
+	Pair.Ends.Append(Ends.GetData(), Ends.Num());
+	Pair.RequestFrame = GFrameCounter;
+
+	return Pair;
+}
+
+void UShooterLineOfSightSubsystem::IssueTraces(FLineOfSightPair& Pair)
+{
+	const FCollisionQueryParams QueryParams = MakeQueryParams(Pair);
+
+	for (const FVector& End : Pair.Ends)
+	{
+		Pair.PendingTraces.Add(GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, Pair.Start, End, TraceChannel, QueryParams));
+	}
+
+	INC_DWORD_STAT_BY(STAT_ShooterLineOfSight_AsyncTraces, Pair.Ends.Num());
+}
+
+bool UShooterLineOfSightSubsystem::CollectTraces(FLineOfSightPair& Pair)
+{
+	UWorld* World = GetWorld();
+
+	bool bVisible = false;
+	bool bLost = false;
+
+	for (const FTraceHandle& Handle : Pair.PendingTraces)
+	{
+		FTraceDatum TraceData;
+		if (World->QueryTraceData(Handle, TraceData))
+		{
+			// test traces only report whether something blocked them
+			if (TraceData.OutHits.Num() == 0)
+			{
+				bVisible = true;
+			}
+
+		} else if (World->IsTraceHandleValid(Handle, false)) {
+
+			// still running
+			return false;
+
+		} else {
+
+			bLost = true;
+		}
+	}
+
+	Pair.PendingTraces.Reset();
+
+	// if a trace was lost and none reached the target, keep the last result and try again on the next refresh
+	if (bLost && !bVisible)
+	{
+		return true;
+	}
+
+	Pair.Result = bVisible ? EShooterLineOfSight::Visible : EShooterLineOfSight::Blocked;
+	Pair.ResultFrame = GFrameCounter;
+
+	return true;
+}
+
+void UShooterLineOfSightSubsystem::RemovePair(int32 Index)
+{
+	PairIndices.Remove(Pairs[Index].Key);
+
+	Pairs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// fix up the index of the pair that took its place
+	if (Pairs.IsValidIndex(Index))
+	{
+		PairIndices.Add(Pairs[Index].Key, Index);
+	}
+}
+
+FCollisionQueryParams UShooterLineOfSightSubsystem::MakeQueryParams(const FLineOfSightPair& Pair)
+{
+	// ignore the observer and target. We want an unobstructed trace not counting them
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterLineOfSight), false);
+	QueryParams.AddIgnoredActor(Pair.Observer.Get());
+	QueryParams.AddIgnoredActor(Pair.Target.Get());
+
+	return QueryParams;
+}
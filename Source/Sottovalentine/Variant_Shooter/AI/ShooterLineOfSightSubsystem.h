@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "ShooterLineOfSightSubsystem.generated.h"
+
+class AActor;
+
+/**
+ *  Result of a line of sight query
+ */
+enum class EShooterLineOfSight : uint8
+{
+	/** No trace has completed for this pair yet */
+	Unknown,
+
+	/** At least one trace reached the target */
+	Visible,
+
+	/** Every trace was obstructed */
+	Blocked
+};
+
+/**
+ *  Shape of a line of sight query
+ *  Each shape is cached separately, so queries tracing different points for the same observer and target don't share results
+ */
+enum class EShooterLineOfSightQuery : uint8
+{
+	/** From the observer's eyes to several heights on the target */
+	Eyes,
+
+	/** From the observer's center to the target's center */
+	Center,
+
+	/** From the observer's view to a point above the target */
+	View
+};
+
+/**
+ *  Shared line of sight service for the shooter NPCs
+ *  Requests are cached per observer, target and query shape. Stale pairs are refreshed with async line traces
+ *  issued together from the subsystem tick, up to a fixed number of pairs per frame,
+ *  so the number of traces doesn't grow with the number of NPCs asking every frame.
+ *  Results are available the frame after the traces are issued.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterLineOfSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Observer, target and query shape of a pair */
+	using FPairKey = TTuple<TObjectKey<AActor>, TObjectKey<AActor>, EShooterLineOfSightQuery>;
+
+	/** Cached line of sight between an observer and a target */
+	struct FLineOfSightPair
+	{
+		FPairKey Key;
+
+		TWeakObjectPtr<AActor> Observer;
+		TWeakObjectPtr<AActor> Target;
+
+		/** Trace points from the latest request */
+		FVector Start = FVector::ZeroVector;
+		TArray<FVector, TInlineAllocator<8>> Ends;
+
+		/** Async traces in flight for this pair */
+		TArray<FTraceHandle, TInlineAllocator<8>> PendingTraces;
+
+		/** Frame the result was last updated */
+		uint64 ResultFrame = 0;
+
+		/** Frame the pair was last asked for */
+		uint64 RequestFrame = 0;
+
+		/** Last known result */
+		EShooterLineOfSight Result = EShooterLineOfSight::Unknown;
+	};
+
+	/** Cached pairs */
+	TArray<FLineOfSightPair> Pairs;
+
+	/** Index of each pair in Pairs */
+	TMap<FPairKey, int32> PairIndices;
+
+	/** Pair to start the next refresh from, so every pair gets its turn when the budget runs out */
+	int32 NextRefresh = 0;
+
+	/** Frame the sync trace budget was last reset */
+	uint64 SyncTraceFrame = 0;
+
+	/** Sync traces run this frame */
+	int32 NumSyncTraces = 0;
+
+public:
+
+	/** Number of frames a result is reused before the pair is traced again */
+	UPROPERTY(Config, EditAnywhere, Category="Line of Sight", meta = (ClampMin = 1, ClampMax = 120))
+	int32 CacheFrames = 6;
+
+	/** Max number of pairs refreshed with async traces per frame */
+	UPROPERTY(Config, EditAnywhere, Category="Line of Sight", meta = (ClampMin = 1, ClampMax = 1024))
+	int32 MaxRefreshesPerFrame = 32;
+
+	/** Max number of sync traces per frame for pairs that have never been traced */
+	UPROPERTY(Config, EditAnywhere, Category="Line of Sight", meta = (ClampMin = 0, ClampMax = 64))
+	int32 MaxSyncTracesPerFrame = 4;
+
+	/** Number of frames a pair is kept after it was last asked for */
+	UPROPERTY(Config, EditAnywhere, Category="Line of Sight", meta = (ClampMin = 1, ClampMax = 600))
+	int32 ForgetAfterFrames = 60;
+
+	/** Trace channel used for line of sight */
+	UPROPERTY(Config, EditAnywhere, Category="Line of Sight")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+public:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Collects finished traces and refreshes stale pairs */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tick */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 *  Returns the cached line of sight from the observer to the target, and keeps the pair refreshed.
+	 *  Line of sight exists if any trace from Start to one of the Ends is unobstructed. Observer and target are ignored by the traces. With no Ends, the target's location is traced.
+	 *  Returns Unknown until the first traces for the pair complete.
+	 */
+	EShooterLineOfSight RequestLineOfSight(AActor* Observer, AActor* Target, EShooterLineOfSightQuery Query, const FVector& Start, TConstArrayView<FVector> Ends);
+
+	/**
+	 *  Like RequestLineOfSight, but pairs that have never been traced are traced right away,
+	 *  within the per frame sync trace budget. Returns Unknown past the budget
+	 */
+	EShooterLineOfSight ResolveLineOfSight(AActor* Observer, AActor* Target, EShooterLineOfSightQuery Query, const FVector& Start, const FVector& End);
+
+	/** Returns the number of cached pairs */
+	int32 GetNumPairs() const { return Pairs.Num(); }
+
+protected:
+
+	/** Finds or adds the pair and updates its trace points */
+	FLineOfSightPair& UpdatePair(AActor* Observer, AActor* Target, EShooterLineOfSightQuery Query, const FVector& Start, TConstArrayView<FVector> Ends);
+
+	/** Issues the async traces for a pair */
+	void IssueTraces(FLineOfSightPair& Pair);
+
+	/** Reads back a pair's traces. Returns false while they're still running */
+	bool CollectTraces(FLineOfSightPair& Pair);
+
+	/** Removes a pair, swapping the last one into its place */
+	void RemovePair(int32 Index);
+
+	/** Builds the query params for a pair */
+	static FCollisionQueryParams MakeQueryParams(const FLineOfSightPair& Pair);
+};
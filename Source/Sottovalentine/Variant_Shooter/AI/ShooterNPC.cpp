@@ -11,6 +11,17 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
+#include "ShooterRagdollSubsystem.h"
+#include "ShooterSignificanceSubsystem.h"
+#include "ShooterAIController.h"
+#include "ShooterAimComponent.h"
+
+AShooterNPC::AShooterNPC()
+{
+	// create the aim component. It only traces while we're shooting
+	AimComponent = CreateDefaultSubobject<UShooterAimComponent>(TEXT("Aim Component"));
+	AimComponent->PrimaryComponentTick.bStartWithTickEnabled = false;
+}
 
 void AShooterNPC::BeginPlay()
 {
@@ -23,6 +34,17 @@ void AShooterNPC::BeginPlay()
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
 	Weapon = GetWorld()->SpawnActor<AShooterWeapon>(WeaponClass, GetActorTransform(), SpawnParams);
+
+	// save the starting state so a pooled NPC can be reset after death
+	InitialHP = CurrentHP;
+	InitialMeshRelativeTransform = GetMesh()->GetRelativeTransform();
+	InitialMeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+
+	// lower our tick rates when we're far from the players
+	if (UShooterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UShooterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterNPC(this);
+	}
 }
 
 void AShooterNPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -31,6 +53,18 @@ void AShooterNPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	// clear the death timer
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// stop tracking our ragdoll
+	if (UShooterRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UShooterRagdollSubsystem>())
+	{
+		Ragdolls->UnregisterRagdoll(this);
+	}
+
+	// stop managing our tick rates
+	if (UShooterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UShooterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterNPC(this);
+	}
 }
 
 float AShooterNPC::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -85,13 +119,13 @@ FVector AShooterNPC::GetWeaponTargetLocation()
 	// start aiming from the camera location
 	const FVector AimSource = GetFirstPersonCameraComponent()->GetComponentLocation();
 
-	FVector AimDir, AimTarget = FVector::ZeroVector;
+	FVector AimDir;
 
 	// do we have an aim target?
 	if (CurrentAimTarget)
 	{
 		// target the actor location
-		AimTarget = CurrentAimTarget->GetActorLocation();
+		FVector AimTarget = CurrentAimTarget->GetActorLocation();
 
 		// apply a vertical offset to target head/feet
 		AimTarget.Z += FMath::RandRange(MinAimOffsetZ, MaxAimOffsetZ);
@@ -100,7 +134,6 @@ FVector AShooterNPC::GetWeaponTargetLocation()
 		AimDir = (AimTarget - AimSource).GetSafeNormal();
 		AimDir = UKismetMathLibrary::RandomUnitVectorInConeInDegrees(AimDir, AimVarianceHalfAngle);
 
-		
 	} else {
 
 		// no aim target, so just use the camera facing
@@ -108,19 +141,27 @@ FVector AShooterNPC::GetWeaponTargetLocation()
 
 	}
 
-	// calculate the unobstructed aim target location
-	AimTarget = AimSource + (AimDir * AimRange);
+	// aim as far as the obstruction found by the aim trace
+	return AimSource + (AimDir * AimComponent->GetAimDistance(Weapon && Weapon->NeedsPreciseAim()));
+}
+
+void AShooterNPC::GetWeaponAimRay(FVector& OutStart, FVector& OutEnd)
+{
+	// aim from the camera location
+	OutStart = GetFirstPersonCameraComponent()->GetComponentLocation();
 
-	// run a visibility trace to see if there's obstructions
-	FHitResult OutHit;
+	FVector AimDir = GetFirstPersonCameraComponent()->GetForwardVector();
 
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	// aim at the middle of the vertical offset range on the target, without the per shot randomness
+	if (CurrentAimTarget)
+	{
+		FVector AimTarget = CurrentAimTarget->GetActorLocation();
+		AimTarget.Z += (MinAimOffsetZ + MaxAimOffsetZ) * 0.5f;
 
-	GetWorld()->LineTraceSingleByChannel(OutHit, AimSource, AimTarget, ECC_Visibility, QueryParams);
+		AimDir = (AimTarget - OutStart).GetSafeNormal();
+	}
 
-	// return either the impact point or the trace end
-	return OutHit.bBlockingHit ? OutHit.ImpactPoint : OutHit.TraceEnd;
+	OutEnd = OutStart + (AimDir * AimRange);
 }
 
 void AShooterNPC::AddWeaponClass(const TSubclassOf<AShooterWeapon>& InWeaponClass)
@@ -159,9 +200,19 @@ void AShooterNPC::Die()
 	// raise the dead flag
 	bIsDead = true;
 
+	// stop tracing our aim
+	AimComponent->SetComponentTickEnabled(false);
+
 	// grant the death tag to the character
 	Tags.Add(DeathTag);
 
+	// dead NPCs go back to full rate so the ragdoll animates properly.
+	// Done before the controller lets go of us, so it gets its full rate back too
+	if (UShooterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UShooterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterNPC(this);
+	}
+
 	// call the delegate
 	OnPawnDeath.Broadcast();
 
@@ -183,15 +234,109 @@ void AShooterNPC::Die()
 	GetMesh()->SetSimulatePhysics(true);
 	GetMesh()->SetPhysicsBlendWeight(1.0f);
 
+	// let the ragdoll budget decide how long we simulate
+	if (UShooterRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UShooterRagdollSubsystem>())
+	{
+		Ragdolls->RegisterRagdoll(this, GetMesh());
+	}
+
 	// schedule actor destruction
 	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &AShooterNPC::DeferredDestruction, DeferredDestructionTime, false);
 }
 
 void AShooterNPC::DeferredDestruction()
 {
+	// pooled NPCs go back to their spawner instead
+	if (bPooled)
+	{
+		DeactivateToPool();
+		OnPawnReturnedToPool.Broadcast(this);
+		return;
+	}
+
 	Destroy();
 }
 
+void AShooterNPC::DeactivateToPool()
+{
+	// clear the death timer in case we're deactivated early
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// stop the weapon
+	bIsShooting = false;
+	CurrentAimTarget = nullptr;
+	AimComponent->SetComponentTickEnabled(false);
+
+	if (Weapon)
+	{
+		Weapon->StopFiring();
+		Weapon->SetActorHiddenInGame(true);
+	}
+
+	// stop tracking our ragdoll
+	if (UShooterRagdollSubsystem* Ragdolls = GetWorld()->GetSubsystem<UShooterRagdollSubsystem>())
+	{
+		Ragdolls->UnregisterRagdoll(this);
+	}
+
+	// stop managing our tick rates in case we're deactivated alive
+	if (UShooterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UShooterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterNPC(this);
+	}
+
+	// end the ragdoll, unfreeze the pose and put the mesh back on the capsule
+	GetMesh()->SetNoSkeletonUpdate(false);
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->SetCollisionProfileName(InitialMeshCollisionProfile);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(InitialMeshRelativeTransform);
+
+	// stop moving
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+
+	// hide the character and disable collision
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+}
+
+void AShooterNPC::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	// move to the spawn point
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// come back to life
+	CurrentHP = InitialHP;
+	bIsDead = false;
+	Tags.Remove(DeathTag);
+
+	// enable collision and movement
+	SetActorEnableCollision(true);
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	// show the character and its weapon
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+
+	if (Weapon)
+	{
+		// don't come back with the ammo and cooldown of our previous life
+		Weapon->ResetForReuse();
+		Weapon->SetActorHiddenInGame(false);
+	}
+
+	// manage our tick rates again
+	if (UShooterSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UShooterSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterNPC(this);
+	}
+}
+
 void AShooterNPC::StartShooting(AActor* ActorToShoot)
 {
 	// save the aim target
@@ -200,6 +345,9 @@ void AShooterNPC::StartShooting(AActor* ActorToShoot)
 	// raise the flag
 	bIsShooting = true;
 
+	// keep the aim traced while we shoot
+	AimComponent->SetComponentTickEnabled(true);
+
 	// signal the weapon
 	Weapon->StartFiring();
 }
@@ -209,6 +357,39 @@ void AShooterNPC::StopShooting()
 	// lower the flag
 	bIsShooting = false;
 
+	// stop tracing our aim
+	AimComponent->SetComponentTickEnabled(false);
+
 	// signal the weapon
 	Weapon->StopFiring();
 }
+
+bool AShooterNPC::IsInCombat() const
+{
+	if (bIsShooting)
+	{
+		return true;
+	}
+
+	const AShooterAIController* AIController = Cast<AShooterAIController>(GetController());
+	return AIController && AIController->GetCurrentTarget() != nullptr;
+}
+
+void AShooterNPC::ApplySignificance(EShooterNPCSignificance NewSignificance, const FShooterNPCLODSettings& Settings)
+{
+	Significance = NewSignificance;
+	bHasSignificance = true;
+
+	// slow down movement
+	GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+
+	// reduce the animation rate
+	GetMesh()->bEnableUpdateRateOptimizations = Settings.bUpdateRateOptimizations;
+	GetMesh()->VisibilityBasedAnimTickOption = Settings.VisibilityBasedAnimTickOption;
+
+	// slow down the behavior and perception
+	if (AShooterAIController* AIController = Cast<AShooterAIController>(GetController()))
+	{
+		AIController->ApplyLODSettings(Settings);
+	}
+}
@@ -7,9 +7,15 @@
 #include "ShooterWeaponHolder.h"
 #include "ShooterNPC.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPawnDeathDelegate);
-
 class AShooterWeapon;
+class AShooterNPC;
+class UStaticMesh;
+class UShooterAimComponent;
+struct FShooterNPCLODSettings;
+enum class EShooterNPCSignificance : uint8;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPawnDeathDelegate);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPawnPoolDelegate, AShooterNPC*, NPC);
 
 /**
  *  A simple AI-controlled shooter game NPC
@@ -21,6 +27,10 @@ class SOTTOVALENTINE_API AShooterNPC : public ASottovalentineCharacter, public I
 {
 	GENERATED_BODY()
 
+	/** Traces and caches where the NPC is aiming while it shoots */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UShooterAimComponent* AimComponent;
+
 public:
 
 	/** Current HP for this character. It dies if it reaches zero through damage */
@@ -76,6 +86,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Aim")
 	float MaxAimOffsetZ = -60.0f;
 
+	/** Mesh drawn for this NPC while it's simulated by the crowd far from the players */
+	UPROPERTY(EditAnywhere, Category="Crowd")
+	TObjectPtr<UStaticMesh> CrowdMesh;
+
+	/** Scale applied to the crowd mesh */
+	UPROPERTY(EditAnywhere, Category="Crowd")
+	FVector CrowdMeshScale = FVector::OneVector;
+
 	/** Actor currently being targeted */
 	TObjectPtr<AActor> CurrentAimTarget;
 
@@ -88,11 +106,35 @@ protected:
 	/** Deferred destruction on death timer */
 	FTimerHandle DeathTimer;
 
+	/** If true, this NPC goes back to its spawner's pool after death instead of being destroyed */
+	bool bPooled = false;
+
+	/** HP to restore when this NPC is reused */
+	float InitialHP = 100.0f;
+
+	/** Mesh placement and collision to restore after ragdoll */
+	FTransform InitialMeshRelativeTransform;
+	FName InitialMeshCollisionProfile;
+
+	/** Significance bucket whose settings are currently applied */
+	EShooterNPCSignificance Significance{};
+
+	/** If true, a significance bucket has been applied since this NPC was last registered */
+	bool bHasSignificance = false;
+
 public:
 
 	/** Delegate called when this NPC dies */
 	FPawnDeathDelegate OnPawnDeath;
 
+	/** Delegate called when a pooled NPC has finished its death and is ready to be reused */
+	FPawnPoolDelegate OnPawnReturnedToPool;
+
+public:
+
+	/** Constructor */
+	AShooterNPC();
+
 protected:
 
 	/** Gameplay initialization */
@@ -125,6 +167,9 @@ public:
 	/** Calculates and returns the aim location for the weapon */
 	virtual FVector GetWeaponTargetLocation() override;
 
+	/** Returns the ray the owner aims along, traced by its aim component */
+	virtual void GetWeaponAimRay(FVector& OutStart, FVector& OutEnd) override;
+
 	/** Gives a weapon of this class to the owner */
 	virtual void AddWeaponClass(const TSubclassOf<AShooterWeapon>& WeaponClass) override;
 
@@ -147,6 +192,20 @@ protected:
 	/** Called after death to destroy the actor */
 	void DeferredDestruction();
 
+public:
+
+	/** Returns true if this NPC is reused by its spawner */
+	bool IsPooled() const { return bPooled; }
+
+	/** Flags this NPC as reused by its spawner */
+	void SetPooled(bool bNewPooled) { bPooled = bNewPooled; }
+
+	/** Hides this NPC and resets it out of ragdoll until it's reused */
+	void DeactivateToPool();
+
+	/** Brings this NPC back to life at the given transform. Called before it's possessed again */
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
 public:
 
 	/** Signals this character to start shooting at the passed actor */
@@ -154,4 +213,33 @@ public:
 
 	/** Signals this character to stop shooting */
 	void StopShooting();
+
+	/** Returns true if this NPC is shooting or has a target */
+	bool IsInCombat() const;
+
+	/** Returns true if this NPC has died */
+	bool IsDead() const { return bIsDead; }
+
+	/** Returns the team byte */
+	uint8 GetTeamByte() const { return TeamByte; }
+
+	/** Returns the mesh drawn for this NPC in the crowd */
+	UStaticMesh* GetCrowdMesh() const { return CrowdMesh; }
+
+	/** Returns the scale of the crowd mesh */
+	const FVector& GetCrowdMeshScale() const { return CrowdMeshScale; }
+
+public:
+
+	/** Applies the tick rates and LOD settings of a significance bucket to this NPC and its controller */
+	void ApplySignificance(EShooterNPCSignificance NewSignificance, const FShooterNPCLODSettings& Settings);
+
+	/** Forgets the applied bucket so the next one is applied in full */
+	void ClearSignificance() { bHasSignificance = false; }
+
+	/** Returns true if a significance bucket has been applied */
+	bool HasSignificance() const { return bHasSignificance; }
+
+	/** Returns the applied significance bucket */
+	EShooterNPCSignificance GetSignificance() const { return Significance; }
 };
@@ -8,6 +8,9 @@
 #include "Components/ArrowComponent.h"
 #include "TimerManager.h"
 #include "ShooterNPC.h"
+#include "ShooterAIController.h"
+#include "ShooterCrowdSubsystem.h"
+#include "ShooterSpawnPointSubsystem.h"
 
 // Sets default values
 AShooterNPCSpawner::AShooterNPCSpawner()
@@ -32,7 +35,50 @@ AShooterNPCSpawner::AShooterNPCSpawner()
 void AShooterNPCSpawner::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// register as a spawn point
+	if (UShooterSpawnPointSubsystem* SpawnPoints = GetWorld()->GetSubsystem<UShooterSpawnPointSubsystem>())
+	{
+		SpawnPoints->RegisterSpawnPoint(this, EShooterSpawnPointType::NPCSpawner, SpawnCapsule->GetComponentTransform());
+	}
+
+	// add our background combatants to the crowd
+	if (CrowdCount > 0)
+	{
+		if (UShooterCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UShooterCrowdSubsystem>())
+		{
+			NumCrowdAgents = Crowd->AddAgents(this, NPCClass, CrowdCount, SpawnCapsule->GetComponentLocation(), CrowdRadius);
+		}
+	}
+
+	// create the pooled NPCs ahead of time. We never need more than we'll spawn or promote
+	if (bPoolNPCs && (SpawnCount > 0 || NumCrowdAgents > 0))
+	{
+		const int32 NumToCreate = FMath::Min(PrewarmCount, SpawnCount + NumCrowdAgents);
+
+		for (int32 i = 0; i < NumToCreate; ++i)
+		{
+			FShooterNPCBundle Bundle;
+			if (!CreateBundle(SpawnCapsule->GetComponentTransform(), Bundle))
+			{
+				break;
+			}
+
+			// NPCs without a shooter AI controller can't be pooled
+			if (!Bundle.NPC->IsPooled())
+			{
+				Bundle.NPC->Destroy();
+				break;
+			}
+
+			// hide the NPC until it's needed and stop the AI. The NPC leaves the significance manager first,
+			// so its controller is back at full rate before it lets go
+			Bundle.NPC->DeactivateToPool();
+			Bundle.Controller->ReleasePawn();
+			FreeBundles.Add(Bundle);
+		}
+	}
+
 	// ensure we don't spawn NPCs if our initial spawn count is zero
 	if (SpawnCount > 0)
 	{
@@ -47,26 +93,185 @@ void AShooterNPCSpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 
 	// clear the spawn timer
 	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+
+	// we're no longer a spawn point
+	if (UShooterSpawnPointSubsystem* SpawnPoints = GetWorld()->GetSubsystem<UShooterSpawnPointSubsystem>())
+	{
+		SpawnPoints->UnregisterSpawnPoint(this);
+	}
+
+	// the world cleans up our NPCs on level transitions, so only tidy up if this spawner alone is going away
+	if (EndPlayReason != EEndPlayReason::Destroyed)
+	{
+		return;
+	}
+
+	// take our combatants out of the crowd
+	if (UShooterCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UShooterCrowdSubsystem>())
+	{
+		Crowd->RemoveAgents(this);
+	}
+
+	NumCrowdAgents = 0;
+
+	// destroy the NPCs waiting in the pool
+	for (const FShooterNPCBundle& Bundle : FreeBundles)
+	{
+		if (IsValid(Bundle.NPC))
+		{
+			Bundle.NPC->Destroy();
+		}
+
+		if (IsValid(Bundle.Controller))
+		{
+			Bundle.Controller->Destroy();
+		}
+	}
+
+	FreeBundles.Empty();
+
+	// let the active NPCs die and get destroyed as usual
+	for (const FShooterNPCBundle& Bundle : ActiveBundles)
+	{
+		if (IsValid(Bundle.NPC))
+		{
+			Bundle.NPC->SetPooled(false);
+		}
+
+		// controllers of NPCs already in ragdoll were kept for reuse, so nobody else will destroy them
+		if (IsValid(Bundle.Controller) && Bundle.Controller->GetPawn() != Bundle.NPC)
+		{
+			Bundle.Controller->Destroy();
+		}
+	}
+
+	ActiveBundles.Empty();
 }
 
 void AShooterNPCSpawner::SpawnNPC()
 {
-	// ensure the NPC class is valid
-	if (IsValid(NPCClass))
+	// a dead NPC still in ragdoll will be back in the pool shortly, so wait for it instead of spawning a new actor
+	if (FreeBundles.Num() == 0)
 	{
-		// spawn the NPC at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		const bool bNPCReturning = ActiveBundles.ContainsByPredicate([](const FShooterNPCBundle& Bundle)
+		{
+			return IsValid(Bundle.NPC) && Bundle.NPC->IsPooled() && Bundle.NPC->IsDead();
+		});
+
+		if (bNPCReturning)
+		{
+			bSpawnOnReturn = true;
+			return;
+		}
+	}
 
-		AShooterNPC* SpawnedNPC = GetWorld()->SpawnActor<AShooterNPC>(NPCClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+	bSpawnOnReturn = false;
 
-		// was the NPC successfully created?
-		if (SpawnedNPC)
+	// reuse a pooled NPC if we have one, or spawn a new one at the reference capsule's transform
+	if (AShooterNPC* SpawnedNPC = AcquireNPC(SpawnCapsule->GetComponentTransform()))
+	{
+		// subscribe to the death delegate. Only our own spawns count towards the spawn count, not crowd promotions
+		SpawnedNPC->OnPawnDeath.AddUniqueDynamic(this, &AShooterNPCSpawner::OnNPCDied);
+	}
+}
+
+AShooterNPC* AShooterNPCSpawner::AcquireNPC(const FTransform& SpawnTransform)
+{
+	// reuse a pooled NPC if we have one
+	while (FreeBundles.Num() > 0)
+	{
+		const FShooterNPCBundle Bundle = FreeBundles.Pop(EAllowShrinking::No);
+
+		// skip bundles that were destroyed while pooled
+		if (!IsValid(Bundle.NPC) || !IsValid(Bundle.Controller))
 		{
-			// subscribe to the death delegate
-			SpawnedNPC->OnPawnDeath.AddDynamic(this, &AShooterNPCSpawner::OnNPCDied);
+			continue;
 		}
+
+		// bring the NPC back at the requested transform and restart its AI
+		Bundle.NPC->ActivateFromPool(SpawnTransform);
+		Bundle.Controller->Possess(Bundle.NPC);
+
+		ActiveBundles.Add(Bundle);
+		return Bundle.NPC;
 	}
+
+	// nothing to reuse, spawn a new NPC
+	FShooterNPCBundle Bundle;
+	if (CreateBundle(SpawnTransform, Bundle))
+	{
+		ActiveBundles.Add(Bundle);
+		return Bundle.NPC;
+	}
+
+	return nullptr;
+}
+
+void AShooterNPCSpawner::ReleaseNPC(AShooterNPC* NPC)
+{
+	const int32 BundleIndex = ActiveBundles.IndexOfByPredicate([NPC](const FShooterNPCBundle& Bundle) { return Bundle.NPC == NPC; });
+
+	if (BundleIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FShooterNPCBundle Bundle = ActiveBundles[BundleIndex];
+	ActiveBundles.RemoveAtSwap(BundleIndex);
+
+	// stop counting this NPC as one of our spawns
+	NPC->OnPawnDeath.RemoveDynamic(this, &AShooterNPCSpawner::OnNPCDied);
+
+	// hide the NPC until it's needed again and stop the AI
+	if (NPC->IsPooled() && IsValid(Bundle.Controller))
+	{
+		NPC->DeactivateToPool();
+		Bundle.Controller->ReleasePawn();
+		FreeBundles.Add(Bundle);
+
+	} else {
+
+		if (IsValid(Bundle.Controller))
+		{
+			Bundle.Controller->ReleasePawn();
+			Bundle.Controller->Destroy();
+		}
+
+		NPC->Destroy();
+	}
+}
+
+bool AShooterNPCSpawner::CreateBundle(const FTransform& SpawnTransform, FShooterNPCBundle& OutBundle)
+{
+	// ensure the NPC class is valid
+	if (!IsValid(NPCClass))
+	{
+		return false;
+	}
+
+	// spawn the NPC at the requested transform
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AShooterNPC* SpawnedNPC = GetWorld()->SpawnActor<AShooterNPC>(NPCClass, SpawnTransform, SpawnParams);
+
+	// was the NPC successfully created?
+	if (!SpawnedNPC)
+	{
+		return false;
+	}
+
+	// keep the NPC and its controller together so they can be reused after death
+	OutBundle.NPC = SpawnedNPC;
+	OutBundle.Controller = Cast<AShooterAIController>(SpawnedNPC->GetController());
+
+	if (bPoolNPCs && OutBundle.Controller)
+	{
+		SpawnedNPC->SetPooled(true);
+		SpawnedNPC->OnPawnReturnedToPool.AddDynamic(this, &AShooterNPCSpawner::OnNPCReturnedToPool);
+	}
+
+	return true;
 }
 
 void AShooterNPCSpawner::OnNPCDied()
@@ -83,3 +288,47 @@ void AShooterNPCSpawner::OnNPCDied()
 	// schedule the next NPC spawn
 	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &AShooterNPCSpawner::SpawnNPC, RespawnDelay);
 }
+
+void AShooterNPCSpawner::OnNPCReturnedToPool(AShooterNPC* NPC)
+{
+	const int32 BundleIndex = ActiveBundles.IndexOfByPredicate([NPC](const FShooterNPCBundle& Bundle) { return Bundle.NPC == NPC; });
+
+	if (BundleIndex == INDEX_NONE)
+	{
+		// not ours anymore, destroy it
+		NPC->Destroy();
+		return;
+	}
+
+	// keep the NPC for the next spawn only if we'll spawn or promote again
+	const FShooterNPCBundle Bundle = ActiveBundles[BundleIndex];
+	ActiveBundles.RemoveAtSwap(BundleIndex);
+
+	// whoever reuses the NPC decides whether its death counts as one of our spawns
+	NPC->OnPawnDeath.RemoveDynamic(this, &AShooterNPCSpawner::OnNPCDied);
+
+	if (SpawnCount > 0 || NumCrowdAgents > 0)
+	{
+		FreeBundles.Add(Bundle);
+
+		// the next spawn was waiting for this NPC
+		if (bSpawnOnReturn)
+		{
+			SpawnNPC();
+		}
+
+	} else {
+
+		Bundle.NPC->Destroy();
+
+		if (IsValid(Bundle.Controller))
+		{
+			Bundle.Controller->Destroy();
+		}
+	}
+}
+
+void AShooterNPCSpawner::OnCrowdAgentDied()
+{
+	--NumCrowdAgents;
+}
@@ -9,10 +9,28 @@
 class UCapsuleComponent;
 class UArrowComponent;
 class AShooterNPC;
+class AShooterAIController;
+
+/**
+ *  An NPC and the AI Controller that possesses it, reused together by the spawner
+ */
+USTRUCT()
+struct FShooterNPCBundle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<AShooterNPC> NPC;
+
+	UPROPERTY()
+	TObjectPtr<AShooterAIController> Controller;
+};
 
 /**
  *  A basic Actor in charge of spawning Shooter NPCs and monitoring their deaths.
  *  NPCs will be spawned one by one, and the spawner will wait until it dies before spawning a new one.
+ *  Dead NPCs can be kept with their controller and weapon and brought back to life instead of spawning new ones.
+ *  The spawner can also add background combatants to the crowd, which borrow NPCs from the same pool near the players.
  */
 UCLASS()
 class SOTTOVALENTINE_API AShooterNPCSpawner : public AActor
@@ -43,9 +61,39 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="NPC Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
 
+	/** If true, dead NPCs return to this spawner's pool after their ragdoll and are reused for the next spawns */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="NPC Spawner|Pooling")
+	bool bPoolNPCs = true;
+
+	/** Number of NPCs to create up front, hidden, so even the first spawn doesn't create actors */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="NPC Spawner|Pooling", meta = (ClampMin = 0, ClampMax = 16, EditCondition = "bPoolNPCs"))
+	int32 PrewarmCount = 1;
+
+	/** Number of background combatants simulated by the crowd around this spawner */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="NPC Spawner|Crowd", meta = (ClampMin = 0, ClampMax = 1000))
+	int32 CrowdCount = 0;
+
+	/** Radius the crowd combatants wander in around this spawner */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="NPC Spawner|Crowd", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float CrowdRadius = 3000.0f;
+
+	/** Number of this spawner's crowd combatants still alive */
+	int32 NumCrowdAgents = 0;
+
+	/** If true, the next spawn is waiting for a dead NPC to finish its ragdoll and return to the pool */
+	bool bSpawnOnReturn = false;
+
 	/** Timer to spawn NPCs after a delay */
 	FTimerHandle SpawnTimer;
 
+	/** NPCs spawned by this spawner that are alive or still in ragdoll */
+	UPROPERTY()
+	TArray<FShooterNPCBundle> ActiveBundles;
+
+	/** Dead NPCs ready to be reused */
+	UPROPERTY()
+	TArray<FShooterNPCBundle> FreeBundles;
+
 public:	
 	
 	/** Constructor */
@@ -64,8 +112,32 @@ protected:
 	/** Spawn an NPC and subscribe to its death event */
 	void SpawnNPC();
 
+	/** Spawns a new NPC and its controller. Returns false if the NPC couldn't be created */
+	bool CreateBundle(const FTransform& SpawnTransform, FShooterNPCBundle& OutBundle);
+
 	/** Called when the spawned NPC has died */
 	UFUNCTION()
 	void OnNPCDied();
 
+	/** Called when a pooled NPC has finished its death and can be reused */
+	UFUNCTION()
+	void OnNPCReturnedToPool(AShooterNPC* NPC);
+
+public:
+
+	/** Brings back a pooled NPC or spawns a new one at the given transform, possessed and running its AI */
+	AShooterNPC* AcquireNPC(const FTransform& SpawnTransform);
+
+	/** Takes a living NPC out of play, back into the pool if possible */
+	void ReleaseNPC(AShooterNPC* NPC);
+
+	/** Called by the crowd when one of this spawner's combatants dies */
+	void OnCrowdAgentDied();
+
+	/** Returns the NPCs spawned by this spawner that are alive or still in ragdoll */
+	const TArray<FShooterNPCBundle>& GetActiveBundles() const { return ActiveBundles; }
+
+	/** Returns the type of NPC spawned */
+	const TSubclassOf<AShooterNPC>& GetNPCClass() const { return NPCClass; }
+
 };
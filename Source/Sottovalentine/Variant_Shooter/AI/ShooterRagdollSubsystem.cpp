@@ -0,0 +1,472 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterRagdollSubsystem.h"
+#include "ShooterNPC.h"
+#include "ShooterNPCSpawner.h"
+#include "Sottovalentine.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Budget Tick"), STAT_ShooterRagdoll_Tick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulating Ragdolls"), STAT_ShooterRagdoll_Simulating, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frozen Ragdolls"), STAT_ShooterRagdoll_Frozen, STATGROUP_Game);
+
+bool UShooterRagdollSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UShooterRagdollSubsystem::IsTickable() const
+{
+	return NumSimulating > 0;
+}
+
+TStatId UShooterRagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterRagdollSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterRagdollSubsystem::RegisterRagdoll(AShooterNPC* NPC, USkeletalMeshComponent* Mesh)
+{
+	if (!NPC || !Mesh)
+	{
+		return;
+	}
+
+	// an NPC only has one ragdoll at a time
+	UnregisterRagdoll(NPC);
+
+	FRagdoll& Ragdoll = Ragdolls.AddDefaulted_GetRef();
+	Ragdoll.NPC = NPC;
+	Ragdoll.Mesh = Mesh;
+	Ragdoll.NumBodies = Mesh->Bodies.Num();
+
+	++NumSimulating;
+
+	// a mass kill may have pushed us over budget
+	if (bEnableBudget)
+	{
+		EnforceBudget();
+	}
+}
+
+void UShooterRagdollSubsystem::UnregisterRagdoll(AShooterNPC* NPC)
+{
+	const int32 Index = Ragdolls.IndexOfByPredicate([NPC](const FRagdoll& Ragdoll) { return Ragdoll.NPC == NPC; });
+
+	if (Index != INDEX_NONE)
+	{
+		if (!Ragdolls[Index].bFrozen)
+		{
+			--NumSimulating;
+		}
+
+		Ragdolls.RemoveAtSwap(Index);
+	}
+}
+
+void UShooterRagdollSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterRagdoll_Tick);
+
+	// distances are measured from the local player's camera
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasView = false;
+
+	if (APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0))
+	{
+		ViewLocation = CameraManager->GetCameraLocation();
+		bHasView = true;
+	}
+
+	for (int32 i = Ragdolls.Num() - 1; i >= 0; --i)
+	{
+		FRagdoll& Ragdoll = Ragdolls[i];
+		USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get();
+
+		// forget ragdolls whose NPC went away without unregistering
+		if (!Mesh || !Ragdoll.NPC.IsValid())
+		{
+			if (!Ragdoll.bFrozen)
+			{
+				--NumSimulating;
+			}
+
+			Ragdolls.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (Ragdoll.bFrozen)
+		{
+			continue;
+		}
+
+		Ragdoll.Age += DeltaTime;
+
+		if (!bEnableBudget)
+		{
+			continue;
+		}
+
+		// distant and off screen ragdolls get less simulation time
+		const float Distance = bHasView ? FVector::Dist(ViewLocation, Mesh->GetComponentLocation()) : 0.0f;
+		const bool bOnScreen = Mesh->WasRecentlyRendered(0.25f);
+		const bool bReducedDetail = !bOnScreen || Distance > ReducedDetailDistance;
+		const float SimulationTime = bReducedDetail ? ReducedSimulationTime : MaxSimulationTime;
+
+		// freeze ragdolls that ran out of time, or came to rest
+		if (Ragdoll.Age >= SimulationTime || (Ragdoll.Age >= MinSimulationTime && !Mesh->IsAnyRigidBodyAwake()))
+		{
+			FreezeRagdoll(Ragdoll);
+			continue;
+		}
+
+		// old, distant and hidden ragdolls are the first to go when over budget
+		Ragdoll.FreezeScore = Ragdoll.Age / FMath::Max(SimulationTime, UE_KINDA_SMALL_NUMBER)
+			+ Distance / FMath::Max(ReducedDetailDistance, 1.0f)
+			+ (bOnScreen ? 0.0f : 1.0f);
+	}
+
+	if (bEnableBudget)
+	{
+		EnforceBudget();
+	}
+
+	SET_DWORD_STAT(STAT_ShooterRagdoll_Simulating, NumSimulating);
+	SET_DWORD_STAT(STAT_ShooterRagdoll_Frozen, Ragdolls.Num() - NumSimulating);
+}
+
+void UShooterRagdollSubsystem::EnforceBudget()
+{
+	int32 NumBodies = 0;
+
+	for (const FRagdoll& Ragdoll : Ragdolls)
+	{
+		if (!Ragdoll.bFrozen)
+		{
+			NumBodies += Ragdoll.NumBodies;
+		}
+	}
+
+	while (NumSimulating > 0 && (NumSimulating > MaxSimulatingRagdolls || NumBodies > MaxSimulatedBodies))
+	{
+		// find the least significant simulating ragdoll
+		FRagdoll* ToFreeze = nullptr;
+
+		for (FRagdoll& Ragdoll : Ragdolls)
+		{
+			if (!Ragdoll.bFrozen && Ragdoll.Mesh.IsValid() && (!ToFreeze || Ragdoll.FreezeScore > ToFreeze->FreezeScore))
+			{
+				ToFreeze = &Ragdoll;
+			}
+		}
+
+		if (!ToFreeze)
+		{
+			break;
+		}
+
+		NumBodies -= ToFreeze->NumBodies;
+		FreezeRagdoll(*ToFreeze);
+	}
+}
+
+void UShooterRagdollSubsystem::FreezeRagdoll(FRagdoll& Ragdoll)
+{
+	if (Ragdoll.bFrozen)
+	{
+		return;
+	}
+
+	Ragdoll.bFrozen = true;
+	--NumSimulating;
+
+	if (USkeletalMeshComponent* Mesh = Ragdoll.Mesh.Get())
+	{
+		// stop updating the bones so the mesh holds its current pose, then stop simulating
+		Mesh->SetNoSkeletonUpdate(true);
+		Mesh->SetSimulatePhysics(false);
+
+		// the frozen body can still be shot, but no longer pushes or gets pushed
+		Mesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	}
+}
+
+// ============================================================================
+// Stress test
+// ============================================================================
+
+namespace ShooterRagdollStress
+{
+	/** Steps of each stress test round */
+	enum class EPhase : uint8
+	{
+		Spawn,
+		Settle,
+		Sample
+	};
+
+	/** State of a running stress test */
+	struct FRun
+	{
+		TWeakObjectPtr<UWorld> World;
+		TSubclassOf<AShooterNPC> NPCClass;
+		TArray<int32> Counts;
+		int32 Round = 0;
+		float SampleSeconds = 3.0f;
+		bool bBudget = true;
+		bool bWasBudgeted = true;
+
+		EPhase Phase = EPhase::Spawn;
+		float PhaseTime = 0.0f;
+
+		TArray<TWeakObjectPtr<AShooterNPC>> NPCs;
+
+		/** Physics timing for the current round */
+		double StepStart = 0.0;
+		int32 NumSteps = 0;
+		double TotalStepSeconds = 0.0;
+		double MaxStepSeconds = 0.0;
+		int32 PeakSimulating = 0;
+
+		FDelegateHandle PreTickHandle;
+		FDelegateHandle PostTickHandle;
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+
+	static TUniquePtr<FRun> ActiveRun;
+
+	static void StopTiming(FRun& Run)
+	{
+		UWorld* World = Run.World.Get();
+		if (FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr)
+		{
+			PhysScene->OnPhysScenePreTick.Remove(Run.PreTickHandle);
+			PhysScene->OnPhysScenePostTick.Remove(Run.PostTickHandle);
+		}
+
+		Run.PreTickHandle.Reset();
+		Run.PostTickHandle.Reset();
+	}
+
+	static void DestroyNPCs(FRun& Run)
+	{
+		for (const TWeakObjectPtr<AShooterNPC>& NPC : Run.NPCs)
+		{
+			if (NPC.IsValid())
+			{
+				NPC->Destroy();
+			}
+		}
+
+		Run.NPCs.Reset();
+	}
+
+	static void Finish()
+	{
+		FRun& Run = *ActiveRun;
+
+		StopTiming(Run);
+		DestroyNPCs(Run);
+
+		UWorld* World = Run.World.Get();
+		if (UShooterRagdollSubsystem* Ragdolls = World ? World->GetSubsystem<UShooterRagdollSubsystem>() : nullptr)
+		{
+			Ragdolls->bEnableBudget = Run.bWasBudgeted;
+		}
+
+		FTSTicker::RemoveTicker(Run.TickerHandle);
+		ActiveRun.Reset();
+	}
+
+	static bool Tick(float DeltaTime)
+	{
+		FRun& Run = *ActiveRun;
+
+		UWorld* World = Run.World.Get();
+		UShooterRagdollSubsystem* Ragdolls = World ? World->GetSubsystem<UShooterRagdollSubsystem>() : nullptr;
+		APawn* PlayerPawn = World ? UGameplayStatics::GetPlayerPawn(World, 0) : nullptr;
+		if (!Ragdolls || !PlayerPawn)
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Ragdoll stress test aborted"));
+			Finish();
+			return false;
+		}
+
+		Run.PhaseTime += DeltaTime;
+
+		switch (Run.Phase)
+		{
+			case EPhase::Spawn:
+			{
+				// spawn the NPCs on a grid in front of the player
+				const int32 Count = Run.Counts[Run.Round];
+				const int32 Columns = FMath::CeilToInt(FMath::Sqrt(float(Count)));
+				const FVector Forward = PlayerPawn->GetActorForwardVector().GetSafeNormal2D();
+				const FVector Right = FVector::CrossProduct(FVector::UpVector, Forward);
+
+				FActorSpawnParameters SpawnParams;
+				SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const FVector Location = PlayerPawn->GetActorLocation()
+						+ Forward * (500.0f + 150.0f * (i / Columns))
+						+ Right * (150.0f * (i % Columns - Columns / 2));
+
+					Run.NPCs.Add(World->SpawnActor<AShooterNPC>(Run.NPCClass, FTransform(Forward.Rotation() + FRotator(0.0f, 180.0f, 0.0f), Location), SpawnParams));
+				}
+
+				Run.Phase = EPhase::Settle;
+				Run.PhaseTime = 0.0f;
+				break;
+			}
+
+			case EPhase::Settle:
+			{
+				// let the NPCs land before killing them all on the same frame
+				if (Run.PhaseTime < 0.5f)
+				{
+					break;
+				}
+
+				Run.NumSteps = 0;
+				Run.TotalStepSeconds = 0.0;
+				Run.MaxStepSeconds = 0.0;
+				Run.PeakSimulating = 0;
+
+				// time every physics frame while the ragdolls simulate
+				FPhysScene* PhysScene = World->GetPhysicsScene();
+				Run.PreTickHandle = PhysScene->OnPhysScenePreTick.AddLambda([](auto&&...)
+				{
+					ActiveRun->StepStart = FPlatformTime::Seconds();
+				});
+
+				Run.PostTickHandle = PhysScene->OnPhysScenePostTick.AddLambda([](auto&&...)
+				{
+					const double StepSeconds = FPlatformTime::Seconds() - ActiveRun->StepStart;
+					++ActiveRun->NumSteps;
+					ActiveRun->TotalStepSeconds += StepSeconds;
+					ActiveRun->MaxStepSeconds = FMath::Max(ActiveRun->MaxStepSeconds, StepSeconds);
+				});
+
+				for (const TWeakObjectPtr<AShooterNPC>& NPC : Run.NPCs)
+				{
+					if (NPC.IsValid())
+					{
+						NPC->TakeDamage(NPC->CurrentHP, FDamageEvent(), nullptr, nullptr);
+					}
+				}
+
+				Run.Phase = EPhase::Sample;
+				Run.PhaseTime = 0.0f;
+				break;
+			}
+
+			case EPhase::Sample:
+			{
+				Run.PeakSimulating = FMath::Max(Run.PeakSimulating, Ragdolls->GetNumSimulating());
+
+				if (Run.PhaseTime < Run.SampleSeconds)
+				{
+					break;
+				}
+
+				StopTiming(Run);
+
+				UE_LOG(LogSottovalentine, Display, TEXT("Ragdoll stress (%s): %d deaths, physics frame avg %.2fms max %.2fms over %d frames, peak %d simulating"),
+					Run.bBudget ? TEXT("budgeted") : TEXT("unbudgeted"), Run.Counts[Run.Round],
+					Run.NumSteps > 0 ? Run.TotalStepSeconds / Run.NumSteps * 1000.0 : 0.0, Run.MaxStepSeconds * 1000.0, Run.NumSteps,
+					Run.PeakSimulating);
+
+				DestroyNPCs(Run);
+
+				// move on to the next round
+				if (++Run.Round >= Run.Counts.Num())
+				{
+					Finish();
+					return false;
+				}
+
+				Run.Phase = EPhase::Spawn;
+				Run.PhaseTime = 0.0f;
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	static void Start(const TArray<FString>& Args, UWorld* World)
+	{
+		if (ActiveRun.IsValid())
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Ragdoll stress test already running"));
+			return;
+		}
+
+		UShooterRagdollSubsystem* Ragdolls = World ? World->GetSubsystem<UShooterRagdollSubsystem>() : nullptr;
+		if (!Ragdolls || !World->GetPhysicsScene() || !UGameplayStatics::GetPlayerPawn(World, 0))
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Ragdoll stress test needs a game world with a player pawn"));
+			return;
+		}
+
+		// kill the NPCs the level spawns
+		TSubclassOf<AShooterNPC> NPCClass;
+		for (TActorIterator<AShooterNPCSpawner> It(World); It && !NPCClass; ++It)
+		{
+			NPCClass = It->GetNPCClass();
+		}
+
+		if (!NPCClass)
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Ragdoll stress test needs an NPC spawner in the level"));
+			return;
+		}
+
+		ActiveRun = MakeUnique<FRun>();
+		FRun& Run = *ActiveRun;
+
+		Run.World = World;
+		Run.NPCClass = NPCClass;
+
+		// death counts to test, comma separated
+		if (Args.Num() > 0)
+		{
+			TArray<FString> CountStrings;
+			Args[0].ParseIntoArray(CountStrings, TEXT(","));
+
+			for (const FString& CountString : CountStrings)
+			{
+				Run.Counts.Add(FMath::Clamp(FCString::Atoi(*CountString), 1, 500));
+			}
+		}
+
+		if (Run.Counts.Num() == 0)
+		{
+			Run.Counts = { 20, 50, 100 };
+		}
+
+		if (Args.Num() > 1) { Run.SampleSeconds = FMath::Clamp(FCString::Atof(*Args[1]), 0.5f, 30.0f); }
+		if (Args.Num() > 2) { Run.bBudget = FCString::Atoi(*Args[2]) != 0; }
+
+		Run.bWasBudgeted = Ragdolls->bEnableBudget;
+		Ragdolls->bEnableBudget = Run.bBudget;
+
+		Run.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StressCommand(
+		TEXT("Shooter.RagdollStress"),
+		TEXT("Kills groups of NPCs on the same frame and logs physics frame time while they ragdoll. Works headless (-nullrhi). Args: [Counts=20,50,100] [Seconds=3] [Budget=1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Start));
+}
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterRagdollSubsystem.generated.h"
+
+class AShooterNPC;
+class USkeletalMeshComponent;
+
+/**
+ *  Keeps NPC death ragdolls within a physics budget
+ *  Each ragdoll simulates for a limited time, shorter when it's far away or off screen, then freezes in its last pose.
+ *  When too many ragdolls or bodies simulate at once, the least significant ones freeze early,
+ *  so mass kills cost a bounded amount of physics time.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterRagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A ragdoll being tracked */
+	struct FRagdoll
+	{
+		TWeakObjectPtr<AShooterNPC> NPC;
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+		/** Time since the ragdoll started */
+		float Age = 0.0f;
+
+		/** Number of physics bodies simulated by this ragdoll */
+		int32 NumBodies = 0;
+
+		/** Freeze priority computed on the last tick. Highest freezes first */
+		float FreezeScore = 0.0f;
+
+		/** If true, physics has been stopped and the pose is held */
+		bool bFrozen = false;
+	};
+
+	/** Tracked ragdolls, simulating or frozen */
+	TArray<FRagdoll> Ragdolls;
+
+	/** Number of ragdolls still simulating */
+	int32 NumSimulating = 0;
+
+public:
+
+	/** If false, ragdolls simulate for the whole death time as they used to */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget")
+	bool bEnableBudget = true;
+
+	/** Max number of ragdolls simulating at once */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget", meta = (ClampMin = 0, ClampMax = 128))
+	int32 MaxSimulatingRagdolls = 12;
+
+	/** Max number of ragdoll physics bodies simulating at once */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget", meta = (ClampMin = 0, ClampMax = 4096))
+	int32 MaxSimulatedBodies = 256;
+
+	/** Time a nearby, visible ragdoll simulates before freezing */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget", meta = (ClampMin = 0, ClampMax = 30, Units = "s"))
+	float MaxSimulationTime = 4.0f;
+
+	/** Time a distant or off screen ragdoll simulates before freezing */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget", meta = (ClampMin = 0, ClampMax = 30, Units = "s"))
+	float ReducedSimulationTime = 1.5f;
+
+	/** Ragdolls further than this from the camera use the reduced simulation time */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float ReducedDetailDistance = 2500.0f;
+
+	/** Ragdolls that come to rest are frozen once they've simulated for at least this long */
+	UPROPERTY(Config, EditAnywhere, Category="Ragdoll Budget", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
+	float MinSimulationTime = 0.5f;
+
+public:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Only tick while ragdolls simulate */
+	virtual bool IsTickable() const override;
+
+	/** Ages ragdolls and enforces the budget */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tick */
+	virtual TStatId GetStatId() const override;
+
+	/** Starts tracking a ragdoll that just started simulating */
+	void RegisterRagdoll(AShooterNPC* NPC, USkeletalMeshComponent* Mesh);
+
+	/** Stops tracking a ragdoll. The caller is in charge of resetting the mesh */
+	void UnregisterRagdoll(AShooterNPC* NPC);
+
+	/** Returns the number of ragdolls still simulating */
+	int32 GetNumSimulating() const { return NumSimulating; }
+
+	/** Returns the number of tracked ragdolls */
+	int32 GetNumRagdolls() const { return Ragdolls.Num(); }
+
+protected:
+
+	/** Stops physics on a ragdoll and holds its current pose */
+	void FreezeRagdoll(FRagdoll& Ragdoll);
+
+	/** Freezes the least significant ragdolls until the budget is met */
+	void EnforceBudget();
+};
@@ -0,0 +1,215 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterSignificanceSubsystem.h"
+#include "ShooterNPC.h"
+#include "SignificanceManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_ShooterSignificance_Update, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Near NPCs"), STAT_ShooterSignificance_Near, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Mid NPCs"), STAT_ShooterSignificance_Mid, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Far NPCs"), STAT_ShooterSignificance_Far, STATGROUP_Game);
+
+const FName UShooterSignificanceSubsystem::SignificanceTag = FName("ShooterNPC");
+
+UShooterSignificanceSubsystem::UShooterSignificanceSubsystem()
+{
+	// near NPCs run at full rate
+	NearSettings.StateTreeTickInterval = 0.0f;
+	NearSettings.MovementTickInterval = 0.0f;
+	NearSettings.bEnableSight = true;
+	NearSettings.bUpdateRateOptimizations = false;
+	NearSettings.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	// mid NPCs think and move at a reduced rate but keep looking around
+	MidSettings.StateTreeTickInterval = 0.1f;
+	MidSettings.MovementTickInterval = 0.033f;
+	MidSettings.bEnableSight = true;
+	MidSettings.bUpdateRateOptimizations = true;
+	MidSettings.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+
+	// far NPCs only react to noise and damage, and don't animate off screen
+	FarSettings.StateTreeTickInterval = 0.5f;
+	FarSettings.MovementTickInterval = 0.1f;
+	FarSettings.bEnableSight = false;
+	FarSettings.bUpdateRateOptimizations = true;
+	FarSettings.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+}
+
+bool UShooterSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UShooterSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterSignificanceSubsystem::Tick(float DeltaTime)
+{
+	// wait for the next update
+	TimeUntilUpdate -= DeltaTime;
+
+	if (TimeUntilUpdate > 0.0f)
+	{
+		return;
+	}
+
+	TimeUntilUpdate = UpdateInterval;
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+
+	if (!SignificanceManager)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterSignificance_Update);
+
+	// gather the viewpoints of the local players
+	Viewpoints.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			Viewpoints.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	// keep the last buckets until there's someone to look at the NPCs
+	if (Viewpoints.Num() == 0)
+	{
+		return;
+	}
+
+	SignificanceManager->Update(Viewpoints);
+
+	// count the NPCs in each bucket
+	int32 NumNear = 0;
+	int32 NumMid = 0;
+	int32 NumFar = 0;
+
+	for (const USignificanceManager::FManagedObjectInfo* ObjectInfo : SignificanceManager->GetManagedObjects(SignificanceTag))
+	{
+		switch (EShooterNPCSignificance(FMath::RoundToInt32(ObjectInfo->GetSignificance())))
+		{
+		case EShooterNPCSignificance::Near:
+			++NumNear;
+			break;
+
+		case EShooterNPCSignificance::Mid:
+			++NumMid;
+			break;
+
+		default:
+			++NumFar;
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ShooterSignificance_Near, NumNear);
+	SET_DWORD_STAT(STAT_ShooterSignificance_Mid, NumMid);
+	SET_DWORD_STAT(STAT_ShooterSignificance_Far, NumFar);
+}
+
+void UShooterSignificanceSubsystem::RegisterNPC(AShooterNPC* NPC)
+{
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+
+	if (!SignificanceManager || !IsValid(NPC))
+	{
+		return;
+	}
+
+	// the significance is computed on parallel threads, so it only reads the NPC
+	auto SignificanceFunction = [WeakThis = TWeakObjectPtr<UShooterSignificanceSubsystem>(this)](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+	{
+		const UShooterSignificanceSubsystem* This = WeakThis.Get();
+		const AShooterNPC* NPC = Cast<AShooterNPC>(ObjectInfo->GetObject());
+
+		return (This && NPC) ? This->CalculateSignificance(NPC, Viewpoint) : 0.0f;
+	};
+
+	// the new bucket is applied on the game thread, and only when it changes
+	auto PostSignificanceFunction = [WeakThis = TWeakObjectPtr<UShooterSignificanceSubsystem>(this)](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+	{
+		const UShooterSignificanceSubsystem* This = WeakThis.Get();
+		AShooterNPC* NPC = Cast<AShooterNPC>(ObjectInfo->GetObject());
+
+		// ignore the final call on unregister. The NPC is dying or leaving
+		if (!This || !NPC || bFinal)
+		{
+			return;
+		}
+
+		const EShooterNPCSignificance NewSignificance = EShooterNPCSignificance(FMath::RoundToInt32(Significance));
+
+		if (!NPC->HasSignificance() || NPC->GetSignificance() != NewSignificance)
+		{
+			NPC->ApplySignificance(NewSignificance, This->GetSettings(NewSignificance));
+		}
+	};
+
+	SignificanceManager->RegisterObject(NPC, SignificanceTag, SignificanceFunction, USignificanceManager::EPostSignificanceType::Sequential, PostSignificanceFunction);
+}
+
+void UShooterSignificanceSubsystem::UnregisterNPC(AShooterNPC* NPC)
+{
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(NPC);
+	}
+
+	// put the NPC back at full rate, and have the next registration apply its bucket in full
+	if (IsValid(NPC) && NPC->HasSignificance())
+	{
+		NPC->ApplySignificance(EShooterNPCSignificance::Near, NearSettings);
+		NPC->ClearSignificance();
+	}
+}
+
+const FShooterNPCLODSettings& UShooterSignificanceSubsystem::GetSettings(EShooterNPCSignificance Significance) const
+{
+	switch (Significance)
+	{
+	case EShooterNPCSignificance::Near:
+		return NearSettings;
+
+	case EShooterNPCSignificance::Mid:
+		return MidSettings;
+
+	default:
+		return FarSettings;
+	}
+}
+
+float UShooterSignificanceSubsystem::CalculateSignificance(const AShooterNPC* NPC, const FTransform& Viewpoint) const
+{
+	const float DistanceSquared = FVector::DistSquared(NPC->GetActorLocation(), Viewpoint.GetLocation());
+	const bool bVisible = NPC->WasRecentlyRendered(0.5f);
+	const bool bInCombat = NPC->IsInCombat();
+
+	// close by, or fighting in view
+	if (DistanceSquared < FMath::Square(NearDistance) || (bInCombat && bVisible))
+	{
+		return float(EShooterNPCSignificance::Near);
+	}
+
+	// fighting off screen, or visible within mid range
+	if (bInCombat || (bVisible && DistanceSquared < FMath::Square(MidDistance)))
+	{
+		return float(EShooterNPCSignificance::Mid);
+	}
+
+	return float(EShooterNPCSignificance::Far);
+}
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "ShooterSignificanceSubsystem.generated.h"
+
+class AShooterNPC;
+
+/**
+ *  Significance buckets for shooter NPCs, from least to most significant
+ */
+UENUM()
+enum class EShooterNPCSignificance : uint8
+{
+	Far,
+	Mid,
+	Near
+};
+
+/**
+ *  Tick rates and LOD settings applied to an NPC in a significance bucket
+ */
+USTRUCT()
+struct FShooterNPCLODSettings
+{
+	GENERATED_BODY()
+
+	/** Tick interval of the NPC's behavior StateTree. Zero ticks every frame */
+	UPROPERTY(EditAnywhere, Category="LOD", meta = (ClampMin = 0, ClampMax = 2, Units = "s"))
+	float StateTreeTickInterval = 0.0f;
+
+	/** Tick interval of the character movement. Zero ticks every frame */
+	UPROPERTY(EditAnywhere, Category="LOD", meta = (ClampMin = 0, ClampMax = 1, Units = "s"))
+	float MovementTickInterval = 0.0f;
+
+	/** If false, the NPC stops running sight queries. Hearing and damage still reach it */
+	UPROPERTY(EditAnywhere, Category="LOD")
+	bool bEnableSight = true;
+
+	/** If true, the skeletal mesh updates its animation at a reduced rate based on screen size */
+	UPROPERTY(EditAnywhere, Category="LOD")
+	bool bUpdateRateOptimizations = false;
+
+	/** What the skeletal mesh still animates when it isn't rendered */
+	UPROPERTY(EditAnywhere, Category="LOD")
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+};
+
+/**
+ *  Sorts shooter NPCs into significance buckets by distance, visibility and combat state through the engine significance manager,
+ *  and lowers the tick rates of their behavior, perception, movement and animation in the less significant buckets.
+ *  NPCs fighting are never in the far bucket, and near NPCs are either close to or fighting in view of a player.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Time until the next significance update */
+	float TimeUntilUpdate = 0.0f;
+
+	/** Player viewpoints, reused across updates */
+	TArray<FTransform> Viewpoints;
+
+public:
+
+	/** Time between significance updates */
+	UPROPERTY(Config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, ClampMax = 2, Units = "s"))
+	float UpdateInterval = 0.25f;
+
+	/** NPCs closer than this to a player are near */
+	UPROPERTY(Config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float NearDistance = 2500.0f;
+
+	/** Visible NPCs closer than this to a player are at least mid */
+	UPROPERTY(Config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, ClampMax = 100000, Units = "cm"))
+	float MidDistance = 6000.0f;
+
+	/** Settings for near NPCs */
+	UPROPERTY(Config, EditAnywhere, Category="Significance")
+	FShooterNPCLODSettings NearSettings;
+
+	/** Settings for mid NPCs */
+	UPROPERTY(Config, EditAnywhere, Category="Significance")
+	FShooterNPCLODSettings MidSettings;
+
+	/** Settings for far NPCs */
+	UPROPERTY(Config, EditAnywhere, Category="Significance")
+	FShooterNPCLODSettings FarSettings;
+
+public:
+
+	/** Constructor */
+	UShooterSignificanceSubsystem();
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Updates the significance manager with the player viewpoints */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tick */
+	virtual TStatId GetStatId() const override;
+
+	/** Starts managing an NPC's tick rates */
+	void RegisterNPC(AShooterNPC* NPC);
+
+	/** Stops managing an NPC's tick rates */
+	void UnregisterNPC(AShooterNPC* NPC);
+
+	/** Returns the settings for a bucket */
+	const FShooterNPCLODSettings& GetSettings(EShooterNPCSignificance Significance) const;
+
+protected:
+
+	/** Name the NPCs are registered under in the significance manager */
+	static const FName SignificanceTag;
+
+	/** Works out the bucket of an NPC for one viewpoint */
+	float CalculateSignificance(const AShooterNPC* NPC, const FTransform& Viewpoint) const;
+};
@@ -8,7 +8,9 @@
 #include "AIController.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "ShooterAIController.h"
+#include "ShooterLineOfSightSubsystem.h"
 #include "StateTreeAsyncExecutionContext.h"
+#include "TimerManager.h"
 
 bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionContext& Context) const
 {
@@ -37,36 +39,47 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 	InstanceData.Target->GetActorBounds(true, CenterOfMass, Extent, false);
 
 	// divide the vertical extent by the number of line of sight checks we'll do
-	const float ExtentZOffset = Extent.Z * 2.0f / InstanceData.NumberOfVerticalLineOfSightChecks;
+	const int32 NumChecks = FMath::Max(InstanceData.NumberOfVerticalLineOfSightChecks, 1);
+	const float ExtentZOffset = Extent.Z * 2.0f / NumChecks;
 
 	// get the character's camera location as the source for the line checks
 	const FVector Start = InstanceData.Character->GetFirstPersonCameraComponent()->GetComponentLocation();
 
-	// ignore the character and target. We want to ensure there's an unobstructed trace not counting them
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(InstanceData.Character);
-	QueryParams.AddIgnoredActor(InstanceData.Target);
+	// build a number of vertically offset endpoints on the target
+	TArray<FVector, TInlineAllocator<8>> Ends;
 
-	FHitResult OutHit;
+	for (int32 i = 0; i < NumChecks - 1; ++i)
+	{
+		Ends.Add(CenterOfMass + FVector(0.0f, 0.0f, Extent.Z - ExtentZOffset * i));
+	}
 
-	// run a number of vertically offset line traces to the target location
-	for (int32 i = 0; i < InstanceData.NumberOfVerticalLineOfSightChecks - 1; ++i)
+	// always trace to the center at least, or the pair would never resolve
+	if (Ends.IsEmpty())
 	{
-		// calculate the endpoint for the trace
-		const FVector End = CenterOfMass + FVector(0.0f, 0.0f, Extent.Z - ExtentZOffset * i);
+		Ends.Add(CenterOfMass);
+	}
 
-		InstanceData.Character->GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
+	// read the cached result. The line of sight service traces to the endpoints in batch with the other NPCs
+	UShooterLineOfSightSubsystem* LineOfSight = InstanceData.Character->GetWorld()->GetSubsystem<UShooterLineOfSightSubsystem>();
+	const EShooterLineOfSight Result = LineOfSight ? LineOfSight->RequestLineOfSight(InstanceData.Character, InstanceData.Target, EShooterLineOfSightQuery::Eyes, Start, Ends) : EShooterLineOfSight::Unknown;
 
-		// is the trace unobstructed?
-		if (!OutHit.bBlockingHit)
-		{
-			// we only need one unobstructed trace, so terminate early
+	switch (Result)
+	{
+		case EShooterLineOfSight::Visible:
+
+			// we only need one unobstructed trace
 			return InstanceData.bMustHaveLineOfSight;
-		}
-	}
 
-	// no line of sight found
-	return !InstanceData.bMustHaveLineOfSight;
+		case EShooterLineOfSight::Blocked:
+
+			// no line of sight found
+			return !InstanceData.bMustHaveLineOfSight;
+
+		default:
+
+			// the first traces haven't come back yet. Fail either way so we don't transition on a guess
+			return false;
+	}
 }
 
 #if WITH_EDITOR
@@ -241,15 +254,33 @@ EStateTreeRunStatus FStateTreeSenseEnemiesTask::EnterState(FStateTreeExecutionCo
 						// is the direction within our perception cone?
 						if (DirDot >= MaxDot)
 						{
-							// run a line trace between the character and the sensed actor
-							FCollisionQueryParams QueryParams;
-							QueryParams.AddIgnoredActor(LambdaInstanceData->Character);
-							QueryParams.AddIgnoredActor(SensedActor);
+							// get the line of sight between the character and the sensed actor from the shared service
+							// it only traces right away if it has never seen this pair, within its per frame budget
+							if (UShooterLineOfSightSubsystem* LineOfSight = LambdaInstanceData->Character->GetWorld()->GetSubsystem<UShooterLineOfSightSubsystem>())
+							{
+								const EShooterLineOfSight Result = LineOfSight->ResolveLineOfSight(LambdaInstanceData->Character, SensedActor, EShooterLineOfSightQuery::Center, LambdaInstanceData->Character->GetActorLocation(), SensedActor->GetActorLocation());
 
-							FHitResult OutHit;
+								// the trace hasn't come back yet. Keep our current target and flags and sense this stimulus again next tick,
+								// since perception won't call us again until the stimulus changes
+								if (Result == EShooterLineOfSight::Unknown)
+								{
+									TWeakObjectPtr<AShooterAIController> WeakController = LambdaInstanceData->Controller;
+									TWeakObjectPtr<AActor> WeakSensedActor = SensedActor;
+
+									LambdaInstanceData->Character->GetWorld()->GetTimerManager().SetTimerForNextTick([WeakController, WeakSensedActor, Stimulus]()
+									{
+										if (WeakController.IsValid() && WeakSensedActor.IsValid())
+										{
+											WeakController->OnShooterPerceptionUpdated.ExecuteIfBound(WeakSensedActor.Get(), Stimulus);
+										}
+									});
+
+									return;
+								}
 
-							// we have direct line of sight if this trace is unobstructed
-							bDirectLOS = !LambdaInstanceData->Character->GetWorld()->LineTraceSingleByChannel(OutHit, LambdaInstanceData->Character->GetActorLocation(), SensedActor->GetActorLocation(), ECC_Visibility, QueryParams);
+								// we have direct line of sight if the trace is unobstructed
+								bDirectLOS = Result == EShooterLineOfSight::Visible;
+							}
 
 						}
 
@@ -12,12 +12,16 @@
 #include "Camera/CameraComponent.h"
 #include "TimerManager.h"
 #include "ShooterGameMode.h"
+#include "ShooterAimComponent.h"
 
 AShooterCharacter::AShooterCharacter()
 {
 	// create the noise emitter component
 	PawnNoiseEmitter = CreateDefaultSubobject<UPawnNoiseEmitterComponent>(TEXT("Pawn Noise Emitter"));
 
+	// create the aim component. It traces every frame so the crosshair can use it too
+	AimComponent = CreateDefaultSubobject<UShooterAimComponent>(TEXT("Aim Component"));
+
 	// configure movement
 	GetCharacterMovement()->RotationRate = FRotator(0.0f, 600.0f, 0.0f);
 }
@@ -197,19 +201,15 @@ void AShooterCharacter::UpdateWeaponHUD(int32 CurrentAmmo, int32 MagazineSize)
 
 FVector AShooterCharacter::GetWeaponTargetLocation()
 {
-	// trace ahead from the camera viewpoint
-	FHitResult OutHit;
-
-	const FVector Start = GetFirstPersonCameraComponent()->GetComponentLocation();
-	const FVector End = Start + (GetFirstPersonCameraComponent()->GetForwardVector() * MaxAimDistance);
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
+	// use the aim traced ahead from the camera viewpoint
+	return AimComponent->GetAimLocation(CurrentWeapon && CurrentWeapon->NeedsPreciseAim());
+}
 
-	// return either the impact point or the trace end
-	return OutHit.bBlockingHit ? OutHit.ImpactPoint : OutHit.TraceEnd;
+void AShooterCharacter::GetWeaponAimRay(FVector& OutStart, FVector& OutEnd)
+{
+	// aim ahead from the camera viewpoint
+	OutStart = GetFirstPersonCameraComponent()->GetComponentLocation();
+	OutEnd = OutStart + (GetFirstPersonCameraComponent()->GetForwardVector() * MaxAimDistance);
 }
 
 void AShooterCharacter::AddWeaponClass(const TSubclassOf<AShooterWeapon>& WeaponClass)
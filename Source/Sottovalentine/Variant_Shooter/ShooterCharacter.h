@@ -11,6 +11,7 @@ class AShooterWeapon;
 class UInputAction;
 class UInputComponent;
 class UPawnNoiseEmitterComponent;
+class UShooterAimComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FBulletCountUpdatedDelegate, int32, MagazineSize, int32, Bullets);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDamagedDelegate, float, LifePercent);
@@ -29,6 +30,10 @@ class SOTTOVALENTINE_API AShooterCharacter : public ASottovalentineCharacter, pu
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UPawnNoiseEmitterComponent* PawnNoiseEmitter;
 
+	/** Traces and caches where the character is aiming */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UShooterAimComponent* AimComponent;
+
 protected:
 
 	/** Fire weapon input action */
@@ -151,6 +156,9 @@ public:
 	/** Calculates and returns the aim location for the weapon */
 	virtual FVector GetWeaponTargetLocation() override;
 
+	/** Returns the ray the owner aims along, traced by its aim component */
+	virtual void GetWeaponAimRay(FVector& OutStart, FVector& OutEnd) override;
+
 	/** Gives a weapon of this class to the owner */
 	virtual void AddWeaponClass(const TSubclassOf<AShooterWeapon>& WeaponClass) override;
 
@@ -184,4 +192,10 @@ public:
 
 	/** Returns true if the character is dead */
 	bool IsDead() const;
+
+	/** Returns the aim component */
+	UShooterAimComponent* GetAimComponent() const { return AimComponent; }
+
+	/** Returns the team byte */
+	uint8 GetTeamByte() const { return TeamByte; }
 };
@@ -5,9 +5,8 @@
 #include "EnhancedInputSubsystems.h"
 #include "Engine/LocalPlayer.h"
 #include "InputMappingContext.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/PlayerStart.h"
 #include "ShooterCharacter.h"
+#include "ShooterSpawnPointSubsystem.h"
 #include "ShooterBulletCounterUI.h"
 #include "Sottovalentine.h"
 #include "Widgets/Input/SVirtualJoystick.h"
@@ -109,18 +108,15 @@ void AShooterPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 		BulletCounterUI->BP_UpdateBulletCounter(0, 0);
 	}
 
-	// find the player start
-	TArray<AActor*> ActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), ActorList);
+	// claim the safest player start from the enemies of the character we're respawning
+	UShooterSpawnPointSubsystem* SpawnPoints = GetWorld()->GetSubsystem<UShooterSpawnPointSubsystem>();
 
-	if (ActorList.Num() > 0)
-	{
-		// select a random player start
-		AActor* RandomPlayerStart = ActorList[FMath::RandRange(0, ActorList.Num() - 1)];
+	const uint8 TeamByte = CharacterClass ? GetDefault<AShooterCharacter>(CharacterClass)->GetTeamByte() : 0;
 
+	FTransform SpawnTransform;
+	if (SpawnPoints && SpawnPoints->ClaimSafestSpawnPoint(EShooterSpawnPointType::PlayerStart, TeamByte, SpawnTransform))
+	{
 		// spawn a character at the player start
-		const FTransform SpawnTransform = RandomPlayerStart->GetActorTransform();
-
 		if (AShooterCharacter* RespawnedCharacter = GetWorld()->SpawnActor<AShooterCharacter>(CharacterClass, SpawnTransform))
 		{
 			// possess the character
@@ -0,0 +1,339 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterSpawnPointSubsystem.h"
+#include "ShooterNPC.h"
+#include "ShooterNPCSpawner.h"
+#include "ShooterCrowdSubsystem.h"
+#include "ShooterLineOfSightSubsystem.h"
+#include "GameFramework/PlayerStart.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Point Query"), STAT_ShooterSpawnPoints_Query, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Points"), STAT_ShooterSpawnPoints_Points, STATGROUP_Game);
+
+bool UShooterSpawnPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UShooterSpawnPointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// register the player starts placed in the loaded levels. This is the only time we look through the world's actors
+	for (TActorIterator<APlayerStart> It(&InWorld); It; ++It)
+	{
+		RegisterSpawnPoint(*It, EShooterSpawnPointType::PlayerStart, It->GetActorTransform());
+	}
+
+	// catch any player starts spawned later
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UShooterSpawnPointSubsystem::OnActorSpawned));
+
+	// catch the player starts in streamed levels as they come and go
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UShooterSpawnPointSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UShooterSpawnPointSubsystem::OnLevelRemoved);
+}
+
+void UShooterSpawnPointSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+
+	Points.Empty();
+	PointIndices.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterSpawnPointSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (APlayerStart* PlayerStart = Cast<APlayerStart>(Actor))
+	{
+		RegisterSpawnPoint(PlayerStart, EShooterSpawnPointType::PlayerStart, PlayerStart->GetActorTransform());
+	}
+}
+
+void UShooterSpawnPointSubsystem::OnLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+	if (!Level || InWorld != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (APlayerStart* PlayerStart = Cast<APlayerStart>(Actor))
+		{
+			RegisterSpawnPoint(PlayerStart, EShooterSpawnPointType::PlayerStart, PlayerStart->GetActorTransform());
+		}
+	}
+}
+
+void UShooterSpawnPointSubsystem::OnLevelRemoved(ULevel* Level, UWorld* InWorld)
+{
+	if (InWorld != GetWorld())
+	{
+		return;
+	}
+
+	// a null level means every level is going away
+	for (int32 i = Points.Num() - 1; i >= 0; --i)
+	{
+		const AActor* Actor = Points[i].Actor.Get();
+
+		if (Points[i].Type == EShooterSpawnPointType::PlayerStart && (!Actor || !Level || Actor->GetLevel() == Level))
+		{
+			RemovePoint(i);
+		}
+	}
+}
+
+void UShooterSpawnPointSubsystem::RegisterSpawnPoint(AActor* Actor, EShooterSpawnPointType Type, const FTransform& SpawnTransform)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	// re-registering moves the point
+	UnregisterSpawnPoint(Actor);
+
+	const int32 Index = Points.AddDefaulted();
+	PointIndices.Add(Actor, Index);
+
+	FSpawnPoint& Point = Points[Index];
+	Point.Key = Actor;
+	Point.Actor = Actor;
+	Point.Transform = SpawnTransform;
+	Point.Cell = GetCell(SpawnTransform.GetLocation());
+	Point.Type = Type;
+
+	Cells.FindOrAdd(Point.Cell).Add(Index);
+
+	SET_DWORD_STAT(STAT_ShooterSpawnPoints_Points, Points.Num());
+}
+
+void UShooterSpawnPointSubsystem::UnregisterSpawnPoint(AActor* Actor)
+{
+	if (const int32* FoundIndex = PointIndices.Find(Actor))
+	{
+		RemovePoint(*FoundIndex);
+	}
+}
+
+bool UShooterSpawnPointSubsystem::ClaimSafestSpawnPoint(EShooterSpawnPointType Type, uint8 TeamByte, FTransform& OutTransform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterSpawnPoints_Query);
+
+	// start with every point unthreatened
+	Threats.Reset();
+	Threats.SetNumZeroed(Points.Num());
+
+	UShooterLineOfSightSubsystem* LineOfSight = GetWorld()->GetSubsystem<UShooterLineOfSightSubsystem>();
+
+	// the registered spawners know every enemy NPC in play
+	for (const FSpawnPoint& Point : Points)
+	{
+		const AShooterNPCSpawner* Spawner = Point.Type == EShooterSpawnPointType::NPCSpawner ? Cast<AShooterNPCSpawner>(Point.Actor.Get()) : nullptr;
+
+		if (!Spawner)
+		{
+			continue;
+		}
+
+		for (const FShooterNPCBundle& Bundle : Spawner->GetActiveBundles())
+		{
+			AShooterNPC* NPC = Bundle.NPC;
+
+			if (IsValid(NPC) && !NPC->IsDead() && NPC->GetTeamByte() != TeamByte)
+			{
+				AddThreat(Type, NPC->GetActorLocation(), NPC, LineOfSight);
+			}
+		}
+	}
+
+	// crowd combatants only threaten by distance, they have no actor to trace from
+	if (UShooterCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UShooterCrowdSubsystem>())
+	{
+		CrowdLocations.Reset();
+		Crowd->GatherEnemyLocations(TeamByte, CrowdLocations);
+
+		for (const FVector& Location : CrowdLocations)
+		{
+			AddThreat(Type, Location, nullptr, nullptr);
+		}
+	}
+
+	// pick the least threatened point, or the least recently used one on a tie
+	int32 BestIndex = INDEX_NONE;
+
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		if (Points[i].Type != Type || !Points[i].Actor.IsValid())
+		{
+			continue;
+		}
+
+		if (BestIndex == INDEX_NONE)
+		{
+			BestIndex = i;
+			continue;
+		}
+
+		const bool bSafer = Threats[i] < Threats[BestIndex] - KINDA_SMALL_NUMBER;
+		const bool bOlder = FMath::IsNearlyEqual(Threats[i], Threats[BestIndex]) && Points[i].LastUsedTime < Points[BestIndex].LastUsedTime;
+
+		if (bSafer || bOlder)
+		{
+			BestIndex = i;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	ClaimPoint(BestIndex, OutTransform);
+	return true;
+}
+
+bool UShooterSpawnPointSubsystem::ClaimLeastRecentlyUsedSpawnPoint(EShooterSpawnPointType Type, FTransform& OutTransform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterSpawnPoints_Query);
+
+	int32 BestIndex = INDEX_NONE;
+
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		if (Points[i].Type != Type || !Points[i].Actor.IsValid())
+		{
+			continue;
+		}
+
+		if (BestIndex == INDEX_NONE || Points[i].LastUsedTime < Points[BestIndex].LastUsedTime)
+		{
+			BestIndex = i;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	ClaimPoint(BestIndex, OutTransform);
+	return true;
+}
+
+FIntPoint UShooterSpawnPointSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UShooterSpawnPointSubsystem::AddThreat(EShooterSpawnPointType Type, const FVector& EnemyLocation, APawn* Enemy, UShooterLineOfSightSubsystem* LineOfSight)
+{
+	const float ThreatRadiusSquared = FMath::Square(ThreatRadius);
+
+	// only visit the cells the threat radius reaches
+	const FIntPoint MinCell = GetCell(EnemyLocation - FVector(ThreatRadius));
+	const FIntPoint MaxCell = GetCell(EnemyLocation + FVector(ThreatRadius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 Index : *Cell)
+			{
+				const FSpawnPoint& Point = Points[Index];
+
+				if (Point.Type != Type)
+				{
+					continue;
+				}
+
+				const FVector PointLocation = Point.Transform.GetLocation();
+				const float DistanceSquared = FVector::DistSquared(PointLocation, EnemyLocation);
+
+				if (DistanceSquared > ThreatRadiusSquared)
+				{
+					continue;
+				}
+
+				// closer enemies are a bigger threat
+				Threats[Index] += 1.0f - FMath::Sqrt(DistanceSquared) / ThreatRadius;
+
+				// enemies that can see the point are a bigger threat still. Traces over the service's budget don't count
+				if (Enemy && LineOfSight && Point.Actor.IsValid())
+				{
+					const FVector ViewLocation = PointLocation + FVector(0.0f, 0.0f, ViewHeight);
+
+					if (LineOfSight->ResolveLineOfSight(Enemy, Point.Actor.Get(), EShooterLineOfSightQuery::View, Enemy->GetPawnViewLocation(), ViewLocation) == EShooterLineOfSight::Visible)
+					{
+						Threats[Index] += SightThreat;
+					}
+				}
+			}
+		}
+	}
+}
+
+void UShooterSpawnPointSubsystem::ClaimPoint(int32 Index, FTransform& OutTransform)
+{
+	Points[Index].LastUsedTime = GetWorld()->GetTimeSeconds();
+
+	OutTransform = Points[Index].Transform;
+}
+
+void UShooterSpawnPointSubsystem::RemovePoint(int32 Index)
+{
+	const FSpawnPoint& Point = Points[Index];
+
+	PointIndices.Remove(Point.Key);
+
+	// take the point out of its cell
+	if (TArray<int32>* Cell = Cells.Find(Point.Cell))
+	{
+		Cell->RemoveSwap(Index, EAllowShrinking::No);
+
+		if (Cell->Num() == 0)
+		{
+			Cells.Remove(Point.Cell);
+		}
+	}
+
+	const int32 LastIndex = Points.Num() - 1;
+
+	Points.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// fix up the indices of the point that took its place
+	if (Index != LastIndex)
+	{
+		const FSpawnPoint& MovedPoint = Points[Index];
+
+		PointIndices.Add(MovedPoint.Key, Index);
+
+		if (TArray<int32>* Cell = Cells.Find(MovedPoint.Cell))
+		{
+			if (int32* CellIndex = Cell->FindByKey(LastIndex))
+			{
+				*CellIndex = Index;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ShooterSpawnPoints_Points, Points.Num());
+}
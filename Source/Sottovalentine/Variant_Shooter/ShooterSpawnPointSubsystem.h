@@ -0,0 +1,146 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterSpawnPointSubsystem.generated.h"
+
+class APawn;
+class ULevel;
+class UShooterLineOfSightSubsystem;
+
+/**
+ *  Kind of registered spawn point
+ */
+enum class EShooterSpawnPointType : uint8
+{
+	/** Player start, used to respawn players */
+	PlayerStart,
+
+	/** NPC spawner */
+	NPCSpawner
+};
+
+/**
+ *  Registry of the spawn points in the world
+ *  Player starts are registered when the world begins play, when spawned later, or when their streamed level is added, and NPC spawners register themselves.
+ *  Points are bucketed in a 2D grid, so enemies only threaten the points in the cells around them.
+ *  Respawns claim a point through a ranked query instead of searching every actor in the world:
+ *  the safest point ranks enemies by distance and line of sight, and the least recently used point rotates through them.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterSpawnPointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A registered spawn point */
+	struct FSpawnPoint
+	{
+		TObjectKey<AActor> Key;
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Transform to spawn at */
+		FTransform Transform;
+
+		/** Grid cell holding the point */
+		FIntPoint Cell = FIntPoint::ZeroValue;
+
+		EShooterSpawnPointType Type = EShooterSpawnPointType::PlayerStart;
+
+		/** World time the point was last claimed, or negative if never */
+		double LastUsedTime = -1.0;
+	};
+
+	/** Registered points */
+	TArray<FSpawnPoint> Points;
+
+	/** Index of each registered actor in Points */
+	TMap<TObjectKey<AActor>, int32> PointIndices;
+
+	/** Indices of the points in each grid cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	/** Threat of each point, reused across queries */
+	TArray<float> Threats;
+
+	/** Crowd enemy locations, reused across queries */
+	TArray<FVector> CrowdLocations;
+
+	/** Handle for the actor spawned delegate */
+	FDelegateHandle ActorSpawnedHandle;
+
+	/** Handles for the streamed level delegates */
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+public:
+
+	/** Size of the grid cells */
+	UPROPERTY(Config, EditAnywhere, Category="Spawn Points", meta = (ClampMin = 100, ClampMax = 100000, Units = "cm"))
+	float CellSize = 5000.0f;
+
+	/** Enemies closer than this to a point make it less safe, more so the closer they are */
+	UPROPERTY(Config, EditAnywhere, Category="Spawn Points", meta = (ClampMin = 100, ClampMax = 100000, Units = "cm"))
+	float ThreatRadius = 5000.0f;
+
+	/** Extra threat added by each enemy with line of sight to a point */
+	UPROPERTY(Config, EditAnywhere, Category="Spawn Points", meta = (ClampMin = 0, ClampMax = 100))
+	float SightThreat = 2.0f;
+
+	/** Height above a point that enemies need to see to threaten it */
+	UPROPERTY(Config, EditAnywhere, Category="Spawn Points", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
+	float ViewHeight = 60.0f;
+
+public:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Registers the player starts placed in the level */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Adds a spawn point, or updates it if already registered */
+	void RegisterSpawnPoint(AActor* Actor, EShooterSpawnPointType Type, const FTransform& SpawnTransform);
+
+	/** Removes a spawn point */
+	void UnregisterSpawnPoint(AActor* Actor);
+
+	/**
+	 *  Claims the point of the given type least threatened by enemies of the team, and returns its transform.
+	 *  Ties go to the least recently used point. Returns false if no point of the type is registered
+	 */
+	bool ClaimSafestSpawnPoint(EShooterSpawnPointType Type, uint8 TeamByte, FTransform& OutTransform);
+
+	/** Claims the least recently used point of the given type, and returns its transform. Returns false if no point of the type is registered */
+	bool ClaimLeastRecentlyUsedSpawnPoint(EShooterSpawnPointType Type, FTransform& OutTransform);
+
+	/** Returns the number of registered points */
+	int32 GetNumSpawnPoints() const { return Points.Num(); }
+
+protected:
+
+	/** Registers player starts spawned after the world began play */
+	void OnActorSpawned(AActor* Actor);
+
+	/** Registers the player starts of a streamed level */
+	void OnLevelAdded(ULevel* Level, UWorld* InWorld);
+
+	/** Removes the player starts of a streamed level */
+	void OnLevelRemoved(ULevel* Level, UWorld* InWorld);
+
+	/** Returns the grid cell holding a location */
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Adds threat from an enemy to the points of the given type around it. Pawns are also checked for line of sight */
+	void AddThreat(EShooterSpawnPointType Type, const FVector& EnemyLocation, APawn* Enemy, UShooterLineOfSightSubsystem* LineOfSight);
+
+	/** Marks a point as used and returns its transform */
+	void ClaimPoint(int32 Index, FTransform& OutTransform);
+
+	/** Removes a point, swapping the last one into its place */
+	void RemovePoint(int32 Index);
+};
@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterAimComponent.h"
+#include "ShooterWeaponHolder.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Async Traces"), STAT_ShooterAim_AsyncTraces, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Sync Traces"), STAT_ShooterAim_SyncTraces, STATGROUP_Game);
+
+UShooterAimComponent::UShooterAimComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	// trace after the camera has moved for this frame
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UShooterAimComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	WeaponHolder = Cast<IShooterWeaponHolder>(GetOwner());
+}
+
+void UShooterAimComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!WeaponHolder)
+	{
+		return;
+	}
+
+	CollectTrace();
+
+	// trace the current aim. The result is read back on the next frame
+	FVector Start, End;
+	WeaponHolder->GetWeaponAimRay(Start, End);
+
+	PendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, TraceChannel, MakeQueryParams());
+
+	INC_DWORD_STAT(STAT_ShooterAim_AsyncTraces);
+}
+
+FVector UShooterAimComponent::GetAimLocation(bool bPrecise)
+{
+	if (!WeaponHolder)
+	{
+		return GetOwner()->GetActorLocation();
+	}
+
+	const float Distance = GetAimDistance(bPrecise);
+
+	// aim along the current ray, at the distance of the cached hit
+	FVector Start, End;
+	WeaponHolder->GetWeaponAimRay(Start, End);
+
+	return Start + (End - Start).GetSafeNormal() * Distance;
+}
+
+float UShooterAimComponent::GetAimDistance(bool bPrecise)
+{
+	ResolveCache(bPrecise);
+
+	return AimDistance;
+}
+
+void UShooterAimComponent::ResolveCache(bool bPrecise)
+{
+	if (!WeaponHolder)
+	{
+		return;
+	}
+
+	// precise shots trace right away, but only once per frame
+	if (bPrecise || bSyncRefresh)
+	{
+		if (SyncFrame != GFrameCounter)
+		{
+			RefreshNow();
+		}
+
+		return;
+	}
+
+	// read back the trace early in case we're asked before our tick
+	CollectTrace();
+
+	// the cache is missing or too old to be useful, trace right away
+	if (!bHasCache || GFrameCounter - CacheFrame > uint64(MaxCacheFrames))
+	{
+		RefreshNow();
+	}
+}
+
+void UShooterAimComponent::CollectTrace()
+{
+	if (!PendingTrace.IsValid())
+	{
+		return;
+	}
+
+	FTraceDatum TraceData;
+	if (GetWorld()->QueryTraceData(PendingTrace, TraceData))
+	{
+		const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& OutHit) { return OutHit.bBlockingHit; });
+		UpdateCache(Hit, TraceData.Start, TraceData.End);
+
+		PendingTrace = FTraceHandle();
+
+	} else if (!GetWorld()->IsTraceHandleValid(PendingTrace, false)) {
+
+		// the result was lost, keep the last cache
+		PendingTrace = FTraceHandle();
+	}
+}
+
+void UShooterAimComponent::RefreshNow()
+{
+	FVector Start, End;
+	WeaponHolder->GetWeaponAimRay(Start, End);
+
+	FHitResult OutHit;
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, TraceChannel, MakeQueryParams());
+
+	UpdateCache(bHit ? &OutHit : nullptr, Start, End);
+
+	SyncFrame = GFrameCounter;
+
+	INC_DWORD_STAT(STAT_ShooterAim_SyncTraces);
+}
+
+void UShooterAimComponent::UpdateCache(const FHitResult* Hit, const FVector& Start, const FVector& End)
+{
+	if (Hit)
+	{
+		AimHit = *Hit;
+		AimDistance = Hit->Distance;
+
+	} else {
+
+		AimHit = FHitResult(Start, End);
+		AimDistance = FVector::Dist(Start, End);
+	}
+
+	CacheFrame = GFrameCounter;
+	bHasCache = true;
+}
+
+FCollisionQueryParams UShooterAimComponent::MakeQueryParams() const
+{
+	// ignore the weapon holder
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterAim), false);
+	QueryParams.AddIgnoredActor(GetOwner());
+
+	return QueryParams;
+}
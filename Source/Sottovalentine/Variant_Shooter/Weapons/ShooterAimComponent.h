@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "ShooterAimComponent.generated.h"
+
+class IShooterWeaponHolder;
+
+/**
+ *  Resolves where a weapon holder is aiming
+ *  Traces the holder's aim ray asynchronously once per frame and caches the hit,
+ *  so every shot fired in a frame, and the crosshair, read the same result instead of tracing again.
+ *  Shots are aimed along the current ray at the cached hit distance. The cache can be refreshed
+ *  synchronously when it's too old, or on every shot for weapons that need exact impacts.
+ */
+UCLASS(ClassGroup=(Shooter), meta=(BlueprintSpawnableComponent))
+class SOTTOVALENTINE_API UShooterAimComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	/** Weapon holder providing the aim ray */
+	IShooterWeaponHolder* WeaponHolder = nullptr;
+
+	/** Async trace issued at the end of the last frame */
+	FTraceHandle PendingTrace;
+
+	/** Last resolved aim hit */
+	FHitResult AimHit;
+
+	/** Distance along the aim ray to the last resolved hit, or the full ray length */
+	float AimDistance = 0.0f;
+
+	/** Frame the cache was last updated */
+	uint64 CacheFrame = 0;
+
+	/** Frame the cache was last refreshed synchronously */
+	uint64 SyncFrame = 0;
+
+	/** If true, the cache holds a resolved trace */
+	bool bHasCache = false;
+
+protected:
+
+	/** Trace channel used for aiming */
+	UPROPERTY(EditAnywhere, Category="Aim")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	/** If true, every shot gets a synchronous aim trace, at most once per frame. Weapons can also ask for it per shot */
+	UPROPERTY(EditAnywhere, Category="Aim")
+	bool bSyncRefresh = false;
+
+	/** Number of frames the cached aim is served before a shot traces synchronously instead */
+	UPROPERTY(EditAnywhere, Category="Aim", meta = (ClampMin = 1, ClampMax = 60))
+	int32 MaxCacheFrames = 2;
+
+public:
+
+	/** Constructor */
+	UShooterAimComponent();
+
+protected:
+
+	/** Finds the weapon holder */
+	virtual void OnRegister() override;
+
+public:
+
+	/** Collects last frame's aim trace and issues the next one */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Returns the aim location for a shot along the holder's current aim ray. Precise shots refresh the aim synchronously */
+	FVector GetAimLocation(bool bPrecise = false);
+
+	/** Returns the distance along the aim ray to what the holder is aiming at. Precise shots refresh the aim synchronously */
+	float GetAimDistance(bool bPrecise = false);
+
+	/** Returns the last resolved aim hit, for crosshair feedback */
+	UFUNCTION(BlueprintPure, Category="Aim")
+	const FHitResult& GetAimHit() const { return AimHit; }
+
+	/** Returns the actor under the aim, if any */
+	UFUNCTION(BlueprintPure, Category="Aim")
+	AActor* GetAimedActor() const { return AimHit.GetActor(); }
+
+protected:
+
+	/** Makes sure the cache is fresh enough for a shot */
+	void ResolveCache(bool bPrecise);
+
+	/** Reads back the pending trace into the cache */
+	void CollectTrace();
+
+	/** Traces the current aim ray right away and updates the cache */
+	void RefreshNow();
+
+	/** Updates the cache from a trace result */
+	void UpdateCache(const FHitResult* Hit, const FVector& Start, const FVector& End);
+
+	/** Builds the query params for the aim traces */
+	FCollisionQueryParams MakeQueryParams() const;
+};
@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterAreaDamage.h"
+#include "ShooterCrowdProxy.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/DamageType.h"
+#include "Components/PrimitiveComponent.h"
+#include "Curves/CurveFloat.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Area Damage Tick"), STAT_ShooterAreaDamage_Tick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Area Damage Explosions"), STAT_ShooterAreaDamage_Explosions, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Area Damage Affected Actors"), STAT_ShooterAreaDamage_Actors, STATGROUP_Game);
+
+bool UShooterAreaDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UShooterAreaDamageSubsystem::IsTickable() const
+{
+	return PendingExplosions.Num() > 0 || OccludingExplosions.Num() > 0;
+}
+
+TStatId UShooterAreaDamageSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterAreaDamageSubsystem, STATGROUP_Tickables);
+}
+
+void UShooterAreaDamageSubsystem::QueueExplosion(const FShooterExplosion& Explosion)
+{
+	IssueOverlap(PendingExplosions.Add_GetRef(Explosion));
+}
+
+void UShooterAreaDamageSubsystem::IssueOverlap(FShooterExplosion& Explosion)
+{
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
+
+	Explosion.OverlapHandle = GetWorld()->AsyncOverlapByObjectType(Explosion.Center, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Explosion.Radius), MakeQueryParams(Explosion));
+}
+
+void UShooterAreaDamageSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterAreaDamage_Tick);
+
+	UWorld* World = GetWorld();
+
+	// take the explosions whose occlusion traces are all back
+	for (int32 i = 0; i < OccludingExplosions.Num();)
+	{
+		if (ReadOcclusionTraces(OccludingExplosions[i]))
+		{
+			ResolvingExplosions.Add(MoveTemp(OccludingExplosions[i]));
+			OccludingExplosions.RemoveAt(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		++i;
+	}
+
+	// take the explosions whose overlaps are ready, oldest first
+	int32 NumGathered = 0;
+
+	for (int32 i = 0; i < PendingExplosions.Num();)
+	{
+		FShooterExplosion& Explosion = PendingExplosions[i];
+
+		FOverlapDatum OverlapData;
+		if (World->QueryOverlapData(Explosion.OverlapHandle, OverlapData))
+		{
+			if (NumGathered < MaxExplosionsPerFrame)
+			{
+				++NumGathered;
+				GatherVictims(Explosion, OverlapData.OutOverlaps);
+
+				// explosions checking occlusion wait for their traces. The rest are resolved right away
+				if (Explosion.bOcclusion && Explosion.Victims.Num() > 0)
+				{
+					OccludingExplosions.Add(MoveTemp(Explosion));
+				} else {
+					ResolvingExplosions.Add(MoveTemp(Explosion));
+				}
+
+				PendingExplosions.RemoveAt(i, 1, EAllowShrinking::No);
+				continue;
+			}
+
+			// over budget. The result won't be kept past this frame, so overlap again for the next one
+			IssueOverlap(Explosion);
+
+		} else if (!World->IsTraceHandleValid(Explosion.OverlapHandle, true)) {
+
+			// the result was lost, overlap again
+			IssueOverlap(Explosion);
+		}
+
+		++i;
+	}
+
+	// resolve them. Explosions chained from these are queued and resolved on a later tick
+	for (int32 i = 0; i < ResolvingExplosions.Num(); ++i)
+	{
+		ResolveExplosion(ResolvingExplosions[i]);
+
+		// the damage causer is free to be reused now
+		ResolvingExplosions[i].OnResolved.ExecuteIfBound();
+	}
+
+	INC_DWORD_STAT_BY(STAT_ShooterAreaDamage_Explosions, ResolvingExplosions.Num());
+
+	ResolvingExplosions.Reset();
+}
+
+void UShooterAreaDamageSubsystem::GatherVictims(FShooterExplosion& Explosion, TArrayView<const FOverlapResult> Overlaps)
+{
+	AffectedActors.Reset();
+	Explosion.Victims.Reset();
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* Actor = Overlap.GetActor();
+		UPrimitiveComponent* Component = Overlap.GetComponent();
+
+		// actors may have been destroyed since the overlap
+		if (!IsValid(Actor) || !IsValid(Component))
+		{
+			continue;
+		}
+
+		// overlaps may return the same actor once per component. Only affect each actor once
+		bool bAlreadyAffected = false;
+		AffectedActors.Add(Actor, &bAlreadyAffected);
+
+		if (bAlreadyAffected)
+		{
+			continue;
+		}
+
+		FShooterExplosionVictim& Victim = Explosion.Victims.AddDefaulted_GetRef();
+		Victim.Actor = Actor;
+		Victim.Component = Component;
+
+		if (Explosion.bOcclusion)
+		{
+			IssueOcclusionTrace(Explosion, Victim);
+		}
+	}
+}
+
+void UShooterAreaDamageSubsystem::IssueOcclusionTrace(const FShooterExplosion& Explosion, FShooterExplosionVictim& Victim)
+{
+	const AActor* Actor = Victim.Actor.Get();
+
+	if (!Actor)
+	{
+		Victim.OcclusionHandle = FTraceHandle();
+		return;
+	}
+
+	// anything in the way other than the actor itself and the shooter blocks the explosion
+	FCollisionQueryParams QueryParams = MakeQueryParams(Explosion);
+	QueryParams.AddIgnoredActor(Actor);
+
+	for (const TWeakObjectPtr<AActor>& IgnoredActor : Explosion.OcclusionIgnoredActors)
+	{
+		QueryParams.AddIgnoredActor(IgnoredActor.Get());
+	}
+
+	Victim.OcclusionHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Explosion.Center, Actor->GetActorLocation(), OcclusionChannel, QueryParams);
+}
+
+bool UShooterAreaDamageSubsystem::ReadOcclusionTraces(FShooterExplosion& Explosion)
+{
+	UWorld* World = GetWorld();
+	bool bAllDone = true;
+
+	for (FShooterExplosionVictim& Victim : Explosion.Victims)
+	{
+		// already read, or nothing left to trace to
+		if (!Victim.OcclusionHandle.IsValid())
+		{
+			continue;
+		}
+
+		FTraceDatum TraceData;
+		if (World->QueryTraceData(Victim.OcclusionHandle, TraceData))
+		{
+			Victim.bOccluded = FHitResult::GetFirstBlockingHit(TraceData.OutHits) != nullptr;
+			Victim.OcclusionHandle = FTraceHandle();
+			continue;
+		}
+
+		// the result was lost, trace again
+		if (!World->IsTraceHandleValid(Victim.OcclusionHandle, false))
+		{
+			IssueOcclusionTrace(Explosion, Victim);
+		}
+
+		bAllDone &= !Victim.OcclusionHandle.IsValid();
+	}
+
+	return bAllDone;
+}
+
+void UShooterAreaDamageSubsystem::ResolveExplosion(const FShooterExplosion& Explosion)
+{
+	for (const FShooterExplosionVictim& Victim : Explosion.Victims)
+	{
+		AActor* Actor = Victim.Actor.Get();
+		UPrimitiveComponent* Component = Victim.Component.Get();
+
+		// actors may have been destroyed since the overlap, or by the damage we've applied so far
+		if (!IsValid(Actor) || !IsValid(Component) || Victim.bOccluded)
+		{
+			continue;
+		}
+
+		const FVector ExplosionDir = Actor->GetActorLocation() - Explosion.Center;
+
+		// scale the damage and impulse by distance
+		float Strength = 1.0f;
+
+		if (const UCurveFloat* Falloff = Explosion.Falloff.Get())
+		{
+			const float Distance = FMath::Clamp(ExplosionDir.Size() / FMath::Max(Explosion.Radius, 1.0f), 0.0f, 1.0f);
+			Strength = FMath::Max(Falloff->GetFloatValue(Distance), 0.0f);
+		}
+
+		if (Strength <= 0.0f)
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_ShooterAreaDamage_Actors);
+
+		// damage characters and crowd combatants
+		if (Actor->IsA<ACharacter>() || Actor->IsA<AShooterCrowdProxy>())
+		{
+			UGameplayStatics::ApplyDamage(Actor, Explosion.Damage * Strength, Explosion.Instigator.Get(), Explosion.DamageCauser.Get(), Explosion.DamageType);
+		}
+
+		// push physics objects away from the explosion
+		if (Component->IsSimulatingPhysics())
+		{
+			Component->AddImpulseAtLocation(ExplosionDir.GetSafeNormal() * Explosion.PhysicsForce * Strength, Explosion.Center);
+		}
+	}
+}
+
+FCollisionQueryParams UShooterAreaDamageSubsystem::MakeQueryParams(const FShooterExplosion& Explosion)
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterAreaDamage), false);
+	QueryParams.AddIgnoredActor(Explosion.DamageCauser.Get());
+
+	for (const TWeakObjectPtr<AActor>& IgnoredActor : Explosion.IgnoredActors)
+	{
+		QueryParams.AddIgnoredActor(IgnoredActor.Get());
+	}
+
+	return QueryParams;
+}
@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "Engine/OverlapResult.h"
+#include "ShooterAreaDamage.generated.h"
+
+class AController;
+class UCurveFloat;
+class UDamageType;
+class UPrimitiveComponent;
+
+/**
+ *  An actor caught in an explosion
+ */
+struct FShooterExplosionVictim
+{
+	/** Actor overlapped, and the first of its components found */
+	TWeakObjectPtr<AActor> Actor;
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	/** Async occlusion trace between the actor and the center, until its result is read */
+	FTraceHandle OcclusionHandle;
+
+	/** True if something blocks the explosion from reaching the actor */
+	bool bOccluded = false;
+};
+
+/**
+ *  An explosion to be resolved by the area damage subsystem
+ */
+struct FShooterExplosion
+{
+	/** Center and radius of the explosion */
+	FVector Center = FVector::ZeroVector;
+	float Radius = 0.0f;
+
+	/** Damage dealt at full strength */
+	float Damage = 0.0f;
+
+	/** Impulse applied to physics objects at full strength */
+	float PhysicsForce = 0.0f;
+
+	/** Type of damage dealt */
+	TSubclassOf<UDamageType> DamageType;
+
+	/** Strength multiplier by distance, from 0 at the center to 1 at the radius. Full strength everywhere if unset */
+	TWeakObjectPtr<const UCurveFloat> Falloff;
+
+	/** If true, actors with something blocking visibility between them and the center are not affected */
+	bool bOcclusion = false;
+
+	/** Actor that caused the explosion, ignored by it. Pooled causers must stay out of their pool until OnResolved */
+	TWeakObjectPtr<AActor> DamageCauser;
+
+	/** Controller credited with the damage */
+	TWeakObjectPtr<AController> Instigator;
+
+	/** Actors the explosion ignores, usually the shooter */
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<2>> IgnoredActors;
+
+	/** Actors that never block the occlusion traces, usually the shooter. Unlike ignored actors they can still be damaged */
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<2>> OcclusionIgnoredActors;
+
+	/** Async overlap for this explosion */
+	FTraceHandle OverlapHandle;
+
+	/** Actors caught in the explosion, found once the overlap is back */
+	TArray<FShooterExplosionVictim> Victims;
+
+	/** Called once the explosion has applied its damage */
+	FSimpleDelegate OnResolved;
+};
+
+/**
+ *  Resolves explosion damage in batch
+ *  Explosions are queued with an async overlap issued right away. On the next tick the overlaps are read back
+ *  and each affected actor is found once through a hash set. Explosions checking occlusion then issue an async
+ *  line trace per actor and wait for all of them. Finally damage and impulse are applied together,
+ *  scaled by the explosion falloff.
+ *  Neither chained explosions nor occlusion ever run a sync query on the game thread.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterAreaDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Explosions waiting for their overlap */
+	TArray<FShooterExplosion> PendingExplosions;
+
+	/** Explosions waiting for their occlusion traces */
+	TArray<FShooterExplosion> OccludingExplosions;
+
+	/** Explosions being resolved this tick. Explosions queued while resolving wait for the next tick */
+	TArray<FShooterExplosion> ResolvingExplosions;
+
+	/** Actors already found in the explosion being gathered */
+	TSet<AActor*> AffectedActors;
+
+public:
+
+	/** Max number of explosions whose overlaps are read back per frame. The rest wait for the next frame */
+	UPROPERTY(Config, EditAnywhere, Category="Area Damage", meta = (ClampMin = 1, ClampMax = 1024))
+	int32 MaxExplosionsPerFrame = 32;
+
+	/** Trace channel used for explosion occlusion */
+	UPROPERTY(Config, EditAnywhere, Category="Area Damage")
+	TEnumAsByte<ECollisionChannel> OcclusionChannel = ECC_Visibility;
+
+public:
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Only tick while explosions are pending or waiting for occlusion */
+	virtual bool IsTickable() const override;
+
+	/** Resolves the explosions queued on previous frames */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tick */
+	virtual TStatId GetStatId() const override;
+
+	/** Queues an explosion and issues its overlap. Damage is applied on the next tick */
+	void QueueExplosion(const FShooterExplosion& Explosion);
+
+	/** Returns the number of explosions waiting to be resolved */
+	int32 GetNumPending() const { return PendingExplosions.Num() + OccludingExplosions.Num(); }
+
+protected:
+
+	/** Issues the async overlap for an explosion */
+	void IssueOverlap(FShooterExplosion& Explosion);
+
+	/** Finds each actor overlapped by an explosion once, and issues its occlusion trace if needed */
+	void GatherVictims(FShooterExplosion& Explosion, TArrayView<const FOverlapResult> Overlaps);
+
+	/** Issues the async trace checking if something blocks the explosion from reaching a victim */
+	void IssueOcclusionTrace(const FShooterExplosion& Explosion, FShooterExplosionVictim& Victim);
+
+	/** Reads back the occlusion traces of an explosion. Returns true once all of them are done */
+	bool ReadOcclusionTraces(FShooterExplosion& Explosion);
+
+	/** Damages and pushes every victim the explosion reaches */
+	void ResolveExplosion(const FShooterExplosion& Explosion);
+
+	/** Builds the query params for an explosion */
+	static FCollisionQueryParams MakeQueryParams(const FShooterExplosion& Explosion);
+};
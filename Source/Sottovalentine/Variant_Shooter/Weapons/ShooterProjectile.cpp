@@ -2,6 +2,9 @@
 
 
 #include "ShooterProjectile.h"
+#include "ShooterProjectilePool.h"
+#include "ShooterAreaDamage.h"
+#include "ShooterCrowdProxy.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "GameFramework/Character.h"
@@ -9,7 +12,6 @@
 #include "GameFramework/DamageType.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/Controller.h"
-#include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 
@@ -42,6 +44,9 @@ void AShooterProjectile::BeginPlay()
 	
 	// ignore the pawn that shot this projectile
 	CollisionComponent->IgnoreActorWhenMoving(GetInstigator(), true);
+
+	// save the starting velocity so it can be restored when the projectile is reused
+	InitialLocalVelocity = GetActorTransform().InverseTransformVectorNoScale(ProjectileMovement->Velocity);
 }
 
 void AShooterProjectile::EndPlay(EEndPlayReason::Type EndPlayReason)
@@ -53,6 +58,20 @@ void AShooterProjectile::EndPlay(EEndPlayReason::Type EndPlayReason)
 }
 
 void AShooterProjectile::NotifyHit(class UPrimitiveComponent* MyComp, AActor* Other, class UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit)
+{
+	HandleHit(Other, OtherComp, Hit);
+}
+
+void AShooterProjectile::ResolveBatchedHit(const FHitResult& Hit)
+{
+	// the batched simulation already moved the projectile to the impact, so don't fly any further
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	HandleHit(Hit.GetActor(), Hit.GetComponent(), Hit);
+}
+
+void AShooterProjectile::HandleHit(AActor* Other, UPrimitiveComponent* OtherComp, const FHitResult& Hit)
 {
 	// ignore if we've already hit something else
 	if (bHit)
@@ -91,52 +110,53 @@ void AShooterProjectile::NotifyHit(class UPrimitiveComponent* MyComp, AActor* Ot
 
 	} else {
 
-		// destroy the projectile right away
-		Destroy();
+		// return the projectile to the pool right away
+		ReturnToPool();
 	}
 }
 
-void AShooterProjectile::ExplosionCheck(const FVector& ExplosionCenter)
+void AShooterProjectile::LifeSpanExpired()
 {
-	// do a sphere overlap check look for nearby actors to damage
-	TArray<FOverlapResult> Overlaps;
-
-	FCollisionShape OverlapShape;
-	OverlapShape.SetSphere(ExplosionRadius);
-
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-	ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
+	// return the projectile to the pool instead of destroying it
+	ReturnToPool();
+}
 
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-	if (!bDamageOwner)
+void AShooterProjectile::ExplosionCheck(const FVector& ExplosionCenter)
+{
+	UShooterAreaDamageSubsystem* AreaDamage = GetWorld()->GetSubsystem<UShooterAreaDamageSubsystem>();
+	if (!AreaDamage)
 	{
-		QueryParams.AddIgnoredActor(GetInstigator());
+		return;
 	}
 
-	GetWorld()->OverlapMultiByObjectType(Overlaps, ExplosionCenter, FQuat::Identity, ObjectParams, OverlapShape, QueryParams);
-
-	TArray<AActor*> DamagedActors;
-
-	// process the overlap results
-	for (const FOverlapResult& CurrentOverlap : Overlaps)
+	FShooterExplosion Explosion;
+	Explosion.Center = ExplosionCenter;
+	Explosion.Radius = ExplosionRadius;
+	Explosion.Damage = HitDamage;
+	Explosion.PhysicsForce = PhysicsForce;
+	Explosion.DamageType = HitDamageType;
+	Explosion.Falloff = ExplosionFalloff;
+	Explosion.bOcclusion = bExplosionOcclusion;
+	Explosion.DamageCauser = this;
+	Explosion.Instigator = GetInstigatorController();
+
+	// we're the damage causer, so we can't be reused until the explosion is resolved
+	Explosion.OnResolved.BindUObject(this, &AShooterProjectile::OnExplosionResolved);
+	bExplosionPending = true;
+
+	// spare the character that shot this projectile
+	if (!bDamageOwner)
 	{
-		// overlaps may return the same actor multiple times per each component overlapped
-		// ensure we only damage each actor once by adding it to a damaged list
-		if (DamagedActors.Find(CurrentOverlap.GetActor()) == INDEX_NONE)
-		{
-			DamagedActors.Add(CurrentOverlap.GetActor());
+		Explosion.IgnoredActors.Add(GetInstigator());
+		Explosion.IgnoredActors.Add(GetOwner());
+	}
 
-			// apply physics force away from the explosion
-			const FVector& ExplosionDir = CurrentOverlap.GetActor()->GetActorLocation() - GetActorLocation();
+	// the character that shot this projectile never shields others from its own blast
+	Explosion.OcclusionIgnoredActors.Add(GetInstigator());
+	Explosion.OcclusionIgnoredActors.Add(GetOwner());
 
-			// push and/or damage the overlapped actor
-			ProcessHit(CurrentOverlap.GetActor(), CurrentOverlap.GetComponent(), GetActorLocation(), ExplosionDir.GetSafeNormal());
-		}
-			
-	}
+	// the overlap runs async, and damage and impulses are applied together on the next frame
+	AreaDamage->QueueExplosion(Explosion);
 }
 
 void AShooterProjectile::ProcessHit(AActor* HitActor, UPrimitiveComponent* HitComp, const FVector& HitLocation, const FVector& HitDirection)
@@ -148,10 +168,16 @@ void AShooterProjectile::ProcessHit(AActor* HitActor, UPrimitiveComponent* HitCo
 		if (HitCharacter != GetOwner() || bDamageOwner)
 		{
 			// apply damage to the character
-			UGameplayStatics::ApplyDamage(HitCharacter, HitDamage, GetInstigator()->GetController(), this, HitDamageType);
+			UGameplayStatics::ApplyDamage(HitCharacter, HitDamage, GetInstigatorController(), this, HitDamageType);
 		}
 	}
 
+	// have we hit a crowd combatant? The crowd applies the damage
+	if (AShooterCrowdProxy* HitProxy = Cast<AShooterCrowdProxy>(HitActor))
+	{
+		UGameplayStatics::ApplyDamage(HitProxy, HitDamage, GetInstigatorController(), this, HitDamageType);
+	}
+
 	// have we hit a physics object?
 	if (HitComp->IsSimulatingPhysics())
 	{
@@ -162,6 +188,94 @@ void AShooterProjectile::ProcessHit(AActor* HitActor, UPrimitiveComponent* HitCo
 
 void AShooterProjectile::OnDeferredDestruction()
 {
-	// destroy this actor
+	// return this actor to the pool
+	ReturnToPool();
+}
+
+void AShooterProjectile::ReturnToPool()
+{
+	// a reused projectile would be taken for the damage causer of our explosion, so wait for it to be resolved
+	if (bExplosionPending)
+	{
+		SetActorHiddenInGame(true);
+		bReturnAfterExplosion = true;
+		return;
+	}
+
+	// let the pool keep this projectile for reuse
+	if (UShooterProjectilePool* Pool = GetWorld()->GetSubsystem<UShooterProjectilePool>())
+	{
+		if (Pool->ReleaseProjectile(this))
+		{
+			return;
+		}
+	}
+
+	// the pool can't take it, destroy this actor
 	Destroy();
 }
+
+void AShooterProjectile::OnExplosionResolved()
+{
+	bExplosionPending = false;
+
+	// return to the pool if we were waiting for the explosion
+	if (bReturnAfterExplosion)
+	{
+		bReturnAfterExplosion = false;
+		ReturnToPool();
+	}
+}
+
+void AShooterProjectile::ActivateFromPool(const FTransform& SpawnTransform, AActor* NewOwner, APawn* NewInstigator)
+{
+	// move to the muzzle and take on the new shooter
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetOwner(NewOwner);
+	SetInstigator(NewInstigator);
+
+	// clear the hit flag so the projectile can collide again
+	bHit = false;
+
+	// ignore the pawn that shot this projectile, and only that pawn
+	CollisionComponent->ClearMoveIgnoreActors();
+	CollisionComponent->IgnoreActorWhenMoving(NewInstigator, true);
+
+	// enable collision
+	SetActorEnableCollision(true);
+	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+	// restart the movement. A projectile that stopped bouncing has lost its updated component
+	ProjectileMovement->SetUpdatedComponent(CollisionComponent);
+	ProjectileMovement->Velocity = SpawnTransform.TransformVectorNoScale(InitialLocalVelocity);
+	ProjectileMovement->Activate(true);
+
+	// show the projectile
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+
+	// restart the life span, if the projectile has one
+	SetLifeSpan(InitialLifeSpan);
+}
+
+void AShooterProjectile::DeactivateToPool()
+{
+	// stop any pending destruction
+	GetWorld()->GetTimerManager().ClearTimer(DestructionTimer);
+	SetLifeSpan(0.0f);
+
+	// stop moving
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	// hide the projectile and disable collision
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorTickEnabled(false);
+
+	// forget about the previous shooter
+	CollisionComponent->ClearMoveIgnoreActors();
+	SetOwner(nullptr);
+	SetInstigator(nullptr);
+}
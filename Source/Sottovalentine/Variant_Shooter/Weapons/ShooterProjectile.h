@@ -10,6 +10,8 @@ class USphereComponent;
 class UProjectileMovementComponent;
 class ACharacter;
 class UPrimitiveComponent;
+class UStaticMesh;
+class UCurveFloat;
 
 /**
  *  Simple projectile class for a first person shooter game
@@ -65,9 +67,23 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Projectile|Explosion", meta = (ClampMin = 0, ClampMax = 5000, Units = "cm"))
 	float ExplosionRadius = 500.0f;	
 
+	/** Explosion damage and force multiplier by distance, from 0 at the center to 1 at the radius. Full strength everywhere if unset */
+	UPROPERTY(EditAnywhere, Category="Projectile|Explosion")
+	TObjectPtr<UCurveFloat> ExplosionFalloff;
+
+	/** If true, actors behind walls or other obstacles are not affected by the explosion */
+	UPROPERTY(EditAnywhere, Category="Projectile|Explosion")
+	bool bExplosionOcclusion = false;
+
 	/** If true, this projectile has already hit another surface */
 	bool bHit = false;
 
+	/** If true, this projectile's explosion is queued and it's still the damage causer */
+	bool bExplosionPending = false;
+
+	/** If true, this projectile returns to the pool as soon as its explosion is resolved */
+	bool bReturnAfterExplosion = false;
+
 	/** How long to wait after a hit before destroying this projectile */
 	UPROPERTY(EditAnywhere, Category="Projectile|Destruction", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float DeferredDestructionTime = 5.0f;
@@ -75,6 +91,24 @@ protected:
 	/** Timer to handle deferred destruction of this projectile */
 	FTimerHandle DestructionTimer;
 
+	/** If true, this projectile was created by the projectile pool and returns to it instead of being destroyed */
+	bool bPooled = false;
+
+	/** Starting velocity relative to the projectile's rotation, restored when the projectile is reused */
+	FVector InitialLocalVelocity = FVector::ZeroVector;
+
+	/** If true, and this projectile doesn't bounce, it can fly without an actor when batched projectile simulation is enabled */
+	UPROPERTY(EditAnywhere, Category="Projectile|Batched")
+	bool bAllowBatchedSimulation = false;
+
+	/** Mesh drawn for this projectile while it's simulated in batch */
+	UPROPERTY(EditAnywhere, Category="Projectile|Batched")
+	TObjectPtr<UStaticMesh> BatchedMesh;
+
+	/** Scale of the batched mesh */
+	UPROPERTY(EditAnywhere, Category="Projectile|Batched")
+	FVector BatchedMeshScale = FVector::OneVector;
+
 public:	
 
 	/** Constructor */
@@ -91,9 +125,15 @@ protected:
 	/** Handles collision */
 	virtual void NotifyHit(class UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit) override;
 
+	/** Damages, makes noise and schedules destruction for a hit against the given actor */
+	void HandleHit(AActor* Other, UPrimitiveComponent* OtherComp, const FHitResult& Hit);
+
+	/** Returns the projectile to the pool when its life span runs out */
+	virtual void LifeSpanExpired() override;
+
 protected:
 
-	/** Looks up actors within the explosion radius and damages them */
+	/** Queues explosion damage for the actors within the explosion radius. It's applied on the next frame */
 	void ExplosionCheck(const FVector& ExplosionCenter);
 
 	/** Processes a projectile hit for the given actor */
@@ -106,4 +146,42 @@ protected:
 	/** Called from the destruction timer to destroy this projectile */
 	void OnDeferredDestruction();
 
+	/** Returns this projectile to the pool, or destroys it if the pool can't take it. Waits for a pending explosion */
+	void ReturnToPool();
+
+	/** Called by the area damage subsystem once this projectile's explosion has been resolved */
+	void OnExplosionResolved();
+
+public:
+
+	/** Resets this projectile and fires it from the given transform. Called by the projectile pool */
+	void ActivateFromPool(const FTransform& SpawnTransform, AActor* NewOwner, APawn* NewInstigator);
+
+	/** Hides this projectile and stops it until it's reused. Called by the projectile pool */
+	void DeactivateToPool();
+
+	/** Returns true if this projectile was created by the projectile pool */
+	bool IsPooled() const { return bPooled; }
+
+	/** Flags this projectile as owned by the projectile pool */
+	void SetPooled(bool bNewPooled) { bPooled = bNewPooled; }
+
+	/** Processes a hit found by the batched projectile simulation as if this projectile had collided */
+	void ResolveBatchedHit(const FHitResult& Hit);
+
+	/** Returns true if this projectile may be simulated in batch */
+	bool CanBeBatched() const { return bAllowBatchedSimulation; }
+
+	/** Returns the mesh drawn while simulated in batch */
+	UStaticMesh* GetBatchedMesh() const { return BatchedMesh; }
+
+	/** Returns the scale of the batched mesh */
+	const FVector& GetBatchedMeshScale() const { return BatchedMeshScale; }
+
+	/** Returns the collision component */
+	USphereComponent* GetCollisionComponent() const { return CollisionComponent; }
+
+	/** Returns the projectile movement component */
+	UProjectileMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
+
 };
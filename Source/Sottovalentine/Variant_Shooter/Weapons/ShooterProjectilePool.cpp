@@ -0,0 +1,352 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterProjectilePool.h"
+#include "ShooterProjectile.h"
+#include "ShooterProjectileSimulation.h"
+#include "ShooterWeapon.h"
+#include "Sottovalentine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "Kismet/GameplayStatics.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_CYCLE_STAT(TEXT("Acquire Projectile"), STAT_ShooterProjectilePool_Acquire, STATGROUP_Game);
+
+bool UShooterProjectilePool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UShooterProjectilePool::Deinitialize()
+{
+	// the world is going away and will destroy the pooled actors with it
+	FreeLists.Empty();
+
+	Super::Deinitialize();
+}
+
+void UShooterProjectilePool::Prewarm(TSubclassOf<AShooterProjectile> ProjectileClass)
+{
+	if (!bEnablePooling || !ProjectileClass)
+	{
+		return;
+	}
+
+	FShooterProjectileFreeList& FreeList = FreeLists.FindOrAdd(ProjectileClass.Get());
+
+	// only create the projectiles this class is still missing
+	const int32 NumToCreate = FMath::Min(PrewarmCount, MaxPooledPerClass) - FreeList.NumCreated;
+
+	for (int32 i = 0; i < NumToCreate; ++i)
+	{
+		if (AShooterProjectile* Projectile = SpawnProjectile(ProjectileClass.Get(), FTransform::Identity, nullptr, nullptr))
+		{
+			Projectile->DeactivateToPool();
+			FreeList.Projectiles.Add(Projectile);
+		}
+	}
+}
+
+AShooterProjectile* UShooterProjectilePool::AcquireProjectile(TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterProjectilePool_Acquire);
+
+	if (!ProjectileClass)
+	{
+		return nullptr;
+	}
+
+	if (bEnablePooling)
+	{
+		if (FShooterProjectileFreeList* FreeList = FreeLists.Find(ProjectileClass.Get()))
+		{
+			// reuse the most recently released projectile, skipping any destroyed while pooled
+			while (FreeList->Projectiles.Num() > 0)
+			{
+				AShooterProjectile* Projectile = FreeList->Projectiles.Pop(EAllowShrinking::No);
+
+				if (IsValid(Projectile))
+				{
+					Projectile->ActivateFromPool(SpawnTransform, Owner, Instigator);
+					return Projectile;
+				}
+
+				--FreeList->NumCreated;
+			}
+		}
+	}
+
+	// nothing to reuse, spawn a new projectile
+	return SpawnProjectile(ProjectileClass.Get(), SpawnTransform, Owner, Instigator);
+}
+
+bool UShooterProjectilePool::ReleaseProjectile(AShooterProjectile* Projectile)
+{
+	// only projectiles this pool created can come back to it
+	if (!IsValid(Projectile) || !Projectile->IsPooled())
+	{
+		return false;
+	}
+
+	FShooterProjectileFreeList* FreeList = FreeLists.Find(Projectile->GetClass());
+
+	// past the class limit, let the projectile be destroyed
+	if (!bEnablePooling || !FreeList || FreeList->Projectiles.Num() >= MaxPooledPerClass)
+	{
+		if (FreeList)
+		{
+			--FreeList->NumCreated;
+		}
+
+		return false;
+	}
+
+	Projectile->DeactivateToPool();
+	FreeList->Projectiles.Add(Projectile);
+
+	return true;
+}
+
+int32 UShooterProjectilePool::GetNumFree(TSubclassOf<AShooterProjectile> ProjectileClass) const
+{
+	const FShooterProjectileFreeList* FreeList = FreeLists.Find(ProjectileClass.Get());
+	return FreeList ? FreeList->Projectiles.Num() : 0;
+}
+
+int32 UShooterProjectilePool::GetNumCreated(TSubclassOf<AShooterProjectile> ProjectileClass) const
+{
+	const FShooterProjectileFreeList* FreeList = FreeLists.Find(ProjectileClass.Get());
+	return FreeList ? FreeList->NumCreated : 0;
+}
+
+AShooterProjectile* UShooterProjectilePool::SpawnProjectile(UClass* ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.TransformScaleMethod = ESpawnActorScaleMethod::OverrideRootScale;
+	SpawnParams.Owner = Owner;
+	SpawnParams.Instigator = Instigator;
+
+	AShooterProjectile* Projectile = GetWorld()->SpawnActor<AShooterProjectile>(ProjectileClass, SpawnTransform, SpawnParams);
+
+	// track the projectile so it can come back to the pool
+	if (Projectile && bEnablePooling)
+	{
+		Projectile->SetPooled(true);
+		++FreeLists.FindOrAdd(ProjectileClass).NumCreated;
+	}
+
+	return Projectile;
+}
+
+// ============================================================================
+// Stress test
+// ============================================================================
+
+namespace ShooterProjectileStress
+{
+	/** State of a running stress test */
+	struct FRun
+	{
+		TWeakObjectPtr<UWorld> World;
+		TSubclassOf<AShooterProjectile> ProjectileClass;
+		TWeakObjectPtr<APawn> Instigator;
+
+		int32 NumShooters = 50;
+		float Duration = 10.0f;
+		float RefireRate = 0.1f;
+		bool bPooled = true;
+		bool bWasPooling = true;
+
+		/** Ring of simulated shooters around the player */
+		FVector Center = FVector::ZeroVector;
+		TArray<float> ShooterCooldowns;
+
+		float Elapsed = 0.0f;
+
+		int32 NumShots = 0;
+		double TotalSpawnSeconds = 0.0;
+		double MaxSpawnSeconds = 0.0;
+
+		int32 NumGCs = 0;
+		double TotalGCSeconds = 0.0;
+		double GCStartTime = 0.0;
+
+		FDelegateHandle PreGCHandle;
+		FDelegateHandle PostGCHandle;
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+
+	static TUniquePtr<FRun> ActiveRun;
+
+	static void Finish(bool bCompleted)
+	{
+		FRun& Run = *ActiveRun;
+
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(Run.PreGCHandle);
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(Run.PostGCHandle);
+		FTSTicker::RemoveTicker(Run.TickerHandle);
+
+		UWorld* World = Run.World.Get();
+		UShooterProjectilePool* Pool = World ? World->GetSubsystem<UShooterProjectilePool>() : nullptr;
+		UShooterProjectileSimulation* Simulation = World ? World->GetSubsystem<UShooterProjectileSimulation>() : nullptr;
+
+		// time a full purge to see how much garbage the run left behind
+		double PurgeSeconds = 0.0;
+		if (bCompleted)
+		{
+			const double PurgeStart = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+			PurgeSeconds = FPlatformTime::Seconds() - PurgeStart;
+		}
+
+		UE_LOG(LogSottovalentine, Display, TEXT("Projectile stress (%s, %d shooters, %.1fs%s): %d shots, spawn avg %.1fus max %.1fus, %d GCs during run %.2fms, final purge %.2fms, pool created %d free %d, batched in flight %d"),
+			Run.bPooled ? TEXT("pooled") : TEXT("unpooled"), Run.NumShooters, Run.Elapsed, bCompleted ? TEXT("") : TEXT(", aborted"),
+			Run.NumShots,
+			Run.NumShots > 0 ? Run.TotalSpawnSeconds / Run.NumShots * 1000000.0 : 0.0, Run.MaxSpawnSeconds * 1000000.0,
+			Run.NumGCs, Run.TotalGCSeconds * 1000.0, PurgeSeconds * 1000.0,
+			Pool ? Pool->GetNumCreated(Run.ProjectileClass) : 0, Pool ? Pool->GetNumFree(Run.ProjectileClass) : 0,
+			Simulation ? Simulation->GetNumProjectiles() : 0);
+
+		// restore the configured pooling mode
+		if (Pool)
+		{
+			Pool->bEnablePooling = Run.bWasPooling;
+		}
+
+		ActiveRun.Reset();
+	}
+
+	static bool Tick(float DeltaTime)
+	{
+		FRun& Run = *ActiveRun;
+
+		UWorld* World = Run.World.Get();
+		UShooterProjectilePool* Pool = World ? World->GetSubsystem<UShooterProjectilePool>() : nullptr;
+		if (!Pool || !Run.Instigator.IsValid())
+		{
+			Finish(false);
+			return false;
+		}
+
+		UShooterProjectileSimulation* Simulation = World->GetSubsystem<UShooterProjectileSimulation>();
+
+		Run.Elapsed += DeltaTime;
+
+		for (int32 i = 0; i < Run.NumShooters; ++i)
+		{
+			Run.ShooterCooldowns[i] -= DeltaTime;
+
+			// fire at the refire rate, like a full auto NPC holding the trigger
+			while (Run.ShooterCooldowns[i] <= 0.0f)
+			{
+				Run.ShooterCooldowns[i] += Run.RefireRate;
+
+				// shooters stand on a ring around the player and fire outwards into the ground
+				const float Angle = 2.0f * PI * i / Run.NumShooters;
+				const FVector Outwards(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+				const FVector MuzzleLoc = Run.Center + Outwards * 500.0f + FVector(0.0f, 0.0f, 150.0f);
+				const FVector TargetLoc = Run.Center + Outwards * 1500.0f + FMath::VRand() * 200.0f;
+				const FTransform SpawnTransform((TargetLoc - MuzzleLoc).Rotation(), MuzzleLoc, FVector::OneVector);
+
+				// fire the same way weapons do, through the batched simulation when the class allows it
+				const double SpawnStart = FPlatformTime::Seconds();
+				if (!Simulation || !Simulation->AddProjectile(Run.ProjectileClass, SpawnTransform, Run.Instigator.Get(), Run.Instigator.Get()))
+				{
+					Pool->AcquireProjectile(Run.ProjectileClass, SpawnTransform, Run.Instigator.Get(), Run.Instigator.Get());
+				}
+				const double SpawnSeconds = FPlatformTime::Seconds() - SpawnStart;
+
+				++Run.NumShots;
+				Run.TotalSpawnSeconds += SpawnSeconds;
+				Run.MaxSpawnSeconds = FMath::Max(Run.MaxSpawnSeconds, SpawnSeconds);
+			}
+		}
+
+		if (Run.Elapsed >= Run.Duration)
+		{
+			Finish(true);
+			return false;
+		}
+
+		return true;
+	}
+
+	static void Start(const TArray<FString>& Args, UWorld* World)
+	{
+		if (ActiveRun.IsValid())
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Projectile stress test already running"));
+			return;
+		}
+
+		UShooterProjectilePool* Pool = World ? World->GetSubsystem<UShooterProjectilePool>() : nullptr;
+		APawn* PlayerPawn = World ? UGameplayStatics::GetPlayerPawn(World, 0) : nullptr;
+		if (!Pool || !PlayerPawn)
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Projectile stress test needs a game world with a player pawn"));
+			return;
+		}
+
+		// fire the projectiles of the first weapon found in the level
+		TSubclassOf<AShooterProjectile> ProjectileClass;
+		for (TActorIterator<AShooterWeapon> It(World); It && !ProjectileClass; ++It)
+		{
+			ProjectileClass = It->GetProjectileClass();
+		}
+
+		if (!ProjectileClass)
+		{
+			UE_LOG(LogSottovalentine, Warning, TEXT("Projectile stress test needs a shooter weapon in the level"));
+			return;
+		}
+
+		ActiveRun = MakeUnique<FRun>();
+		FRun& Run = *ActiveRun;
+
+		Run.World = World;
+		Run.ProjectileClass = ProjectileClass;
+		Run.Instigator = PlayerPawn;
+		Run.Center = PlayerPawn->GetActorLocation();
+
+		if (Args.Num() > 0) { Run.NumShooters = FMath::Clamp(FCString::Atoi(*Args[0]), 1, 500); }
+		if (Args.Num() > 1) { Run.Duration = FMath::Clamp(FCString::Atof(*Args[1]), 1.0f, 120.0f); }
+		if (Args.Num() > 2) { Run.bPooled = FCString::Atoi(*Args[2]) != 0; }
+
+		// spread the first shots over one refire interval
+		Run.ShooterCooldowns.SetNum(Run.NumShooters);
+		for (int32 i = 0; i < Run.NumShooters; ++i)
+		{
+			Run.ShooterCooldowns[i] = FMath::FRandRange(0.0f, Run.RefireRate);
+		}
+
+		Run.bWasPooling = Pool->bEnablePooling;
+		Pool->bEnablePooling = Run.bPooled;
+		Pool->Prewarm(ProjectileClass);
+
+		Run.PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddLambda([]()
+		{
+			ActiveRun->GCStartTime = FPlatformTime::Seconds();
+		});
+
+		Run.PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([]()
+		{
+			++ActiveRun->NumGCs;
+			ActiveRun->TotalGCSeconds += FPlatformTime::Seconds() - ActiveRun->GCStartTime;
+		});
+
+		Run.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+
+		UE_LOG(LogSottovalentine, Display, TEXT("Projectile stress test started: %d shooters firing %s every %.2fs for %.1fs (%s)"),
+			Run.NumShooters, *ProjectileClass->GetName(), Run.RefireRate, Run.Duration, Run.bPooled ? TEXT("pooled") : TEXT("unpooled"));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StressCommand(
+		TEXT("Shooter.ProjectileStress"),
+		TEXT("Simulates NPCs firing full auto around the player and logs projectile spawn cost and GC time. Args: [Shooters=50] [Seconds=10] [Pooled=1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Start));
+}
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ShooterProjectilePool.generated.h"
+
+class AShooterProjectile;
+class APawn;
+
+/**
+ *  Inactive projectiles of a single class
+ */
+USTRUCT()
+struct FShooterProjectileFreeList
+{
+	GENERATED_BODY()
+
+	/** Hidden, non-colliding projectiles ready to be fired again */
+	UPROPERTY()
+	TArray<TObjectPtr<AShooterProjectile>> Projectiles;
+
+	/** Number of projectiles of this class owned by the pool, in flight or not */
+	int32 NumCreated = 0;
+};
+
+/**
+ *  Per-world pool of shooter projectiles
+ *  Weapons acquire projectiles from the pool instead of spawning them,
+ *  and projectiles return to it instead of being destroyed.
+ *  This keeps full auto weapons from creating and destroying an actor per shot.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterProjectilePool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Inactive projectiles, per projectile class */
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FShooterProjectileFreeList> FreeLists;
+
+public:
+
+	/** Number of projectiles created up front for each projectile class */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile Pool", meta = (ClampMin = 0, ClampMax = 512))
+	int32 PrewarmCount = 16;
+
+	/** Max number of inactive projectiles kept per class. Projectiles returned past this are destroyed */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile Pool", meta = (ClampMin = 0, ClampMax = 2048))
+	int32 MaxPooledPerClass = 128;
+
+	/** If false, projectiles are spawned and destroyed as usual */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile Pool")
+	bool bEnablePooling = true;
+
+public:
+
+	/** Only create the pool in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Ensures at least PrewarmCount projectiles of the given class exist in the pool */
+	void Prewarm(TSubclassOf<AShooterProjectile> ProjectileClass);
+
+	/** Returns an active projectile of the given class, reusing an inactive one if possible */
+	AShooterProjectile* AcquireProjectile(TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator);
+
+	/** Deactivates the projectile and keeps it for reuse. Returns false if the pool is full and the projectile should be destroyed */
+	bool ReleaseProjectile(AShooterProjectile* Projectile);
+
+	/** Returns the number of inactive projectiles of the given class */
+	int32 GetNumFree(TSubclassOf<AShooterProjectile> ProjectileClass) const;
+
+	/** Returns the number of projectiles of the given class created by the pool */
+	int32 GetNumCreated(TSubclassOf<AShooterProjectile> ProjectileClass) const;
+
+protected:
+
+	/** Spawns a new projectile for the pool */
+	AShooterProjectile* SpawnProjectile(UClass* ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator);
+};
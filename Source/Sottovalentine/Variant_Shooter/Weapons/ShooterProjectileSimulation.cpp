@@ -0,0 +1,318 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "ShooterProjectileSimulation.h"
+#include "ShooterProjectile.h"
+#include "ShooterProjectilePool.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/WorldSettings.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched Projectiles Tick"), STAT_ShooterProjectileSimulation_Tick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Projectiles"), STAT_ShooterProjectileSimulation_Num, STATGROUP_Game);
+
+bool UShooterProjectileSimulation::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UShooterProjectileSimulation::Deinitialize()
+{
+	// the world is going away and will destroy the instance owner with it
+	Groups.Empty();
+	InstancesOwner = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UShooterProjectileSimulation::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterProjectileSimulation, STATGROUP_Tickables);
+}
+
+bool UShooterProjectileSimulation::CanSimulate(TSubclassOf<AShooterProjectile> ProjectileClass) const
+{
+	if (!bEnableBatchedSimulation || !ProjectileClass)
+	{
+		return false;
+	}
+
+	// bouncing projectiles need the full projectile movement, so they stay actors
+	const AShooterProjectile* ProjectileCDO = ProjectileClass->GetDefaultObject<AShooterProjectile>();
+	return ProjectileCDO->CanBeBatched() && !ProjectileCDO->GetProjectileMovement()->bShouldBounce;
+}
+
+bool UShooterProjectileSimulation::AddProjectile(TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator)
+{
+	if (!CanSimulate(ProjectileClass) || GetNumProjectiles() >= MaxProjectiles)
+	{
+		return false;
+	}
+
+	FShooterBatchedProjectileGroup& Group = FindOrAddGroup(ProjectileClass);
+
+	// the first sweep is issued on the next tick, together with the rest of the batch
+	Group.Positions.Add(SpawnTransform.GetLocation());
+	Group.Velocities.Add(SpawnTransform.TransformVectorNoScale(Group.InitialLocalVelocity));
+	Group.SweepEnds.Add(SpawnTransform.GetLocation());
+	Group.SweepHandles.AddDefaulted();
+	Group.Ages.Add(0.0f);
+	Group.Owners.Add(Owner);
+	Group.Instigators.Add(Instigator);
+
+	return true;
+}
+
+int32 UShooterProjectileSimulation::GetNumProjectiles() const
+{
+	int32 NumProjectiles = 0;
+
+	for (const FShooterBatchedProjectileGroup& Group : Groups)
+	{
+		NumProjectiles += Group.Num();
+	}
+
+	return NumProjectiles;
+}
+
+FShooterBatchedProjectileGroup& UShooterProjectileSimulation::FindOrAddGroup(TSubclassOf<AShooterProjectile> ProjectileClass)
+{
+	for (FShooterBatchedProjectileGroup& Group : Groups)
+	{
+		if (Group.ProjectileClass == ProjectileClass)
+		{
+			return Group;
+		}
+	}
+
+	FShooterBatchedProjectileGroup& Group = Groups.AddDefaulted_GetRef();
+	Group.ProjectileClass = ProjectileClass;
+
+	// copy the movement and collision settings of the class
+	const AShooterProjectile* ProjectileCDO = ProjectileClass->GetDefaultObject<AShooterProjectile>();
+	const UProjectileMovementComponent* Movement = ProjectileCDO->GetProjectileMovement();
+	const USphereComponent* Collision = ProjectileCDO->GetCollisionComponent();
+
+	Group.GravityZ = GetWorld()->GetGravityZ() * Movement->ProjectileGravityScale;
+	Group.MaxSpeed = Movement->MaxSpeed;
+	Group.LifeSpan = ProjectileCDO->InitialLifeSpan > 0.0f ? ProjectileCDO->InitialLifeSpan : MaxFlightTime;
+
+	// same rule the projectile movement uses to set up its starting velocity
+	Group.InitialLocalVelocity = Movement->InitialSpeed > 0.0f ? Movement->Velocity.GetSafeNormal() * Movement->InitialSpeed : Movement->Velocity;
+
+	Group.SweepShape = FCollisionShape::MakeSphere(Collision->GetUnscaledSphereRadius());
+	Group.SweepChannel = Collision->GetCollisionObjectType();
+	Group.SweepResponse = FCollisionResponseParams(Collision->GetCollisionResponseToChannels());
+
+	// create the instanced mesh that draws this class
+	if (UStaticMesh* Mesh = ProjectileCDO->GetBatchedMesh())
+	{
+		if (!InstancesOwner)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+
+			InstancesOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+			USceneComponent* Root = NewObject<USceneComponent>(InstancesOwner, TEXT("Root"));
+			InstancesOwner->SetRootComponent(Root);
+			Root->RegisterComponent();
+		}
+
+		Group.MeshScale = ProjectileCDO->GetBatchedMeshScale();
+
+		Group.Instances = NewObject<UInstancedStaticMeshComponent>(InstancesOwner);
+		Group.Instances->SetStaticMesh(Mesh);
+		Group.Instances->SetMobility(EComponentMobility::Movable);
+		Group.Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Group.Instances->SetCanEverAffectNavigation(false);
+		Group.Instances->SetupAttachment(InstancesOwner->GetRootComponent());
+		Group.Instances->RegisterComponent();
+		InstancesOwner->AddInstanceComponent(Group.Instances);
+	}
+
+	return Group;
+}
+
+void UShooterProjectileSimulation::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterProjectileSimulation_Tick);
+
+	UWorld* World = GetWorld();
+	const float KillZ = World->GetWorldSettings()->KillZ;
+
+	// shared query params. Each sweep adds its own shooter to the ignore list
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShooterBatchedProjectile), false);
+
+	for (FShooterBatchedProjectileGroup& Group : Groups)
+	{
+		// resolve last frame's sweeps. Walk backwards so removed slots are filled with projectiles already visited
+		for (int32 i = Group.Num() - 1; i >= 0; --i)
+		{
+			Group.Ages[i] += DeltaTime;
+
+			if (Group.SweepHandles[i].IsValid())
+			{
+				FHitResult Hit;
+				bool bBlocked = false;
+
+				FTraceDatum SweepData;
+				if (World->QueryTraceData(Group.SweepHandles[i], SweepData))
+				{
+					for (const FHitResult& OutHit : SweepData.OutHits)
+					{
+						if (OutHit.bBlockingHit)
+						{
+							Hit = OutHit;
+							bBlocked = true;
+							break;
+						}
+					}
+
+				} else {
+
+					// the async result was lost, sweep right away instead
+					FCollisionQueryParams ProjectileParams = QueryParams;
+					ProjectileParams.AddIgnoredActor(Group.Instigators[i].Get());
+
+					bBlocked = World->SweepSingleByChannel(Hit, Group.Positions[i], Group.SweepEnds[i], FQuat::Identity, Group.SweepChannel, Group.SweepShape, ProjectileParams, Group.SweepResponse);
+				}
+
+				Group.SweepHandles[i] = FTraceHandle();
+
+				// hits against components destroyed since the sweep are ignored
+				if (bBlocked && IsValid(Hit.GetComponent()))
+				{
+					ResolveHit(Group, i, Hit);
+					RemoveProjectile(Group, i);
+					continue;
+				}
+
+				// nothing in the way, commit the move
+				Group.Positions[i] = Group.SweepEnds[i];
+			}
+
+			// drop projectiles that flew for too long or fell out of the world
+			if (Group.Ages[i] > Group.LifeSpan || Group.Positions[i].Z < KillZ)
+			{
+				RemoveProjectile(Group, i);
+			}
+		}
+
+		const int32 NumProjectiles = Group.Num();
+		FVector* Positions = Group.Positions.GetData();
+		FVector* Velocities = Group.Velocities.GetData();
+		FVector* SweepEnds = Group.SweepEnds.GetData();
+		const FVector GravityStep(0.0f, 0.0f, Group.GravityZ * DeltaTime);
+
+		// integrate the whole group in flat loops over contiguous arrays so the compiler can vectorize them
+		for (int32 i = 0; i < NumProjectiles; ++i)
+		{
+			Velocities[i] += GravityStep;
+		}
+
+		if (Group.MaxSpeed > 0.0f && Group.GravityZ != 0.0f)
+		{
+			for (int32 i = 0; i < NumProjectiles; ++i)
+			{
+				Velocities[i] = Velocities[i].GetClampedToMaxSize(Group.MaxSpeed);
+			}
+		}
+
+		for (int32 i = 0; i < NumProjectiles; ++i)
+		{
+			SweepEnds[i] = Positions[i] + Velocities[i] * DeltaTime;
+		}
+
+		// queue the sweeps for this move. They run with the rest of the frame's async traces
+		for (int32 i = 0; i < NumProjectiles; ++i)
+		{
+			IssueSweep(Group, i, QueryParams);
+		}
+
+		UpdateInstances(Group);
+	}
+
+	SET_DWORD_STAT(STAT_ShooterProjectileSimulation_Num, GetNumProjectiles());
+}
+
+void UShooterProjectileSimulation::IssueSweep(FShooterBatchedProjectileGroup& Group, int32 Index, const FCollisionQueryParams& QueryParams)
+{
+	// ignore the pawn that shot this projectile
+	FCollisionQueryParams ProjectileParams = QueryParams;
+	ProjectileParams.AddIgnoredActor(Group.Instigators[Index].Get());
+
+	Group.SweepHandles[Index] = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, Group.Positions[Index], Group.SweepEnds[Index], FQuat::Identity, Group.SweepChannel, Group.SweepShape, ProjectileParams, Group.SweepResponse);
+}
+
+void UShooterProjectileSimulation::RemoveProjectile(FShooterBatchedProjectileGroup& Group, int32 Index)
+{
+	Group.Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Group.Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Group.SweepEnds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Group.SweepHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Group.Ages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Group.Owners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Group.Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UShooterProjectileSimulation::ResolveHit(FShooterBatchedProjectileGroup& Group, int32 Index, const FHitResult& Hit)
+{
+	UShooterProjectilePool* Pool = GetWorld()->GetSubsystem<UShooterProjectilePool>();
+	if (!Pool)
+	{
+		return;
+	}
+
+	// bring in an actor at the impact so the hit runs through the regular projectile code
+	const FTransform HitTransform(Group.Velocities[Index].Rotation(), Hit.Location, FVector::OneVector);
+
+	if (AShooterProjectile* Projectile = Pool->AcquireProjectile(Group.ProjectileClass, HitTransform, Group.Owners[Index].Get(), Group.Instigators[Index].Get()))
+	{
+		Projectile->ResolveBatchedHit(Hit);
+	}
+}
+
+void UShooterProjectileSimulation::UpdateInstances(FShooterBatchedProjectileGroup& Group)
+{
+	if (!Group.Instances)
+	{
+		return;
+	}
+
+	const int32 NumProjectiles = Group.Num();
+
+	InstanceTransforms.Reset(NumProjectiles);
+
+	for (int32 i = 0; i < NumProjectiles; ++i)
+	{
+		InstanceTransforms.Emplace(Group.Velocities[i].Rotation(), Group.Positions[i], Group.MeshScale);
+	}
+
+	// match the instance count to the projectile count. Slot i is always instance i
+	const int32 NumInstances = Group.Instances->GetInstanceCount();
+
+	if (NumInstances > NumProjectiles)
+	{
+		TArray<int32> InstancesToRemove;
+		for (int32 i = NumInstances - 1; i >= NumProjectiles; --i)
+		{
+			InstancesToRemove.Add(i);
+		}
+
+		Group.Instances->RemoveInstances(InstancesToRemove);
+
+	} else if (NumInstances < NumProjectiles) {
+
+		TArray<FTransform> NewInstances(InstanceTransforms.GetData() + NumInstances, NumProjectiles - NumInstances);
+		Group.Instances->AddInstances(NewInstances, false, true);
+	}
+
+	if (NumProjectiles > 0)
+	{
+		Group.Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+	}
+}
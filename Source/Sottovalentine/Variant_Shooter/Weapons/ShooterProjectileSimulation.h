@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "ShooterProjectileSimulation.generated.h"
+
+class AShooterProjectile;
+class APawn;
+class UInstancedStaticMeshComponent;
+
+/**
+ *  Projectiles of a single class simulated by the batched projectile simulation
+ *  Per projectile state is kept in parallel arrays indexed by the same slot,
+ *  and slot i is also instance i of the class instanced mesh.
+ */
+USTRUCT()
+struct FShooterBatchedProjectileGroup
+{
+	GENERATED_BODY()
+
+	/** Projectile class simulated by this group */
+	UPROPERTY()
+	TSubclassOf<AShooterProjectile> ProjectileClass;
+
+	/** Draws every projectile of this group */
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	/** Position committed after the last resolved sweep */
+	TArray<FVector> Positions;
+
+	/** Current velocity */
+	TArray<FVector> Velocities;
+
+	/** Position the pending sweep moves to */
+	TArray<FVector> SweepEnds;
+
+	/** Pending async sweep from Positions to SweepEnds */
+	TArray<FTraceHandle> SweepHandles;
+
+	/** Time spent in flight */
+	TArray<float> Ages;
+
+	/** Actor that owns the projectile */
+	TArray<TWeakObjectPtr<AActor>> Owners;
+
+	/** Pawn that shot the projectile */
+	TArray<TWeakObjectPtr<APawn>> Instigators;
+
+	/** Gravity acceleration, from the class projectile movement gravity scale */
+	float GravityZ = 0.0f;
+
+	/** Max speed, from the class projectile movement. Zero means no limit */
+	float MaxSpeed = 0.0f;
+
+	/** Max time in flight before the projectile is dropped */
+	float LifeSpan = 0.0f;
+
+	/** Starting velocity relative to the firing rotation */
+	FVector InitialLocalVelocity = FVector::ZeroVector;
+
+	/** Scale applied to the instanced mesh */
+	FVector MeshScale = FVector::OneVector;
+
+	/** Collision shape and channel from the class collision component */
+	FCollisionShape SweepShape;
+	TEnumAsByte<ECollisionChannel> SweepChannel = ECC_WorldDynamic;
+	FCollisionResponseParams SweepResponse;
+
+	/** Returns the number of projectiles in flight */
+	int32 Num() const { return Positions.Num(); }
+};
+
+/**
+ *  Simulates non-bouncing projectiles without spawning actors
+ *  Every projectile is a slot in a struct of arrays. The whole batch is integrated in one tick,
+ *  swept with async traces and drawn through one instanced mesh per class.
+ *  A projectile only becomes an actor when it hits something: one is taken from the projectile pool
+ *  at the impact so hit processing, explosions and Blueprint hit effects run unchanged.
+ *  Sweeps are resolved the frame after they're issued, so batched projectiles are drawn one frame behind.
+ */
+UCLASS(config=Game)
+class SOTTOVALENTINE_API UShooterProjectileSimulation : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Projectile groups, one per simulated class */
+	UPROPERTY()
+	TArray<FShooterBatchedProjectileGroup> Groups;
+
+	/** Actor owning the instanced mesh components */
+	UPROPERTY()
+	TObjectPtr<AActor> InstancesOwner;
+
+	/** Scratch instance transforms, reused across ticks */
+	TArray<FTransform> InstanceTransforms;
+
+public:
+
+	/** If true, projectile classes that allow it are simulated in batch instead of as actors */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile Simulation")
+	bool bEnableBatchedSimulation = false;
+
+	/** Max time in flight for classes without a life span */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile Simulation", meta = (ClampMin = 0.1, ClampMax = 60, Units = "s"))
+	float MaxFlightTime = 10.0f;
+
+	/** Max number of batched projectiles in flight. Shots past this are dropped */
+	UPROPERTY(Config, EditAnywhere, Category="Projectile Simulation", meta = (ClampMin = 0, ClampMax = 65536))
+	int32 MaxProjectiles = 8192;
+
+public:
+
+	/** Only simulate in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Integrates and sweeps every batched projectile */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Stat ID for the tick */
+	virtual TStatId GetStatId() const override;
+
+	/** Returns true if projectiles of this class can be fired through the batched simulation */
+	bool CanSimulate(TSubclassOf<AShooterProjectile> ProjectileClass) const;
+
+	/** Fires a batched projectile. Returns false if it couldn't be added */
+	bool AddProjectile(TSubclassOf<AShooterProjectile> ProjectileClass, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator);
+
+	/** Returns the number of batched projectiles in flight */
+	int32 GetNumProjectiles() const;
+
+protected:
+
+	/** Finds or creates the group for a projectile class */
+	FShooterBatchedProjectileGroup& FindOrAddGroup(TSubclassOf<AShooterProjectile> ProjectileClass);
+
+	/** Removes a projectile from its group, swapping the last one into its slot */
+	void RemoveProjectile(FShooterBatchedProjectileGroup& Group, int32 Index);
+
+	/** Turns a batched hit into a projectile actor and lets it process the hit */
+	void ResolveHit(FShooterBatchedProjectileGroup& Group, int32 Index, const FHitResult& Hit);
+
+	/** Issues the async sweep for the next move of a projectile */
+	void IssueSweep(FShooterBatchedProjectileGroup& Group, int32 Index, const FCollisionQueryParams& QueryParams);
+
+	/** Matches the group instances to its projectiles */
+	void UpdateInstances(FShooterBatchedProjectileGroup& Group);
+};
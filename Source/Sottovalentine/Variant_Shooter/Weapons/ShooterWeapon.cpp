@@ -5,6 +5,8 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Engine/World.h"
 #include "ShooterProjectile.h"
+#include "ShooterProjectilePool.h"
+#include "ShooterProjectileSimulation.h"
 #include "ShooterWeaponHolder.h"
 #include "Components/SceneComponent.h"
 #include "TimerManager.h"
@@ -52,6 +54,12 @@ void AShooterWeapon::BeginPlay()
 
 	// attach the meshes to the owner
 	WeaponOwner->AttachWeaponMeshes(this);
+
+	// create our projectiles ahead of time so the first shots don't spawn actors
+	if (UShooterProjectilePool* ProjectilePool = GetWorld()->GetSubsystem<UShooterProjectilePool>())
+	{
+		ProjectilePool->Prewarm(ProjectileClass);
+	}
 }
 
 void AShooterWeapon::EndPlay(EEndPlayReason::Type EndPlayReason)
@@ -123,6 +131,16 @@ void AShooterWeapon::StopFiring()
 	GetWorld()->GetTimerManager().ClearTimer(RefireTimer);
 }
 
+void AShooterWeapon::ResetForReuse()
+{
+	// stop firing and clear any pending refire
+	StopFiring();
+
+	// start over with a full magazine and no cooldown
+	CurrentBullets = MagazineSize;
+	TimeOfLastShot = 0.0f;
+}
+
 void AShooterWeapon::Fire()
 {
 	// ensure the player still wants to fire. They may have let go of the trigger
@@ -164,14 +182,28 @@ void AShooterWeapon::FireProjectile(const FVector& TargetLocation)
 	// get the projectile transform
 	FTransform ProjectileTransform = CalculateProjectileSpawnTransform(TargetLocation);
 	
-	// spawn the projectile
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	SpawnParams.TransformScaleMethod = ESpawnActorScaleMethod::OverrideRootScale;
-	SpawnParams.Owner = GetOwner();
-	SpawnParams.Instigator = PawnOwner;
-
-	AShooterProjectile* Projectile = GetWorld()->SpawnActor<AShooterProjectile>(ProjectileClass, ProjectileTransform, SpawnParams);
+	// fire the projectile through the batched simulation if its class allows it
+	UShooterProjectileSimulation* ProjectileSimulation = GetWorld()->GetSubsystem<UShooterProjectileSimulation>();
+	const bool bBatched = ProjectileSimulation && ProjectileSimulation->AddProjectile(ProjectileClass, ProjectileTransform, GetOwner(), PawnOwner);
+
+	if (!bBatched)
+	{
+		// get the projectile from the pool, or spawn it if there's no pool for this world
+		if (UShooterProjectilePool* ProjectilePool = GetWorld()->GetSubsystem<UShooterProjectilePool>())
+		{
+			ProjectilePool->AcquireProjectile(ProjectileClass, ProjectileTransform, GetOwner(), PawnOwner);
+
+		} else {
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParams.TransformScaleMethod = ESpawnActorScaleMethod::OverrideRootScale;
+			SpawnParams.Owner = GetOwner();
+			SpawnParams.Instigator = PawnOwner;
+
+			GetWorld()->SpawnActor<AShooterProjectile>(ProjectileClass, ProjectileTransform, SpawnParams);
+		}
+	}
 
 	// play the firing montage
 	WeaponOwner->PlayFiringMontage(FiringMontage);
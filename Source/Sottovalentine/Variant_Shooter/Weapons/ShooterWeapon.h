@@ -73,6 +73,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Aim")
 	FName MuzzleSocketName;
 
+	/** If true, shots trace the holder's aim right away instead of using the aim cached on the last frame */
+	UPROPERTY(EditAnywhere, Category="Aim")
+	bool bPreciseAim = false;
+
 	/** Distance ahead of the muzzle that bullets will spawn at */
 	UPROPERTY(EditAnywhere, Category="Aim", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
 	float MuzzleOffset = 10.0f;
@@ -142,6 +146,9 @@ public:
 	/** Stop firing this weapon */
 	void StopFiring();
 
+	/** Stops firing, refills the magazine and clears the refire cooldown so a reused owner gets the weapon back as new */
+	void ResetForReuse();
+
 protected:
 
 	/** Fire the weapon */
@@ -177,4 +184,10 @@ public:
 
 	/** Returns the current bullet count */
 	int32 GetBulletCount() const { return CurrentBullets; }
+
+	/** Returns the projectile class shot by this weapon */
+	const TSubclassOf<AShooterProjectile>& GetProjectileClass() const { return ProjectileClass; }
+
+	/** Returns true if shots need an exact aim trace */
+	bool NeedsPreciseAim() const { return bPreciseAim; }
 };
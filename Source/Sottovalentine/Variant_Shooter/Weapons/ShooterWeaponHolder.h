@@ -41,6 +41,9 @@ public:
 	/** Calculates and returns the aim location for the weapon */
 	virtual FVector GetWeaponTargetLocation() = 0;
 
+	/** Returns the ray the owner aims along, traced by its aim component */
+	virtual void GetWeaponAimRay(FVector& OutStart, FVector& OutEnd) = 0;
+
 	/** Gives a weapon of this class to the owner */
 	virtual void AddWeaponClass(const TSubclassOf<AShooterWeapon>& WeaponClass) = 0;
 